@@ -0,0 +1,53 @@
+#[===================================================================[
+   protocol codec fuzz targets and benchmark
+#]===================================================================]
+
+if(fuzzing)
+  # With clang every harness is a libFuzzer binary, and libxrpl is built
+  # with the coverage instrumentation libFuzzer needs. Other compilers get
+  # a driver that replays, or randomly mutates, a corpus instead.
+  if(is_clang)
+    if(xrpld)
+      # Only binaries linked with libFuzzer can resolve the instrumentation.
+      message(FATAL_ERROR "fuzzing: configure a separate build with -Dxrpld=OFF")
+    endif()
+    target_compile_options(xrpl.libxrpl PRIVATE -fsanitize=fuzzer-no-link)
+  else()
+    message(STATUS "fuzzing: libFuzzer needs clang, using the replay driver")
+    add_library(xrpl.fuzz_driver OBJECT src/fuzz/StandaloneMain.cpp)
+    target_include_directories(xrpl.fuzz_driver
+      PRIVATE $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/src>)
+    target_link_libraries(xrpl.fuzz_driver PRIVATE Ripple::opts)
+  endif()
+
+  file(GLOB harnesses CONFIGURE_DEPENDS
+    "${CMAKE_CURRENT_SOURCE_DIR}/src/fuzz/*_fuzz.cpp"
+  )
+  foreach(harness ${harnesses})
+    get_filename_component(name ${harness} NAME_WE)
+    add_executable(${name} ${harness})
+    target_include_directories(${name}
+      PRIVATE $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/src>)
+    target_link_libraries(${name} PRIVATE xrpl.libxrpl)
+    if(is_clang)
+      target_compile_options(${name} PRIVATE -fsanitize=fuzzer)
+      target_link_options(${name} PRIVATE -fsanitize=fuzzer)
+    else()
+      target_link_libraries(${name} PRIVATE xrpl.fuzz_driver)
+    endif()
+    exclude_if_included(${name})
+  endforeach()
+endif()
+
+if(benchmarks)
+  if(fuzzing AND is_clang)
+    message(WARNING
+      "benchmarks: libxrpl is instrumented for fuzzing, "
+      "so codec_bench will not measure a release build")
+  endif()
+  add_executable(codec_bench src/fuzz/CodecBench.cpp)
+  target_include_directories(codec_bench
+    PRIVATE $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/src>)
+  target_link_libraries(codec_bench PRIVATE xrpl.libxrpl)
+  exclude_if_included(codec_bench)
+endif()
@@ -12,6 +12,10 @@ option(xrpld "Build xrpld" ON)
 
 option(tests "Build tests" ON)
 
+option(fuzzing "Build the protocol codec fuzz targets" OFF)
+
+option(benchmarks "Build the protocol codec benchmark" OFF)
+
 option(unity "Creates a build using UNITY support in cmake. This is the default" ON)
 if(unity)
   if(NOT is_ci)
@@ -20,6 +20,8 @@
 #ifndef RIPPLE_BASICS_BYTEUTILITIES_H_INCLUDED
 #define RIPPLE_BASICS_BYTEUTILITIES_H_INCLUDED
 
+#include <cstddef>
+
 namespace ripple {
 
 template <class T>
@@ -36,6 +38,21 @@ megabytes(T value) noexcept
     return kilobytes(kilobytes(value));
 }
 
+/** Returns the approximate number of bytes an object occupies.
+
+    Types that own memory beyond their own storage report it through a
+    `memoryFootprint()` member; for any other type this is its size.
+*/
+template <class T>
+std::size_t
+memoryFootprint(T const& t) noexcept
+{
+    if constexpr (requires { t.memoryFootprint(); })
+        return t.memoryFootprint();
+    else
+        return sizeof(T);
+}
+
 static_assert(kilobytes(2) == 2048, "kilobytes(2) == 2048");
 static_assert(megabytes(3) == 3145728, "megabytes(3) == 3145728");
 }  // namespace ripple
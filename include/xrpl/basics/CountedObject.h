@@ -22,6 +22,8 @@
 
 #include <xrpl/beast/type_name.h>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -41,6 +43,15 @@ public:
     List
     getCounts(int minimumThreshold) const;
 
+    using ByteList = std::vector<std::pair<std::string, std::uint64_t>>;
+
+    /** Returns the approximate bytes held by the instances of each type.
+
+        Only types with at least `minimumThreshold` instances are listed.
+    */
+    ByteList
+    getBytes(int minimumThreshold) const;
+
 public:
     /** Implementation for @ref CountedObject.
 
@@ -49,7 +60,8 @@ public:
     class Counter
     {
     public:
-        Counter(std::string name) noexcept : name_(std::move(name)), count_(0)
+        Counter(std::string name, std::size_t size = 0) noexcept
+            : name_(std::move(name)), size_(size), count_(0), extra_(0)
         {
             // Insert ourselves at the front of the lock-free linked list
             CountedObjects& instance = CountedObjects::getInstance();
@@ -84,6 +96,23 @@ public:
             return count_.load();
         }
 
+        void
+        addBytes(std::ptrdiff_t bytes) noexcept
+        {
+            extra_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        /** The size of every instance plus the memory they own. */
+        std::uint64_t
+        getBytes() const noexcept
+        {
+            auto const bytes =
+                static_cast<std::int64_t>(getCount()) *
+                    static_cast<std::int64_t>(size_) +
+                extra_.load(std::memory_order_relaxed);
+            return bytes > 0 ? bytes : 0;
+        }
+
         Counter*
         getNext() const noexcept
         {
@@ -98,7 +127,10 @@ public:
 
     private:
         std::string const name_;
+        std::size_t const size_;
         std::atomic<int> count_;
+        // Memory owned by the instances outside their own storage
+        std::atomic<std::int64_t> extra_;
         Counter* next_;
     };
 
@@ -118,6 +150,10 @@ private:
     Derived classes have their instances counted automatically. This is used
     for reporting purposes.
 
+    The bytes held by the instances are their count times the size of the
+    object. A class that owns further memory, such as a buffer, reports it
+    with countBytes() when it allocates and frees that memory.
+
     @ingroup ripple_basics
 */
 template <class Object>
@@ -127,10 +163,19 @@ private:
     static auto&
     getCounter() noexcept
     {
-        static CountedObjects::Counter c{beast::type_name<Object>()};
+        static CountedObjects::Counter c{
+            beast::type_name<Object>(), sizeof(Object)};
         return c;
     }
 
+protected:
+    /** Count memory owned by an instance, or, if negative, released. */
+    static void
+    countBytes(std::ptrdiff_t bytes) noexcept
+    {
+        getCounter().addBytes(bytes);
+    }
+
 public:
     CountedObject() noexcept
     {
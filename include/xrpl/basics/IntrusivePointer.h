@@ -0,0 +1,379 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_INTRUSIVEPOINTER_H_INCLUDED
+#define RIPPLE_BASICS_INTRUSIVEPOINTER_H_INCLUDED
+
+#include <xrpl/basics/IntrusiveRefCounts.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ripple {
+
+/** A strong pointer to an object that embeds its reference counts.
+
+    Behaves like std::shared_ptr, but the object must derive from
+    IntrusiveRefCounts and provide a `partialDestructor()` member, called
+    when the last strong reference goes away while weak references remain.
+    The pointer itself is a single machine word.
+*/
+template <class T>
+class SharedIntrusive
+{
+public:
+    using element_type = T;
+
+    SharedIntrusive() noexcept = default;
+
+    SharedIntrusive(std::nullptr_t) noexcept
+    {
+    }
+
+    /** Take a new strong reference to `p`. */
+    explicit SharedIntrusive(T* p) noexcept : ptr_(p)
+    {
+        if (ptr_)
+            ptr_->addStrongRef();
+    }
+
+    SharedIntrusive(SharedIntrusive const& rhs) noexcept
+        : SharedIntrusive(rhs.ptr_)
+    {
+    }
+
+    template <class U>
+        requires std::is_convertible_v<U*, T*>
+    SharedIntrusive(SharedIntrusive<U> const& rhs) noexcept
+        : SharedIntrusive(rhs.get())
+    {
+    }
+
+    SharedIntrusive(SharedIntrusive&& rhs) noexcept
+        : ptr_(std::exchange(rhs.ptr_, nullptr))
+    {
+    }
+
+    template <class U>
+        requires std::is_convertible_v<U*, T*>
+    SharedIntrusive(SharedIntrusive<U>&& rhs) noexcept
+        : ptr_(std::exchange(rhs.ptr_, nullptr))
+    {
+    }
+
+    SharedIntrusive&
+    operator=(SharedIntrusive const& rhs) noexcept
+    {
+        SharedIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    SharedIntrusive&
+    operator=(SharedIntrusive&& rhs) noexcept
+    {
+        SharedIntrusive(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+        requires std::is_convertible_v<U*, T*>
+    SharedIntrusive&
+    operator=(SharedIntrusive<U> const& rhs) noexcept
+    {
+        SharedIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+        requires std::is_convertible_v<U*, T*>
+    SharedIntrusive&
+    operator=(SharedIntrusive<U>&& rhs) noexcept
+    {
+        SharedIntrusive(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~SharedIntrusive()
+    {
+        if (ptr_)
+            releaseStrong(ptr_);
+    }
+
+    void
+    reset() noexcept
+    {
+        SharedIntrusive().swap(*this);
+    }
+
+    void
+    swap(SharedIntrusive& rhs) noexcept
+    {
+        std::swap(ptr_, rhs.ptr_);
+    }
+
+    T*
+    get() const noexcept
+    {
+        return ptr_;
+    }
+
+    T&
+    operator*() const noexcept
+    {
+        return *ptr_;
+    }
+
+    T*
+    operator->() const noexcept
+    {
+        return ptr_;
+    }
+
+    explicit
+    operator bool() const noexcept
+    {
+        return ptr_ != nullptr;
+    }
+
+    /** Returns the number of strong references, or 0 if null. */
+    std::size_t
+    use_count() const noexcept
+    {
+        return ptr_ ? ptr_->use_count() : 0;
+    }
+
+private:
+    template <class U>
+    friend class SharedIntrusive;
+
+    template <class U>
+    friend class WeakIntrusive;
+
+    template <class TT, class UU>
+    friend SharedIntrusive<TT>
+    static_pointer_cast(SharedIntrusive<UU>&& sp) noexcept;
+
+    template <class TT, class UU>
+    friend SharedIntrusive<TT>
+    dynamic_pointer_cast(SharedIntrusive<UU>&& sp) noexcept;
+
+    struct AdoptTag
+    {
+    };
+
+    // Take ownership of a strong reference the caller already holds.
+    SharedIntrusive(T* p, AdoptTag) noexcept : ptr_(p)
+    {
+    }
+
+    static void
+    releaseStrong(T* p) noexcept
+    {
+        switch (p->releaseStrongRef())
+        {
+            case ReleaseStrongRefAction::noop:
+                break;
+            case ReleaseStrongRefAction::destroy:
+                delete p;
+                break;
+            case ReleaseStrongRefAction::partialDestroy:
+                p->partialDestructor();
+                if (p->releaseWeakRef() == ReleaseWeakRefAction::destroy)
+                    delete p;
+                break;
+        }
+    }
+
+    T* ptr_ = nullptr;
+};
+
+template <class T, class U>
+bool
+operator==(SharedIntrusive<T> const& a, SharedIntrusive<U> const& b) noexcept
+{
+    return a.get() == b.get();
+}
+
+template <class T>
+bool
+operator==(SharedIntrusive<T> const& a, std::nullptr_t) noexcept
+{
+    return a.get() == nullptr;
+}
+
+/** A weak pointer to an object that embeds its reference counts.
+
+    Behaves like std::weak_ptr: it keeps the memory of the object alive,
+    but not the object, and can be converted to a SharedIntrusive as long
+    as some strong reference remains.
+*/
+template <class T>
+class WeakIntrusive
+{
+public:
+    WeakIntrusive() noexcept = default;
+
+    WeakIntrusive(WeakIntrusive const& rhs) noexcept : ptr_(rhs.ptr_)
+    {
+        if (ptr_)
+            ptr_->addWeakRef();
+    }
+
+    WeakIntrusive(WeakIntrusive&& rhs) noexcept
+        : ptr_(std::exchange(rhs.ptr_, nullptr))
+    {
+    }
+
+    template <class U>
+        requires std::is_convertible_v<U*, T*>
+    WeakIntrusive(SharedIntrusive<U> const& rhs) noexcept : ptr_(rhs.get())
+    {
+        if (ptr_)
+            ptr_->addWeakRef();
+    }
+
+    WeakIntrusive&
+    operator=(WeakIntrusive const& rhs) noexcept
+    {
+        WeakIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    WeakIntrusive&
+    operator=(WeakIntrusive&& rhs) noexcept
+    {
+        WeakIntrusive(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <class U>
+        requires std::is_convertible_v<U*, T*>
+    WeakIntrusive&
+    operator=(SharedIntrusive<U> const& rhs) noexcept
+    {
+        WeakIntrusive(rhs).swap(*this);
+        return *this;
+    }
+
+    ~WeakIntrusive()
+    {
+        if (ptr_ && ptr_->releaseWeakRef() == ReleaseWeakRefAction::destroy)
+            delete ptr_;
+    }
+
+    void
+    reset() noexcept
+    {
+        WeakIntrusive().swap(*this);
+    }
+
+    void
+    swap(WeakIntrusive& rhs) noexcept
+    {
+        std::swap(ptr_, rhs.ptr_);
+    }
+
+    /** Returns a strong pointer to the object, or null if it is gone. */
+    SharedIntrusive<T>
+    lock() const noexcept
+    {
+        if (ptr_ && ptr_->checkoutStrongRefFromWeak())
+            return SharedIntrusive<T>(
+                ptr_, typename SharedIntrusive<T>::AdoptTag{});
+        return {};
+    }
+
+    bool
+    expired() const noexcept
+    {
+        return !ptr_ || ptr_->expired();
+    }
+
+private:
+    T* ptr_ = nullptr;
+};
+
+/** Allocate an object and return a strong pointer to it. */
+template <class T, class... Args>
+SharedIntrusive<T>
+make_SharedIntrusive(Args&&... args)
+{
+    return SharedIntrusive<T>(new T(std::forward<Args>(args)...));
+}
+
+template <class T, class U>
+SharedIntrusive<T>
+static_pointer_cast(SharedIntrusive<U> const& sp) noexcept
+{
+    return SharedIntrusive<T>(static_cast<T*>(sp.get()));
+}
+
+template <class T, class U>
+SharedIntrusive<T>
+static_pointer_cast(SharedIntrusive<U>&& sp) noexcept
+{
+    return SharedIntrusive<T>(
+        static_cast<T*>(std::exchange(sp.ptr_, nullptr)),
+        typename SharedIntrusive<T>::AdoptTag{});
+}
+
+template <class T, class U>
+SharedIntrusive<T>
+dynamic_pointer_cast(SharedIntrusive<U> const& sp) noexcept
+{
+    return SharedIntrusive<T>(dynamic_cast<T*>(sp.get()));
+}
+
+/** On failure, `sp` is left unchanged. */
+template <class T, class U>
+SharedIntrusive<T>
+dynamic_pointer_cast(SharedIntrusive<U>&& sp) noexcept
+{
+    auto p = dynamic_cast<T*>(sp.ptr_);
+    if (!p)
+        return {};
+    sp.ptr_ = nullptr;
+    return SharedIntrusive<T>(p, typename SharedIntrusive<T>::AdoptTag{});
+}
+
+/** Names mirroring the std smart pointer facilities. */
+namespace intr_ptr {
+
+template <class T>
+using SharedPtr = SharedIntrusive<T>;
+
+template <class T>
+using WeakPtr = WeakIntrusive<T>;
+
+template <class T, class... Args>
+SharedPtr<T>
+make_shared(Args&&... args)
+{
+    return make_SharedIntrusive<T>(std::forward<Args>(args)...);
+}
+
+using ripple::dynamic_pointer_cast;
+using ripple::static_pointer_cast;
+
+}  // namespace intr_ptr
+
+}  // namespace ripple
+
+#endif
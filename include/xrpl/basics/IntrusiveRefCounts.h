@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_INTRUSIVEREFCOUNTS_H_INCLUDED
+#define RIPPLE_BASICS_INTRUSIVEREFCOUNTS_H_INCLUDED
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+namespace ripple {
+
+/** Action to take after releasing a strong reference. */
+enum class ReleaseStrongRefAction { noop, partialDestroy, destroy };
+
+/** Action to take after releasing a weak reference. */
+enum class ReleaseWeakRefAction { noop, destroy };
+
+/** Strong and weak reference counts embedded in an object.
+
+    Used with SharedIntrusive and WeakIntrusive, this avoids the separate
+    control block and the wider pointers of std::shared_ptr.
+
+    Both counts are packed into a single atomic word. While any strong
+    references exist, they collectively hold one extra weak reference. When
+    the last strong reference goes away, the object is destroyed right away
+    if no weak references remain. Otherwise its `partialDestructor` is called
+    to release the resources it holds, and the memory itself is freed once
+    the last weak reference goes away.
+
+    @note The strong count is limited to 2^20 - 1 and the weak count to
+          2^12 - 2 references.
+*/
+class IntrusiveRefCounts
+{
+public:
+    void
+    addStrongRef() const noexcept
+    {
+        [[maybe_unused]] auto const prev =
+            refCounts_.fetch_add(strongOne, std::memory_order_relaxed);
+        assert(strong(prev) != strongMax);
+    }
+
+    void
+    addWeakRef() const noexcept
+    {
+        [[maybe_unused]] auto const prev =
+            refCounts_.fetch_add(weakOne, std::memory_order_relaxed);
+        assert(weak(prev) != weakMax);
+    }
+
+    /** Release a strong reference.
+
+        If this returns `partialDestroy`, the caller must call the object's
+        partial destructor and then releaseWeakRef, acting on its result.
+    */
+    [[nodiscard]] ReleaseStrongRefAction
+    releaseStrongRef() const noexcept
+    {
+        auto const prev =
+            refCounts_.fetch_sub(strongOne, std::memory_order_acq_rel);
+        assert(strong(prev) != 0);
+        if (strong(prev) != 1)
+            return ReleaseStrongRefAction::noop;
+        // No strong references remain, so no new weak references can be
+        // created: if the implicit one is the only one left, we are done.
+        if (weak(prev) == 1)
+            return ReleaseStrongRefAction::destroy;
+        return ReleaseStrongRefAction::partialDestroy;
+    }
+
+    [[nodiscard]] ReleaseWeakRefAction
+    releaseWeakRef() const noexcept
+    {
+        auto const prev =
+            refCounts_.fetch_sub(weakOne, std::memory_order_acq_rel);
+        assert(weak(prev) != 0);
+        if (weak(prev) == 1)
+            return ReleaseWeakRefAction::destroy;
+        return ReleaseWeakRefAction::noop;
+    }
+
+    /** Add a strong reference, unless none remain.
+
+        @return `true` if a strong reference was added.
+    */
+    [[nodiscard]] bool
+    checkoutStrongRefFromWeak() const noexcept
+    {
+        auto current = refCounts_.load(std::memory_order_relaxed);
+        while (strong(current) != 0)
+        {
+            assert(strong(current) != strongMax);
+            if (refCounts_.compare_exchange_weak(
+                    current,
+                    current + strongOne,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    /** Returns true if no strong references remain. */
+    bool
+    expired() const noexcept
+    {
+        return strong(refCounts_.load(std::memory_order_acquire)) == 0;
+    }
+
+    /** Returns the number of strong references. */
+    std::size_t
+    use_count() const noexcept
+    {
+        return strong(refCounts_.load(std::memory_order_acquire));
+    }
+
+protected:
+    // Objects start out with no strong references and the implicit weak one.
+    IntrusiveRefCounts() noexcept = default;
+
+    IntrusiveRefCounts(IntrusiveRefCounts const&) = delete;
+    IntrusiveRefCounts&
+    operator=(IntrusiveRefCounts const&) = delete;
+
+    ~IntrusiveRefCounts() noexcept
+    {
+        assert(strong(refCounts_.load()) == 0);
+    }
+
+private:
+    using CountType = std::uint32_t;
+
+    static constexpr int strongBits = 20;
+    static constexpr CountType strongOne = 1;
+    static constexpr CountType strongMax = (CountType{1} << strongBits) - 1;
+    static constexpr CountType weakOne = CountType{1} << strongBits;
+    static constexpr CountType weakMax = (~CountType{0}) >> strongBits;
+
+    static constexpr CountType
+    strong(CountType counts) noexcept
+    {
+        return counts & strongMax;
+    }
+
+    static constexpr CountType
+    weak(CountType counts) noexcept
+    {
+        return counts >> strongBits;
+    }
+
+    mutable std::atomic<CountType> refCounts_{weakOne};
+};
+
+}  // namespace ripple
+
+#endif
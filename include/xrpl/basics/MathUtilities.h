@@ -21,8 +21,11 @@
 #define RIPPLE_BASICS_MATHUTILITIES_H_INCLUDED
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 
 namespace ripple {
 
@@ -63,6 +66,44 @@ static_assert(calculatePercent(50'000'000, 100'000'000) == 50);
 static_assert(calculatePercent(50'000'001, 100'000'000) == 51);
 static_assert(calculatePercent(99'999'999, 100'000'000) == 100);
 
+/** The powers of ten that fit in 64 bits, from 10^0 to 10^19. */
+inline constexpr std::array<std::uint64_t, 20> powersOfTen = []() {
+    std::array<std::uint64_t, 20> result{};
+    std::uint64_t p = 1;
+    for (auto& r : result)
+    {
+        r = p;
+        p *= 10;
+    }
+    return result;
+}();
+
+/** The number of decimal digits in a value, or zero for zero.
+ *
+ * The bit width times log10(2) is at most one less than the answer, so a
+ * single comparison replaces a loop of divisions.
+ * */
+constexpr int
+decimalDigits(std::uint64_t value)
+{
+    int const guess = ((64 - std::countl_zero(value)) * 1233) >> 12;
+    return guess + (value >= powersOfTen[guess]);
+}
+
+// unit tests
+static_assert(powersOfTen[0] == 1);
+static_assert(powersOfTen[15] == 1'000'000'000'000'000);
+static_assert(powersOfTen[19] == 10'000'000'000'000'000'000ull);
+static_assert(decimalDigits(0) == 0);
+static_assert(decimalDigits(1) == 1);
+static_assert(decimalDigits(9) == 1);
+static_assert(decimalDigits(10) == 2);
+static_assert(decimalDigits(999'999'999'999'999) == 15);
+static_assert(decimalDigits(1'000'000'000'000'000) == 16);
+static_assert(decimalDigits(9'999'999'999'999'999) == 16);
+static_assert(decimalDigits(10'000'000'000'000'000'000ull) == 20);
+static_assert(decimalDigits(~std::uint64_t(0)) == 20);
+
 }  // namespace ripple
 
 #endif
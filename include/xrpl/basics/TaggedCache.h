@@ -20,16 +20,20 @@
 #ifndef RIPPLE_BASICS_TAGGEDCACHE_H_INCLUDED
 #define RIPPLE_BASICS_TAGGEDCACHE_H_INCLUDED
 
+#include <xrpl/basics/ByteUtilities.h>
 #include <xrpl/basics/Log.h>
 #include <xrpl/basics/UnorderedContainers.h>
 #include <xrpl/basics/hardened_hash.h>
 #include <xrpl/beast/clock/abstract_clock.h>
 #include <xrpl/beast/insight/Insight.h>
+#include <algorithm>
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ripple {
@@ -45,6 +49,10 @@ namespace ripple {
 
     @note Callers must not modify data objects that are stored in the cache
           unless they hold their own lock over all cache operations.
+
+    The strong and weak pointer types default to std::shared_ptr and
+    std::weak_ptr, but any pair with the same interface may be used, such as
+    SharedIntrusive and WeakIntrusive.
 */
 template <
     class Key,
@@ -52,13 +60,17 @@ template <
     bool IsKeyCache = false,
     class Hash = hardened_hash<>,
     class KeyEqual = std::equal_to<Key>,
-    class Mutex = std::recursive_mutex>
+    class Mutex = std::recursive_mutex,
+    class SharedPointerType = std::shared_ptr<T>,
+    class WeakPointerType = std::weak_ptr<T>>
 class TaggedCache
 {
 public:
     using mutex_type = Mutex;
     using key_type = Key;
     using mapped_type = T;
+    using shared_pointer_type = SharedPointerType;
+    using weak_pointer_type = WeakPointerType;
     using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
 
 public:
@@ -80,6 +92,7 @@ public:
         , m_target_size(size)
         , m_target_age(expiration)
         , m_cache_count(0)
+        , m_bytes(0)
         , m_hits(0)
         , m_misses(0)
     {
@@ -101,6 +114,13 @@ public:
         return m_cache.size();
     }
 
+    int
+    getTargetSize() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_target_size;
+    }
+
     void
     setTargetSize(int s)
     {
@@ -151,6 +171,28 @@ public:
         return m_cache.size();
     }
 
+    /** Returns the approximate number of bytes the cache holds.
+
+        This counts the objects the cache keeps alive, measured with
+        memoryFootprint() when they were cached, and the entries of the
+        map itself. Objects tracked only weakly are owned elsewhere.
+    */
+    std::uint64_t
+    getBytes() const
+    {
+        std::lock_guard lock(m_mutex);
+        return m_bytes + m_cache.size() * getEntryOverhead();
+    }
+
+    /** Returns the approximate bytes each entry adds to the map itself:
+        the key, the entry and the node of the bucket that holds them.
+    */
+    static constexpr std::size_t
+    getEntryOverhead()
+    {
+        return sizeof(key_type) + sizeof(Entry) + 2 * sizeof(void*);
+    }
+
     float
     getHitRate()
     {
@@ -159,12 +201,21 @@ public:
         return m_hits * (100.0f / std::max(1.0f, total));
     }
 
+    /** Returns the number of hits and misses since the last reset. */
+    std::pair<std::uint64_t, std::uint64_t>
+    getHitsAndMisses() const
+    {
+        std::lock_guard lock(m_mutex);
+        return {m_hits, m_misses};
+    }
+
     void
     clear()
     {
         std::lock_guard lock(m_mutex);
         m_cache.clear();
         m_cache_count = 0;
+        m_bytes = 0;
     }
 
     void
@@ -173,6 +224,7 @@ public:
         std::lock_guard lock(m_mutex);
         m_cache.clear();
         m_cache_count = 0;
+        m_bytes = 0;
         m_hits = 0;
         m_misses = 0;
     }
@@ -197,8 +249,8 @@ public:
     }
 
     using SweptPointersVector = std::pair<
-        std::vector<std::shared_ptr<mapped_type>>,
-        std::vector<std::weak_ptr<mapped_type>>>;
+        std::vector<SharedPointerType>,
+        std::vector<WeakPointerType>>;
 
     void
     sweep()
@@ -239,6 +291,7 @@ public:
             std::vector<std::thread> workers;
             workers.reserve(m_cache.partitions());
             std::atomic<int> allRemovals = 0;
+            std::atomic<std::uint64_t> allBytes = 0;
 
             for (std::size_t p = 0; p < m_cache.partitions(); ++p)
             {
@@ -248,12 +301,14 @@ public:
                     m_cache.map()[p],
                     allStuffToSweep[p],
                     allRemovals,
+                    allBytes,
                     lock));
             }
             for (std::thread& worker : workers)
                 worker.join();
 
             m_cache_count -= allRemovals;
+            m_bytes -= allBytes;
         }
         // At this point allStuffToSweep will go out of scope outside the lock
         // and decrement the reference count on each strong pointer.
@@ -285,6 +340,7 @@ public:
         {
             --m_cache_count;
             entry.ptr.reset();
+            account(entry);
             ret = true;
         }
 
@@ -311,8 +367,8 @@ public:
     bool
     canonicalize(
         const key_type& key,
-        std::shared_ptr<T>& data,
-        std::function<bool(std::shared_ptr<T> const&)>&& replace)
+        SharedPointerType& data,
+        std::function<bool(SharedPointerType const&)>&& replace)
     {
         // Return canonical value, store if needed, refresh in cache
         // Return values: true=we had the data already
@@ -322,11 +378,12 @@ public:
 
         if (cit == m_cache.end())
         {
-            m_cache.emplace(
+            auto const it = m_cache.emplace(
                 std::piecewise_construct,
                 std::forward_as_tuple(key),
                 std::forward_as_tuple(m_clock.now(), data));
             ++m_cache_count;
+            account(it.first->second);
             return false;
         }
 
@@ -339,6 +396,7 @@ public:
             {
                 entry.ptr = data;
                 entry.weak_ptr = data;
+                account(entry);
             }
             else
             {
@@ -364,12 +422,14 @@ public:
             }
 
             ++m_cache_count;
+            account(entry);
             return true;
         }
 
         entry.ptr = data;
         entry.weak_ptr = data;
         ++m_cache_count;
+        account(entry);
 
         return false;
     }
@@ -377,22 +437,22 @@ public:
     bool
     canonicalize_replace_cache(
         const key_type& key,
-        std::shared_ptr<T> const& data)
+        SharedPointerType const& data)
     {
         return canonicalize(
             key,
-            const_cast<std::shared_ptr<T>&>(data),
-            [](std::shared_ptr<T> const&) { return true; });
+            const_cast<SharedPointerType&>(data),
+            [](SharedPointerType const&) { return true; });
     }
 
     bool
-    canonicalize_replace_client(const key_type& key, std::shared_ptr<T>& data)
+    canonicalize_replace_client(const key_type& key, SharedPointerType& data)
     {
         return canonicalize(
-            key, data, [](std::shared_ptr<T> const&) { return false; });
+            key, data, [](SharedPointerType const&) { return false; });
     }
 
-    std::shared_ptr<T>
+    SharedPointerType
     fetch(const key_type& key)
     {
         std::lock_guard<mutex_type> l(m_mutex);
@@ -411,7 +471,7 @@ public:
     insert(key_type const& key, T const& value)
         -> std::enable_if_t<!IsKeyCache, ReturnType>
     {
-        auto p = std::make_shared<T>(std::cref(value));
+        SharedPointerType p = std::make_shared<T>(std::cref(value));
         return canonicalize_replace_client(key, p);
     }
 
@@ -469,6 +529,41 @@ public:
         return v;
     }
 
+    /** Return the keys of the most recently accessed entries.
+
+        The keys are ordered from the most to the least recently accessed.
+
+        @param limit the maximum number of keys to return
+    */
+    std::vector<key_type>
+    getRecentKeys(std::size_t limit) const
+    {
+        std::vector<std::pair<clock_type::time_point, key_type>> v;
+
+        {
+            std::lock_guard lock(m_mutex);
+            v.reserve(m_cache.size());
+            for (auto const& _ : m_cache)
+                v.emplace_back(_.second.last_access, _.first);
+        }
+
+        auto const newer = [](auto const& a, auto const& b) {
+            return a.first > b.first;
+        };
+        if (v.size() > limit)
+        {
+            std::nth_element(v.begin(), v.begin() + limit, v.end(), newer);
+            v.resize(limit);
+        }
+        std::sort(v.begin(), v.end(), newer);
+
+        std::vector<key_type> keys;
+        keys.reserve(v.size());
+        for (auto const& _ : v)
+            keys.push_back(_.second);
+        return keys;
+    }
+
     // CachedSLEs functions.
     /** Returns the fraction of cache hits. */
     double
@@ -487,7 +582,7 @@ public:
             std::shared_ptr<SLE const>(void)
     */
     template <class Handler>
-    std::shared_ptr<T>
+    SharedPointerType
     fetch(key_type const& digest, Handler const& h)
     {
         {
@@ -504,14 +599,16 @@ public:
         ++m_misses;
         auto const [it, inserted] =
             m_cache.emplace(digest, Entry(m_clock.now(), std::move(sle)));
-        if (!inserted)
+        if (inserted)
+            account(it->second);
+        else
             it->second.touch(m_clock.now());
         return it->second.ptr;
     }
     // End CachedSLEs functions.
 
 private:
-    std::shared_ptr<T>
+    SharedPointerType
     initialFetch(key_type const& key, std::lock_guard<mutex_type> const& l)
     {
         auto cit = m_cache.find(key);
@@ -530,6 +627,7 @@ private:
         {
             // independent of cache size, so not counted as a hit
             ++m_cache_count;
+            account(entry);
             entry.touch(m_clock.now());
             return entry.ptr;
         }
@@ -542,6 +640,7 @@ private:
     collect_metrics()
     {
         m_stats.size.set(getCacheSize());
+        m_stats.bytes.set(getBytes());
 
         {
             beast::insight::Gauge::value_type hit_rate(0);
@@ -566,6 +665,7 @@ private:
             : hook(collector->make_hook(handler))
             , size(collector->make_gauge(prefix, "size"))
             , hit_rate(collector->make_gauge(prefix, "hit_rate"))
+            , bytes(collector->make_gauge(prefix, "bytes"))
             , hits(0)
             , misses(0)
         {
@@ -574,6 +674,7 @@ private:
         beast::insight::Hook hook;
         beast::insight::Gauge size;
         beast::insight::Gauge hit_rate;
+        beast::insight::Gauge bytes;
 
         std::size_t hits;
         std::size_t misses;
@@ -599,13 +700,15 @@ private:
     class ValueEntry
     {
     public:
-        std::shared_ptr<mapped_type> ptr;
-        std::weak_ptr<mapped_type> weak_ptr;
+        SharedPointerType ptr;
+        WeakPointerType weak_ptr;
         clock_type::time_point last_access;
+        // The footprint of the object counted while ptr holds it
+        std::uint32_t bytes = 0;
 
         ValueEntry(
             clock_type::time_point const& last_access_,
-            std::shared_ptr<mapped_type> const& ptr_)
+            SharedPointerType const& ptr_)
             : ptr(ptr_), weak_ptr(ptr_), last_access(last_access_)
         {
         }
@@ -625,7 +728,7 @@ private:
         {
             return weak_ptr.expired();
         }
-        std::shared_ptr<mapped_type>
+        SharedPointerType
         lock()
         {
             return weak_ptr.lock();
@@ -650,6 +753,18 @@ private:
     using cache_type =
         hardened_partitioned_hash_map<key_type, Entry, Hash, KeyEqual>;
 
+    // Bring the bytes counted for an entry in line with the object it now
+    // holds strongly, if any. The caller must hold the lock.
+    void
+    account(Entry& entry)
+    {
+        std::uint32_t const bytes = entry.isCached()
+            ? static_cast<std::uint32_t>(memoryFootprint(*entry.ptr))
+            : 0;
+        m_bytes = m_bytes - entry.bytes + bytes;
+        entry.bytes = bytes;
+    }
+
     [[nodiscard]] std::thread
     sweepHelper(
         clock_type::time_point const& when_expire,
@@ -657,11 +772,13 @@ private:
         typename KeyValueCacheType::map_type& partition,
         SweptPointersVector& stuffToSweep,
         std::atomic<int>& allRemovals,
+        std::atomic<std::uint64_t>& allBytes,
         std::lock_guard<std::recursive_mutex> const&)
     {
         return std::thread([&, this]() {
             int cacheRemovals = 0;
             int mapRemovals = 0;
+            std::uint64_t bytesRemoved = 0;
 
             // Keep references to all the stuff we sweep
             // so that we can destroy them outside the lock.
@@ -690,6 +807,8 @@ private:
                     {
                         // strong, expired
                         ++cacheRemovals;
+                        bytesRemoved += cit->second.bytes;
+                        cit->second.bytes = 0;
                         if (cit->second.ptr.use_count() == 1)
                         {
                             stuffToSweep.first.push_back(
@@ -721,6 +840,7 @@ private:
             }
 
             allRemovals += cacheRemovals;
+            allBytes += bytesRemoved;
         });
     }
 
@@ -731,6 +851,7 @@ private:
         typename KeyOnlyCacheType::map_type& partition,
         SweptPointersVector&,
         std::atomic<int>& allRemovals,
+        std::atomic<std::uint64_t>&,
         std::lock_guard<std::recursive_mutex> const&)
     {
         return std::thread([&, this]() {
@@ -788,6 +909,8 @@ private:
 
     // Number of items cached
     int m_cache_count;
+    // Footprint of the objects held strongly
+    std::uint64_t m_bytes;
     cache_type m_cache;  // Hold strong reference to recent objects
     std::uint64_t m_hits;
     std::uint64_t m_misses;
@@ -621,7 +621,9 @@ template <std::size_t Bits, class Tag>
 inline std::string
 to_string(base_uint<Bits, Tag> const& a)
 {
-    return strHex(a.cbegin(), a.cend());
+    std::string result(2 * a.size(), '\0');
+    strHex(a.data(), a.size(), result.data());
+    return result;
 }
 
 template <std::size_t Bits, class Tag>
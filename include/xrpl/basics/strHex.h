@@ -23,8 +23,42 @@
 #include <boost/algorithm/hex.hpp>
 #include <boost/endian/conversion.hpp>
 
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <string>
+
 namespace ripple {
 
+namespace detail {
+
+// Each byte maps to its two upper case hex digits
+inline constexpr std::array<char, 512> hexPairs = []() {
+    constexpr char digits[] = "0123456789ABCDEF";
+    std::array<char, 512> pairs{};
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+        pairs[2 * i] = digits[i >> 4];
+        pairs[2 * i + 1] = digits[i & 0xf];
+    }
+    return pairs;
+}();
+
+}  // namespace detail
+
+/** Write the upper case hex encoding of `size` bytes to `out`.
+
+    The output must have room for 2 * size characters. Encoding a byte is
+    one table lookup and one two byte copy, with no branches.
+*/
+inline void
+strHex(void const* data, std::size_t size, char* out) noexcept
+{
+    auto const bytes = static_cast<unsigned char const*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+        std::memcpy(out + 2 * i, &detail::hexPairs[2 * bytes[i]], 2);
+}
+
 template <class FwdIt>
 std::string
 strHex(FwdIt begin, FwdIt end)
@@ -34,9 +68,24 @@ strHex(FwdIt begin, FwdIt end)
             typename std::iterator_traits<FwdIt>::iterator_category,
             std::forward_iterator_tag>::value,
         "FwdIt must be a forward iterator");
+    using value_type = typename std::iterator_traits<FwdIt>::value_type;
+
     std::string result;
-    result.reserve(2 * std::distance(begin, end));
-    boost::algorithm::hex(begin, end, std::back_inserter(result));
+    if constexpr (sizeof(value_type) == 1)
+    {
+        result.resize(2 * std::distance(begin, end));
+        char* out = result.data();
+        for (; begin != end; ++begin, out += 2)
+        {
+            auto const b = static_cast<unsigned char>(*begin);
+            std::memcpy(out, &detail::hexPairs[2 * b], 2);
+        }
+    }
+    else
+    {
+        result.reserve(2 * sizeof(value_type) * std::distance(begin, end));
+        boost::algorithm::hex(begin, end, std::back_inserter(result));
+    }
     return result;
 }
 
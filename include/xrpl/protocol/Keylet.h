@@ -47,6 +47,10 @@ struct Keylet
     /** Returns true if the SLE matches the type */
     bool
     check(STLedgerEntry const&) const;
+
+    /** Returns true if an entry of the given type matches the type */
+    bool
+    check(LedgerEntryType sleType) const;
 };
 
 }  // namespace ripple
@@ -256,6 +256,22 @@ verify(
     Slice const& sig,
     bool mustBeFullyCanonical = true) noexcept;
 
+/** Lookups in the cache of decoded secp256k1 public keys.
+
+    To check a secp256k1 signature, the public key must first be decoded
+    into a point on the curve, which takes a square root. The same
+    validators sign every validation and busy accounts sign many
+    transactions, so the points of recently used keys are cached.
+*/
+struct PublicKeyCacheCounts
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+};
+
+PublicKeyCacheCounts
+getPublicKeyCacheCounts();
+
 /** Calculate the 160-bit node ID from a node public key. */
 NodeID
 calcNodeID(PublicKey const&);
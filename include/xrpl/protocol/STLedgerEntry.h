@@ -77,6 +77,10 @@ public:
         uint256& prevTxID,
         std::uint32_t& prevLedgerID);
 
+    /** The approximate bytes taken by the entry and its fields. */
+    std::size_t
+    memoryFootprint() const;
+
 private:
     /*  Make STObject comply with the template for this SLE type
         Can throw
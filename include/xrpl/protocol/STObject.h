@@ -168,6 +168,13 @@ public:
     int
     getCount() const;
 
+    /** The approximate bytes the fields take outside the object itself.
+
+        Nested objects, arrays, blobs, hash vectors and paths are included.
+    */
+    std::size_t
+    getFieldsFootprint() const;
+
     bool setFlag(std::uint32_t);
     bool clearFlag(std::uint32_t);
     bool isFlag(std::uint32_t) const;
@@ -410,6 +417,26 @@ public:
 
     class FieldErr;
 
+protected:
+    /** Deserialize, optionally noting where each field begins.
+
+        When fieldOffsets is not null, the offset from the iterator's
+        starting position of each field's encoding, and of the end marker
+        if one is reached, is appended to it in the order they appear.
+    */
+    bool
+    set(SerialIter& u, int depth, std::vector<std::size_t>* fieldOffsets);
+
+    /** Called before a field is changed, or handed out to be changed.
+
+        A derived class that caches something computed from the fields
+        overrides this to discard it.
+    */
+    virtual void
+    onChange()
+    {
+    }
+
 private:
     enum WhichFields : bool {
         // These values are carefully chosen to do the right thing if passed
@@ -919,6 +946,7 @@ template <class... Args>
 inline std::size_t
 STObject::emplace_back(Args&&... args)
 {
+    onChange();
     v_.emplace_back(std::forward<Args>(args)...);
     return v_.size() - 1;
 }
@@ -938,6 +966,7 @@ STObject::peekAtIndex(int offset) const
 inline STBase&
 STObject::getIndex(int offset)
 {
+    onChange();
     return v_[offset].get();
 }
 
@@ -950,6 +979,7 @@ STObject::peekAtPIndex(int offset) const
 inline STBase*
 STObject::getPIndex(int offset)
 {
+    onChange();
     return &v_[offset].get();
 }
 
@@ -22,6 +22,7 @@
 
 #include <xrpl/basics/Expected.h>
 #include <xrpl/protocol/Feature.h>
+#include <xrpl/protocol/HashPrefix.h>
 #include <xrpl/protocol/PublicKey.h>
 #include <xrpl/protocol/Rules.h>
 #include <xrpl/protocol/STObject.h>
@@ -31,6 +32,8 @@
 #include <boost/container/flat_set.hpp>
 
 #include <functional>
+#include <memory>
+#include <optional>
 
 namespace ripple {
 
@@ -45,9 +48,14 @@ enum TxnSql : char {
 
 class STTx final : public STObject, public CountedObject<STTx>
 {
+    struct Wire;
+
     uint256 tid_;
     TxType tx_type_;
 
+    // The canonical encoding the transaction was parsed from, if any
+    std::shared_ptr<Wire const> wire_;
+
 public:
     static std::size_t const minMultiSigners = 1;
 
@@ -70,6 +78,16 @@ public:
     explicit STTx(SerialIter&& sit);
     explicit STTx(STObject&& object);
 
+    /** Constructs a transaction from its wire encoding.
+
+        The transaction and signing hashes are computed from the encoded
+        bytes in one pass rather than by serializing the parsed object,
+        and the bytes are retained for signature checks and relaying.
+        Encodings that differ from the canonical serialization fall back
+        to the slower path, and are not retained.
+    */
+    explicit STTx(Slice wire);
+
     /** Constructs a transaction.
 
         The returned transaction will have the specified type and
@@ -107,6 +125,14 @@ public:
     uint256
     getTransactionID() const;
 
+    /** The canonical encoding this transaction was parsed from.
+
+        Only available if the transaction was constructed from a Slice and
+        its fields have not been changed since, including by signing it.
+    */
+    std::optional<Slice>
+    getWireData() const;
+
     Json::Value
     getJson(JsonOptions options) const override;
 
@@ -140,6 +166,12 @@ public:
         std::string const& escapedMetaData) const;
 
 private:
+    Serializer
+    getWireSigningData(HashPrefix prefix) const;
+
+    void
+    onChange() override;
+
     Expected<void, std::string>
     checkSingleSign(RequireFullyCanonicalSig requireCanonicalSig) const;
 
@@ -37,19 +37,40 @@
 
 namespace ripple {
 
+/** Counts of the buffers Serializer took from its pool, or allocated.
+
+    Most serializers are short lived: an object is serialized to be
+    hashed, signed, or copied into a SHAMapItem or a message, and the
+    buffer is then thrown away. Each thread keeps the buffers of those
+    serializers, up to a small size, to be reused by the next ones.
+*/
+struct SerializerPoolCounts
+{
+    std::uint64_t reused = 0;
+    std::uint64_t allocated = 0;
+};
+
+SerializerPoolCounts
+getSerializerPoolCounts();
+
 class Serializer
 {
 private:
     // DEPRECATED
     Blob mData;
 
+    static Blob
+    takeBuffer(std::size_t n);
+
+    static void
+    recycleBuffer(Blob&& buffer) noexcept;
+
 public:
-    explicit Serializer(int n = 256)
+    explicit Serializer(int n = 256) : mData(takeBuffer(n))
     {
-        mData.reserve(n);
     }
 
-    Serializer(void const* data, std::size_t size)
+    Serializer(void const* data, std::size_t size) : mData(takeBuffer(size))
     {
         mData.resize(size);
 
@@ -60,6 +81,18 @@ public:
         }
     }
 
+    Serializer(Serializer const&) = default;
+    Serializer(Serializer&&) = default;
+    Serializer&
+    operator=(Serializer const&) = default;
+    Serializer&
+    operator=(Serializer&&) = default;
+
+    ~Serializer()
+    {
+        recycleBuffer(std::move(mData));
+    }
+
     Slice
     slice() const noexcept
     {
@@ -44,6 +44,7 @@ namespace jss {
 // clang-format off
 JSS(AL_size);              // out: GetCounts
 JSS(AL_hit_rate);          // out: GetCounts
+JSS(AL_cache_bytes);       // out: GetCounts
 JSS(Account);              // in: TransactionSign; field.
 JSS(AccountRoot);          // ledger type.
 JSS(AMM);                  // ledger type
@@ -96,6 +97,7 @@ JSS(PriceData);                          // field.
 JSS(Provider);                           // field.
 JSS(QuoteAsset);                         // in: Oracle.
 JSS(RippleState);                        // ledger type.
+JSS(SLE_cache_bytes);                    // out: GetCounts
 JSS(SLE_hit_rate);                       // out: GetCounts.
 JSS(Scale);                              // field.
 JSS(SettleDelay);                        // in: TransactionSign
@@ -186,8 +188,13 @@ JSS(both_sides);                  // in: Subscribe, Unsubscribe
 JSS(broadcast);                   // out: SubmitTransaction
 JSS(bridge);                      // in: LedgerEntry
 JSS(bridge_account);              // in: LedgerEntry
+JSS(budget);                      // out: MemoryGovernor
 JSS(build_path);                  // in: TransactionSign
 JSS(build_version);               // out: NetworkOPs
+JSS(bytes);                       // out: MemoryGovernor
+JSS(bytes_received);              // out: InboundLedger
+JSS(cache_warm);                  // out: NetworkOPs
+JSS(caches);                      // out: MemoryGovernor
 JSS(cancel_after);                // out: AccountChannels
 JSS(can_delete);                  // out: CanDelete
 JSS(changes);                     // out: BookChanges
@@ -267,6 +274,7 @@ JSS(engine_result);           // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_code);      // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_message);   // out: NetworkOPs, TransactionSign, Submit
 JSS(entire_set);              // out: get_aggregate_price
+JSS(entries);                 // out: MemoryGovernor
 JSS(ephemeral_key);           // out: ValidatorInfo
                               // in/out: Manifest
 JSS(error);                   // out: error
@@ -281,6 +289,7 @@ JSS(expected_date_UTC);     // out: any (warnings)
 JSS(expected_ledger_size);  // out: TxQ
 JSS(expiration);            // out: AccountOffers, AccountChannels,
                             //      ValidatorList, amm_info
+JSS(fail_counts);           // out: LedgerCleaner
 JSS(fail_hard);             // in: Sign, Submit
 JSS(failed);                // out: InboundLedger
 JSS(feature);               // in: Feature
@@ -317,6 +326,7 @@ JSS(high);                  // out: BookChanges
 JSS(highest_sequence);      // out: AccountInfo
 JSS(highest_ticket);        // out: AccountInfo
 JSS(historical_perminute);  // historical_perminute.
+JSS(hit_rate);              // out: MemoryGovernor
 JSS(hostid);                // out: NetworkOPs
 JSS(hotwallet);             // in: GatewayBalances
 JSS(id);                    // websocket.
@@ -362,6 +372,7 @@ JSS(last_refresh_message);        // out: ValidatorSite
 JSS(ledger);                      // in: NetworkOPs, LedgerCleaner,
                                   //     RPCHelpers
                                   // out: NetworkOPs, PeerImp
+JSS(ledger_cleaner);              // out: LedgerCleaner
 JSS(ledger_current_index);        // out: NetworkOPs, RPCHelpers,
                                   //      LedgerCurrent, LedgerAccept,
                                   //      AccountLines
@@ -381,6 +392,8 @@ JSS(ledger_min);                  // in, out: AccountTx*
 JSS(ledger_time);                 // out: NetworkOPs
 JSS(LEDGER_ENTRY_TYPES);          // out: RPC server_definitions
                                   // matches definitions.json format
+JSS(ledgers_cleaned);             // out: LedgerCleaner
+JSS(ledgers_per_second);          // out: LedgerCleaner
 JSS(levels);                      // LogLevels
 JSS(limit);                       // in/out: AccountTx*, AccountOffers,
                                   //         AccountLines, AccountObjects
@@ -399,6 +412,7 @@ JSS(load_factor_local);           // out: NetworkOPs
 JSS(load_factor_net);             // out: NetworkOPs
 JSS(load_factor_server);          // out: NetworkOPs
 JSS(load_fee);                    // out: LoadFeeTrackImp, NetworkOPs
+JSS(loaded);                      // out: CacheWarmer
 JSS(local);                       // out: resource/Logic.h
 JSS(local_txs);                   // out: GetCounts
 JSS(local_static_keys);           // out: ValidatorList
@@ -426,6 +440,7 @@ JSS(mean);                        // out: get_aggregate_price
 JSS(median);                      // out: get_aggregate_price
 JSS(median_fee);                  // out: TxQ
 JSS(median_level);                // out: TxQ
+JSS(memory_governor);             // out: GetCounts
 JSS(message);                     // error.
 JSS(meta);                        // out: NetworkOPs, AccountTx*, Tx
 JSS(meta_blob);                   // out: NetworkOPs, AccountTx*, Tx
@@ -438,6 +453,7 @@ JSS(min_count);                  // in: GetCounts
 JSS(min_ledger);                 // in: LedgerCleaner
 JSS(minimum_fee);                // out: TxQ
 JSS(minimum_level);              // out: TxQ
+JSS(missing);                    // out: CacheWarmer
 JSS(missingCommand);             // error
 JSS(name);                       // out: AmendmentTableImpl, PeerImp
 JSS(needed_state_hashes);        // out: InboundLedger
@@ -464,6 +480,8 @@ JSS(node_reads_hit);             // out: GetCounts
 JSS(node_reads_total);           // out: GetCounts
 JSS(node_reads_duration_us);     // out: GetCounts
 JSS(node_size);                  // out: server_info
+JSS(nodes_per_second);           // out: InboundLedger
+JSS(nodes_received);             // out: InboundLedger
 JSS(nodestore);                  // out: GetCounts
 JSS(node_writes);                // out: GetCounts
 JSS(node_written_bytes);         // out: GetCounts
@@ -472,6 +490,7 @@ JSS(node_write_retries);         // out: GetCounts
 JSS(node_writes_delayed);        // out::GetCounts
 JSS(nth);                        // out: RPC server_definitions
 JSS(nunl);                       // in: AccountObjects
+JSS(object_bytes);               // out: GetCounts
 JSS(obligations);                // out: GatewayBalances
 JSS(offer);                      // in: LedgerEntry
 JSS(offers);                     // out: NetworkOPs, AccountOffers, Subscribe
@@ -487,6 +506,7 @@ JSS(oracles);                    // in: get_aggregate_price
 JSS(oracle_document_id);         // in: get_aggregate_price
 JSS(owner);                      // in: LedgerEntry, out: NetworkOPs
 JSS(owner_funds);                // in/out: Ledger, NetworkOPs, AcceptedLedgerTx
+JSS(outstanding);                // out: InboundLedger
 JSS(page_index);
 JSS(params);                      // RPC
 JSS(parent_close_time);           // out: LedgerToJson
@@ -494,6 +514,7 @@ JSS(parent_hash);                 // out: LedgerToJson
 JSS(partition);                   // in: LogLevel
 JSS(passphrase);                  // in: WalletPropose
 JSS(password);                    // in: Subscribe
+JSS(path);                        // in: SnapshotCreate
 JSS(paths);                       // in: RipplePathFind
 JSS(paths_canonical);             // out: RipplePathFind
 JSS(paths_computed);              // out: PathRequest, RipplePathFind
@@ -505,6 +526,7 @@ JSS(peers);                       // out: InboundLedger, handlers/Peers, Overlay
 JSS(peer_disconnects);            // Severed peer connection counter.
 JSS(peer_disconnects_resources);  // Severed peer connections because of
                                   // excess resource consumption.
+JSS(peer_stats);                  // out: InboundLedger
 JSS(port);                        // in: Connect, out: NetworkOPs
 JSS(ports);                       // out: NetworkOPs
 JSS(previous);                    // out: Reservations
@@ -515,6 +537,7 @@ JSS(propose_seq);                 // out: LedgerPropose
 JSS(proposers);                   // out: NetworkOPs, LedgerConsensus
 JSS(protocol);                    // out: NetworkOPs, PeerImp
 JSS(proxied);                     // out: RPC ping
+JSS(pubkey_hit_rate);             // out: GetCounts
 JSS(pubkey_node);                 // out: NetworkOPs
 JSS(pubkey_publisher);            // out: ValidatorList
 JSS(pubkey_validator);            // out: NetworkOPs, ValidatorList
@@ -598,7 +621,7 @@ JSS(started);
 JSS(state);                 // out: Logic.h, ServerState, LedgerData
 JSS(state_accounting);      // out: NetworkOPs
 JSS(state_now);             // in: Subscribe
-JSS(status);                // error
+JSS(status);                // error, in: LedgerCleaner
 JSS(stop);                  // in: LedgerCleaner
 JSS(stop_history_tx_only);  // in: Unsubscribe, stop history tx stream
 JSS(streams);               // in: Subscribe, Unsubscribe
@@ -615,6 +638,8 @@ JSS(taker_gets);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_gets_funded);     // out: NetworkOPs
 JSS(taker_pays);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_pays_funded);     // out: NetworkOPs
+JSS(target_size);           // out: MemoryGovernor
+JSS(threads);               // out: LedgerCleaner
 JSS(threshold);             // in: Blacklist
 JSS(ticket);                // in: AccountObjects
 JSS(ticket_count);          // out: AccountInfo
@@ -625,6 +650,7 @@ JSS(time_threshold);          // in/out: Oracle aggregate
 JSS(time_interval);           // out: AMM Auction Slot
 JSS(track);                   // out: PeerImp
 JSS(traffic);                 // out: Overlay
+JSS(treenode_cache_bytes);    // out: GetCounts
 JSS(trim);                    // in: get_aggregate_price
 JSS(trimmed_set);             // out: get_aggregate_price
 JSS(total);                   // out: counters
@@ -25,7 +25,9 @@
 #include <xrpl/beast/core/List.h>
 #include <xrpl/resource/detail/Key.h>
 #include <xrpl/resource/detail/Tuning.h>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 
 namespace ripple {
 namespace Resource {
@@ -42,7 +44,8 @@ struct Entry : public beast::List<Entry>::Node
        @param now Construction time of Entry.
     */
     explicit Entry(clock_type::time_point const now)
-        : refcount(0)
+        : shard(0)
+        , refcount(0)
         , local_balance(now)
         , remote_balance(0)
         , lastWarningTime()
@@ -85,14 +88,18 @@ struct Entry : public beast::List<Entry>::Node
     // Back pointer to the map key (bit of a hack here)
     Key const* key;
 
+    // Index of the table shard which holds this entry
+    std::size_t shard;
+
     // Number of Consumer references
     int refcount;
 
     // Exponentially decaying balance of resource consumption
     DecayingSample<decayWindowSeconds, clock_type> local_balance;
 
-    // Normalized balance contribution from imports
-    int remote_balance;
+    // Normalized balance contribution from imports. Imports are applied
+    // without holding the lock of the shard which holds this entry.
+    std::atomic<int> remote_balance;
 
     // Time of the last warning
     clock_type::time_point lastWarningTime;
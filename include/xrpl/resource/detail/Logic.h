@@ -31,6 +31,7 @@
 #include <xrpl/resource/Fees.h>
 #include <xrpl/resource/Gossip.h>
 #include <xrpl/resource/detail/Import.h>
+#include <array>
 #include <cassert>
 #include <mutex>
 
@@ -57,30 +58,43 @@ private:
         beast::insight::Meter drop;
     };
 
-    Stats m_stats;
-    Stopwatch& m_clock;
-    beast::Journal m_journal;
+    // A partition of the consumer table. Each entry lives in exactly one
+    // shard, chosen by the hash of its key, and is only touched while that
+    // shard's mutex is held. This lets peers and clients which hash to
+    // different shards be charged concurrently.
+    struct Shard
+    {
+        std::mutex mutex;
+
+        // Table of the entries in this shard
+        Table table;
+
+        // Because the following are intrusive lists, a given Entry may be in
+        // at most list at a given instant.  The Entry must be removed from
+        // one list before placing it in another.
 
-    std::recursive_mutex lock_;
+        // List of all active inbound entries
+        EntryIntrusiveList inbound;
 
-    // Table of all entries
-    Table table_;
+        // List of all active outbound entries
+        EntryIntrusiveList outbound;
 
-    // Because the following are intrusive lists, a given Entry may be in
-    // at most list at a given instant.  The Entry must be removed from
-    // one list before placing it in another.
+        // List of all active admin entries
+        EntryIntrusiveList admin;
 
-    // List of all active inbound entries
-    EntryIntrusiveList inbound_;
+        // List of all inactve entries
+        EntryIntrusiveList inactive;
+    };
 
-    // List of all active outbound entries
-    EntryIntrusiveList outbound_;
+    Stats m_stats;
+    Stopwatch& m_clock;
+    beast::Journal m_journal;
 
-    // List of all active admin entries
-    EntryIntrusiveList admin_;
+    std::array<Shard, consumerTableShards> shards_;
 
-    // List of all inactve entries
-    EntryIntrusiveList inactive_;
+    // Protects the import table. When both are needed, this is
+    // acquired before a shard's mutex.
+    std::mutex importLock_;
 
     // All imported gossip data
     Imports importTable_;
@@ -103,65 +117,30 @@ public:
         // destroyed before the consumer table.
         //
         importTable_.clear();
-        table_.clear();
+        for (auto& shard : shards_)
+            shard.table.clear();
     }
 
     Consumer
     newInboundEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
-
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindInbound, address.at_port(0)),  // Key
-                std::make_tuple(m_clock.now()));                   // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                {
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                }
-                inbound_.push_back(*entry);
-            }
-        }
+        Entry& entry(
+            newEndpoint(Key(kindInbound, address.at_port(0)), &Shard::inbound));
 
-        JLOG(m_journal.debug()) << "New inbound endpoint " << *entry;
+        JLOG(m_journal.debug()) << "New inbound endpoint " << entry;
 
-        return Consumer(*this, *entry);
+        return Consumer(*this, entry);
     }
 
     Consumer
     newOutboundEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
-
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindOutbound, address),  // Key
-                std::make_tuple(m_clock.now()));         // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                outbound_.push_back(*entry);
-            }
-        }
+        Entry& entry(
+            newEndpoint(Key(kindOutbound, address), &Shard::outbound));
 
-        JLOG(m_journal.debug()) << "New outbound endpoint " << *entry;
+        JLOG(m_journal.debug()) << "New outbound endpoint " << entry;
 
-        return Consumer(*this, *entry);
+        return Consumer(*this, entry);
     }
 
     /**
@@ -172,29 +151,12 @@ public:
     Consumer
     newUnlimitedEndpoint(beast::IP::Endpoint const& address)
     {
-        Entry* entry(nullptr);
-
-        {
-            std::lock_guard _(lock_);
-            auto [resultIt, resultInserted] = table_.emplace(
-                std::piecewise_construct,
-                std::make_tuple(kindUnlimited, address.at_port(1)),  // Key
-                std::make_tuple(m_clock.now()));                     // Entry
-
-            entry = &resultIt->second;
-            entry->key = &resultIt->first;
-            ++entry->refcount;
-            if (entry->refcount == 1)
-            {
-                if (!resultInserted)
-                    inactive_.erase(inactive_.iterator_to(*entry));
-                admin_.push_back(*entry);
-            }
-        }
+        Entry& entry(newEndpoint(
+            Key(kindUnlimited, address.at_port(1)), &Shard::admin));
 
-        JLOG(m_journal.debug()) << "New unlimited endpoint " << *entry;
+        JLOG(m_journal.debug()) << "New unlimited endpoint " << entry;
 
-        return Consumer(*this, *entry);
+        return Consumer(*this, entry);
     }
 
     Json::Value
@@ -210,43 +172,28 @@ public:
         clock_type::time_point const now(m_clock.now());
 
         Json::Value ret(Json::objectValue);
-        std::lock_guard _(lock_);
 
-        for (auto& inboundEntry : inbound_)
-        {
-            int localBalance = inboundEntry.local_balance.value(now);
-            if ((localBalance + inboundEntry.remote_balance) >= threshold)
-            {
-                Json::Value& entry =
-                    (ret[inboundEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = inboundEntry.remote_balance;
-                entry[jss::type] = "inbound";
-            }
-        }
-        for (auto& outboundEntry : outbound_)
-        {
-            int localBalance = outboundEntry.local_balance.value(now);
-            if ((localBalance + outboundEntry.remote_balance) >= threshold)
+        auto const addList = [&](EntryIntrusiveList& list, char const* type) {
+            for (auto& listEntry : list)
             {
-                Json::Value& entry =
-                    (ret[outboundEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = outboundEntry.remote_balance;
-                entry[jss::type] = "outbound";
+                int localBalance = listEntry.local_balance.value(now);
+                if ((localBalance + listEntry.remote_balance) >= threshold)
+                {
+                    Json::Value& entry =
+                        (ret[listEntry.to_string()] = Json::objectValue);
+                    entry[jss::local] = localBalance;
+                    entry[jss::remote] = listEntry.remote_balance.load();
+                    entry[jss::type] = type;
+                }
             }
-        }
-        for (auto& adminEntry : admin_)
+        };
+
+        for (auto& shard : shards_)
         {
-            int localBalance = adminEntry.local_balance.value(now);
-            if ((localBalance + adminEntry.remote_balance) >= threshold)
-            {
-                Json::Value& entry =
-                    (ret[adminEntry.to_string()] = Json::objectValue);
-                entry[jss::local] = localBalance;
-                entry[jss::remote] = adminEntry.remote_balance;
-                entry[jss::type] = "admin";
-            }
+            std::lock_guard _(shard.mutex);
+            addList(shard.inbound, "inbound");
+            addList(shard.outbound, "outbound");
+            addList(shard.admin, "admin");
         }
 
         return ret;
@@ -258,18 +205,22 @@ public:
         clock_type::time_point const now(m_clock.now());
 
         Gossip gossip;
-        std::lock_guard _(lock_);
-
-        gossip.items.reserve(inbound_.size());
 
-        for (auto& inboundEntry : inbound_)
+        for (auto& shard : shards_)
         {
-            Gossip::Item item;
-            item.balance = inboundEntry.local_balance.value(now);
-            if (item.balance >= minimumGossipBalance)
+            std::lock_guard _(shard.mutex);
+
+            gossip.items.reserve(gossip.items.size() + shard.inbound.size());
+
+            for (auto& inboundEntry : shard.inbound)
             {
-                item.address = inboundEntry.key->address;
-                gossip.items.push_back(item);
+                Gossip::Item item;
+                item.balance = inboundEntry.local_balance.value(now);
+                if (item.balance >= minimumGossipBalance)
+                {
+                    item.address = inboundEntry.key->address;
+                    gossip.items.push_back(item);
+                }
             }
         }
 
@@ -283,7 +234,7 @@ public:
     {
         auto const elapsed = m_clock.now();
         {
-            std::lock_guard _(lock_);
+            std::lock_guard _(importLock_);
             auto [resultIt, resultInserted] = importTable_.emplace(
                 std::piecewise_construct,
                 std::make_tuple(origin),  // Key
@@ -341,25 +292,31 @@ public:
     void
     periodicActivity()
     {
-        std::lock_guard _(lock_);
-
         auto const elapsed = m_clock.now();
 
-        for (auto iter(inactive_.begin()); iter != inactive_.end();)
+        for (auto& shard : shards_)
         {
-            if (iter->whenExpires <= elapsed)
-            {
-                JLOG(m_journal.debug()) << "Expired " << *iter;
-                auto table_iter = table_.find(*iter->key);
-                ++iter;
-                erase(table_iter);
-            }
-            else
+            std::lock_guard _(shard.mutex);
+
+            for (auto iter(shard.inactive.begin());
+                 iter != shard.inactive.end();)
             {
-                break;
+                if (iter->whenExpires <= elapsed)
+                {
+                    JLOG(m_journal.debug()) << "Expired " << *iter;
+                    auto table_iter = shard.table.find(*iter->key);
+                    ++iter;
+                    erase(shard, table_iter);
+                }
+                else
+                {
+                    break;
+                }
             }
         }
 
+        std::lock_guard _(importLock_);
+
         auto iter = importTable_.begin();
         while (iter != importTable_.end())
         {
@@ -396,27 +353,18 @@ public:
         return Disposition::ok;
     }
 
-    void
-    erase(Table::iterator iter)
-    {
-        std::lock_guard _(lock_);
-        Entry& entry(iter->second);
-        assert(entry.refcount == 0);
-        inactive_.erase(inactive_.iterator_to(entry));
-        table_.erase(iter);
-    }
-
     void
     acquire(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        std::lock_guard _(shards_[entry.shard].mutex);
         ++entry.refcount;
     }
 
     void
     release(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        Shard& shard(shards_[entry.shard]);
+        std::lock_guard _(shard.mutex);
         if (--entry.refcount == 0)
         {
             JLOG(m_journal.debug()) << "Inactive " << entry;
@@ -424,19 +372,19 @@ public:
             switch (entry.key->kind)
             {
                 case kindInbound:
-                    inbound_.erase(inbound_.iterator_to(entry));
+                    shard.inbound.erase(shard.inbound.iterator_to(entry));
                     break;
                 case kindOutbound:
-                    outbound_.erase(outbound_.iterator_to(entry));
+                    shard.outbound.erase(shard.outbound.iterator_to(entry));
                     break;
                 case kindUnlimited:
-                    admin_.erase(admin_.iterator_to(entry));
+                    shard.admin.erase(shard.admin.iterator_to(entry));
                     break;
                 default:
                     assert(false);
                     break;
             }
-            inactive_.push_back(entry);
+            shard.inactive.push_back(entry);
             entry.whenExpires = m_clock.now() + secondsUntilExpiration;
         }
     }
@@ -444,11 +392,8 @@ public:
     Disposition
     charge(Entry& entry, Charge const& fee)
     {
-        std::lock_guard _(lock_);
-        clock_type::time_point const now(m_clock.now());
-        int const balance(entry.add(fee.cost(), now));
-        JLOG(m_journal.trace()) << "Charging " << entry << " for " << fee;
-        return disposition(balance);
+        std::lock_guard _(shards_[entry.shard].mutex);
+        return chargeLocked(entry, fee);
     }
 
     bool
@@ -457,13 +402,13 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard _(lock_);
+        std::lock_guard _(shards_[entry.shard].mutex);
         bool notify(false);
         auto const elapsed = m_clock.now();
         if (entry.balance(m_clock.now()) >= warningThreshold &&
             elapsed != entry.lastWarningTime)
         {
-            charge(entry, feeWarning);
+            chargeLocked(entry, feeWarning);
             notify = true;
             entry.lastWarningTime = elapsed;
         }
@@ -481,7 +426,7 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard _(lock_);
+        std::lock_guard _(shards_[entry.shard].mutex);
         bool drop(false);
         clock_type::time_point const now(m_clock.now());
         int const balance(entry.balance(now));
@@ -494,7 +439,7 @@ public:
             // Adding feeDrop at this point keeps the dropped connection
             // from re-connecting for at least a little while after it is
             // dropped.
-            charge(entry, feeDrop);
+            chargeLocked(entry, feeDrop);
             ++m_stats.drop;
             drop = true;
         }
@@ -504,7 +449,7 @@ public:
     int
     balance(Entry& entry)
     {
-        std::lock_guard _(lock_);
+        std::lock_guard _(shards_[entry.shard].mutex);
         return entry.balance(m_clock.now());
     }
 
@@ -524,7 +469,7 @@ public:
             item["name"] = entry.to_string();
             item["balance"] = entry.balance(now);
             if (entry.remote_balance != 0)
-                item["remote_balance"] = entry.remote_balance;
+                item["remote_balance"] = entry.remote_balance.load();
         }
     }
 
@@ -533,27 +478,69 @@ public:
     {
         clock_type::time_point const now(m_clock.now());
 
-        std::lock_guard _(lock_);
+        auto const write = [&](char const* name,
+                               EntryIntrusiveList Shard::*list) {
+            beast::PropertyStream::Set s(name, map);
+            for (auto& shard : shards_)
+            {
+                std::lock_guard _(shard.mutex);
+                writeList(now, s, shard.*list);
+            }
+        };
+
+        write("inbound", &Shard::inbound);
+        write("outbound", &Shard::outbound);
+        write("admin", &Shard::admin);
+        write("inactive", &Shard::inactive);
+    }
 
+private:
+    // Finds or creates the entry for a key and adds a reference to it,
+    // moving it to the given active list if it was inactive.
+    Entry&
+    newEndpoint(Key const& key, EntryIntrusiveList Shard::*active)
+    {
+        std::size_t const index = Key::hasher{}(key) % shards_.size();
+        Shard& shard(shards_[index]);
+
+        std::lock_guard _(shard.mutex);
+        auto [resultIt, resultInserted] = shard.table.emplace(
+            std::piecewise_construct,
+            std::make_tuple(key),             // Key
+            std::make_tuple(m_clock.now()));  // Entry
+
+        Entry& entry(resultIt->second);
+        entry.key = &resultIt->first;
+        entry.shard = index;
+        ++entry.refcount;
+        if (entry.refcount == 1)
         {
-            beast::PropertyStream::Set s("inbound", map);
-            writeList(now, s, inbound_);
+            if (!resultInserted)
+                shard.inactive.erase(shard.inactive.iterator_to(entry));
+            (shard.*active).push_back(entry);
         }
 
-        {
-            beast::PropertyStream::Set s("outbound", map);
-            writeList(now, s, outbound_);
-        }
+        return entry;
+    }
 
-        {
-            beast::PropertyStream::Set s("admin", map);
-            writeList(now, s, admin_);
-        }
+    // Must be called with the shard's mutex held.
+    void
+    erase(Shard& shard, Table::iterator iter)
+    {
+        Entry& entry(iter->second);
+        assert(entry.refcount == 0);
+        shard.inactive.erase(shard.inactive.iterator_to(entry));
+        shard.table.erase(iter);
+    }
 
-        {
-            beast::PropertyStream::Set s("inactive", map);
-            writeList(now, s, inactive_);
-        }
+    // Must be called with the mutex of the entry's shard held.
+    Disposition
+    chargeLocked(Entry& entry, Charge const& fee)
+    {
+        clock_type::time_point const now(m_clock.now());
+        int const balance(entry.add(fee.cost(), now));
+        JLOG(m_journal.trace()) << "Charging " << entry << " for " << fee;
+        return disposition(balance);
     }
 };
 
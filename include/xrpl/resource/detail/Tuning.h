@@ -21,6 +21,7 @@
 #define RIPPLE_RESOURCE_TUNING_H_INCLUDED
 
 #include <chrono>
+#include <cstddef>
 
 namespace ripple {
 namespace Resource {
@@ -50,6 +51,9 @@ std::chrono::seconds constexpr secondsUntilExpiration{300};
 // Number of seconds until imported gossip expires
 std::chrono::seconds constexpr gossipExpirationSeconds{30};
 
+// Number of independently locked partitions of the consumer table
+std::size_t constexpr consumerTableShards{16};
+
 }  // namespace Resource
 }  // namespace ripple
 
@@ -0,0 +1,606 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// A throughput benchmark of the protocol codecs.
+//
+// Usage: codec_bench [--time=<ms>] [--corpus=<dir>] [filter]...
+//
+// Each benchmark runs one codec operation over a fixed set of realistic
+// samples for about --time milliseconds (500 by default), and reports the
+// time, heap allocations and bytes allocated per operation. Filters select
+// the benchmarks whose names contain any of them.
+//
+// Every operator new in the process is counted, so the allocation figures
+// are exact, and the counting costs each allocation a few nanoseconds.
+//
+// --corpus writes the samples, laid out as the fuzz targets expect, to one
+// directory per target, as a seed corpus.
+
+#include <xrpl/basics/Slice.h>
+#include <xrpl/json/to_string.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/PublicKey.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/STArray.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/STParsedJSON.h>
+#include <xrpl/protocol/STPathSet.h>
+#include <xrpl/protocol/STTx.h>
+#include <xrpl/protocol/STValidation.h>
+#include <xrpl/protocol/SecretKey.h>
+#include <xrpl/protocol/Seed.h>
+#include <xrpl/protocol/Serializer.h>
+#include <xrpl/protocol/TxFlags.h>
+#include <xrpl/protocol/digest.h>
+#include <xrpl/protocol/jss.h>
+#include <xrpl/protocol/tokens.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+std::atomic<std::size_t> allocatedBytes{0};
+
+void*
+allocate(std::size_t size, std::size_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (size == 0)
+        size = 1;
+    void* p = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+        p = std::malloc(size);
+    else
+        p = std::aligned_alloc(
+            alignment, (size + alignment - 1) / alignment * alignment);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+}  // namespace
+
+// The array and nothrow forms forward to these.
+void*
+operator new(std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+namespace ripple {
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct Options
+{
+    std::chrono::milliseconds time{500};
+    std::vector<std::string> filters;
+};
+
+// Keeps the results of the operations alive, so they cannot be elided.
+std::size_t volatile sink = 0;
+
+template <class Sample, class F>
+void
+bench(
+    Options const& options,
+    char const* name,
+    std::vector<Sample> const& samples,
+    F&& f)
+{
+    if (!options.filters.empty())
+    {
+        bool selected = false;
+        for (auto const& filter : options.filters)
+            selected |= std::string(name).find(filter) != std::string::npos;
+        if (!selected)
+            return;
+    }
+
+    // Once through to warm the caches and any lazily built tables.
+    std::size_t total = 0;
+    for (auto const& sample : samples)
+        total += f(sample);
+
+    std::size_t ops = 0;
+    auto const allocationsBefore = allocations.load();
+    auto const bytesBefore = allocatedBytes.load();
+    auto const start = clock_type::now();
+    auto elapsed = clock_type::duration{};
+    do
+    {
+        for (auto const& sample : samples)
+            total += f(sample);
+        ops += samples.size();
+        elapsed = clock_type::now() - start;
+    } while (elapsed < options.time);
+    auto const allocated = allocations.load() - allocationsBefore;
+    auto const bytes = allocatedBytes.load() - bytesBefore;
+    sink = sink + total;
+
+    auto const ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::cout << std::left << std::setw(34) << name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(11)
+              << static_cast<double>(ns) / ops << " ns/op"
+              << std::setprecision(2) << std::setw(9)
+              << static_cast<double>(allocated) / ops << " allocs/op"
+              << std::setprecision(1) << std::setw(11)
+              << static_cast<double>(bytes) / ops << " bytes/op" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+
+struct Samples
+{
+    std::vector<Blob> transactions;
+    std::vector<Json::Value> transactionJson;
+    std::vector<std::pair<Blob, uint256>> entries;
+    std::vector<Json::Value> entryJson;
+    std::vector<Blob> validations;
+    std::vector<STAmount> amounts;
+    std::vector<Blob> amountBlobs;
+    std::vector<std::string> amountText;
+    std::vector<Json::Value> amountJson;
+    std::vector<AccountID> accounts;
+    std::vector<std::string> addresses;
+    std::vector<PublicKey> nodeKeys;
+    std::vector<std::string> nodeKeyText;
+};
+
+template <class T>
+Blob
+serialize(T const& t)
+{
+    Serializer s;
+    t.add(s);
+    return s.getData();
+}
+
+Samples
+makeSamples()
+{
+    Samples samples;
+
+    auto const [pk, sk] =
+        generateKeyPair(KeyType::secp256k1, generateSeed("codec_bench"));
+    auto const [edPk, edSk] =
+        generateKeyPair(KeyType::ed25519, generateSeed("codec_bench"));
+
+    for (int i = 0; i < 8; ++i)
+    {
+        auto const seed = generateSeed("account " + std::to_string(i));
+        samples.accounts.push_back(calcAccountID(
+            generateKeyPair(KeyType::secp256k1, seed).first));
+    }
+    auto const& alice = samples.accounts[0];
+    auto const& bob = samples.accounts[1];
+    auto const& gateway = samples.accounts[2];
+    Issue const usd{to_currency("USD"), gateway};
+    Issue const eur{to_currency("EUR"), gateway};
+
+    for (auto const& account : samples.accounts)
+        samples.addresses.push_back(toBase58(account));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        auto const seed = generateSeed("node " + std::to_string(i));
+        auto const node = generateKeyPair(KeyType::secp256k1, seed).first;
+        samples.nodeKeys.push_back(node);
+        samples.nodeKeyText.push_back(toBase58(TokenType::NodePublic, node));
+    }
+
+    // Transactions of the kinds that make up most of the traffic.
+    auto const addTx = [&](TxType type,
+                           PublicKey const& signer,
+                           SecretKey const& secret,
+                           std::function<void(STObject&)> fill) {
+        STTx tx(type, [&](STObject& obj) {
+            obj.setAccountID(sfAccount, alice);
+            obj.setFieldAmount(sfFee, STAmount(12));
+            obj.setFieldU32(sfSequence, 1000 + samples.transactions.size());
+            obj.setFieldU32(sfLastLedgerSequence, 90000000);
+            obj.setFieldVL(sfSigningPubKey, signer.slice());
+            fill(obj);
+        });
+        tx.sign(signer, secret);
+        samples.transactions.push_back(serialize(tx));
+        // As a client would send it, without the hash.
+        auto json = tx.getJson(JsonOptions::none);
+        json.removeMember(jss::hash);
+        samples.transactionJson.push_back(std::move(json));
+    };
+
+    addTx(ttPAYMENT, pk, sk, [&](STObject& obj) {
+        obj.setAccountID(sfDestination, bob);
+        obj.setFieldAmount(sfAmount, STAmount(25000000));
+    });
+    addTx(ttPAYMENT, edPk, edSk, [&](STObject& obj) {
+        obj.setAccountID(sfDestination, bob);
+        obj.setFieldU32(sfDestinationTag, 42);
+        obj.setFieldAmount(sfAmount, STAmount(usd, 1234567, -4));
+        obj.setFieldAmount(sfSendMax, STAmount(eur, 130, 0));
+        STPathSet paths(sfPaths);
+        paths.push_back(STPath({STPathElement(
+            std::nullopt, usd.currency, usd.account)}));
+        obj.setFieldPathSet(sfPaths, paths);
+        obj.setFieldU32(sfFlags, tfPartialPayment);
+    });
+    addTx(ttOFFER_CREATE, pk, sk, [&](STObject& obj) {
+        obj.setFieldAmount(sfTakerPays, STAmount(usd, 5432, -2));
+        obj.setFieldAmount(sfTakerGets, STAmount(100000000));
+        obj.setFieldU32(sfExpiration, 800000000);
+    });
+    addTx(ttTRUST_SET, pk, sk, [&](STObject& obj) {
+        obj.setFieldAmount(sfLimitAmount, STAmount(usd, 1, 9));
+        obj.setFieldU32(sfFlags, tfSetNoRipple);
+    });
+    addTx(ttACCOUNT_SET, edPk, edSk, [&](STObject& obj) {
+        STArray memos(sfMemos);
+        STObject memo(sfMemo);
+        memo.setFieldVL(sfMemoType, makeSlice(std::string("text/plain")));
+        memo.setFieldVL(
+            sfMemoData, makeSlice(std::string("a short note, for the log")));
+        memos.push_back(std::move(memo));
+        obj.setFieldArray(sfMemos, memos);
+    });
+
+    // Ledger entries, as they are read from the state map.
+    auto const addEntry = [&](STLedgerEntry const& sle) {
+        samples.entries.emplace_back(serialize(sle), sle.key());
+        samples.entryJson.push_back(sle.getJson(JsonOptions::none));
+    };
+    {
+        STLedgerEntry sle(keylet::account(alice));
+        sle.setAccountID(sfAccount, alice);
+        sle.setFieldAmount(sfBalance, STAmount(123456789));
+        sle.setFieldU32(sfSequence, 1005);
+        sle.setFieldU32(sfOwnerCount, 3);
+        sle.setFieldH256(sfPreviousTxnID, sha512Half(alice));
+        sle.setFieldU32(sfPreviousTxnLgrSeq, 89999990);
+        addEntry(sle);
+    }
+    {
+        STLedgerEntry sle(keylet::line(alice, gateway, usd.currency));
+        sle.setFieldAmount(
+            sfBalance, STAmount(Issue{usd.currency, noAccount()}, 5, 1));
+        sle.setFieldAmount(sfLowLimit, STAmount(Issue{usd.currency, alice}));
+        sle.setFieldAmount(
+            sfHighLimit, STAmount(Issue{usd.currency, gateway}, 1, 9));
+        sle.setFieldU32(sfFlags, lsfLowReserve);
+        sle.setFieldU64(sfLowNode, 0);
+        sle.setFieldU64(sfHighNode, 0);
+        sle.setFieldH256(sfPreviousTxnID, sha512Half(gateway));
+        sle.setFieldU32(sfPreviousTxnLgrSeq, 89999991);
+        addEntry(sle);
+    }
+    {
+        STLedgerEntry sle(keylet::offer(alice, 1002));
+        sle.setAccountID(sfAccount, alice);
+        sle.setFieldU32(sfSequence, 1002);
+        sle.setFieldAmount(sfTakerPays, STAmount(usd, 5432, -2));
+        sle.setFieldAmount(sfTakerGets, STAmount(100000000));
+        sle.setFieldH256(sfBookDirectory, sha512Half(usd.currency));
+        sle.setFieldU64(sfBookNode, 0);
+        sle.setFieldU64(sfOwnerNode, 0);
+        sle.setFieldH256(sfPreviousTxnID, sha512Half(bob));
+        sle.setFieldU32(sfPreviousTxnLgrSeq, 89999992);
+        addEntry(sle);
+    }
+
+    // Full validations, as a validator sends them.
+    for (std::uint32_t seq = 89999990; seq < 89999994; ++seq)
+    {
+        STValidation const validation(
+            NetClock::time_point{NetClock::duration{780000000 + seq}},
+            pk,
+            sk,
+            calcNodeID(pk),
+            [&](STValidation& v) {
+                v.setFieldH256(sfLedgerHash, sha512Half(seq));
+                v.setFieldH256(sfConsensusHash, sha512Half(seq, 1));
+                v.setFieldH256(sfValidatedHash, sha512Half(seq, 2));
+                v.setFieldU32(sfLedgerSequence, seq);
+                v.setFieldU64(sfCookie, 0x5A5A5A5A12345678);
+                v.setFieldU32(sfLoadFee, 256);
+                v.setFlag(vfFullValidation);
+            });
+        samples.validations.push_back(validation.getSerialized());
+    }
+
+    samples.amounts = {
+        STAmount(12),
+        STAmount(99999999999ull),
+        STAmount(usd, 1234567, -4),
+        STAmount(usd, 1, 9),
+        STAmount(eur, std::int64_t{3333333333333333}, -20),
+        STAmount(eur, -5)};
+    for (auto const& amount : samples.amounts)
+    {
+        samples.amountBlobs.push_back(serialize(amount));
+        samples.amountText.push_back(amount.getText());
+        samples.amountJson.push_back(amount.getJson(JsonOptions::none));
+    }
+
+    return samples;
+}
+
+//------------------------------------------------------------------------------
+
+void
+runBenchmarks(Options const& options, Samples const& samples)
+{
+    static Rules const rules{{}};
+
+    // Serializer and STObject
+    bench(options, "Serializer add fields", samples.nodeKeys, [](auto& pk) {
+        Serializer s;
+        s.addFieldID(STI_UINT16, sfTransactionType.fieldValue);
+        s.add16(ttPAYMENT);
+        s.addFieldID(STI_UINT32, sfSequence.fieldValue);
+        s.add32(1000);
+        s.addFieldID(STI_UINT256, sfLedgerHash.fieldValue);
+        s.addBitString(uint256{});
+        s.addFieldID(STI_VL, sfSigningPubKey.fieldValue);
+        s.addVL(pk.slice());
+        return s.size();
+    });
+    bench(options, "STLedgerEntry parse", samples.entries, [](auto& e) {
+        return STLedgerEntry(SerialIter{makeSlice(e.first)}, e.second)
+            .getCount();
+    });
+    {
+        std::vector<STObject> entries;
+        for (auto const& [blob, key] : samples.entries)
+            entries.emplace_back(SerialIter{makeSlice(blob)}, sfLedgerEntry);
+        bench(options, "STObject::add (ledger entry)", entries, [](auto& e) {
+            Serializer s;
+            e.add(s);
+            return s.size();
+        });
+        bench(
+            options, "STObject::getJson (ledger entry)", entries, [](auto& e) {
+                return e.getJson(JsonOptions::none).size();
+            });
+    }
+    bench(options, "STParsedJSONObject (ledger entry)", samples.entryJson,
+        [](auto& json) {
+            return STParsedJSONObject("entry", json).object->getCount();
+        });
+
+    // STTx
+    bench(options, "STTx from SerialIter", samples.transactions, [](auto& b) {
+        return STTx(SerialIter{makeSlice(b)}).getCount();
+    });
+    bench(options, "STTx from Slice", samples.transactions, [](auto& b) {
+        return STTx(makeSlice(b)).getCount();
+    });
+    {
+        std::vector<STTx> transactions;
+        for (auto const& blob : samples.transactions)
+            transactions.emplace_back(SerialIter{makeSlice(blob)});
+        bench(options, "STTx::add", transactions, [](auto& tx) {
+            Serializer s;
+            tx.add(s);
+            return s.size();
+        });
+        bench(options, "STTx::getJson", transactions, [](auto& tx) {
+            return tx.getJson(JsonOptions::none).size();
+        });
+    }
+    bench(options, "STTx from STParsedJSONObject", samples.transactionJson,
+        [](auto& json) {
+            STParsedJSONObject parsed("tx_json", json);
+            return STTx(std::move(*parsed.object)).getCount();
+        });
+
+    // STValidation
+    auto const lookup = [](PublicKey const& pk) { return calcNodeID(pk); };
+    bench(options, "STValidation parse", samples.validations, [&](auto& b) {
+        SerialIter sit{makeSlice(b)};
+        return STValidation(sit, lookup, false).getCount();
+    });
+    {
+        std::vector<STValidation> validations;
+        for (auto const& blob : samples.validations)
+        {
+            SerialIter sit{makeSlice(blob)};
+            validations.emplace_back(sit, lookup, false);
+        }
+        bench(options, "STValidation::getSerialized", validations,
+            [](auto& v) { return v.getSerialized().size(); });
+    }
+
+    // STAmount
+    bench(options, "STAmount parse", samples.amountBlobs, [](auto& b) {
+        SerialIter sit{makeSlice(b)};
+        return STAmount(sit, sfGeneric).mantissa();
+    });
+    bench(options, "STAmount::add", samples.amounts, [](auto& a) {
+        Serializer s;
+        a.add(s);
+        return s.size();
+    });
+    bench(options, "STAmount::getText", samples.amounts, [](auto& a) {
+        return a.getText().size();
+    });
+    {
+        std::vector<std::pair<Issue, std::string>> text;
+        for (std::size_t i = 0; i < samples.amounts.size(); ++i)
+            text.emplace_back(
+                samples.amounts[i].issue(), samples.amountText[i]);
+        bench(options, "amountFromString", text, [](auto& t) {
+            return amountFromString(t.first, t.second).mantissa();
+        });
+    }
+    bench(options, "STAmount::getJson", samples.amounts, [](auto& a) {
+        return a.getJson(JsonOptions::none).size();
+    });
+    bench(options, "amountFromJson", samples.amountJson, [](auto& json) {
+        return amountFromJson(sfGeneric, json).mantissa();
+    });
+
+    // tokens
+    bench(options, "AccountID to base58", samples.accounts, [](auto& a) {
+        return toBase58(a).size();
+    });
+    bench(options, "base58 to AccountID", samples.addresses, [](auto& s) {
+        return parseBase58<AccountID>(s)->size();
+    });
+    bench(options, "NodePublic to base58", samples.nodeKeys, [](auto& pk) {
+        return toBase58(TokenType::NodePublic, pk).size();
+    });
+    bench(options, "base58 to NodePublic", samples.nodeKeyText, [](auto& s) {
+        return parseBase58<PublicKey>(TokenType::NodePublic, s)->size();
+    });
+}
+
+//------------------------------------------------------------------------------
+
+void
+writeCorpus(std::filesystem::path const& root, Samples const& samples)
+{
+    std::size_t count = 0;
+    auto const write = [&](char const* target,
+                           std::uint8_t selector,
+                           std::string const& bytes,
+                           bool withSelector = true) {
+        auto const dir = root / target;
+        std::filesystem::create_directories(dir);
+        std::ofstream out(
+            dir / ("seed-" + std::to_string(++count)), std::ios::binary);
+        if (withSelector)
+            out.put(static_cast<char>(selector));
+        out << bytes;
+    };
+    auto const str = [](Blob const& b) {
+        return std::string(b.begin(), b.end());
+    };
+
+    for (auto const& tx : samples.transactions)
+    {
+        write("STTx_fuzz", 0, str(tx), false);
+        write("STObject_fuzz", 0, str(tx));
+    }
+    for (auto const& json : samples.transactionJson)
+        write("STObject_fuzz", 1, to_string(json));
+    for (auto const& entry : samples.entries)
+        write("STObject_fuzz", 0, str(entry.first));
+    for (auto const& validation : samples.validations)
+        write("STValidation_fuzz", 1, str(validation));
+
+    for (std::size_t i = 0; i < samples.amounts.size(); ++i)
+    {
+        auto const& amount = samples.amounts[i];
+        write("STAmount_fuzz", 0, str(samples.amountBlobs[i]));
+        write("STAmount_fuzz", amount.native() ? 1 : 4, samples.amountText[i]);
+        auto const& next =
+            samples.amountBlobs[(i + 1) % samples.amountBlobs.size()];
+        write("STAmount_fuzz", 2, str(samples.amountBlobs[i]) + str(next));
+    }
+
+    // The token harness names its token types in this order.
+    for (auto const& address : samples.addresses)
+        write("tokens_fuzz", 0, address);
+    for (auto const& text : samples.nodeKeyText)
+        write("tokens_fuzz", 0, text);
+    for (auto const& account : samples.accounts)
+        write("tokens_fuzz", 1, std::string(account.begin(), account.end()));
+    for (auto const& pk : samples.nodeKeys)
+        write("tokens_fuzz", 1 | (3 << 1), std::string(pk.begin(), pk.end()));
+
+    std::cout << "Wrote " << count << " inputs to " << root.string()
+              << std::endl;
+}
+
+}  // namespace
+}  // namespace ripple
+
+int
+main(int argc, char** argv)
+{
+    using namespace ripple;
+
+    Options options;
+    std::optional<std::string> corpus;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string const arg = argv[i];
+        if (arg.rfind("--time=", 0) == 0)
+            options.time = std::chrono::milliseconds(std::stoul(arg.substr(7)));
+        else if (arg.rfind("--corpus=", 0) == 0)
+            corpus = arg.substr(9);
+        else
+            options.filters.push_back(arg);
+    }
+
+    auto const samples = makeSamples();
+    if (corpus)
+    {
+        writeCorpus(*corpus, samples);
+        return 0;
+    }
+
+    runBenchmarks(options, samples);
+    return 0;
+}
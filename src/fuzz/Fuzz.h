@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_FUZZ_FUZZ_H_INCLUDED
+#define RIPPLE_FUZZ_FUZZ_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+/** The entry point of a fuzz target.
+
+    Each harness defines it once. It is called with one input at a time,
+    either by libFuzzer or by the replay driver in StandaloneMain.cpp, and
+    must return 0. Inputs that the codec rejects are not failures; a
+    harness fails, through FUZZ_CHECK, only when a codec accepts an input
+    and then disagrees with itself about it.
+*/
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size);
+
+namespace ripple {
+namespace fuzz {
+
+[[noreturn]] inline void
+fail(char const* condition, char const* file, int line)
+{
+    std::cerr << file << ":" << line << ": check failed: " << condition
+              << std::endl;
+    std::abort();
+}
+
+/** Splits a fuzz input into a selector byte and the rest. */
+struct Input
+{
+    std::uint8_t selector = 0;
+    std::uint8_t const* data = nullptr;
+    std::size_t size = 0;
+
+    Input(std::uint8_t const* d, std::size_t s)
+    {
+        if (s != 0)
+        {
+            selector = d[0];
+            data = d + 1;
+            size = s - 1;
+        }
+    }
+};
+
+}  // namespace fuzz
+}  // namespace ripple
+
+// Unlike an assert, this is checked in every build.
+#define FUZZ_CHECK(cond) \
+    ((cond) ? (void)0 : ::ripple::fuzz::fail(#cond, __FILE__, __LINE__))
+
+#endif
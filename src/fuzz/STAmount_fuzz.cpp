@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// Round trips amounts through their binary, text and JSON forms, and runs
+// them through the arithmetic.
+//
+// The first byte picks what the rest of the input is: one serialized
+// amount, a decimal string to parse as XRP or as an IOU, or two serialized
+// amounts to combine. Arithmetic may refuse its operands by throwing, but
+// must not crash, and must not depend on their order where the operation
+// is commutative.
+
+#include <fuzz/Fuzz.h>
+
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/Serializer.h>
+#include <xrpl/protocol/UintTypes.h>
+
+#include <optional>
+#include <string>
+
+namespace ripple {
+namespace {
+
+std::optional<STAmount>
+parse(SerialIter& sit)
+{
+    try
+    {
+        return STAmount(sit, sfGeneric);
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+template <class F>
+std::optional<STAmount>
+attempt(F&& f)
+{
+    try
+    {
+        return f();
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+// Checks an amount that one of the parsers accepted.
+void
+check(STAmount const& amount)
+{
+    Serializer s;
+    amount.add(s);
+    SerialIter sit{s.slice()};
+    auto const again = parse(sit);
+    FUZZ_CHECK(again && sit.empty());
+    FUZZ_CHECK(*again == amount);
+    FUZZ_CHECK(again->issue() == amount.issue());
+
+    // The binary form can hold more drops than exist, which transactors
+    // reject with isLegalNet, but the text and JSON parsers refuse.
+    if (!isLegalNet(amount))
+        return;
+
+    auto const fromText = attempt(
+        [&]() { return amountFromString(amount.issue(), amount.getText()); });
+    FUZZ_CHECK(fromText && *fromText == amount);
+
+    auto const fromJson = attempt([&]() {
+        return amountFromJson(sfGeneric, amount.getJson(JsonOptions::none));
+    });
+    FUZZ_CHECK(fromJson && *fromJson == amount);
+    FUZZ_CHECK(fromJson->issue() == amount.issue());
+}
+
+void
+combine(STAmount const& a, STAmount const& b)
+{
+    // Adding zero to an amount that is out of range hands it back as it
+    // is, but adding it to zero checks the range, so order only stops
+    // mattering for amounts that are in range.
+    bool const legal = isLegalNet(a) && isLegalNet(b);
+
+    auto const sum = attempt([&]() { return a + b; });
+    auto const reversed = attempt([&]() { return b + a; });
+    if (legal)
+    {
+        FUZZ_CHECK(sum.has_value() == reversed.has_value());
+        if (sum)
+            FUZZ_CHECK(*sum == *reversed);
+    }
+
+    auto const issue = a.issue();
+    auto const product = attempt([&]() { return multiply(a, b, issue); });
+    auto const swapped = attempt([&]() { return multiply(b, a, issue); });
+    if (legal)
+    {
+        FUZZ_CHECK(product.has_value() == swapped.has_value());
+        if (product)
+            FUZZ_CHECK(*product == *swapped);
+    }
+
+    (void)attempt([&]() { return a - b; });
+    (void)attempt([&]() { return divide(a, b, issue); });
+    for (bool const roundUp : {false, true})
+    {
+        (void)attempt([&]() { return mulRound(a, b, issue, roundUp); });
+        (void)attempt([&]() { return mulRoundStrict(a, b, issue, roundUp); });
+        (void)attempt([&]() { return divRound(a, b, issue, roundUp); });
+        (void)attempt([&]() { return divRoundStrict(a, b, issue, roundUp); });
+    }
+}
+
+}  // namespace
+}  // namespace ripple
+
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size)
+{
+    using namespace ripple;
+
+    fuzz::Input const input(data, size);
+    SerialIter sit{input.data, input.size};
+
+    switch (input.selector % 3)
+    {
+        case 0:
+            if (auto const amount = parse(sit))
+                check(*amount);
+            break;
+
+        case 1: {
+            static Issue const usd{to_currency("USD"), AccountID(0x4985601)};
+            auto const& issue = (input.selector & 4) ? usd : xrpIssue();
+            std::string const text(
+                reinterpret_cast<char const*>(input.data), input.size);
+            if (auto const amount = attempt(
+                    [&]() { return amountFromString(issue, text); }))
+                check(*amount);
+            break;
+        }
+
+        default: {
+            auto const a = parse(sit);
+            auto const b = parse(sit);
+            if (a && b)
+            {
+                check(*a);
+                check(*b);
+                combine(*a, *b);
+            }
+            break;
+        }
+    }
+    return 0;
+}
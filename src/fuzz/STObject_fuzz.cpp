@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// Round trips STObject through its binary and JSON forms.
+//
+// The first byte picks how the rest of the input is read: as a serialized
+// object, or as JSON text for STParsedJSONObject. Whatever is accepted must
+// serialize to a canonical encoding that parses back to the same object,
+// and that survives a trip through JSON unchanged.
+
+#include <fuzz/Fuzz.h>
+
+#include <xrpl/json/json_reader.h>
+#include <xrpl/protocol/STObject.h>
+#include <xrpl/protocol/STParsedJSON.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <optional>
+#include <string>
+
+namespace ripple {
+namespace {
+
+std::optional<STObject>
+fromBinary(Slice data)
+{
+    try
+    {
+        return STObject(SerialIter{data}, sfGeneric);
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+std::optional<STObject>
+fromJson(Json::Value const& json)
+{
+    try
+    {
+        STParsedJSONObject parsed("fuzz", json);
+        return std::move(parsed.object);
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+// Checks an object that one of the parsers accepted.
+void
+check(STObject const& object)
+{
+    Serializer s;
+    object.add(s);
+
+    auto const again = fromBinary(s.slice());
+    FUZZ_CHECK(again);
+    FUZZ_CHECK(*again == object);
+
+    Serializer s2;
+    again->add(s2);
+    FUZZ_CHECK(s2.slice() == s.slice());
+
+    // JSON is only checked one way: it cannot carry everything the binary
+    // form can, so the parser may refuse what getJson wrote, but what it
+    // does accept must be the same object.
+    if (auto const parsed = fromJson(object.getJson(JsonOptions::none)))
+    {
+        Serializer s3;
+        parsed->add(s3);
+        FUZZ_CHECK(s3.slice() == s.slice());
+    }
+}
+
+}  // namespace
+}  // namespace ripple
+
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size)
+{
+    using namespace ripple;
+
+    fuzz::Input const input(data, size);
+
+    if ((input.selector & 1) == 0)
+    {
+        if (auto const object = fromBinary(Slice(input.data, input.size)))
+            check(*object);
+        return 0;
+    }
+
+    Json::Value json;
+    Json::Reader reader;
+    auto const text = reinterpret_cast<char const*>(input.data);
+    if (!reader.parse(text, text + input.size, json) || !json.isObject())
+        return 0;
+
+    if (auto const object = fromJson(json))
+        check(*object);
+    return 0;
+}
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// Compares the two ways of parsing a transaction, and round trips it.
+//
+// STTx can be built from a SerialIter, which hashes a fresh serialization,
+// or from a Slice, which hashes the encoding it was given and keeps it.
+// Both must accept the same inputs and agree on the hashes and on whether
+// the signature checks out. Accepted transactions that survive a trip
+// through JSON must come back unchanged.
+
+#include <fuzz/Fuzz.h>
+
+#include <xrpl/protocol/Rules.h>
+#include <xrpl/protocol/STParsedJSON.h>
+#include <xrpl/protocol/STTx.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <memory>
+#include <optional>
+
+namespace ripple {
+namespace {
+
+template <class Source>
+std::optional<STTx>
+parse(Source&& source)
+{
+    try
+    {
+        return STTx(std::forward<Source>(source));
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+bool
+signatureChecks(STTx const& tx, Rules const& rules)
+{
+    return static_cast<bool>(
+        tx.checkSign(STTx::RequireFullyCanonicalSig::yes, rules));
+}
+
+void
+checkJson(STTx const& tx, Slice canonical)
+{
+    auto const json = tx.getJson(JsonOptions::none);
+
+    std::optional<STTx> fromJson;
+    try
+    {
+        STParsedJSONObject parsed("tx_json", json);
+        if (parsed.object)
+            fromJson.emplace(std::move(*parsed.object));
+    }
+    catch (std::exception const&)
+    {
+    }
+
+    // Not every field survives the trip through JSON, but whatever is
+    // parsed back must encode exactly as before.
+    if (!fromJson)
+        return;
+
+    Serializer s;
+    fromJson->add(s);
+    FUZZ_CHECK(s.slice() == canonical);
+}
+
+}  // namespace
+}  // namespace ripple
+
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size)
+{
+    using namespace ripple;
+
+    static Rules const rules{{}};
+
+    Slice const input(data, size);
+    auto const fromIter = parse(SerialIter{input});
+    auto const fromWire = parse(input);
+
+    FUZZ_CHECK(fromIter.has_value() == fromWire.has_value());
+    if (!fromIter)
+        return 0;
+
+    FUZZ_CHECK(fromIter->isEquivalent(*fromWire));
+    FUZZ_CHECK(
+        fromIter->getTransactionID() == fromWire->getTransactionID());
+    FUZZ_CHECK(fromIter->getSigningHash() == fromWire->getSigningHash());
+    FUZZ_CHECK(
+        signatureChecks(*fromIter, rules) ==
+        signatureChecks(*fromWire, rules));
+
+    Serializer s;
+    fromIter->add(s);
+
+    // The encoding is only kept if it was canonical to begin with.
+    if (auto const wire = fromWire->getWireData())
+        FUZZ_CHECK(*wire == s.slice());
+
+    auto const again = parse(s.slice());
+    FUZZ_CHECK(again);
+    FUZZ_CHECK(again->getWireData() == s.slice());
+    FUZZ_CHECK(
+        again->getTransactionID() == fromIter->getTransactionID());
+
+    checkJson(*fromIter, s.slice());
+    return 0;
+}
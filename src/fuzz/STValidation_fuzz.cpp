@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// Round trips validations received from peers.
+//
+// A validation that parses must serialize to an encoding that parses back
+// to the same validation, signed by the same node over the same hash, with
+// the signature checking out the same way.
+
+#include <fuzz/Fuzz.h>
+
+#include <xrpl/protocol/PublicKey.h>
+#include <xrpl/protocol/STValidation.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <optional>
+
+namespace ripple {
+namespace {
+
+std::optional<STValidation>
+parse(Slice data, bool checkSignature)
+{
+    try
+    {
+        SerialIter sit{data};
+        return STValidation(
+            sit,
+            [](PublicKey const& pk) { return calcNodeID(pk); },
+            checkSignature);
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+}  // namespace
+}  // namespace ripple
+
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size)
+{
+    using namespace ripple;
+
+    // Random signatures never check out, so only a corpus of real
+    // validations gets past a signature check; the first byte decides
+    // whether to ask for one.
+    fuzz::Input const input(data, size);
+    bool const checkSignature = (input.selector & 1) != 0;
+
+    auto const validation =
+        parse(Slice(input.data, input.size), checkSignature);
+    if (!validation)
+        return 0;
+
+    auto const valid = validation->isValid();
+    FUZZ_CHECK(valid || !checkSignature);
+
+    auto const serialized = validation->getSerialized();
+    auto const again = parse(makeSlice(serialized), false);
+    FUZZ_CHECK(again);
+    FUZZ_CHECK(*again == *validation);
+    FUZZ_CHECK(again->getNodeID() == validation->getNodeID());
+    FUZZ_CHECK(again->getSigningHash() == validation->getSigningHash());
+    FUZZ_CHECK(again->isValid() == valid);
+    FUZZ_CHECK(again->getSerialized() == serialized);
+    return 0;
+}
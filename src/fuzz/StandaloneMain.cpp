@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// A stand-in for libFuzzer's main(), for compilers without libFuzzer.
+//
+// Usage: <target> [-runs=N] [-seed=S] [file or directory]...
+//
+// Every file named, and every file in a directory named, is run through
+// the target once. With -runs, that corpus is then mutated at random N
+// times, which is far weaker than coverage guided fuzzing but still finds
+// shallow bugs. With no files at all, one input is read from stdin.
+//
+// If a check fails, the input being run is written to crash-input.
+
+#include <fuzz/Fuzz.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+Bytes const* current = nullptr;
+
+extern "C" void
+onAbort(int)
+{
+    // Only async-signal-safe calls from here.
+    if (current)
+    {
+        int const fd =
+            ::open("crash-input", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0)
+        {
+            auto const written = ::write(fd, current->data(), current->size());
+            (void)written;
+            ::close(fd);
+        }
+    }
+    std::signal(SIGABRT, SIG_DFL);
+    std::raise(SIGABRT);
+}
+
+void
+run(Bytes const& input)
+{
+    current = &input;
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    current = nullptr;
+}
+
+Bytes
+readFile(std::filesystem::path const& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return Bytes(
+        std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Applies a few byte level edits of the kinds that matter to the codecs:
+// changed type and length bytes, and truncated or spliced fields.
+void
+mutate(Bytes& input, std::mt19937_64& gen)
+{
+    auto const pick = [&](std::size_t n) {
+        return std::uniform_int_distribution<std::size_t>(0, n - 1)(gen);
+    };
+    auto const byte = [&]() { return static_cast<std::uint8_t>(gen()); };
+
+    auto edits = 1 + pick(4);
+    while (edits-- != 0)
+    {
+        switch (input.empty() ? 1 : pick(5))
+        {
+            case 0:
+                input[pick(input.size())] ^= 1 << pick(8);
+                break;
+            case 1:
+                input.insert(input.begin() + pick(input.size() + 1), byte());
+                break;
+            case 2:
+                input.erase(input.begin() + pick(input.size()));
+                break;
+            case 3:
+                input.resize(pick(input.size() + 1));
+                break;
+            default:
+                input[pick(input.size())] = byte();
+                break;
+        }
+    }
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    std::size_t runs = 0;
+    std::uint64_t seed = std::random_device{}();
+    std::vector<Bytes> corpus;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string const arg = argv[i];
+        if (arg.rfind("-runs=", 0) == 0)
+        {
+            runs = std::stoull(arg.substr(6));
+        }
+        else if (arg.rfind("-seed=", 0) == 0)
+        {
+            seed = std::stoull(arg.substr(6));
+        }
+        else if (std::filesystem::is_directory(arg))
+        {
+            for (auto const& entry :
+                 std::filesystem::recursive_directory_iterator(arg))
+            {
+                if (entry.is_regular_file())
+                    corpus.push_back(readFile(entry.path()));
+            }
+        }
+        else
+        {
+            corpus.push_back(readFile(arg));
+        }
+    }
+
+    std::signal(SIGABRT, onAbort);
+
+    if (corpus.empty() && runs == 0)
+        corpus.push_back(Bytes(
+            std::istreambuf_iterator<char>(std::cin),
+            std::istreambuf_iterator<char>()));
+
+    for (auto const& input : corpus)
+        run(input);
+
+    std::mt19937_64 gen(seed);
+    Bytes input;
+    for (std::size_t i = 0; i < runs; ++i)
+    {
+        if (corpus.empty())
+            input.clear();
+        else
+            input = corpus[gen() % corpus.size()];
+        mutate(input, gen);
+        run(input);
+    }
+
+    std::cout << "Done: " << corpus.size() << " inputs, " << runs
+              << " mutations (seed " << seed << ")\n";
+    return 0;
+}
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// Compares the fast base58 codec with the reference one, and round trips
+// tokens through both.
+//
+// The first byte picks what the rest of the input is: a string to decode
+// as each type of token, or a payload to encode as the token type the
+// first byte names. The fast codec only handles payloads of 1 to 33
+// bytes, the size of a public key, and refuses anything else; the
+// reference codec can encode anything, but only decodes what is not much
+// longer.
+
+#include <fuzz/Fuzz.h>
+
+#include <xrpl/protocol/tokens.h>
+
+#include <array>
+#include <string>
+
+namespace ripple {
+namespace {
+
+bool
+fastHandles(std::size_t payload)
+{
+    return payload >= 1 && payload <= 33;
+}
+
+// The reference decoder gives up on more than 64 significant digits.
+bool
+referenceHandles(std::size_t payload)
+{
+    return payload >= 1 && payload <= 41;
+}
+
+constexpr std::array<TokenType, 6> tokenTypes{
+    TokenType::AccountID,
+    TokenType::AccountPublic,
+    TokenType::AccountSecret,
+    TokenType::NodePublic,
+    TokenType::NodePrivate,
+    TokenType::FamilySeed};
+
+void
+checkDecode(std::string const& text)
+{
+    for (auto const type : tokenTypes)
+    {
+        auto const reference = b58_ref::decodeBase58Token(text, type);
+        auto const decoded = decodeBase58Token(text, type);
+
+        if (fastHandles(reference.size()))
+            FUZZ_CHECK(decoded == reference);
+        else
+            FUZZ_CHECK(decoded.empty());
+
+        // An encoding is unique, so a token that decodes must be exactly
+        // what encoding its payload gives back.
+        if (!reference.empty())
+            FUZZ_CHECK(
+                b58_ref::encodeBase58Token(
+                    type, reference.data(), reference.size()) == text);
+    }
+}
+
+void
+checkEncode(TokenType type, std::string const& payload)
+{
+    auto const reference =
+        b58_ref::encodeBase58Token(type, payload.data(), payload.size());
+    if (referenceHandles(payload.size()))
+        FUZZ_CHECK(b58_ref::decodeBase58Token(reference, type) == payload);
+
+    auto const encoded =
+        encodeBase58Token(type, payload.data(), payload.size());
+    if (fastHandles(payload.size()))
+        FUZZ_CHECK(encoded == reference);
+    else
+        FUZZ_CHECK(encoded.empty());
+}
+
+}  // namespace
+}  // namespace ripple
+
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size)
+{
+    using namespace ripple;
+
+    fuzz::Input const input(data, size);
+    std::string const text(
+        reinterpret_cast<char const*>(input.data), input.size);
+
+    if ((input.selector & 1) == 0)
+        checkDecode(text);
+    else
+        checkEncode(
+            tokenTypes[(input.selector >> 1) % tokenTypes.size()], text);
+    return 0;
+}
@@ -55,4 +55,23 @@ CountedObjects::getCounts(int minimumThreshold) const
     return counts;
 }
 
+CountedObjects::ByteList
+CountedObjects::getBytes(int minimumThreshold) const
+{
+    ByteList bytes;
+
+    bytes.reserve(m_count.load());
+
+    for (auto* ctr = m_head.load(); ctr != nullptr; ctr = ctr->getNext())
+    {
+        // Counters that are not tied to an object hold no bytes
+        if (ctr->getCount() >= minimumThreshold && ctr->getBytes() != 0)
+            bytes.emplace_back(ctr->getName(), ctr->getBytes());
+    }
+
+    std::sort(bytes.begin(), bytes.end());
+
+    return bytes;
+}
+
 }  // namespace ripple
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <xrpl/basics/IOUAmount.h>
+#include <xrpl/basics/MathUtilities.h>
 #include <xrpl/basics/contract.h>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <algorithm>
@@ -89,19 +90,24 @@ IOUAmount::normalize()
     if (negative)
         mantissa_ = -mantissa_;
 
-    while ((mantissa_ < minMantissa) && (exponent_ > minExponent))
+    // Scale the mantissa into range a power of ten at a time, exactly as
+    // repeated multiplication or division by ten would.
+    if ((mantissa_ < minMantissa) && (exponent_ > minExponent))
     {
-        mantissa_ *= 10;
-        --exponent_;
+        int const shift = std::min(
+            16 - decimalDigits(mantissa_), exponent_ - minExponent);
+        mantissa_ *= powersOfTen[shift];
+        exponent_ -= shift;
     }
 
-    while (mantissa_ > maxMantissa)
+    if (mantissa_ > maxMantissa)
     {
-        if (exponent_ >= maxExponent)
+        int const shift = decimalDigits(mantissa_) - 16;
+        if (exponent_ + shift > maxExponent)
             Throw<std::overflow_error>("IOUAmount::normalize");
 
-        mantissa_ /= 10;
-        ++exponent_;
+        mantissa_ /= powersOfTen[shift];
+        exponent_ += shift;
     }
 
     if ((exponent_ < minExponent) || (mantissa_ < minMantissa))
@@ -18,7 +18,6 @@
 //==============================================================================
 
 #include <xrpl/basics/Number.h>
-#include <boost/predef.h>
 #include <algorithm>
 #include <cassert>
 #include <numeric>
@@ -26,12 +25,12 @@
 #include <type_traits>
 #include <utility>
 
-#ifdef BOOST_COMP_MSVC
+#ifndef __SIZEOF_INT128__
 #include <boost/multiprecision/cpp_int.hpp>
 using uint128_t = boost::multiprecision::uint128_t;
-#else   // !defined(_MSVC_LANG)
+#else   // defined(__SIZEOF_INT128__)
 using uint128_t = __uint128_t;
-#endif  // !defined(_MSVC_LANG)
+#endif  // defined(__SIZEOF_INT128__)
 
 namespace ripple {
 
@@ -32,14 +32,9 @@ namespace ripple {
 std::string
 sqlBlobLiteral(Blob const& blob)
 {
-    std::string j;
-
-    j.reserve(blob.size() * 2 + 3);
-    j.push_back('X');
-    j.push_back('\'');
-    boost::algorithm::hex(blob.begin(), blob.end(), std::back_inserter(j));
-    j.push_back('\'');
-
+    std::string j(blob.size() * 2 + 3, '\'');
+    j[0] = 'X';
+    strHex(blob.data(), blob.size(), j.data() + 2);
     return j;
 }
 
@@ -18,12 +18,16 @@
 //==============================================================================
 
 #include <xrpl/basics/contract.h>
+#include <xrpl/basics/hardened_hash.h>
 #include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/PublicKey.h>
 #include <xrpl/protocol/detail/secp256k1.h>
 #include <xrpl/protocol/digest.h>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <ed25519.h>
+#include <array>
+#include <atomic>
+#include <mutex>
 
 namespace ripple {
 
@@ -218,6 +222,95 @@ publicKeyType(Slice const& slice)
     return std::nullopt;
 }
 
+namespace {
+
+/** A bounded cache of decoded secp256k1 public keys.
+
+    Each key maps to one slot, chosen by a hash seeded at startup so that
+    keys cannot be crafted to push out those of the validators. A key
+    that maps to a slot in use replaces its occupant. The slots are
+    guarded by a set of striped locks, so concurrent lookups rarely
+    contend.
+*/
+class DecodedKeyCache
+{
+    static constexpr std::size_t slotCount = 4096;
+    static constexpr std::size_t lockCount = 64;
+
+    struct Slot
+    {
+        std::array<std::uint8_t, 33> key{};
+        secp256k1_pubkey point;
+        bool used = false;
+    };
+
+    hardened_hash<> const hasher_;
+    std::array<Slot, slotCount> slots_;
+    std::array<std::mutex, lockCount> locks_;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+
+public:
+    /** Decode a public key, using the cached point if there is one.
+        @return `false` if the key is not a valid point.
+    */
+    bool
+    decode(PublicKey const& publicKey, secp256k1_pubkey& point)
+    {
+        auto const index = hasher_(publicKey) % slotCount;
+        auto& slot = slots_[index];
+        auto const key = publicKey.data();
+
+        {
+            std::lock_guard lock(locks_[index % lockCount]);
+            if (slot.used &&
+                std::equal(slot.key.begin(), slot.key.end(), key))
+            {
+                point = slot.point;
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        if (secp256k1_ec_pubkey_parse(
+                secp256k1Context(),
+                &point,
+                reinterpret_cast<unsigned char const*>(key),
+                publicKey.size()) != 1)
+            return false;
+
+        std::lock_guard lock(locks_[index % lockCount]);
+        std::copy(key, key + publicKey.size(), slot.key.begin());
+        slot.point = point;
+        slot.used = true;
+        return true;
+    }
+
+    PublicKeyCacheCounts
+    counts() const
+    {
+        return {
+            hits_.load(std::memory_order_relaxed),
+            misses_.load(std::memory_order_relaxed)};
+    }
+};
+
+DecodedKeyCache&
+decodedKeyCache()
+{
+    static DecodedKeyCache cache;
+    return cache;
+}
+
+}  // namespace
+
+PublicKeyCacheCounts
+getPublicKeyCacheCounts()
+{
+    return decodedKeyCache().counts();
+}
+
 bool
 verifyDigest(
     PublicKey const& publicKey,
@@ -235,11 +328,7 @@ verifyDigest(
         return false;
 
     secp256k1_pubkey pubkey_imp;
-    if (secp256k1_ec_pubkey_parse(
-            secp256k1Context(),
-            &pubkey_imp,
-            reinterpret_cast<unsigned char const*>(publicKey.data()),
-            publicKey.size()) != 1)
+    if (!decodedKeyCache().decode(publicKey, pubkey_imp))
         return false;
 
     secp256k1_ecdsa_signature sig_imp;
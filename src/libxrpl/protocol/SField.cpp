@@ -17,11 +17,17 @@
 */
 //==============================================================================
 
+#include <xrpl/basics/contract.h>
 #include <xrpl/protocol/SField.h>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -30,6 +36,25 @@ SField::IsSigning const SField::notSigning;
 int SField::num = 0;
 std::map<int, SField const*> SField::knownCodeToField;
 
+// Every field that can appear in a serialized object has a type and a value
+// below 256. Those are found by indexing a flat table with the two, which
+// is zero initialized before any SField is constructed. The rest (the
+// high level types, and fields like sfHash that are never serialized) are
+// only in knownCodeToField.
+static constexpr int tableTypes = 32;
+static constexpr int tableValues = 256;
+static std::array<SField const*, tableTypes * tableValues> codeTable;
+
+static SField const**
+tableSlot(int code)
+{
+    auto const type = static_cast<unsigned>(code) >> 16;
+    auto const value = static_cast<unsigned>(code) & 0xffff;
+    if (type >= tableTypes || value >= tableValues)
+        return nullptr;
+    return &codeTable[type * tableValues + value];
+}
+
 // Give only this translation unit permission to construct SFields
 struct SField::private_access_tag_t
 {
@@ -98,6 +123,8 @@ SField::SField(
     , jsonName(fieldName.c_str())
 {
     knownCodeToField[fieldCode] = this;
+    if (auto const slot = tableSlot(fieldCode))
+        *slot = this;
 }
 
 SField::SField(private_access_tag_t, int fc)
@@ -110,11 +137,16 @@ SField::SField(private_access_tag_t, int fc)
     , jsonName(fieldName.c_str())
 {
     knownCodeToField[fieldCode] = this;
+    if (auto const slot = tableSlot(fieldCode))
+        *slot = this;
 }
 
 SField const&
 SField::getField(int code)
 {
+    if (auto const slot = tableSlot(code))
+        return *slot ? **slot : sfInvalid;
+
     auto it = knownCodeToField.find(code);
 
     if (it != knownCodeToField.end())
@@ -140,15 +172,145 @@ SField::compare(SField const& f1, SField const& f2)
     return 0;
 }
 
-SField const&
-SField::getField(std::string const& fieldName)
+namespace {
+
+/** A perfect hash of the field names.
+
+    The names are spread over buckets of about four by one hash. Each bucket
+    then gets the first displacement which, mixed into the hash, puts all of
+    its names in free slots. A lookup costs one hash of the name, two table
+    reads and one string comparison.
+*/
+class FieldNameIndex
 {
-    for (auto const& [_, f] : knownCodeToField)
+public:
+    explicit FieldNameIndex(std::map<int, SField const*> const& fields)
+    {
+        // Keep the field with the lowest code when names repeat, as the
+        // linear search this replaces did.
+        std::vector<std::pair<std::uint64_t, SField const*>> keys;
+        {
+            std::unordered_map<std::string_view, SField const*> unique;
+            for (auto const& [_, f] : fields)
+            {
+                (void)_;
+                if (unique.emplace(f->fieldName, f).second)
+                    keys.emplace_back(hash(f->fieldName), f);
+            }
+        }
+
+        std::size_t slots = 1;
+        while (slots < 2 * keys.size())
+            slots <<= 1;
+        mask_ = slots - 1;
+        slots_.assign(slots, nullptr);
+        displacement_.assign(std::max<std::size_t>(1, keys.size() / 4), 0);
+
+        std::vector<std::vector<std::size_t>> buckets(displacement_.size());
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            buckets[bucket(keys[i].first)].push_back(i);
+
+        std::vector<std::size_t> order(buckets.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(
+            order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                return buckets[a].size() > buckets[b].size();
+            });
+
+        std::vector<std::size_t> placed;
+        for (auto const b : order)
+        {
+            auto const& members = buckets[b];
+            std::uint32_t d = 0;
+            for (;; ++d)
+            {
+                if (d == maxDisplacement)
+                    LogicError("FieldNameIndex: no perfect hash found");
+
+                placed.clear();
+                bool fits = true;
+                for (auto const i : members)
+                {
+                    auto const s = slot(keys[i].first, d);
+                    if (slots_[s] ||
+                        std::find(placed.begin(), placed.end(), s) !=
+                            placed.end())
+                    {
+                        fits = false;
+                        break;
+                    }
+                    placed.push_back(s);
+                }
+                if (fits)
+                    break;
+            }
+
+            displacement_[b] = d;
+            for (std::size_t j = 0; j < members.size(); ++j)
+                slots_[placed[j]] = keys[members[j]].second;
+        }
+    }
+
+    SField const*
+    find(std::string_view name) const
     {
-        (void)_;
-        if (f->fieldName == fieldName)
-            return *f;
+        auto const h = hash(name);
+        auto const f = slots_[slot(h, displacement_[bucket(h)])];
+        if (f && f->fieldName == name)
+            return f;
+        return nullptr;
     }
+
+private:
+    static constexpr std::uint32_t maxDisplacement = 1 << 20;
+
+    // 64 bit FNV-1a
+    static std::uint64_t
+    hash(std::string_view name)
+    {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (unsigned char c : name)
+        {
+            h ^= c;
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    std::size_t
+    bucket(std::uint64_t h) const
+    {
+        return (h >> 32) % displacement_.size();
+    }
+
+    std::size_t
+    slot(std::uint64_t h, std::uint32_t d) const
+    {
+        // The splitmix64 finalizer, so that each displacement gives an
+        // unrelated placement.
+        h += (d + 1) * 0x9e3779b97f4a7c15ull;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        h ^= h >> 31;
+        return h & mask_;
+    }
+
+    std::size_t mask_ = 0;
+    std::vector<std::uint32_t> displacement_;
+    std::vector<SField const*> slots_;
+};
+
+}  // namespace
+
+SField const&
+SField::getField(std::string const& fieldName)
+{
+    // Built on first use, when every SField has been constructed
+    static FieldNameIndex const index(knownCodeToField);
+
+    if (auto const f = index.find(fieldName))
+        return *f;
     return sfInvalid;
 }
 
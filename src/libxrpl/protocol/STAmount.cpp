@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <xrpl/basics/Log.h>
+#include <xrpl/basics/MathUtilities.h>
 #include <xrpl/basics/contract.h>
 #include <xrpl/basics/safe_cast.h>
 #include <xrpl/beast/core/LexicalCast.h>
@@ -26,12 +27,18 @@
 #include <xrpl/protocol/UintTypes.h>
 #include <xrpl/protocol/jss.h>
 #include <boost/algorithm/string.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <boost/regex.hpp>
 #include <iostream>
 #include <iterator>
 #include <memory>
 
+#ifndef __SIZEOF_INT128__
+#include <boost/multiprecision/cpp_int.hpp>
+using uint128_t = boost::multiprecision::uint128_t;
+#else   // defined(__SIZEOF_INT128__)
+using uint128_t = __uint128_t;
+#endif  // defined(__SIZEOF_INT128__)
+
 namespace ripple {
 
 namespace {
@@ -756,10 +763,12 @@ STAmount::canonicalize()
         }
         else
         {
-            while (mOffset < 0)
+            // Dividing by ten once per step truncates the same way as
+            // dividing by the power of ten at once.
+            if (mOffset < 0)
             {
-                mValue /= 10;
-                ++mOffset;
+                mValue /= powersOfTen[-mOffset];
+                mOffset = 0;
             }
 
             while (mOffset > 0)
@@ -798,19 +807,24 @@ STAmount::canonicalize()
         return;
     }
 
-    while ((mValue < cMinValue) && (mOffset > cMinOffset))
+    // Scale the mantissa into range a power of ten at a time, exactly as
+    // repeated multiplication or division by ten would.
+    if ((mValue < cMinValue) && (mOffset > cMinOffset))
     {
-        mValue *= 10;
-        --mOffset;
+        int const shift =
+            std::min(16 - decimalDigits(mValue), mOffset - cMinOffset);
+        mValue *= powersOfTen[shift];
+        mOffset -= shift;
     }
 
-    while (mValue > cMaxValue)
+    if (mValue > cMaxValue)
     {
-        if (mOffset >= cMaxOffset)
+        int const shift = decimalDigits(mValue) - 16;
+        if (mOffset + shift > cMaxOffset)
             Throw<std::runtime_error>("value overflow");
 
-        mValue /= 10;
-        ++mOffset;
+        mValue /= powersOfTen[shift];
+        mOffset += shift;
     }
 
     if ((mOffset < cMinOffset) || (mValue < cMinValue))
@@ -1122,9 +1136,7 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * uint128_t(multiplicand);
     ret /= divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
@@ -1144,9 +1156,7 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * uint128_t(multiplicand);
     ret += rounding;
     ret /= divisor;
 
@@ -1161,6 +1171,19 @@ muldiv_round(
     return static_cast<uint64_t>(ret);
 }
 
+// Bring a non-zero native mantissa up to STAmount::cMinValue, as
+// repeatedly multiplying by ten would.
+static void
+scaleUpNative(std::uint64_t& value, int& offset)
+{
+    if (value < STAmount::cMinValue)
+    {
+        int const shift = 16 - decimalDigits(value);
+        value *= powersOfTen[shift];
+        offset -= shift;
+    }
+}
+
 STAmount
 divide(STAmount const& num, STAmount const& den, Issue const& issue)
 {
@@ -1176,23 +1199,10 @@ divide(STAmount const& num, STAmount const& den, Issue const& issue)
     int denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            // Need to bring into range
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        scaleUpNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        scaleUpNative(denVal, denOffset);
 
     // We divide the two mantissas (each is between 10^15
     // and 10^16). To maintain precision, we multiply the
@@ -1237,22 +1247,10 @@ multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
     int offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        scaleUpNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        scaleUpNative(value2, offset2);
 
     // We multiply the two mantissas (each is between 10^15
     // and 10^16), so their product is in the 10^30 to 10^32
@@ -1292,18 +1290,14 @@ canonicalizeRound(bool native, std::uint64_t& value, int& offset, bool)
     {
         if (offset < 0)
         {
-            int loops = 0;
-
-            while (offset < -1)
-            {
-                value /= 10;
-                ++offset;
-                ++loops;
-            }
+            // Divide by ten until one digit is left to round. A value has
+            // at most 20 digits, so longer runs of divisions leave zero.
+            int const loops = -1 - offset;
+            value = loops < 20 ? value / powersOfTen[loops] : 0;
 
             value += (loops >= 2) ? 9 : 10;  // add before last divide
             value /= 10;
-            ++offset;
+            offset = 0;
         }
     }
     else if (value > STAmount::cMaxValue)
@@ -1335,22 +1329,25 @@ canonicalizeRoundStrict(
     {
         if (offset < 0)
         {
+            // Divide by ten until one digit is left to round, noting
+            // whether any of the digits dropped were non-zero.
+            int const loops = -1 - offset;
             bool hadRemainder = false;
-
-            while (offset < -1)
+            if (loops < 20)
             {
-                // It would be better to use std::lldiv than to separately
-                // compute the remainder.  But std::lldiv does not support
-                // unsigned arguments.
-                std::uint64_t const newValue = value / 10;
-                hadRemainder |= (value != (newValue * 10));
+                std::uint64_t const newValue = value / powersOfTen[loops];
+                hadRemainder = value != newValue * powersOfTen[loops];
                 value = newValue;
-                ++offset;
+            }
+            else
+            {
+                hadRemainder = value != 0;
+                value = 0;
             }
             value +=
                 (hadRemainder && roundUp) ? 10 : 9;  // Add before last divide
             value /= 10;
-            ++offset;
+            offset = 0;
         }
     }
     else if (value > STAmount::cMaxValue)
@@ -1424,22 +1421,10 @@ mulRoundImpl(
     int offset1 = v1.exponent(), offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        scaleUpNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        scaleUpNative(value2, offset2);
 
     bool const resultNegative = v1.negative() != v2.negative();
 
@@ -1527,22 +1512,10 @@ divRoundImpl(
     int numOffset = num.exponent(), denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        scaleUpNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        scaleUpNative(denVal, denOffset);
 
     bool const resultNegative = (num.negative() != den.negative());
 
@@ -128,6 +128,12 @@ STLedgerEntry::getJson(JsonOptions options) const
     return ret;
 }
 
+std::size_t
+STLedgerEntry::memoryFootprint() const
+{
+    return sizeof(*this) + getFieldsFootprint();
+}
+
 bool
 STLedgerEntry::isThreadedType(Rules const& rules) const
 {
@@ -124,6 +124,7 @@ STObject::operator=(STObject&& other)
 void
 STObject::set(const SOTemplate& type)
 {
+    onChange();
     v_.clear();
     v_.reserve(type.size());
     mType = &type;
@@ -148,6 +149,7 @@ STObject::applyTemplate(const SOTemplate& type)
         Throw<FieldErr>(text);
     };
 
+    onChange();
     mType = &type;
     decltype(v_) v;
     v.reserve(type.size());
@@ -203,9 +205,20 @@ STObject::applyTemplateFromSField(SField const& sField)
 // return true = terminated with end-of-object
 bool
 STObject::set(SerialIter& sit, int depth)
+{
+    return set(sit, depth, nullptr);
+}
+
+bool
+STObject::set(
+    SerialIter& sit,
+    int depth,
+    std::vector<std::size_t>* fieldOffsets)
 {
     bool reachedEndOfObject = false;
+    std::size_t const length = sit.getBytesLeft();
 
+    onChange();
     v_.clear();
 
     // Consume data in the pipe until we run out or reach the end
@@ -214,6 +227,9 @@ STObject::set(SerialIter& sit, int depth)
         int type;
         int field;
 
+        if (fieldOffsets)
+            fieldOffsets->push_back(length - sit.getBytesLeft());
+
         // Get the metadata for the next field
         sit.getFieldID(type, field);
 
@@ -378,6 +394,44 @@ STObject::getSigningHash(HashPrefix prefix) const
     return s.getSHA512Half();
 }
 
+std::size_t
+STObject::getFieldsFootprint() const
+{
+    std::size_t bytes = v_.capacity() * sizeof(detail::STVar);
+
+    for (auto const& e : v_)
+    {
+        switch (e->getSType())
+        {
+            case STI_OBJECT:
+                bytes += sizeof(STObject) +
+                    static_cast<STObject const&>(e.get()).getFieldsFootprint();
+                break;
+            case STI_ARRAY:
+                for (auto const& o : static_cast<STArray const&>(e.get()))
+                    bytes += sizeof(STObject) + o.getFieldsFootprint();
+                break;
+            case STI_VL:
+                bytes += static_cast<STBlob const&>(e.get()).size();
+                break;
+            case STI_VECTOR256:
+                bytes += static_cast<STVector256 const&>(e.get())
+                             .value()
+                             .capacity() *
+                    sizeof(uint256);
+                break;
+            case STI_PATHSET:
+                for (auto const& p : static_cast<STPathSet const&>(e.get()))
+                    bytes += sizeof(STPath) + p.size() * sizeof(STPathElement);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return bytes;
+}
+
 int
 STObject::getFieldIndex(SField const& field) const
 {
@@ -547,6 +601,7 @@ STObject::makeFieldAbsent(SField const& field)
 
     if (f.getSType() == STI_NOTPRESENT)
         return;
+    onChange();
     v_[index] = detail::STVar(detail::nonPresentObject, f.getFName());
 }
 
@@ -565,6 +620,7 @@ STObject::delField(SField const& field)
 void
 STObject::delField(int index)
 {
+    onChange();
     v_.erase(v_.begin() + index);
 }
 
@@ -668,6 +724,7 @@ STObject::set(std::unique_ptr<STBase> v)
 void
 STObject::set(STBase&& v)
 {
+    onChange();
     auto const i = getFieldIndex(v.getFName());
     if (i != -1)
     {
@@ -693,6 +693,23 @@ parseLeaf(
 
                         p.emplace_back(
                             uAccount, uCurrency, uIssuer, hasCurrency);
+
+                        // An element that names nothing has no encoding; its
+                        // type byte would end the path set.
+                        if (p.back().getNodeType() == STPathElement::typeNone)
+                        {
+                            error = invalid_data(element_name);
+                            return ret;
+                        }
+                    }
+
+                    // Nor does an empty path.
+                    if (p.empty())
+                    {
+                        std::stringstream ss;
+                        ss << fieldName << "[" << i << "]";
+                        error = invalid_data(json_name, ss.str());
+                        return ret;
                     }
 
                     tail.push_back(p);
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <xrpl/basics/Buffer.h>
 #include <xrpl/basics/Log.h>
 #include <xrpl/basics/StringUtilities.h>
 #include <xrpl/basics/contract.h>
@@ -32,6 +33,7 @@
 #include <xrpl/protocol/Sign.h>
 #include <xrpl/protocol/TxFlags.h>
 #include <xrpl/protocol/UintTypes.h>
+#include <xrpl/protocol/digest.h>
 #include <xrpl/protocol/jss.h>
 #include <boost/format.hpp>
 
@@ -39,6 +41,7 @@
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -80,6 +83,132 @@ STTx::STTx(SerialIter& sit) : STObject(sfTransaction)
     tid_ = getHash(HashPrefix::transactionID);
 }
 
+struct STTx::Wire
+{
+    Buffer bytes;
+    uint256 signingHash;
+
+    // The [begin, end) byte ranges of the signing fields within bytes
+    std::vector<std::pair<std::size_t, std::size_t>> signingFields;
+};
+
+// Whether serializing a field of this type always reproduces, byte for
+// byte, the encoding that it was parsed from.
+static bool
+isEncodingExact(SerializedTypeID type)
+{
+    switch (type)
+    {
+        case STI_UINT8:
+        case STI_UINT16:
+        case STI_UINT32:
+        case STI_UINT64:
+        case STI_UINT128:
+        case STI_UINT160:
+        case STI_UINT192:
+        case STI_UINT256:
+        case STI_VL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+STTx::STTx(Slice wire) : STObject(sfTransaction)
+{
+    if ((wire.size() < txMinSizeBytes) || (wire.size() > txMaxSizeBytes))
+        Throw<std::runtime_error>("Transaction length invalid");
+
+    std::vector<std::size_t> offsets;
+    offsets.reserve(32);
+
+    SerialIter sit(wire);
+    if (set(sit, 0, &offsets))
+        Throw<std::runtime_error>("Transaction contains an object terminator");
+
+    tx_type_ = safe_cast<TxType>(getFieldU16(sfTransactionType));
+
+    applyTemplate(getTxFormat(tx_type_)->getSOTemplate());  // May throw
+
+    // The encoded fields can be hashed directly as long as the encoding is
+    // the one that add() would produce: every field must have survived the
+    // template, appear in canonical order and be encoded exactly as it
+    // would be serialized.
+    auto w = std::make_shared<Wire>();
+    sha512_half_hasher txid;
+    sha512_half_hasher signing;
+    hash_append(txid, HashPrefix::transactionID);
+    hash_append(signing, HashPrefix::txSign);
+
+    Serializer s;
+    int lastCode = 0;
+    bool canonical = true;
+
+    for (std::size_t i = 0; canonical && i != offsets.size(); ++i)
+    {
+        auto const begin = offsets[i];
+        auto const end =
+            (i + 1 != offsets.size()) ? offsets[i + 1] : wire.size();
+        Slice const encoded{wire.data() + begin, end - begin};
+
+        SerialIter it(encoded);
+        int type;
+        int name;
+        it.getFieldID(type, name);
+
+        auto const& sf = SField::getField(type, name);
+        auto const field = peekAtPField(sf);
+
+        if (!field || field->getSType() == STI_NOTPRESENT ||
+            sf.fieldCode <= lastCode)
+        {
+            canonical = false;
+            break;
+        }
+        lastCode = sf.fieldCode;
+
+        // Native amounts are exact too; other types are checked by
+        // serializing just this field.
+        auto const value = encoded.size() - it.getBytesLeft();
+        bool exact = isEncodingExact(field->getSType()) ||
+            (type == STI_AMOUNT && (encoded[value] & 0x80) == 0);
+
+        if (!exact)
+        {
+            s.erase();
+            field->addFieldID(s);
+            field->add(s);
+            if (type == STI_ARRAY || type == STI_OBJECT)
+                s.addFieldID(type, 1);
+            exact = (s.slice() == encoded);
+        }
+
+        if (!exact)
+        {
+            canonical = false;
+            break;
+        }
+
+        txid(encoded.data(), encoded.size());
+        if (sf.shouldInclude(false))
+            signing(encoded.data(), encoded.size());
+        else
+            w->signingFields.emplace_back(begin, end);
+    }
+
+    if (canonical)
+    {
+        tid_ = static_cast<uint256>(txid);
+        w->signingHash = static_cast<uint256>(signing);
+        w->bytes = Buffer(wire.data(), wire.size());
+        wire_ = std::move(w);
+    }
+    else
+    {
+        tid_ = getHash(HashPrefix::transactionID);
+    }
+}
+
 STTx::STTx(TxType type, std::function<void(STObject&)> assembler)
     : STObject(sfTransaction)
 {
@@ -164,6 +293,8 @@ getSigningData(STTx const& that)
 uint256
 STTx::getSigningHash() const
 {
+    if (wire_)
+        return wire_->signingHash;
     return STObject::getSigningHash(HashPrefix::txSign);
 }
 
@@ -227,6 +358,40 @@ STTx::checkSign(
     return Unexpected("Internal signature check failure.");
 }
 
+void
+STTx::onChange()
+{
+    // The fields may no longer match the encoding
+    wire_.reset();
+}
+
+std::optional<Slice>
+STTx::getWireData() const
+{
+    if (!wire_)
+        return std::nullopt;
+    return wire_->bytes;
+}
+
+Serializer
+STTx::getWireSigningData(HashPrefix prefix) const
+{
+    assert(wire_);
+    auto const& bytes = wire_->bytes;
+
+    Serializer s(bytes.size() + sizeof(std::uint32_t));
+    s.add32(prefix);
+
+    std::size_t pos = 0;
+    for (auto const& [begin, end] : wire_->signingFields)
+    {
+        s.addRaw(bytes.data() + pos, begin - pos);
+        pos = end;
+    }
+    s.addRaw(bytes.data() + pos, bytes.size() - pos);
+    return s;
+}
+
 Json::Value
 STTx::getJson(JsonOptions options) const
 {
@@ -323,16 +488,40 @@ STTx::checkSingleSign(RequireFullyCanonicalSig requireCanonicalSig) const
 
         auto const spk = getFieldVL(sfSigningPubKey);
 
-        if (publicKeyType(makeSlice(spk)))
+        if (auto const type = publicKeyType(makeSlice(spk)))
         {
+            PublicKey const publicKey(makeSlice(spk));
             Blob const signature = getFieldVL(sfTxnSignature);
-            Blob const data = getSigningData(*this);
 
-            validSig = verify(
-                PublicKey(makeSlice(spk)),
-                makeSlice(data),
-                makeSlice(signature),
-                fullyCanonical);
+            if (!wire_)
+            {
+                Blob const data = getSigningData(*this);
+
+                validSig = verify(
+                    publicKey,
+                    makeSlice(data),
+                    makeSlice(signature),
+                    fullyCanonical);
+            }
+            else if (*type == KeyType::secp256k1)
+            {
+                // The digest of the signing data is already known.
+                validSig = verifyDigest(
+                    publicKey,
+                    wire_->signingHash,
+                    makeSlice(signature),
+                    fullyCanonical);
+            }
+            else
+            {
+                auto const data = getWireSigningData(HashPrefix::txSign);
+
+                validSig = verify(
+                    publicKey,
+                    data.slice(),
+                    makeSlice(signature),
+                    fullyCanonical);
+            }
         }
     }
     catch (std::exception const&)
@@ -371,7 +560,9 @@ STTx::checkMultiSign(
     // We can ease the computational load inside the loop a bit by
     // pre-constructing part of the data that we hash.  Fill a Serializer
     // with the stuff that stays constant from signature to signature.
-    Serializer const dataStart{startMultiSigningData(*this)};
+    Serializer const dataStart{
+        wire_ ? getWireSigningData(HashPrefix::txMultiSign)
+              : startMultiSigningData(*this)};
 
     // We also use the sfAccount field inside the loop.  Get it once.
     auto const txnAccountID = getAccountID(sfAccount);
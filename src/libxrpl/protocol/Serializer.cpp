@@ -21,10 +21,143 @@
 #include <xrpl/basics/contract.h>
 #include <xrpl/protocol/Serializer.h>
 #include <xrpl/protocol/digest.h>
+#include <atomic>
+#include <mutex>
 #include <type_traits>
+#include <vector>
 
 namespace ripple {
 
+namespace {
+
+// Buffers that grew past this are freed rather than kept, so that a
+// thread never holds more than a few kilobytes.
+constexpr std::size_t pooledCapacity = 512;
+constexpr std::size_t pooledBuffers = 8;
+
+// Serializers that outlive the pool of their thread, in other thread_local
+// or static objects, allocate and free their buffers as usual.
+thread_local bool poolDestroyed = false;
+
+struct BufferPool;
+
+// The pools of live threads, and the counts of threads that have exited.
+// Each pool counts its own buffers, so that taking one touches no memory
+// shared with other threads; the counts are only summed when read.
+struct PoolRegistry
+{
+    std::mutex mutex;
+    std::vector<BufferPool*> pools;
+    SerializerPoolCounts retired;
+};
+
+PoolRegistry&
+poolRegistry()
+{
+    static PoolRegistry registry;
+    return registry;
+}
+
+// Only the owning thread writes a pool's counts, so a plain load and store
+// is enough.
+void
+bump(std::atomic<std::uint64_t>& counter)
+{
+    counter.store(
+        counter.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+}
+
+struct BufferPool
+{
+    std::vector<Blob> buffers;
+    std::atomic<std::uint64_t> reused{0};
+    std::atomic<std::uint64_t> allocated{0};
+
+    BufferPool()
+    {
+        buffers.reserve(pooledBuffers);
+        auto& registry = poolRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.pools.push_back(this);
+    }
+
+    ~BufferPool()
+    {
+        poolDestroyed = true;
+        auto& registry = poolRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.retired.reused += reused.load(std::memory_order_relaxed);
+        registry.retired.allocated +=
+            allocated.load(std::memory_order_relaxed);
+        std::erase(registry.pools, this);
+    }
+};
+
+BufferPool*
+bufferPool()
+{
+    if (poolDestroyed)
+        return nullptr;
+    thread_local BufferPool pool;
+    return &pool;
+}
+
+}  // namespace
+
+SerializerPoolCounts
+getSerializerPoolCounts()
+{
+    auto& registry = poolRegistry();
+    std::lock_guard lock(registry.mutex);
+    auto counts = registry.retired;
+    for (auto const pool : registry.pools)
+    {
+        counts.reused += pool->reused.load(std::memory_order_relaxed);
+        counts.allocated += pool->allocated.load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+Blob
+Serializer::takeBuffer(std::size_t n)
+{
+    Blob buffer;
+    auto const pool = bufferPool();
+    if (pool && n <= pooledCapacity)
+    {
+        auto& buffers = pool->buffers;
+        if (!buffers.empty() && buffers.back().capacity() >= n)
+        {
+            buffer = std::move(buffers.back());
+            buffers.pop_back();
+            bump(pool->reused);
+            return buffer;
+        }
+    }
+    if (pool && n != 0)
+        bump(pool->allocated);
+    buffer.reserve(n);
+    return buffer;
+}
+
+void
+Serializer::recycleBuffer(Blob&& buffer) noexcept
+{
+    // A buffer whose data was moved out has no capacity left
+    auto const capacity = buffer.capacity();
+    if (capacity == 0 || capacity > pooledCapacity)
+        return;
+
+    // The pool reserved its slots up front, so this never allocates
+    auto const pool = bufferPool();
+    if (pool && pool->buffers.size() < pooledBuffers)
+    {
+        buffer.clear();
+        pool->buffers.push_back(std::move(buffer));
+    }
+}
+
 int
 Serializer::add16(std::uint16_t i)
 {
@@ -35,6 +35,7 @@
 #include <boost/endian.hpp>
 #include <boost/endian/conversion.hpp>
 
+#include <array>
 #include <cassert>
 #include <cstring>
 #include <memory>
@@ -538,7 +539,8 @@ b58_to_b256_be(std::string_view input, std::span<std::uint8_t> out)
     assert(num_b_58_10_coeffs <= b_58_10_coeff.size());
     for (auto c : input.substr(0, partial_coeff_len))
     {
-        auto cur_val = ::ripple::alphabetReverse[c];
+        auto cur_val =
+            ::ripple::alphabetReverse[static_cast<unsigned char>(c)];
         if (cur_val < 0)
         {
             return Unexpected(TokenCodecErrc::invalidEncodingChar);
@@ -551,7 +553,8 @@ b58_to_b256_be(std::string_view input, std::span<std::uint8_t> out)
         for (int j = 0; j < num_full_coeffs; ++j)
         {
             auto c = input[partial_coeff_len + j * 10 + i];
-            auto cur_val = ::ripple::alphabetReverse[c];
+            auto cur_val =
+                ::ripple::alphabetReverse[static_cast<unsigned char>(c)];
             if (cur_val < 0)
             {
                 return Unexpected(TokenCodecErrc::invalidEncodingChar);
@@ -705,39 +708,36 @@ decodeBase58Token(
 [[nodiscard]] std::string
 encodeBase58Token(TokenType type, void const* token, std::size_t size)
 {
-    std::string sr;
     // The largest object encoded as base58 is 33 bytes; This will be encoded in
     // at most ceil(log(2^256,58)) bytes, or 46 bytes. 128 is plenty (and
     // there's not real benefit making it smaller). Note that 46 bytes may be
     // encoded in more than 46 base58 chars. Since decode uses 64 as the
     // over-allocation, this function uses 128 (again, over-allocation assuming
     // 2 base 58 char per byte)
-    sr.resize(128);
-    std::span<std::uint8_t> outSp(
-        reinterpret_cast<std::uint8_t*>(sr.data()), sr.size());
+    //
+    // The result is built on the stack, so that the returned string is
+    // allocated once and at its final size.
+    std::array<std::uint8_t, 128> buf;
     std::span<std::uint8_t const> inSp(
         reinterpret_cast<std::uint8_t const*>(token), size);
-    auto r = b58_fast::encodeBase58Token(type, inSp, outSp);
+    auto r = b58_fast::encodeBase58Token(type, inSp, buf);
     if (!r)
         return {};
-    sr.resize(r.value().size());
-    return sr;
+    return std::string(
+        reinterpret_cast<char const*>(r.value().data()), r.value().size());
 }
 
 [[nodiscard]] std::string
 decodeBase58Token(std::string const& s, TokenType type)
 {
-    std::string sr;
     // The largest object encoded as base58 is 33 bytes; 64 is plenty (and
     // there's no benefit making it smaller)
-    sr.resize(64);
-    std::span<std::uint8_t> outSp(
-        reinterpret_cast<std::uint8_t*>(sr.data()), sr.size());
-    auto r = b58_fast::decodeBase58Token(type, s, outSp);
+    std::array<std::uint8_t, 64> buf;
+    auto r = b58_fast::decodeBase58Token(type, s, buf);
     if (!r)
         return {};
-    sr.resize(r.value().size());
-    return sr;
+    return std::string(
+        reinterpret_cast<char const*>(r.value().data()), r.value().size());
 }
 
 }  // namespace b58_fast
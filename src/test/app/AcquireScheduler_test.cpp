@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/ledger/detail/AcquireScheduler.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/jss.h>
+
+#include <numeric>
+
+namespace ripple {
+namespace test {
+
+class AcquireScheduler_test : public beast::unit_test::suite
+{
+    using clock_type = AcquireScheduler::clock_type;
+
+    static constexpr auto as = protocol::liAS_NODE;
+
+    // The ID of the nth node below the root
+    static SHAMapNodeID
+    node(unsigned int n)
+    {
+        return SHAMapNodeID().getChildNodeID(n);
+    }
+
+    // Ask a peer for the nth node below the root
+    static void
+    request(
+        AcquireScheduler& s,
+        Peer::id_t peer,
+        unsigned int n,
+        clock_type::time_point now)
+    {
+        s.onRequest(peer, as, {node(n)}, now);
+    }
+
+    static std::vector<int>
+    items(int n)
+    {
+        std::vector<int> v(n);
+        std::iota(v.begin(), v.end(), 0);
+        return v;
+    }
+
+    void
+    testWindow()
+    {
+        using namespace std::chrono_literals;
+        testcase("Request window");
+
+        AcquireScheduler s(2);
+        auto const now = clock_type::now();
+
+        BEAST_EXPECT(s.capacity(1) == 2);
+        request(s, 1, 0, now);
+        request(s, 1, 0, now);
+        BEAST_EXPECT(s.capacity(1) == 0);
+        BEAST_EXPECT(s.capacity(2) == 2);
+
+        s.onReply(1, as, node(0), 10, 1000, now + 50ms);
+        BEAST_EXPECT(s.capacity(1) == 1);
+        BEAST_EXPECT(s.nodes() == 10);
+
+        // The remaining request expires
+        s.expire(now + 1s, 3s);
+        BEAST_EXPECT(s.capacity(1) == 1);
+        s.expire(now + 4s, 3s);
+        BEAST_EXPECT(s.capacity(1) == 2);
+    }
+
+    void
+    testMatching()
+    {
+        using namespace std::chrono_literals;
+        testcase("Reply matching");
+
+        AcquireScheduler s(2);
+        auto const now = clock_type::now();
+
+        // A reply nobody asked for counts toward the nodes received, but
+        // does not free the window or change the latency
+        request(s, 1, 1, now);
+        BEAST_EXPECT(!s.onReply(1, as, node(5), 20, 800, now + 10ms));
+        BEAST_EXPECT(s.capacity(1) == 1);
+        BEAST_EXPECT(s.nodes() == 20);
+        auto j = s.getJson(now + 10ms);
+        BEAST_EXPECT(j[jss::bytes_received].asUInt() == 800);
+        BEAST_EXPECT(j[jss::peer_stats][0u][jss::outstanding].asUInt() == 1);
+        BEAST_EXPECT(j[jss::peer_stats][0u][jss::latency].asUInt() == 0);
+
+        // Neither does a reply from a peer that was never asked, such as
+        // one answering a request sent to every peer
+        BEAST_EXPECT(!s.onReply(2, as, node(1), 5, 100, now + 10ms));
+        BEAST_EXPECT(s.capacity(2) == 2);
+        BEAST_EXPECT(s.nodes() == 25);
+
+        // Nor a reply with the right node from the wrong map
+        BEAST_EXPECT(
+            !s.onReply(1, protocol::liTX_NODE, node(1), 1, 10, now + 10ms));
+        BEAST_EXPECT(s.capacity(1) == 1);
+
+        // Replies that arrive out of order each answer their own request
+        request(s, 1, 2, now + 20ms);
+        BEAST_EXPECT(s.capacity(1) == 0);
+        BEAST_EXPECT(s.onReply(1, as, node(2), 10, 400, now + 50ms));
+        BEAST_EXPECT(s.capacity(1) == 1);
+        j = s.getJson(now + 50ms);
+        BEAST_EXPECT(j[jss::peer_stats][0u][jss::latency].asUInt() == 30);
+
+        // The request that is left is the one for node 1
+        BEAST_EXPECT(!s.onReply(1, as, node(2), 10, 400, now + 60ms));
+        BEAST_EXPECT(s.onReply(1, as, node(1), 10, 400, now + 60ms));
+        BEAST_EXPECT(s.capacity(1) == 2);
+    }
+
+    void
+    testAssign()
+    {
+        using namespace std::chrono_literals;
+        testcase("Assignment");
+
+        auto const now = clock_type::now();
+        {
+            // Peers we know nothing about share equally, in contiguous runs
+            AcquireScheduler s;
+            auto const a = s.assign(items(12), {1, 2, 3}, 100);
+            BEAST_EXPECT(a.size() == 3);
+            int next = 0;
+            for (auto const& [id, run] : a)
+            {
+                BEAST_EXPECT(run.size() == 4);
+                for (auto i : run)
+                    BEAST_EXPECT(i == next++);
+            }
+        }
+        {
+            // A fast peer gets more than a slow one
+            AcquireScheduler s;
+            request(s, 1, 0, now);
+            s.onReply(1, as, node(0), 100, 0, now + 10ms);
+            request(s, 2, 0, now);
+            s.onReply(2, as, node(0), 100, 0, now + 400ms);
+            BEAST_EXPECT(s.score(1) > s.score(2));
+
+            auto const a = s.assign(items(100), {1, 2}, 100);
+            BEAST_EXPECT(a.size() == 2);
+            BEAST_EXPECT(a[0].first == 1 && a[1].first == 2);
+            BEAST_EXPECT(a[0].second.size() > a[1].second.size());
+            BEAST_EXPECT(a[0].second.size() + a[1].second.size() == 100);
+        }
+        {
+            // Per-peer caps and busy peers limit the assignment
+            AcquireScheduler s(1);
+            request(s, 2, 0, now);
+            auto const a = s.assign(items(100), {1, 2, 3}, 10);
+            BEAST_EXPECT(a.size() == 2);
+            for (auto const& [id, run] : a)
+            {
+                BEAST_EXPECT(id != 2);
+                BEAST_EXPECT(run.size() == 10);
+            }
+        }
+        {
+            // A peer that only timed out still gets some work
+            AcquireScheduler s;
+            request(s, 1, 0, now);
+            s.onReply(1, as, node(0), 50, 0, now + 20ms);
+            request(s, 2, 0, now);
+            s.expire(now + 5s, 3s);
+            BEAST_EXPECT(s.score(2) == 0);
+            auto const a = s.assign(items(200), {1, 2}, 200);
+            BEAST_EXPECT(a.size() == 2);
+            BEAST_EXPECT(a[1].second.size() > 0);
+            BEAST_EXPECT(a[1].second.size() < a[0].second.size());
+        }
+    }
+
+    void
+    testJson()
+    {
+        using namespace std::chrono_literals;
+        testcase("Json");
+
+        AcquireScheduler s;
+        auto const now = clock_type::now();
+        request(s, 7, 0, now);
+        s.onReply(7, as, node(0), 500, 20000, now + 100ms);
+
+        auto const j = s.getJson(now + 2s);
+        BEAST_EXPECT(j[jss::nodes_received].asUInt() == 500);
+        BEAST_EXPECT(j[jss::bytes_received].asUInt() == 20000);
+        BEAST_EXPECT(j[jss::nodes_per_second].asUInt() == 250);
+        BEAST_EXPECT(j[jss::peer_stats].size() == 1);
+        BEAST_EXPECT(j[jss::peer_stats][0u][jss::id].asUInt() == 7);
+        BEAST_EXPECT(j[jss::peer_stats][0u][jss::latency].asUInt() == 100);
+        BEAST_EXPECT(j[jss::peer_stats][0u][jss::outstanding].asUInt() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testWindow();
+        testMatching();
+        testAssign();
+        testJson();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AcquireScheduler, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/misc/CacheWarmer.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/digest.h>
+
+namespace ripple {
+namespace test {
+
+class CacheWarmer_test : public beast::unit_test::suite
+{
+    static std::vector<uint256>
+    makeKeys(std::uint32_t first, std::uint32_t count)
+    {
+        std::vector<uint256> keys;
+        for (auto i = first; i < first + count; ++i)
+            keys.push_back(sha512Half(i));
+        return keys;
+    }
+
+    void
+    testRoundTrip()
+    {
+        testcase("Round trip");
+
+        {
+            auto const image = deserializeCacheImage(
+                makeSlice(serializeCacheImage(CacheImage{})));
+            BEAST_EXPECT(image);
+            BEAST_EXPECT(image && image->ledgers.empty());
+            BEAST_EXPECT(image && image->treeNodes.empty());
+            BEAST_EXPECT(image && image->sles.empty());
+        }
+
+        CacheImage const original{
+            makeKeys(0, 3), makeKeys(100, 1000), makeKeys(5000, 17)};
+        auto const image =
+            deserializeCacheImage(makeSlice(serializeCacheImage(original)));
+        BEAST_EXPECT(image);
+        if (!image)
+            return;
+        BEAST_EXPECT(image->ledgers == original.ledgers);
+        BEAST_EXPECT(image->treeNodes == original.treeNodes);
+        BEAST_EXPECT(image->sles == original.sles);
+    }
+
+    void
+    testDamaged()
+    {
+        testcase("Damaged images");
+
+        CacheImage const original{
+            makeKeys(0, 2), makeKeys(10, 20), makeKeys(50, 5)};
+        auto const data = serializeCacheImage(original);
+
+        // Every truncation is rejected
+        for (std::size_t size = 0; size < data.size(); ++size)
+            BEAST_EXPECT(!deserializeCacheImage(Slice(data.data(), size)));
+
+        // So is a change to any byte
+        for (std::size_t i = 0; i < data.size(); i += 7)
+        {
+            auto copy = data;
+            copy[i] ^= 0x01;
+            BEAST_EXPECT(!deserializeCacheImage(makeSlice(copy)));
+        }
+
+        // So is trailing data
+        auto longer = data;
+        longer.push_back(0);
+        BEAST_EXPECT(!deserializeCacheImage(makeSlice(longer)));
+    }
+
+public:
+    void
+    run() override
+    {
+        testRoundTrip();
+        testDamaged();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CacheWarmer, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -242,6 +242,38 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testIfKnown()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s);
+
+        uint256 const key1(1);
+        uint256 const key2(2);
+
+        // An unknown message is not added
+        auto [known, relayed] = router.addSuppressionPeerIfKnown(key1, 1);
+        BEAST_EXPECT(!known && !relayed);
+        BEAST_EXPECT(router.addSuppressionPeer(key1, 2));
+
+        // A known one is, and the peer with it
+        std::tie(known, relayed) = router.addSuppressionPeerIfKnown(key1, 3);
+        BEAST_EXPECT(known && !relayed);
+        auto const peers = router.shouldRelay(key1);
+        BEAST_EXPECT(peers && peers->size() == 2 && peers->count(3) == 1);
+
+        ++stopwatch;
+        std::tie(known, relayed) = router.addSuppressionPeerIfKnown(key1, 4);
+        BEAST_EXPECT(known && relayed);
+
+        // Looking a message up keeps it from expiring
+        ++stopwatch;
+        router.addSuppression(key2);
+        std::tie(known, relayed) = router.addSuppressionPeerIfKnown(key1, 5);
+        BEAST_EXPECT(known);
+    }
+
 public:
     void
     run() override
@@ -252,6 +284,7 @@ public:
         testSetFlags();
         testRelay();
         testProcess();
+        testIfKnown();
     }
 };
 
@@ -0,0 +1,338 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <xrpld/app/ledger/detail/LedgerCleanerImp.h>
+#include <xrpl/beast/utility/temp_dir.h>
+#include <xrpl/json/json_reader.h>
+#include <xrpl/protocol/jss.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace ripple {
+namespace test {
+
+class LedgerCleaner_test : public beast::unit_test::suite
+{
+    // A cleaner that records the ledgers it is asked to clean instead of
+    // cleaning them.
+    class TestCleaner : public LedgerCleanerImp
+    {
+    public:
+        using LedgerCleanerImp::LedgerCleanerImp;
+
+        // Ledgers that always fail to clean
+        std::set<LedgerIndex> failing;
+
+        // How long each ledger takes to clean
+        std::chrono::milliseconds delay{0};
+
+        // The number of times each ledger was attempted
+        std::map<LedgerIndex, int>
+        attempts() const
+        {
+            std::lock_guard lock(recordMutex_);
+            return attempts_;
+        }
+
+        std::size_t
+        cleaned() const
+        {
+            std::lock_guard lock(recordMutex_);
+            return cleaned_.size();
+        }
+
+        bool
+        wasCleaned(LedgerIndex index) const
+        {
+            std::lock_guard lock(recordMutex_);
+            return cleaned_.count(index) != 0;
+        }
+
+        bool
+        checkedNodes() const
+        {
+            std::lock_guard lock(recordMutex_);
+            return doNodes_;
+        }
+
+    protected:
+        bool
+        cleanOne(
+            LedgerIndex ledgerIndex,
+            std::shared_ptr<ReadView const>&,
+            bool doNodes,
+            bool) override
+        {
+            if (delay.count() != 0)
+                std::this_thread::sleep_for(delay);
+
+            std::lock_guard lock(recordMutex_);
+            ++attempts_[ledgerIndex];
+            doNodes_ = doNodes;
+            if (failing.count(ledgerIndex) != 0)
+                return false;
+            cleaned_.insert(ledgerIndex);
+            return true;
+        }
+
+    private:
+        mutable std::mutex recordMutex_;
+        std::map<LedgerIndex, int> attempts_;
+        std::multiset<LedgerIndex> cleaned_;
+        bool doNodes_ = false;
+    };
+
+    static Section
+    makeSection(int threads, std::string const& checkpoint)
+    {
+        Section section("ledger_cleaner");
+        section.set("threads", std::to_string(threads));
+        section.set("max_ledgers_per_second", "0");
+        section.set("checkpoint", checkpoint);
+        return section;
+    }
+
+    static void
+    write(std::string const& path, std::string const& contents)
+    {
+        std::ofstream out(path, std::ios::out | std::ios::trunc);
+        out << contents;
+    }
+
+    static Json::Value
+    read(std::string const& path)
+    {
+        std::ifstream in(path);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        Json::Value v;
+        Json::Reader().parse(ss.str(), v);
+        return v;
+    }
+
+    template <class Pred>
+    bool
+    waitFor(Pred pred)
+    {
+        using namespace std::chrono_literals;
+        auto const until = std::chrono::steady_clock::now() + 30s;
+        while (!pred())
+        {
+            if (std::chrono::steady_clock::now() > until)
+                return false;
+            std::this_thread::sleep_for(10ms);
+        }
+        return true;
+    }
+
+    static bool
+    idle(LedgerCleaner const& cleaner)
+    {
+        return cleaner.getJson()[jss::state] == "idle";
+    }
+
+    static Json::Value
+    range(LedgerIndex min, LedgerIndex max)
+    {
+        Json::Value params(Json::objectValue);
+        params[jss::min_ledger] = min;
+        params[jss::max_ledger] = max;
+        return params;
+    }
+
+    void
+    testResume()
+    {
+        testcase("Resume from a checkpoint");
+
+        jtx::Env env(*this);
+        beast::temp_dir td;
+        auto const path = td.file("ledger_cleaner.json");
+
+        {
+            // The cleaner picks up where the checkpoint says
+            write(
+                path,
+                R"({"min_ledger":10,"max_ledger":200,)"
+                R"("check_nodes":true,"fix_txns":false})");
+            TestCleaner cleaner(env.app(), makeSection(2, path), env.journal);
+            cleaner.start();
+            BEAST_EXPECT(waitFor([&] { return idle(cleaner); }));
+            cleaner.stop();
+
+            auto const attempts = cleaner.attempts();
+            BEAST_EXPECT(attempts.size() == 191);
+            BEAST_EXPECT(attempts.begin()->first == 10);
+            BEAST_EXPECT(attempts.rbegin()->first == 200);
+            BEAST_EXPECT(cleaner.cleaned() == 191);
+            BEAST_EXPECT(cleaner.checkedNodes());
+
+            // Nothing is left, so neither is the checkpoint
+            BEAST_EXPECT(!boost::filesystem::exists(path));
+        }
+
+        auto ignored = [&](std::string const& contents) {
+            write(path, contents);
+            TestCleaner cleaner(env.app(), makeSection(2, path), env.journal);
+            cleaner.start();
+            bool const ok = idle(cleaner);
+            cleaner.stop();
+            return ok && cleaner.attempts().empty();
+        };
+
+        // A damaged or truncated checkpoint is ignored
+        BEAST_EXPECT(ignored("not a checkpoint"));
+        BEAST_EXPECT(ignored(R"({"min_ledger":10,"max_led)"));
+        BEAST_EXPECT(ignored(""));
+        BEAST_EXPECT(ignored(R"({"min_ledger":"ten","max_ledger":200})"));
+        BEAST_EXPECT(ignored(R"([10, 200])"));
+
+        // So is one with an empty range
+        BEAST_EXPECT(ignored(R"({"min_ledger":200,"max_ledger":10})"));
+        BEAST_EXPECT(ignored(R"({"min_ledger":0,"max_ledger":10})"));
+    }
+
+    void
+    testFailedBatch()
+    {
+        testcase("Failed batch");
+
+        jtx::Env env(*this);
+        beast::temp_dir td;
+        auto const path = td.file("ledger_cleaner.json");
+
+        // Two workers split the range into a batch of 64 from ledger 100
+        // down and one of the rest. Ledger 50 never cleans.
+        TestCleaner cleaner(env.app(), makeSection(2, path), env.journal);
+        cleaner.failing.insert(50);
+        cleaner.start();
+        cleaner.clean(range(1, 100));
+
+        BEAST_EXPECT(waitFor([&] {
+            auto const attempts = cleaner.attempts();
+            return cleaner.cleaned() == 86 && attempts.count(50) != 0;
+        }));
+
+        // The ledgers above the failed one are clean, but the lower batch
+        // being done does not move the range past the failed ledger.
+        auto const j = cleaner.getJson();
+        BEAST_EXPECT(j[jss::state] == "running");
+        BEAST_EXPECT(j[jss::max_ledger].asUInt() == 50);
+        BEAST_EXPECT(j[jss::min_ledger].asUInt() == 1);
+        for (LedgerIndex i = 51; i <= 100; ++i)
+            BEAST_EXPECT(cleaner.wasCleaned(i));
+        for (LedgerIndex i = 1; i <= 36; ++i)
+            BEAST_EXPECT(cleaner.wasCleaned(i));
+
+        // The worker stuck on ledger 50 never got further down its batch
+        auto const attempts = cleaner.attempts();
+        for (LedgerIndex i = 37; i < 50; ++i)
+            BEAST_EXPECT(attempts.count(i) == 0);
+
+        // Stopping saves the range left, starting at the failed ledger
+        cleaner.stop();
+        auto const checkpoint = read(path);
+        BEAST_EXPECT(checkpoint[jss::max_ledger].asUInt() == 50);
+        BEAST_EXPECT(checkpoint[jss::min_ledger].asUInt() == 1);
+    }
+
+    void
+    testWorkers()
+    {
+        testcase("Several workers");
+
+        jtx::Env env(*this);
+        beast::temp_dir td;
+        auto const path = td.file("ledger_cleaner.json");
+
+        {
+            // Every ledger is cleaned exactly once
+            TestCleaner cleaner(env.app(), makeSection(4, path), env.journal);
+            cleaner.start();
+            cleaner.clean(range(3, 1000));
+            BEAST_EXPECT(waitFor([&] { return idle(cleaner); }));
+            cleaner.stop();
+
+            auto const attempts = cleaner.attempts();
+            BEAST_EXPECT(attempts.size() == 998);
+            BEAST_EXPECT(cleaner.cleaned() == 998);
+            BEAST_EXPECT(std::all_of(
+                attempts.begin(), attempts.end(), [](auto const& a) {
+                    return a.second == 1;
+                }));
+            BEAST_EXPECT(attempts.begin()->first == 3);
+            BEAST_EXPECT(attempts.rbegin()->first == 1000);
+            BEAST_EXPECT(!boost::filesystem::exists(path));
+        }
+
+        LedgerIndex left = 0;
+        {
+            // Stopping part way saves a range above which every ledger
+            // is clean
+            using namespace std::chrono_literals;
+            TestCleaner cleaner(env.app(), makeSection(4, path), env.journal);
+            cleaner.delay = 1ms;
+            cleaner.start();
+            cleaner.clean(range(1, 5000));
+            BEAST_EXPECT(waitFor([&] { return cleaner.cleaned() >= 300; }));
+            cleaner.stop();
+
+            auto const checkpoint = read(path);
+            left = checkpoint[jss::max_ledger].asUInt();
+            BEAST_EXPECT(checkpoint[jss::min_ledger].asUInt() == 1);
+            BEAST_EXPECT(left < 5000);
+            BEAST_EXPECT(left >= 1);
+            for (LedgerIndex i = left + 1; i <= 5000; ++i)
+                BEAST_EXPECT(cleaner.wasCleaned(i));
+            BEAST_EXPECT(cleaner.cleaned() < 5000);
+        }
+        {
+            // A new cleaner finishes the rest
+            TestCleaner cleaner(env.app(), makeSection(4, path), env.journal);
+            cleaner.start();
+            BEAST_EXPECT(waitFor([&] { return idle(cleaner); }));
+            cleaner.stop();
+
+            auto const attempts = cleaner.attempts();
+            BEAST_EXPECT(attempts.size() == left);
+            BEAST_EXPECT(!attempts.empty() && attempts.rbegin()->first == left);
+            BEAST_EXPECT(!boost::filesystem::exists(path));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testResume();
+        testFailedBatch();
+        testWorkers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerCleaner, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -54,6 +54,8 @@ class LedgerLoad_test : public beast::unit_test::suite
     {
         std::string const dbPath;
         std::string ledgerFile{};
+        std::string snapshotFile{};
+        std::string snapshotHash{};
         Json::Value ledger{};
         Json::Value hashes{};
         uint256 trapTxHash{};
@@ -114,6 +116,15 @@ class LedgerLoad_test : public beast::unit_test::suite
         std::ofstream o(retval.ledgerFile, std::ios::out | std::ios::trunc);
         o << to_string(retval.ledger);
         o.close();
+
+        // and write a snapshot of the last closed ledger
+        retval.snapshotFile = td.file("ledger.snapshot");
+        auto const snap =
+            env.rpc("snapshot_create", retval.snapshotFile, "closed");
+        BEAST_EXPECT(snap[jss::result][jss::status] == "success");
+        retval.snapshotHash =
+            snap[jss::result][jss::ledger_hash].asString();
+        BEAST_EXPECT(boost::filesystem::exists(retval.snapshotFile));
         return retval;
     }
 
@@ -330,6 +341,72 @@ class LedgerLoad_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testLoadSnapshot(SetupData const& sd)
+    {
+        testcase("Load a snapshot");
+        using namespace test::jtx;
+
+        {
+            Env env(
+                *this,
+                envconfig(
+                    ledgerConfig,
+                    sd.dbPath,
+                    sd.snapshotFile,
+                    Config::LOAD_SNAPSHOT,
+                    std::nullopt),
+                nullptr,
+                beast::severities::kDisabled);
+            auto const closed = env.rpc("ledger", "closed")[jss::result];
+            BEAST_EXPECT(closed[jss::ledger_hash] == sd.snapshotHash);
+            auto jrb = env.rpc("ledger", "current", "full")[jss::result];
+            BEAST_EXPECT(
+                sd.ledger[jss::ledger][jss::accountState].size() ==
+                jrb[jss::ledger][jss::accountState].size());
+        }
+
+        // A damaged snapshot must be rejected
+        auto damaged = [&](std::string const& name, auto&& damage) {
+            auto const path = boost::filesystem::path{sd.dbPath} / name;
+            boost::system::error_code ec;
+            boost::filesystem::copy_file(
+                sd.snapshotFile,
+                path,
+                boost::filesystem::copy_options::overwrite_existing,
+                ec);
+            if (!BEAST_EXPECTS(!ec, ec.message()))
+                return;
+            damage(path);
+            except([&] {
+                Env env(
+                    *this,
+                    envconfig(
+                        ledgerConfig,
+                        sd.dbPath,
+                        path.string(),
+                        Config::LOAD_SNAPSHOT,
+                        std::nullopt),
+                    nullptr,
+                    beast::severities::kDisabled);
+            });
+        };
+
+        damaged("truncated.snapshot", [](auto const& path) {
+            auto const size = boost::filesystem::file_size(path);
+            boost::filesystem::resize_file(path, size - 10);
+        });
+        damaged("flipped.snapshot", [](auto const& path) {
+            std::fstream f(
+                path.string(), std::ios::in | std::ios::out | std::ios::binary);
+            f.seekg(boost::filesystem::file_size(path) / 2);
+            char c;
+            f.get(c);
+            f.seekp(boost::filesystem::file_size(path) / 2);
+            f.put(c ^ 0x01);
+        });
+    }
+
     void
     testLoadLatest(SetupData const& sd)
     {
@@ -384,6 +461,7 @@ public:
         testReplayTxFail(sd);
         testLoadLatest(sd);
         testLoadIndex(sd);
+        testLoadSnapshot(sd);
     }
 };
 
@@ -20,6 +20,8 @@
 #include <test/jtx.h>
 #include <test/jtx/Env.h>
 #include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/overlay/Message.h>
+#include <xrpld/overlay/Peer.h>
 #include <xrpl/protocol/jss.h>
 
 namespace ripple {
@@ -27,6 +29,133 @@ namespace test {
 
 class LedgerMaster_test : public beast::unit_test::suite
 {
+    // A peer that keeps the messages sent to it
+    class RecordingPeer : public Peer
+    {
+    public:
+        RecordingPeer()
+            : nodePublicKey_(
+                  derivePublicKey(KeyType::ed25519, randomSecretKey()))
+        {
+        }
+
+        std::vector<std::shared_ptr<Message>> sent;
+
+        void
+        send(std::shared_ptr<Message> const& m) override
+        {
+            sent.push_back(m);
+        }
+        beast::IP::Endpoint
+        getRemoteAddress() const override
+        {
+            return {};
+        }
+        void
+        charge(Resource::Charge const& fee) override
+        {
+        }
+        id_t
+        id() const override
+        {
+            return 1;
+        }
+        bool
+        cluster() const override
+        {
+            return false;
+        }
+        bool
+        isHighLatency() const override
+        {
+            return false;
+        }
+        int
+        getScore(bool) const override
+        {
+            return 0;
+        }
+        PublicKey const&
+        getNodePublic() const override
+        {
+            return nodePublicKey_;
+        }
+        Json::Value
+        json() override
+        {
+            return {};
+        }
+        bool
+        supportsFeature(ProtocolFeature f) const override
+        {
+            return false;
+        }
+        std::optional<std::size_t>
+        publisherListSequence(PublicKey const&) const override
+        {
+            return {};
+        }
+        void
+        setPublisherListSequence(PublicKey const&, std::size_t const) override
+        {
+        }
+        uint256 const&
+        getClosedLedgerHash() const override
+        {
+            static uint256 hash{};
+            return hash;
+        }
+        bool
+        hasLedger(uint256 const& hash, std::uint32_t seq) const override
+        {
+            return true;
+        }
+        void
+        ledgerRange(std::uint32_t& minSeq, std::uint32_t& maxSeq)
+            const override
+        {
+        }
+        bool
+        hasTxSet(uint256 const& hash) const override
+        {
+            return false;
+        }
+        void
+        cycleStatus() override
+        {
+        }
+        bool
+        hasRange(std::uint32_t uMin, std::uint32_t uMax) override
+        {
+            return false;
+        }
+        bool
+        compressionEnabled() const override
+        {
+            return false;
+        }
+        void
+        sendTxQueue() override
+        {
+        }
+        void
+        addTxQueue(uint256 const&) override
+        {
+        }
+        void
+        removeTxQueue(uint256 const&) override
+        {
+        }
+        bool
+        txReduceRelayEnabled() const override
+        {
+            return false;
+        }
+
+    private:
+        PublicKey nodePublicKey_;
+    };
+
     std::unique_ptr<Config>
     makeNetworkConfig(uint32_t networkID)
     {
@@ -117,6 +246,62 @@ class LedgerMaster_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testFetchPackCache()
+    {
+        testcase("fetch pack cache");
+
+        using namespace test::jtx;
+
+        Env env{*this};
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+        for (int i = 0; i < 3; ++i)
+        {
+            env(pay(alice, bob, XRP(1)));
+            env.close();
+        }
+
+        auto& lm = env.app().getLedgerMaster();
+        auto const have = env.closed()->info().hash;
+
+        auto request = std::make_shared<protocol::TMGetObjectByHash>();
+        request->set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+        request->set_query(true);
+        request->set_ledgerhash(have.data(), have.size());
+
+        // Nothing has been built yet
+        auto const first = std::make_shared<RecordingPeer>();
+        BEAST_EXPECT(!lm.sendCachedFetchPack(first, *request, have));
+        BEAST_EXPECT(first->sent.empty());
+
+        lm.makeFetchPack(first, request, have, UptimeClock::now());
+        BEAST_EXPECT(!first->sent.empty());
+
+        // A second peer asking for the same pack gets the same messages
+        auto const second = std::make_shared<RecordingPeer>();
+        BEAST_EXPECT(lm.sendCachedFetchPack(second, *request, have));
+        BEAST_EXPECT(second->sent == first->sent);
+
+        // Building it again for a third peer sends the cached messages too
+        auto const third = std::make_shared<RecordingPeer>();
+        lm.makeFetchPack(third, request, have, UptimeClock::now());
+        BEAST_EXPECT(third->sent == first->sent);
+
+        // A pack for another ledger is not in the cache
+        auto const parent = env.closed()->info().parentHash;
+        auto const other = std::make_shared<RecordingPeer>();
+        BEAST_EXPECT(!lm.sendCachedFetchPack(other, *request, parent));
+        BEAST_EXPECT(other->sent.empty());
+
+        // Nor is a reply that must echo the request's sequence
+        request->set_seq(7);
+        BEAST_EXPECT(!lm.sendCachedFetchPack(other, *request, have));
+        BEAST_EXPECT(other->sent.empty());
+    }
+
 public:
     void
     run() override
@@ -130,6 +315,7 @@ public:
     testWithFeats(FeatureBitset features)
     {
         testTxnIdFromIndex(features);
+        testFetchPackCache();
     }
 };
 
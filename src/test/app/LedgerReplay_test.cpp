@@ -32,6 +32,7 @@
 #include <xrpl/basics/Slice.h>
 
 #include <chrono>
+#include <sstream>
 #include <thread>
 
 namespace ripple {
@@ -66,6 +67,129 @@ struct LedgerReplay_test : public beast::unit_test::suite
             env.journal);
 
         BEAST_EXPECT(replayed->info().hash == lastClosed->info().hash);
+
+        testParallelChecks();
+    }
+
+    void
+    testParallelChecks()
+    {
+        testcase("Replay ledger with parallel transaction checks");
+
+        using namespace jtx;
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 64; ++i)
+            accounts.emplace_back("a" + std::to_string(i));
+
+        Env env(*this);
+        for (auto const& account : accounts)
+            env.fund(XRP(10000), account);
+        env.close();
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+            env(pay(accounts[i], accounts[(i + 1) % accounts.size()], XRP(1)));
+        env.close();
+
+        LedgerMaster& ledgerMaster = env.app().getLedgerMaster();
+        auto const lastClosed = ledgerMaster.getClosedLedger();
+        auto const lastClosedParent =
+            ledgerMaster.getLedgerByHash(lastClosed->info().parentHash);
+
+        // A server that has not seen the transactions checks them all
+        Env other(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->PARALLEL_TX_CHECKS = true;
+            return cfg;
+        }));
+
+        auto const replayed = buildLedger(
+            LedgerReplay(lastClosedParent, lastClosed),
+            tapNONE,
+            other.app(),
+            other.journal);
+
+        BEAST_EXPECT(replayed->info().hash == lastClosed->info().hash);
+        BEAST_EXPECT(
+            replayed->txMap().getHash() == lastClosed->txMap().getHash());
+    }
+};
+
+// Replays a ledger full of payments on a server that has not seen them,
+// with and without parallel transaction checks. The argument is of the
+// form "txs=N,accounts=M".
+struct LedgerReplayPerf_test : public beast::unit_test::suite
+{
+    void
+    run() override
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        std::size_t txs = 2000;
+        std::size_t numAccounts = 500;
+        {
+            std::stringstream ss(arg());
+            std::string token;
+            while (std::getline(ss, token, ','))
+            {
+                auto const pos = token.find('=');
+                if (pos == std::string::npos)
+                    continue;
+                auto const value = std::stoul(token.substr(pos + 1));
+                if (token.substr(0, pos) == "txs")
+                    txs = value;
+                else if (token.substr(0, pos) == "accounts")
+                    numAccounts = value;
+            }
+        }
+
+        testcase(
+            std::to_string(txs) + " payments between " +
+            std::to_string(numAccounts) + " accounts");
+
+        std::vector<Account> accounts;
+        for (std::size_t i = 0; i < numAccounts; ++i)
+            accounts.emplace_back("a" + std::to_string(i));
+
+        Env env(*this, envconfig(), nullptr, beast::severities::kDisabled);
+        for (auto const& account : accounts)
+            env.fund(XRP(100000), account);
+        env.close();
+        for (std::size_t i = 0; i < txs; ++i)
+            env(pay(
+                accounts[i % numAccounts],
+                accounts[(i + 1) % numAccounts],
+                XRP(1)));
+        env.close();
+
+        auto const lastClosed = env.app().getLedgerMaster().getClosedLedger();
+        auto const lastClosedParent =
+            env.app().getLedgerMaster().getLedgerByHash(
+                lastClosed->info().parentHash);
+
+        for (bool const parallel : {false, true})
+        {
+            Env other(
+                *this,
+                envconfig([parallel](std::unique_ptr<Config> cfg) {
+                    cfg->PARALLEL_TX_CHECKS = parallel;
+                    return cfg;
+                }),
+                nullptr,
+                beast::severities::kDisabled);
+
+            auto const start = steady_clock::now();
+            auto const replayed = buildLedger(
+                LedgerReplay(lastClosedParent, lastClosed),
+                tapNONE,
+                other.app(),
+                other.journal);
+            auto const elapsed =
+                duration_cast<milliseconds>(steady_clock::now() - start);
+
+            BEAST_EXPECT(replayed->info().hash == lastClosed->info().hash);
+            log << (parallel ? "parallel checks: " : "serial checks:   ")
+                << elapsed.count() << " ms" << std::endl;
+        }
     }
 };
 
@@ -734,6 +858,28 @@ public:
         return i->second.lock();
     }
 
+    std::vector<std::shared_ptr<LedgerDeltaAcquire>>
+    getDeltas(std::shared_ptr<LedgerReplayTask> const& task)
+    {
+        std::lock_guard lock(task->mtx_);
+        return task->deltas_;
+    }
+
+    // The number of deltas the task started, and the next one it builds
+    std::pair<std::uint32_t, std::uint32_t>
+    deltaProgress(std::shared_ptr<LedgerReplayTask> const& task)
+    {
+        std::lock_guard lock(task->mtx_);
+        return {task->deltasStarted_, task->deltaToBuild_};
+    }
+
+    bool
+    deltaStarted(std::shared_ptr<LedgerDeltaAcquire> const& delta)
+    {
+        std::lock_guard lock(delta->mtx_);
+        return delta->started_;
+    }
+
     template <typename T>
     TaskStatus
     taskStatus(std::shared_ptr<T> const& t)
@@ -880,6 +1026,7 @@ struct NetworkOfTwo
  * -- process a bad skip list
  * -- process a bad ledger delta
  * -- replay ledger ranges with different overlaps
+ * -- acquire only a window of deltas ahead of the ledger being built
  *
  * LedgerReplayerTimeout_test:
  * -- timeouts of SkipListAcquire
@@ -1453,6 +1600,72 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         BEAST_EXPECT(net.client.countsAsExpected(0, 0, 0));
     }
 
+    void
+    testPrefetchWindow()
+    {
+        testcase("Delta prefetch window");
+        std::uint32_t const window =
+            LedgerReplayParameters::DELTA_PREFETCH_WINDOW;
+        int const totalReplay = window + 8;
+        NetworkOfTwo net(
+            *this,
+            {totalReplay + 1},
+            PeerSetBehavior::DropLedgerDeltaReply,
+            InboundLedgersBehavior::DropAll,
+            PeerFeature::LedgerReplayEnabled);
+
+        // The ledgers to replay, from the last to the first
+        std::vector<std::shared_ptr<Ledger const>> ledgers{
+            net.server.ledgerMaster.getClosedLedger()};
+        while (ledgers.size() < totalReplay)
+            ledgers.push_back(net.server.ledgerMaster.getLedgerByHash(
+                ledgers.back()->info().parentHash));
+
+        // The client has the first ledger, and no delta replies arrive
+        uint256 const finalHash = ledgers.front()->info().hash;
+        net.client.addLedger(ledgers.back());
+        net.client.replayer.replay(
+            InboundLedger::Reason::GENERIC, finalHash, totalReplay);
+        auto const task = net.client.findTask(finalHash, totalReplay);
+        BEAST_EXPECT(task);
+        if (!task)
+            return;
+
+        auto const deltas = net.client.getDeltas(task);
+        BEAST_EXPECT(deltas.size() == totalReplay - 1);
+        if (deltas.size() != totalReplay - 1)
+            return;
+
+        // Only the window ahead of the next ledger to build is acquired
+        auto progress = net.client.deltaProgress(task);
+        BEAST_EXPECT(progress.first == window);
+        BEAST_EXPECT(progress.second == 0);
+        for (std::size_t i = 0; i < deltas.size(); ++i)
+            BEAST_EXPECT(net.client.deltaStarted(deltas[i]) == (i < window));
+
+        // Each ledger built moves the window on by one delta
+        for (std::uint32_t built = 1; built <= 3; ++built)
+        {
+            auto const& ledger = ledgers[totalReplay - 1 - built];
+            std::map<std::uint32_t, std::shared_ptr<STTx const>> txns;
+            for (auto const& [tx, meta] : ledger->txs)
+                txns.emplace(meta->getFieldU32(sfTransactionIndex), tx);
+            deltas[built - 1]->processData(ledger->info(), std::move(txns));
+
+            for (int i = 0; i < 100; ++i)
+            {
+                progress = net.client.deltaProgress(task);
+                if (progress.second == built)
+                    break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            BEAST_EXPECT(progress.second == built);
+            BEAST_EXPECT(progress.first == window + built);
+            BEAST_EXPECT(net.client.deltaStarted(deltas[window + built - 1]));
+            BEAST_EXPECT(!net.client.deltaStarted(deltas[window + built]));
+        }
+    }
+
     void
     run() override
     {
@@ -1473,6 +1686,7 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         testSkipListBadReply();
         testLedgerDeltaBadReply();
         testLedgerReplayOverlap();
+        testPrefetchWindow();
     }
 };
 
@@ -1612,6 +1826,7 @@ BEAST_DEFINE_TESTSUITE(LedgerReplay, app, ripple);
 BEAST_DEFINE_TESTSUITE_PRIO(LedgerReplayer, app, ripple, 1);
 BEAST_DEFINE_TESTSUITE(LedgerReplayerTimeout, app, ripple);
 BEAST_DEFINE_TESTSUITE_MANUAL(LedgerReplayerLong, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(LedgerReplayPerf, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/misc/MemoryGovernor.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <xrpl/basics/ByteUtilities.h>
+#include <xrpl/basics/TaggedCache.h>
+#include <xrpl/basics/chrono.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/Protocol.h>
+#include <xrpl/protocol/jss.h>
+
+namespace ripple {
+namespace test {
+
+class MemoryGovernor_test : public beast::unit_test::suite
+{
+    static constexpr std::size_t entryBytes = kilobytes(1);
+
+    // A value that, with its entry in the cache, takes entryBytes
+    struct Value
+    {
+        int value;
+
+        std::size_t
+        memoryFootprint() const;
+    };
+
+    using Cache = TaggedCache<LedgerIndex, Value>;
+
+    // Fill the cache with `count` entries, then record `misses` misses
+    static void
+    fill(Cache& cache, int count, int misses)
+    {
+        for (int i = 0; i < count; ++i)
+            cache.insert(i, {i});
+        for (int i = 0; i < misses; ++i)
+            cache.fetch(count + i);
+    }
+
+    void
+    testMeasureOnly()
+    {
+        testcase("No budget");
+
+        SuiteJournal journal("MemoryGovernor_test", *this);
+        TestStopwatch clock;
+        Cache a("a", 100, std::chrono::seconds(60), clock, journal);
+        fill(a, 100, 1000);
+
+        MemoryGovernor governor(0, journal);
+        governor.add("a", a, entryBytes, 10);
+        governor.addFixed("fixed", []() { return std::uint64_t{12345}; });
+        governor.rebalance();
+
+        BEAST_EXPECT(a.getTargetSize() == 100);
+        auto const json = governor.getJson();
+        BEAST_EXPECT(json[jss::budget] == "0");
+        BEAST_EXPECT(
+            json[jss::bytes] == std::to_string(100 * entryBytes + 12345));
+        BEAST_EXPECT(json[jss::caches]["a"][jss::entries] == 100);
+        BEAST_EXPECT(json[jss::caches]["a"][jss::action] == "hold");
+        BEAST_EXPECT(json[jss::caches]["fixed"][jss::bytes] == "12345");
+    }
+
+    void
+    testOverBudget()
+    {
+        testcase("Over budget");
+
+        SuiteJournal journal("MemoryGovernor_test", *this);
+        TestStopwatch clock;
+        Cache busy("busy", 1000, std::chrono::seconds(60), clock, journal);
+        Cache idle("idle", 1000, std::chrono::seconds(60), clock, journal);
+        fill(busy, 1000, 500);
+        fill(idle, 1000, 0);
+
+        // 2000 entries held against a budget of 1800
+        MemoryGovernor governor(1800 * entryBytes, journal);
+        governor.add("busy", busy, entryBytes, 10);
+        governor.add("idle", idle, entryBytes, 10);
+        governor.rebalance();
+
+        // Only the cache with no misses gives up memory
+        BEAST_EXPECT(busy.getTargetSize() == 1000);
+        BEAST_EXPECT(idle.getTargetSize() == 800);
+        BEAST_EXPECT(
+            governor.getJson()[jss::caches]["idle"][jss::action] == "shrink");
+
+        // Until the sweep catches up, the target is not cut again
+        governor.rebalance();
+        BEAST_EXPECT(idle.getTargetSize() == 800);
+    }
+
+    void
+    testLimits()
+    {
+        testcase("Limits");
+
+        SuiteJournal journal("MemoryGovernor_test", *this);
+        TestStopwatch clock;
+        Cache a("a", 1000, std::chrono::seconds(60), clock, journal);
+        Cache b("b", 1000, std::chrono::seconds(60), clock, journal);
+        fill(a, 1000, 0);
+        fill(b, 1000, 0);
+
+        // Far over budget: each cache shrinks by at most a quarter, and
+        // never below its minimum
+        MemoryGovernor governor(100 * entryBytes, journal);
+        governor.add("a", a, entryBytes, 10);
+        governor.add("b", b, entryBytes, 900);
+        governor.rebalance();
+        BEAST_EXPECT(a.getTargetSize() == 750);
+        BEAST_EXPECT(b.getTargetSize() == 900);
+    }
+
+    void
+    testPartlyFull()
+    {
+        testcase("Partly full");
+
+        SuiteJournal journal("MemoryGovernor_test", *this);
+        TestStopwatch clock;
+        Cache sparse("sparse", 1000, std::chrono::seconds(60), clock, journal);
+        Cache busy("busy", 1000, std::chrono::seconds(60), clock, journal);
+        fill(sparse, 400, 0);
+        fill(busy, 1000, 500);
+
+        // 1400 entries held against a budget of 1200. Cutting the target
+        // of the sparse cache from 1000 to 300 frees only 100 entries, so
+        // the busy cache gives up the rest.
+        MemoryGovernor governor(1200 * entryBytes, journal);
+        governor.add("sparse", sparse, entryBytes, 10);
+        governor.add("busy", busy, entryBytes, 10);
+        governor.rebalance();
+        BEAST_EXPECT(sparse.getTargetSize() == 300);
+        BEAST_EXPECT(busy.getTargetSize() == 900);
+    }
+
+    void
+    testUnderBudget()
+    {
+        testcase("Under budget");
+
+        SuiteJournal journal("MemoryGovernor_test", *this);
+        TestStopwatch clock;
+        Cache full("full", 100, std::chrono::seconds(60), clock, journal);
+        Cache empty("empty", 1000, std::chrono::seconds(60), clock, journal);
+        fill(full, 100, 50);
+        fill(empty, 10, 50);
+
+        MemoryGovernor governor(10000 * entryBytes, journal);
+        governor.add("full", full, entryBytes, 10);
+        governor.add("empty", empty, entryBytes, 10);
+        governor.rebalance();
+
+        // The cache that fills its target grows by a quarter. The other
+        // does not, since more room would not help it.
+        BEAST_EXPECT(full.getTargetSize() == 125);
+        BEAST_EXPECT(empty.getTargetSize() == 1000);
+
+        // With no new misses there is no reason to grow
+        governor.rebalance();
+        BEAST_EXPECT(full.getTargetSize() == 125);
+    }
+
+    void
+    testTransfer()
+    {
+        testcase("Transfer");
+
+        SuiteJournal journal("MemoryGovernor_test", *this);
+        TestStopwatch clock;
+        Cache hot("hot", 1000, std::chrono::seconds(60), clock, journal);
+        Cache cold("cold", 1000, std::chrono::seconds(60), clock, journal);
+        fill(hot, 1000, 400);
+        fill(cold, 1000, 10);
+
+        // Within budget, memory moves from the cold cache to the hot one
+        MemoryGovernor governor(2100 * entryBytes, journal);
+        governor.add("hot", hot, entryBytes, 10);
+        governor.add("cold", cold, entryBytes, 10);
+        governor.rebalance();
+        BEAST_EXPECT(cold.getTargetSize() == 875);
+        BEAST_EXPECT(hot.getTargetSize() == 1125);
+    }
+
+public:
+    void
+    run() override
+    {
+        testMeasureOnly();
+        testOverBudget();
+        testLimits();
+        testPartlyFull();
+        testUnderBudget();
+        testTransfer();
+    }
+};
+
+std::size_t
+MemoryGovernor_test::Value::memoryFootprint() const
+{
+    return entryBytes - Cache::getEntryOverhead();
+}
+
+BEAST_DEFINE_TESTSUITE(MemoryGovernor, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
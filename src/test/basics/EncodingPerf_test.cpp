@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/random.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/beast/utility/rngfill.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/tokens.h>
+
+#include <boost/algorithm/hex.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace ripple {
+
+// A microbenchmark of the encodings that dominate large RPC responses:
+// hashes in hex, and AccountIDs in base58.
+class EncodingPerf_test : public beast::unit_test::suite
+{
+    using clock = std::chrono::steady_clock;
+
+    template <class T, class F>
+    std::chrono::nanoseconds
+    time(std::vector<T> const& items, std::size_t rounds, F&& f)
+    {
+        std::size_t total = 0;
+        auto const start = clock::now();
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (auto const& item : items)
+                total += f(item);
+        }
+        auto const elapsed = clock::now() - start;
+        BEAST_EXPECT(total != 0);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   elapsed) /
+            (rounds * items.size());
+    }
+
+    void
+    reportHex()
+    {
+        testcase("hex encoding performance");
+
+        std::vector<uint256> hashes(10000);
+        for (auto& h : hashes)
+            beast::rngfill(h.data(), h.size(), default_prng());
+
+        auto const boostHex = time(hashes, 100, [](uint256 const& h) {
+            std::string s;
+            s.reserve(64);
+            boost::algorithm::hex(h.begin(), h.end(), std::back_inserter(s));
+            return s.size();
+        });
+        auto const tableHex = time(hashes, 100, [](uint256 const& h) {
+            return to_string(h).size();
+        });
+
+        std::cout << "uint256 to hex: " << boostHex.count()
+                  << "ns with boost, " << tableHex.count()
+                  << "ns with the table\n";
+    }
+
+    void
+    reportBase58()
+    {
+        testcase("base58 encoding performance");
+
+        // A listing of transactions names a few accounts over and over
+        std::vector<AccountID> accounts(500);
+        for (auto& a : accounts)
+            beast::rngfill(a.data(), a.size(), default_prng());
+        std::vector<AccountID> listing;
+        for (std::size_t i = 0; i < 20000; ++i)
+            listing.push_back(accounts[rand_int(accounts.size() - 1)]);
+
+        auto const reference = time(listing, 2, [](AccountID const& a) {
+            return b58_ref::encodeBase58Token(
+                       TokenType::AccountID, a.data(), a.size())
+                .size();
+        });
+        auto const fast = time(listing, 2, [](AccountID const& a) {
+            return encodeBase58Token(TokenType::AccountID, a.data(), a.size())
+                .size();
+        });
+
+        // The cache is process wide, and only this suite sets it up when
+        // tests are run. The cached run keeps every string, as a response
+        // being built would.
+        initAccountIdCache(4096);
+        auto const timeCached = [&](auto&& encode) {
+            std::size_t total = 0;
+            auto const start = clock::now();
+            for (std::size_t r = 0; r < 2; ++r)
+                total += encode().size();
+            auto const elapsed = clock::now() - start;
+            BEAST_EXPECT(total == 2 * listing.size());
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       elapsed) /
+                (2 * listing.size());
+        };
+        auto const cached = timeCached([&]() {
+            std::vector<std::string> result;
+            result.reserve(listing.size());
+            for (auto const& a : listing)
+                result.push_back(toBase58(a));
+            return result;
+        });
+
+        std::cout << "AccountID to base58: " << reference.count()
+                  << "ns reference, " << fast.count() << "ns fast, "
+                  << cached.count() << "ns cached\n";
+    }
+
+public:
+    void
+    run() override
+    {
+        reportHex();
+        reportBase58();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(EncodingPerf, ripple_basics, ripple);
+
+}  // namespace ripple
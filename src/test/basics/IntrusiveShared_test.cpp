@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/basics/IntrusivePointer.h>
+#include <xrpl/basics/IntrusiveRefCounts.h>
+#include <xrpl/beast/unit_test.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace tests {
+
+namespace {
+
+struct Tracker
+{
+    std::atomic<int> constructed{0};
+    std::atomic<int> partiallyDestroyed{0};
+    std::atomic<int> destroyed{0};
+};
+
+struct TIBase : IntrusiveRefCounts
+{
+    explicit TIBase(Tracker& t) : tracker_(t)
+    {
+        ++tracker_.constructed;
+    }
+
+    virtual ~TIBase()
+    {
+        ++tracker_.destroyed;
+    }
+
+    virtual void
+    partialDestructor()
+    {
+        ++tracker_.partiallyDestroyed;
+    }
+
+    Tracker& tracker_;
+};
+
+struct TIDerived : TIBase
+{
+    explicit TIDerived(Tracker& t) : TIBase(t)
+    {
+    }
+
+    int value = 42;
+};
+
+}  // namespace
+
+class IntrusiveShared_test : public beast::unit_test::suite
+{
+public:
+    void
+    testBasics()
+    {
+        testcase("Basics");
+
+        Tracker t;
+        {
+            intr_ptr::SharedPtr<TIBase> a = intr_ptr::make_shared<TIBase>(t);
+            BEAST_EXPECT(a.use_count() == 1);
+            {
+                auto b = a;
+                BEAST_EXPECT(a.use_count() == 2);
+                BEAST_EXPECT(a == b);
+                auto c = std::move(b);
+                BEAST_EXPECT(!b);
+                BEAST_EXPECT(c.use_count() == 2);
+            }
+            BEAST_EXPECT(a.use_count() == 1);
+            BEAST_EXPECT(t.destroyed == 0);
+        }
+        BEAST_EXPECT(t.constructed == 1);
+        BEAST_EXPECT(t.destroyed == 1);
+        // No weak references: the partial destructor is skipped.
+        BEAST_EXPECT(t.partiallyDestroyed == 0);
+
+        intr_ptr::SharedPtr<TIBase> n;
+        BEAST_EXPECT(n == nullptr);
+        BEAST_EXPECT(n.use_count() == 0);
+        n = intr_ptr::make_shared<TIBase>(t);
+        n.reset();
+        BEAST_EXPECT(t.destroyed == 2);
+    }
+
+    void
+    testWeak()
+    {
+        testcase("Weak references");
+
+        Tracker t;
+        intr_ptr::WeakPtr<TIBase> w;
+        {
+            auto s = intr_ptr::make_shared<TIBase>(t);
+            w = intr_ptr::WeakPtr<TIBase>{s};
+            BEAST_EXPECT(!w.expired());
+            auto l = w.lock();
+            BEAST_EXPECT(l == s);
+            BEAST_EXPECT(s.use_count() == 2);
+        }
+        // The object is partially destroyed but its memory is still owned
+        // by the weak pointer.
+        BEAST_EXPECT(w.expired());
+        BEAST_EXPECT(!w.lock());
+        BEAST_EXPECT(t.partiallyDestroyed == 1);
+        BEAST_EXPECT(t.destroyed == 0);
+        w.reset();
+        BEAST_EXPECT(t.destroyed == 1);
+
+        // Dropping the weak pointer first destroys the object with its
+        // last strong reference.
+        {
+            auto s = intr_ptr::make_shared<TIBase>(t);
+            {
+                intr_ptr::WeakPtr<TIBase> w2{s};
+            }
+        }
+        BEAST_EXPECT(t.partiallyDestroyed == 1);
+        BEAST_EXPECT(t.destroyed == 2);
+    }
+
+    void
+    testCasts()
+    {
+        testcase("Casts");
+
+        Tracker t;
+        {
+            intr_ptr::SharedPtr<TIBase> b = intr_ptr::make_shared<TIDerived>(t);
+            auto d = intr_ptr::dynamic_pointer_cast<TIDerived>(b);
+            BEAST_EXPECT(d && d->value == 42);
+            BEAST_EXPECT(b.use_count() == 2);
+
+            auto s = intr_ptr::static_pointer_cast<TIDerived>(std::move(b));
+            BEAST_EXPECT(!b);
+            BEAST_EXPECT(s.use_count() == 2);
+
+            intr_ptr::SharedPtr<TIBase> base =
+                intr_ptr::make_shared<TIBase>(t);
+            BEAST_EXPECT(!intr_ptr::dynamic_pointer_cast<TIDerived>(base));
+            auto moved =
+                intr_ptr::dynamic_pointer_cast<TIDerived>(std::move(base));
+            BEAST_EXPECT(!moved);
+            // A failed cast leaves the source untouched.
+            BEAST_EXPECT(base && base.use_count() == 1);
+        }
+        BEAST_EXPECT(t.constructed == 2);
+        BEAST_EXPECT(t.destroyed == 2);
+    }
+
+    void
+    testThreads()
+    {
+        testcase("Multithreaded");
+
+        // Race strong releases against weak locks. Every object must be
+        // destroyed exactly once and partially destroyed at most once.
+        Tracker t;
+        constexpr int iterations = 2000;
+        constexpr int numThreads = 4;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto s = intr_ptr::make_shared<TIBase>(t);
+            intr_ptr::WeakPtr<TIBase> w{s};
+            std::atomic<int> locked{0};
+            std::vector<std::thread> threads;
+            threads.reserve(numThreads);
+            for (int j = 0; j < numThreads; ++j)
+            {
+                threads.emplace_back([&, j, s]() mutable {
+                    intr_ptr::WeakPtr<TIBase> local{w};
+                    if (j % 2 == 0)
+                        s.reset();
+                    if (auto l = local.lock())
+                        ++locked;
+                });
+            }
+            s.reset();
+            for (auto& th : threads)
+                th.join();
+        }
+        BEAST_EXPECT(t.constructed == iterations);
+        BEAST_EXPECT(t.destroyed == iterations);
+        BEAST_EXPECT(t.partiallyDestroyed <= iterations);
+    }
+
+    void
+    run() override
+    {
+        testBasics();
+        testWeak();
+        testCasts();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(IntrusiveShared, basics, ripple);
+
+}  // namespace tests
+}  // namespace ripple
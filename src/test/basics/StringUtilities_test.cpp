@@ -305,6 +305,38 @@ public:
         }
     }
 
+    void
+    testHex()
+    {
+        testcase("strHex");
+
+        BEAST_EXPECT(strHex(std::string("RippleD")) == "526970706C6544");
+        BEAST_EXPECT(strHex(Blob{}).empty());
+        BEAST_EXPECT(sqlBlobLiteral(Blob{0x00, 0xab, 0xff}) == "X'00ABFF'");
+        BEAST_EXPECT(sqlBlobLiteral(Blob{}) == "X''");
+
+        // Every byte value, through each of the entry points
+        Blob all(256);
+        for (std::size_t i = 0; i < all.size(); ++i)
+            all[i] = static_cast<std::uint8_t>(i);
+        std::string expected;
+        for (auto const b : all)
+        {
+            expected.push_back("0123456789ABCDEF"[b >> 4]);
+            expected.push_back("0123456789ABCDEF"[b & 0xf]);
+        }
+        BEAST_EXPECT(strHex(all) == expected);
+        BEAST_EXPECT(strHex(makeSlice(all)) == expected);
+        std::string out(2 * all.size(), ' ');
+        strHex(all.data(), all.size(), out.data());
+        BEAST_EXPECT(out == expected);
+        BEAST_EXPECT(strUnHex(expected) == all);
+
+        // Wider elements are encoded a whole element at a time
+        std::vector<std::uint16_t> const wide{0x0102, 0xabcd};
+        BEAST_EXPECT(strHex(wide) == "0102ABCD");
+    }
+
     void
     testToString()
     {
@@ -318,6 +350,7 @@ public:
     {
         testParseUrl();
         testUnHex();
+        testHex();
         testToString();
     }
 };
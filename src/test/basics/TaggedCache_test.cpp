@@ -148,6 +148,50 @@ public:
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
+
+        // Keys are returned from the most to the least recently accessed,
+        // and only as many as were asked for.
+        {
+            BEAST_EXPECT(!c.insert(5, "five"));
+            ++clock;
+            BEAST_EXPECT(!c.insert(6, "six"));
+            ++clock;
+            BEAST_EXPECT(!c.insert(7, "seven"));
+            ++clock;
+            BEAST_EXPECT(c.fetch(5) != nullptr);
+
+            auto const all = c.getRecentKeys(10);
+            BEAST_EXPECT((all == std::vector<Key>{5, 7, 6}));
+            auto const two = c.getRecentKeys(2);
+            BEAST_EXPECT((two == std::vector<Key>{5, 7}));
+            BEAST_EXPECT(c.getRecentKeys(0).empty());
+        }
+
+        // The bytes held follow the objects the cache keeps alive, plus the
+        // entries of the map itself.
+        {
+            Cache b("bytes", 1, 1s, clock, journal);
+            auto const entry = Cache::getEntryOverhead();
+            BEAST_EXPECT(b.getBytes() == 0);
+            BEAST_EXPECT(!b.insert(1, "one"));
+            BEAST_EXPECT(b.getBytes() == sizeof(Value) + entry);
+
+            {
+                auto const p = b.fetch(1);
+                ++clock;
+                b.sweep();
+                // Tracked weakly, the object is not held by the cache
+                BEAST_EXPECT(b.getBytes() == entry);
+                BEAST_EXPECT(b.fetch(1) == p);
+                BEAST_EXPECT(b.getBytes() == sizeof(Value) + entry);
+                BEAST_EXPECT(b.del(1, true));
+                BEAST_EXPECT(b.getBytes() == entry);
+            }
+
+            ++clock;
+            b.sweep();
+            BEAST_EXPECT(b.getBytes() == 0);
+        }
     }
 };
 
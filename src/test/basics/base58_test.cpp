@@ -462,11 +462,45 @@ class base58_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testInvalidChars()
+    {
+        testcase("invalid_chars");
+
+        std::array<std::uint8_t, 20> account{};
+        account.fill(0x5A);
+        auto const address = ripple::b58_ref::encodeBase58Token(
+            ripple::TokenType::AccountID, account.data(), account.size());
+
+        // Every byte outside the alphabet, including those with the high
+        // bit set, must be refused wherever it appears.
+        std::string const alphabet =
+            "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+        for (int b = 0; b < 256; ++b)
+        {
+            if (alphabet.find(static_cast<char>(b)) != std::string::npos)
+                continue;
+
+            for (std::size_t const at : {0u, 1u, 11u})
+            {
+                auto bad = address;
+                bad.insert(bad.begin() + at, static_cast<char>(b));
+                BEAST_EXPECT(ripple::b58_fast::decodeBase58Token(
+                                 bad, ripple::TokenType::AccountID)
+                                 .empty());
+                BEAST_EXPECT(ripple::b58_ref::decodeBase58Token(
+                                 bad, ripple::TokenType::AccountID)
+                                 .empty());
+            }
+        }
+    }
+
     void
     run() override
     {
         testMultiprecision();
         testFastMatchesRef();
+        testInvalidChars();
     }
 };
 
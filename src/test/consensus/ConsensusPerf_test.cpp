@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/csf.h>
+#include <test/csf/random.h>
+#include <xrpl/beast/unit_test.h>
+
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace ripple {
+namespace test {
+
+/** Benchmarks consensus on large simulated networks.
+
+    Runs a network of validators which all trust each other, connected by
+    links with randomized latency, under a constant transaction load. Reports
+    simulated ledger close and validation times, consensus round durations,
+    validation propagation, and the real time spent in the generic
+    Consensus<Adaptor> and Validations code, so that consensus performance can
+    be compared across releases.
+
+    The optional argument is a comma separated list of parameters, e.g.
+    --unittest=ConsensusPerf --unittest-arg=peers=300,duration=600
+
+        peers       Number of validators (200)
+        degree      Random connections made by each peer (10)
+        delay       Mean message latency, in milliseconds (200)
+        jitter      Maximum deviation from the mean latency, in ms (50)
+        txrate      Transactions submitted per second (100)
+        duration    Simulated duration, in seconds (300)
+        seed        Random seed (0)
+*/
+class ConsensusPerf_test : public beast::unit_test::suite
+{
+    struct Params
+    {
+        std::size_t peers = 200;
+        std::size_t degree = 10;
+        std::chrono::milliseconds delay{200};
+        std::chrono::milliseconds jitter{50};
+        std::size_t txrate = 100;
+        std::chrono::seconds duration{300};
+        std::uint64_t seed = 0;
+    };
+
+    Params
+    parseParams(std::string const& args)
+    {
+        std::map<std::string, std::uint64_t> values;
+        std::stringstream ss(args);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            auto const pos = item.find('=');
+            if (pos == std::string::npos)
+            {
+                fail("Invalid parameter: " + item);
+                continue;
+            }
+            values[item.substr(0, pos)] = std::stoull(item.substr(pos + 1));
+        }
+
+        Params params;
+        auto set = [&](std::string const& name, auto& field) {
+            if (auto const it = values.find(name); it != values.end())
+            {
+                field = std::remove_reference_t<decltype(field)>(it->second);
+                values.erase(it);
+            }
+        };
+        set("peers", params.peers);
+        set("degree", params.degree);
+        set("delay", params.delay);
+        set("jitter", params.jitter);
+        set("txrate", params.txrate);
+        set("duration", params.duration);
+        set("seed", params.seed);
+
+        for (auto const& [name, value] : values)
+            fail("Unknown parameter: " + name);
+
+        return params;
+    }
+
+    void
+    run() override
+    {
+        using namespace csf;
+        using namespace std::chrono;
+
+        Params const params = parseParams(arg());
+        if (!BEAST_EXPECT(params.peers > 1 && params.jitter <= params.delay))
+            return;
+
+        testcase(
+            "Consensus performance: " + std::to_string(params.peers) +
+            " peers");
+
+        Sim sim;
+        sim.rng.seed(params.seed);
+
+        PeerGroup network = sim.createGroup(params.peers);
+        network.trust(network);
+
+        // Connect peers in a ring, so the network is connected, then add
+        // random links. Each link gets its own latency.
+        std::uniform_int_distribution<std::int64_t> latency(
+            (params.delay - params.jitter).count(),
+            (params.delay + params.jitter).count());
+        std::uniform_int_distribution<std::size_t> pick(0, params.peers - 1);
+        auto const connect = [&](Peer* from, Peer* to) {
+            if (from != to)
+                from->connect(*to, milliseconds(latency(sim.rng)));
+        };
+        for (std::size_t i = 0; i < network.size(); ++i)
+        {
+            connect(network[i], network[(i + 1) % network.size()]);
+            for (std::size_t d = 1; d < params.degree; ++d)
+                connect(network[i], network[pick(sim.rng)]);
+        }
+
+        TxCollector txCollector;
+        LedgerCollector ledgerCollector;
+        RoundCollector roundCollector;
+        ValidationCollector validationCollector(params.peers);
+        auto colls = makeCollectors(
+            txCollector, ledgerCollector, roundCollector, validationCollector);
+        sim.collectors.add(colls);
+
+        // Initial round to set prior state
+        sim.run(1);
+
+        std::chrono::nanoseconds const simDuration = params.duration;
+        std::chrono::nanoseconds const quiet = 10s;
+        Rate const rate{params.txrate, 1000ms};
+
+        std::vector<double> const weights(network.size(), 1.0);
+        auto peerSelector =
+            makeSelector(network.begin(), network.end(), weights, sim.rng);
+        auto txSubmitter = makeSubmitter(
+            ConstantDistribution{rate.inv()},
+            sim.scheduler.now() + quiet,
+            sim.scheduler.now() + (simDuration - quiet),
+            peerSelector,
+            sim.scheduler,
+            sim.rng);
+
+        auto const start = steady_clock::now();
+        sim.run(simDuration);
+        auto const elapsed = steady_clock::now() - start;
+
+        BEAST_EXPECT(sim.branches() == 1);
+        BEAST_EXPECT(sim.synchronized());
+
+        Peer::ProcessingTime::clock_type::duration consensusTime{0};
+        Peer::ProcessingTime::clock_type::duration validationsTime{0};
+        for (Peer const* peer : network)
+        {
+            consensusTime += peer->processingTime.consensus.total;
+            validationsTime += peer->processingTime.validations.total;
+        }
+
+        auto const fmtMs = [](auto dur) {
+            return duration_cast<duration<double, std::milli>>(dur).count();
+        };
+        auto const perLedger = [&](auto dur) {
+            auto const ledgers = ledgerCollector.accepted;
+            return ledgers == 0 ? 0.0 : fmtMs(dur) / ledgers;
+        };
+
+        log << std::fixed << std::setprecision(2);
+        log << "Peers: " << network.size() << ", links per peer: "
+            << params.degree << ", latency: " << params.delay.count() << "+/-"
+            << params.jitter.count() << " ms, load: " << params.txrate
+            << " tx/s" << std::endl;
+        log << "Simulated duration: "
+            << duration_cast<seconds>(simDuration).count()
+            << " s, real time: " << fmtMs(elapsed) << " ms" << std::endl;
+        log << "Branches: " << sim.branches()
+            << ", synchronized: " << (sim.synchronized() ? "Y" : "N")
+            << std::endl;
+        log << "Consensus<Adaptor>: " << fmtMs(consensusTime) << " ms total, "
+            << perLedger(consensusTime) << " ms per ledger" << std::endl;
+        log << "Validations: " << fmtMs(validationsTime) << " ms total, "
+            << perLedger(validationsTime) << " ms per ledger" << std::endl;
+        log << std::endl;
+
+        txCollector.report(simDuration, log);
+        ledgerCollector.report(simDuration, log);
+        roundCollector.report(simDuration, log);
+        validationCollector.report(simDuration, log);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(ConsensusPerf, consensus, ripple, 80);
+
+}  // namespace test
+}  // namespace ripple
@@ -33,6 +33,8 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
 #include <algorithm>
+#include <chrono>
+#include <optional>
 
 namespace ripple {
 namespace test {
@@ -110,6 +112,58 @@ struct Peer
         }
     };
 
+    /** Real (not simulated) time spent in the generic consensus code.
+
+        Accumulated around calls from the peer into Consensus<Peer> and
+        Validations<ValAdaptor>, so simulations can track the cost of that
+        code as the network grows. Consensus calls back into the peer, so the
+        consensus time includes any validation work done in those callbacks.
+    */
+    struct ProcessingTime
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        struct Counter
+        {
+            clock_type::duration total{0};
+            bool active = false;
+        };
+
+        Counter consensus;
+        Counter validations;
+
+        //! Adds the real time spent in its scope to a counter, unless the
+        //! scope is nested within another for the same counter.
+        class Scope
+        {
+            Counter& counter_;
+            std::optional<clock_type::time_point> start_;
+
+        public:
+            explicit Scope(Counter& counter) : counter_(counter)
+            {
+                if (!counter_.active)
+                {
+                    counter_.active = true;
+                    start_ = clock_type::now();
+                }
+            }
+
+            Scope(Scope const&) = delete;
+            Scope&
+            operator=(Scope const&) = delete;
+
+            ~Scope()
+            {
+                if (start_)
+                {
+                    counter_.total += clock_type::now() - *start_;
+                    counter_.active = false;
+                }
+            }
+        };
+    };
+
     /** Generic Validations adaptor that simply ignores recently stale
      * validations
      */
@@ -229,6 +283,9 @@ struct Peer
     //! Simulated delays to use for internal processing
     ProcessingDelays delays;
 
+    //! Real time spent processing in consensus and validations
+    ProcessingTime processingTime;
+
     //! Whether to simulate running as validator or a tracking node
     bool runAsValidator = true;
 
@@ -483,12 +540,14 @@ struct Peer
     std::size_t
     proposersValidated(Ledger::ID const& prevLedger)
     {
+        ProcessingTime::Scope _(processingTime.validations);
         return validations.numTrustedForLedger(prevLedger);
     }
 
     std::size_t
     proposersFinished(Ledger const& prevLedger, Ledger::ID const& prevLedgerID)
     {
+        ProcessingTime::Scope _(processingTime.validations);
         return validations.getNodesAfter(prevLedger, prevLedgerID);
     }
 
@@ -619,8 +678,10 @@ struct Peer
         if (ledger.seq() == Ledger::Seq{0})
             return ledgerID;
 
-        Ledger::ID const netLgr =
-            validations.getPreferred(ledger, earliestAllowedSeq());
+        Ledger::ID const netLgr = [&]() {
+            ProcessingTime::Scope _(processingTime.validations);
+            return validations.getPreferred(ledger, earliestAllowedSeq());
+        }();
 
         if (netLgr != ledgerID)
         {
@@ -674,7 +735,10 @@ struct Peer
     {
         v.setTrusted();
         v.setSeen(now());
-        ValStatus const res = validations.add(v.nodeID(), v);
+        ValStatus const res = [&]() {
+            ProcessingTime::Scope _(processingTime.validations);
+            return validations.add(v.nodeID(), v);
+        }();
 
         if (res == ValStatus::stale)
             return false;
@@ -693,7 +757,10 @@ struct Peer
         if (ledger.seq() <= fullyValidatedLedger.seq())
             return;
 
-        std::size_t const count = validations.numTrustedForLedger(ledger.id());
+        std::size_t const count = [&]() {
+            ProcessingTime::Scope _(processingTime.validations);
+            return validations.numTrustedForLedger(ledger.id());
+        }();
         std::size_t const numTrustedPeers = trustGraph.graph().outDegree(this);
         quorum = static_cast<std::size_t>(std::ceil(numTrustedPeers * 0.8));
         if (count >= quorum && ledger.isAncestor(fullyValidatedLedger))
@@ -796,6 +863,7 @@ struct Peer
         dest.push_back(p);
 
         // Rely on consensus to decide whether to relay
+        ProcessingTime::Scope _(processingTime.consensus);
         return consensus.peerProposal(now(), Position{p});
     }
 
@@ -805,7 +873,10 @@ struct Peer
         bool const inserted =
             txSets.insert(std::make_pair(txs.id(), txs)).second;
         if (inserted)
+        {
+            ProcessingTime::Scope _(processingTime.consensus);
             consensus.gotTxSet(now(), txs);
+        }
         // relay only if new
         return inserted;
     }
@@ -888,7 +959,10 @@ struct Peer
     void
     timerEntry()
     {
-        consensus.timerEntry(now());
+        {
+            ProcessingTime::Scope _(processingTime.consensus);
+            consensus.timerEntry(now());
+        }
         // only reschedule if not completed
         if (completedLedgers < targetLedgers)
             scheduler.in(parms().ledgerGRANULARITY, [this]() { timerEntry(); });
@@ -901,8 +975,11 @@ struct Peer
         // Between rounds, we take the majority ledger
         // In the future, consider taking peer dominant ledger if no validations
         // yet
-        Ledger::ID bestLCL =
-            validations.getPreferred(lastClosedLedger, earliestAllowedSeq());
+        Ledger::ID bestLCL = [&]() {
+            ProcessingTime::Scope _(processingTime.validations);
+            return validations.getPreferred(
+                lastClosedLedger, earliestAllowedSeq());
+        }();
         if (bestLCL == Ledger::ID{0})
             bestLCL = lastClosedLedger.id();
 
@@ -910,6 +987,7 @@ struct Peer
 
         // Not yet modeling dynamic UNL.
         hash_set<PeerID> nowUntrusted;
+        ProcessingTime::Scope _(processingTime.consensus);
         consensus.startRound(
             now(), bestLCL, lastClosedLedger, nowUntrusted, runAsValidator);
     }
@@ -28,6 +28,8 @@
 #include <optional>
 #include <ostream>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -638,6 +640,256 @@ struct LedgerCollector
     }
 };
 
+/** Tracks the duration of each peer's consensus rounds.
+
+    A round starts when a peer calls startRound and ends when it accepts the
+    resulting ledger. The open phase ends when the peer closes its open ledger,
+    after which it establishes consensus with its peers.
+*/
+struct RoundCollector
+{
+    struct Tracker
+    {
+        SimTime start;
+        std::optional<SimTime> close;
+    };
+
+    hash_map<PeerID, Tracker> rounds_;
+
+    std::size_t completed{0};
+
+    using Hist = Histogram<SimTime::duration>;
+    Hist openPhase;
+    Hist establishPhase;
+    Hist roundDuration;
+
+    // Ignore most events by default
+    template <class E>
+    void
+    on(PeerID, SimTime, E const& e)
+    {
+    }
+
+    void
+    on(PeerID who, SimTime when, StartRound const&)
+    {
+        rounds_[who] = Tracker{when, std::nullopt};
+    }
+
+    void
+    on(PeerID who, SimTime when, CloseLedger const&)
+    {
+        auto const it = rounds_.find(who);
+        if (it != rounds_.end() && !it->second.close)
+        {
+            it->second.close = when;
+            openPhase.insert(when - it->second.start);
+        }
+    }
+
+    void
+    on(PeerID who, SimTime when, AcceptLedger const&)
+    {
+        auto const it = rounds_.find(who);
+        if (it == rounds_.end())
+            return;
+
+        ++completed;
+        roundDuration.insert(when - it->second.start);
+        if (it->second.close)
+            establishPhase.insert(when - *it->second.close);
+        rounds_.erase(it);
+    }
+
+    template <class T>
+    void
+    report(SimDuration simDuration, T& log, bool printBreakline = false)
+    {
+        using namespace std::chrono;
+        auto perSec = [&simDuration](std::size_t count) {
+            return double(count) / duration_cast<seconds>(simDuration).count();
+        };
+
+        auto fmtS = [](SimDuration dur) {
+            return duration_cast<duration<float>>(dur).count();
+        };
+
+        auto row = [&](char const* name, Hist const& h) {
+            log << std::left << std::setw(11) << name << "|" << std::right
+                << std::setw(7) << h.size() << "|" << std::setw(7)
+                << std::setprecision(2) << perSec(h.size()) << "|"
+                << std::setw(15) << " " << std::setw(7) << std::setprecision(2)
+                << fmtS(h.percentile(0.1f)) << std::setw(7)
+                << std::setprecision(2) << fmtS(h.percentile(0.5f))
+                << std::setw(7) << std::setprecision(2)
+                << fmtS(h.percentile(0.9f)) << std::endl;
+        };
+
+        if (printBreakline)
+        {
+            log << std::setw(11) << std::setfill('-') << "-" << "-"
+                << std::setw(7) << std::setfill('-') << "-" << "-"
+                << std::setw(7) << std::setfill('-') << "-" << "-"
+                << std::setw(36) << std::setfill('-') << "-" << std::endl;
+            log << std::setfill(' ');
+        }
+
+        log << std::left << std::setw(11) << "RoundStats" << "|"
+            << std::setw(7) << "Count" << "|" << std::setw(7) << "Per Sec"
+            << "|" << std::setw(15) << "Duration (sec)" << std::right
+            << std::setw(7) << "10-ile" << std::setw(7) << "50-ile"
+            << std::setw(7) << "90-ile" << std::left << std::endl;
+
+        log << std::setw(11) << std::setfill('-') << "-" << "|" << std::setw(7)
+            << std::setfill('-') << "-" << "|" << std::setw(7)
+            << std::setfill('-') << "-" << "|" << std::setw(36)
+            << std::setfill('-') << "-" << std::endl;
+        log << std::setfill(' ');
+
+        row("Open", openPhase);
+        row("Establish", establishPhase);
+        row("Round", roundDuration);
+
+        log << std::setw(11) << std::setfill('-') << "-" << "-" << std::setw(7)
+            << std::setfill('-') << "-" << "-" << std::setw(7)
+            << std::setfill('-') << "-" << "-" << std::setw(36)
+            << std::setfill('-') << "-" << std::endl;
+        log << std::setfill(' ');
+    }
+};
+
+/** Tracks how quickly validations propagate through the network.
+
+    Measures the time from when a validator shares a validation until each
+    other peer first receives it, and until every other peer has received it.
+    The number of peers must be provided so that full propagation can be
+    detected.
+*/
+struct ValidationCollector
+{
+    struct Tracker
+    {
+        SimTime shared;
+        std::vector<bool> received;
+        std::size_t count{0};
+    };
+
+    std::size_t const numPeers;
+
+    hash_map<std::pair<PeerID, Ledger::ID>, Tracker> validations_;
+
+    std::size_t shared{0};
+    std::size_t fullyPropagated{0};
+
+    using Hist = Histogram<SimTime::duration>;
+    Hist toPeer;
+    Hist toAll;
+
+    explicit ValidationCollector(std::size_t peers) : numPeers{peers}
+    {
+    }
+
+    // Ignore most events by default
+    template <class E>
+    void
+    on(PeerID, SimTime, E const& e)
+    {
+    }
+
+    void
+    on(PeerID who, SimTime when, Share<Validation> const& e)
+    {
+        if (validations_
+                .emplace(
+                    std::make_pair(e.val.nodeID(), e.val.ledgerID()),
+                    Tracker{when, std::vector<bool>(numPeers, false), 0})
+                .second)
+            ++shared;
+    }
+
+    void
+    on(PeerID who, SimTime when, Receive<Validation> const& e)
+    {
+        auto const it = validations_.find(
+            std::make_pair(e.val.nodeID(), e.val.ledgerID()));
+        auto const index = static_cast<std::uint32_t>(who);
+        if (it == validations_.end() || index >= numPeers)
+            return;
+
+        auto& tracker = it->second;
+        if (tracker.received[index])
+            return;
+
+        tracker.received[index] = true;
+        toPeer.insert(when - tracker.shared);
+
+        // Every peer other than the origin has it
+        if (++tracker.count + 1 == numPeers)
+        {
+            ++fullyPropagated;
+            toAll.insert(when - tracker.shared);
+            validations_.erase(it);
+        }
+    }
+
+    template <class T>
+    void
+    report(SimDuration simDuration, T& log, bool printBreakline = false)
+    {
+        using namespace std::chrono;
+        auto perSec = [&simDuration](std::size_t count) {
+            return double(count) / duration_cast<seconds>(simDuration).count();
+        };
+
+        auto fmtMs = [](SimDuration dur) {
+            return duration_cast<milliseconds>(dur).count();
+        };
+
+        if (printBreakline)
+        {
+            log << std::setw(11) << std::setfill('-') << "-" << "-"
+                << std::setw(7) << std::setfill('-') << "-" << "-"
+                << std::setw(7) << std::setfill('-') << "-" << "-"
+                << std::setw(36) << std::setfill('-') << "-" << std::endl;
+            log << std::setfill(' ');
+        }
+
+        log << std::left << std::setw(11) << "ValStats" << "|" << std::setw(7)
+            << "Count" << "|" << std::setw(7) << "Per Sec" << "|"
+            << std::setw(15) << "Latency (ms)" << std::right << std::setw(7)
+            << "10-ile" << std::setw(7) << "50-ile" << std::setw(7)
+            << "90-ile" << std::left << std::endl;
+
+        log << std::setw(11) << std::setfill('-') << "-" << "|" << std::setw(7)
+            << std::setfill('-') << "-" << "|" << std::setw(7)
+            << std::setfill('-') << "-" << "|" << std::setw(36)
+            << std::setfill('-') << "-" << std::endl;
+        log << std::setfill(' ');
+
+        log << std::left << std::setw(11) << "Shared " << "|" << std::right
+            << std::setw(7) << shared << "|" << std::setw(7)
+            << std::setprecision(2) << perSec(shared) << "|" << std::setw(15)
+            << std::left << "To Peer" << std::right << std::setw(7)
+            << fmtMs(toPeer.percentile(0.1f)) << std::setw(7)
+            << fmtMs(toPeer.percentile(0.5f)) << std::setw(7)
+            << fmtMs(toPeer.percentile(0.9f)) << std::endl;
+
+        log << std::left << std::setw(11) << "Propagated " << "|"
+            << std::right << std::setw(7) << fullyPropagated << "|"
+            << std::setw(7) << std::setprecision(2) << perSec(fullyPropagated)
+            << "|" << std::setw(15) << std::left << "To All" << std::right
+            << std::setw(7) << fmtMs(toAll.percentile(0.1f)) << std::setw(7)
+            << fmtMs(toAll.percentile(0.5f)) << std::setw(7)
+            << fmtMs(toAll.percentile(0.9f)) << std::endl;
+
+        log << std::setw(11) << std::setfill('-') << "-" << "-" << std::setw(7)
+            << std::setfill('-') << "-" << "-" << std::setw(7)
+            << std::setfill('-') << "-" << "-" << std::setw(36)
+            << std::setfill('-') << "-" << std::endl;
+        log << std::setfill(' ');
+    }
+};
+
 /** Write out stream of ledger activity
 
     Writes information about every accepted and fully-validated ledger to a
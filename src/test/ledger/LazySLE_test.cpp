@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/ledger/LazySLE.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/LedgerFormats.h>
+#include <xrpl/protocol/STArray.h>
+#include <xrpl/protocol/STIssue.h>
+#include <xrpl/protocol/UintTypes.h>
+
+namespace ripple {
+namespace test {
+
+class LazySLE_test : public beast::unit_test::suite
+{
+    static LazySLE
+    serialized(SLE const& sle)
+    {
+        Serializer s;
+        sle.add(s);
+        return LazySLE(make_shamapitem(sle.key(), s.slice()));
+    }
+
+    // Check a lazy entry both over the serialized bytes and wrapping the
+    // deserialized entry.
+    template <class F>
+    void
+    check(SLE const& sle, F const& f)
+    {
+        auto const lazy = serialized(sle);
+        BEAST_EXPECT(lazy.key() == sle.key());
+        BEAST_EXPECT(lazy.getType() == sle.getType());
+        BEAST_EXPECT(*lazy.decode() == sle);
+        BEAST_EXPECT(
+            lazy.getJson(JsonOptions::none) == sle.getJson(JsonOptions::none));
+        f(lazy);
+
+        auto const wrapped = LazySLE(std::make_shared<SLE const>(sle));
+        BEAST_EXPECT(wrapped.key() == sle.key());
+        BEAST_EXPECT(wrapped.getType() == sle.getType());
+        f(wrapped);
+    }
+
+    void
+    testAccountRoot()
+    {
+        testcase("AccountRoot");
+
+        AccountID const alice{1};
+        SLE sle(keylet::account(alice));
+        sle.setAccountID(sfAccount, alice);
+        sle.setFieldAmount(sfBalance, STAmount(XRPAmount{123456789}));
+        sle.setFieldU32(sfSequence, 42);
+        sle.setFieldU32(sfOwnerCount, 3);
+        sle.setFieldU32(sfFlags, lsfRequireAuth | lsfDefaultRipple);
+        sle.setFieldU32(sfTransferRate, 1'005'000'000);
+
+        check(sle, [&](LazySLE const& lazy) {
+            BEAST_EXPECT(lazy.getAccountID(sfAccount) == alice);
+            BEAST_EXPECT(
+                lazy.getFieldAmount(sfBalance) == XRPAmount{123456789});
+            BEAST_EXPECT(lazy.getFieldU32(sfSequence) == 42);
+            BEAST_EXPECT(lazy[sfOwnerCount] == 3);
+            BEAST_EXPECT(lazy.isFlag(lsfRequireAuth));
+            BEAST_EXPECT(!lazy.isFlag(lsfGlobalFreeze));
+            BEAST_EXPECT(lazy.isFieldPresent(sfTransferRate));
+            BEAST_EXPECT(lazy[~sfTransferRate] == 1'005'000'000);
+
+            // Absent optional fields
+            BEAST_EXPECT(!lazy.isFieldPresent(sfDomain));
+            BEAST_EXPECT(!lazy[~sfDomain]);
+            BEAST_EXPECT(lazy.getFieldU32(sfTicketCount) == 0);
+            BEAST_EXPECT(lazy.getFieldH256(sfAMMID) == beast::zero);
+            try
+            {
+                (void)lazy[sfDomain];
+                fail("Missing optional field should throw");
+            }
+            catch (STObject::FieldErr const&)
+            {
+                pass();
+            }
+
+            // Fields that an AccountRoot cannot have
+            BEAST_EXPECT(!lazy.isFieldPresent(sfLowLimit));
+            BEAST_EXPECT(!lazy[~sfLowQualityIn]);
+            try
+            {
+                (void)lazy.getFieldU32(sfLowQualityIn);
+                fail("Field outside the template should throw");
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        });
+    }
+
+    void
+    testRippleState()
+    {
+        testcase("RippleState");
+
+        AccountID const low{1};
+        AccountID const high{2};
+        Currency const usd = to_currency("USD");
+
+        SLE sle(keylet::line(low, high, usd));
+        sle.setFieldAmount(sfBalance, STAmount(Issue{usd, noAccount()}, -5));
+        sle.setFieldAmount(sfLowLimit, STAmount(Issue{usd, low}, 100));
+        sle.setFieldAmount(sfHighLimit, STAmount(Issue{usd, high}, 0));
+        sle.setFieldU64(sfLowNode, 7);
+        sle.setFieldU64(sfHighNode, 0x1'0000'0000ull);
+        sle.setFieldU32(sfFlags, lsfLowReserve | lsfHighFreeze);
+        sle.setFieldU32(sfLowQualityIn, 990'000'000);
+
+        check(sle, [&](LazySLE const& lazy) {
+            auto const balance = sle.getFieldAmount(sfBalance);
+            BEAST_EXPECT(lazy.getFieldAmount(sfBalance) == balance);
+            BEAST_EXPECT(lazy.getFieldAmount(sfLowLimit).getIssuer() == low);
+            BEAST_EXPECT(lazy.getFieldAmount(sfHighLimit).getIssuer() == high);
+            BEAST_EXPECT(lazy[sfLowNode] == 7);
+            BEAST_EXPECT(lazy.getFieldU64(sfHighNode) == 0x1'0000'0000ull);
+            BEAST_EXPECT(lazy.isFlag(lsfHighFreeze));
+            BEAST_EXPECT(lazy.getFieldU32(sfLowQualityIn) == 990'000'000);
+            BEAST_EXPECT(lazy.getFieldU32(sfHighQualityOut) == 0);
+        });
+    }
+
+    void
+    testDirectory()
+    {
+        testcase("DirectoryNode");
+
+        AccountID const alice{1};
+        SLE sle(keylet::ownerDir(alice));
+        STVector256 indexes;
+        for (int i = 1; i <= 3; ++i)
+            indexes.push_back(uint256{static_cast<std::uint64_t>(i)});
+        sle.setFieldV256(sfIndexes, indexes);
+        sle.setAccountID(sfOwner, alice);
+        sle.setFieldH256(sfRootIndex, sle.key());
+
+        check(sle, [&](LazySLE const& lazy) {
+            BEAST_EXPECT(lazy.getFieldV256(sfIndexes) == indexes);
+            BEAST_EXPECT(lazy.getFieldU64(sfIndexNext) == 0);
+            BEAST_EXPECT(!lazy[~sfIndexPrevious]);
+            BEAST_EXPECT(lazy.getFieldH256(sfRootIndex) == sle.key());
+        });
+    }
+
+    void
+    testNestedFields()
+    {
+        // Arrays and issues are skipped by deserializing them, and the
+        // fields that follow must still be found.
+        testcase("Nested fields");
+
+        AccountID const amm{3};
+        AccountID const voter{4};
+        Issue const usd{to_currency("USD"), AccountID{5}};
+
+        SLE sle(keylet::amm(xrpIssue(), usd));
+        sle.setAccountID(sfAccount, amm);
+        sle.setFieldU16(sfTradingFee, 250);
+        sle.setFieldAmount(sfLPTokenBalance, STAmount(Issue{usd}, 10));
+        sle.setFieldIssue(sfAsset, STIssue{sfAsset, xrpIssue()});
+        sle.setFieldIssue(sfAsset2, STIssue{sfAsset2, usd});
+        sle.setFieldU64(sfOwnerNode, 9);
+
+        STObject vote(sfVoteEntry);
+        vote.setAccountID(sfAccount, voter);
+        vote.setFieldU16(sfTradingFee, 300);
+        vote.setFieldU32(sfVoteWeight, 100'000);
+        STArray votes(sfVoteSlots, 1);
+        votes.push_back(std::move(vote));
+        sle.setFieldArray(sfVoteSlots, votes);
+
+        check(sle, [&](LazySLE const& lazy) {
+            BEAST_EXPECT(lazy.getAccountID(sfAccount) == amm);
+            BEAST_EXPECT(lazy.getFieldU16(sfTradingFee) == 250);
+            BEAST_EXPECT(lazy.isFieldPresent(sfVoteSlots));
+            BEAST_EXPECT(!lazy.isFieldPresent(sfAuctionSlot));
+            BEAST_EXPECT(lazy[sfAsset] == xrpIssue());
+            BEAST_EXPECT(lazy[sfAsset2] == usd);
+            BEAST_EXPECT(lazy.getFieldU64(sfOwnerNode) == 9);
+        });
+    }
+
+public:
+    void
+    run() override
+    {
+        testAccountRoot();
+        testRippleState();
+        testDirectory();
+        testNestedFields();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LazySLE, ledger, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -655,6 +655,15 @@ public:
                 fetchCopyOfBatch(*db, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
+
+            {
+                // Write another batch with one call and read it back
+                auto const more = createPredictableBatch(numObjsToTest, rng());
+                db->storeBatch(more, db->earliestLedgerSeq());
+                Batch copy;
+                fetchCopyOfBatch(*db, &copy, more);
+                BEAST_EXPECT(areBatchesEqual(more, copy));
+            }
         }
 
         if (testPersistence)
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/jtx.h>
+#include <xrpld/core/JobQueue.h>
+#include <xrpld/overlay/detail/Tuning.h>
+#include <xrpld/overlay/detail/ValidationIngest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class ValidationIngest_test : public beast::unit_test::suite
+{
+    // An ingest that counts the validations it checks instead of checking
+    // them, and that can be held so that they pile up.
+    class TestIngest : public ValidationIngest
+    {
+    public:
+        using ValidationIngest::ValidationIngest;
+
+        void
+        hold()
+        {
+            std::lock_guard lock(checkMutex_);
+            held_ = true;
+        }
+
+        void
+        release()
+        {
+            {
+                std::lock_guard lock(checkMutex_);
+                held_ = false;
+            }
+            cv_.notify_all();
+        }
+
+        std::size_t
+        checked() const
+        {
+            std::lock_guard lock(checkMutex_);
+            return checked_;
+        }
+
+    protected:
+        void
+        check(Item const&) override
+        {
+            std::unique_lock lock(checkMutex_);
+            cv_.wait(lock, [this] { return !held_; });
+            ++checked_;
+        }
+
+    private:
+        mutable std::mutex checkMutex_;
+        std::condition_variable cv_;
+        bool held_ = false;
+        std::size_t checked_ = 0;
+    };
+
+    template <class Pred>
+    bool
+    waitFor(Pred pred)
+    {
+        using namespace std::chrono_literals;
+        auto const until = std::chrono::steady_clock::now() + 30s;
+        while (!pred())
+        {
+            if (std::chrono::steady_clock::now() > until)
+                return false;
+            std::this_thread::sleep_for(10ms);
+        }
+        return true;
+    }
+
+    void
+    testBound()
+    {
+        testcase("Bounded queue");
+
+        jtx::Env env(*this);
+        TestIngest ingest(
+            env.app().getJobQueue(),
+            jtVALIDATION_t,
+            "Trusted validation",
+            env.journal);
+
+        // While the checks are held, each job takes at most one batch, and
+        // the rest waits until the queue is full.
+        std::size_t const limit = Tuning::maxPendingValidations;
+        std::size_t const taken =
+            Tuning::maxValidationJobs * Tuning::validationBatchSize;
+        ingest.hold();
+        std::size_t accepted = 0;
+        for (std::size_t i = 0; i < 2 * limit; ++i)
+        {
+            if (ingest.add({}))
+                ++accepted;
+        }
+        BEAST_EXPECT(accepted >= limit);
+        BEAST_EXPECT(accepted <= limit + taken);
+        BEAST_EXPECT(ingest.size() <= limit);
+
+        // Once released, everything accepted is checked
+        ingest.release();
+        BEAST_EXPECT(waitFor([&] {
+            return ingest.checked() == accepted && ingest.size() == 0;
+        }));
+
+        // and there is room again
+        BEAST_EXPECT(ingest.add({}));
+        BEAST_EXPECT(
+            waitFor([&] { return ingest.checked() == accepted + 1; }));
+
+        // Let the last job finish before the ingest goes away
+        env.app().getJobQueue().stop();
+    }
+
+    void
+    testStopped()
+    {
+        testcase("Stopped job queue");
+
+        jtx::Env env(*this);
+        TestIngest ingest(
+            env.app().getJobQueue(),
+            jtVALIDATION_ut,
+            "Untrusted validation",
+            env.journal);
+
+        // Without a job to take them, validations are dropped rather than
+        // left waiting.
+        env.app().getJobQueue().stop();
+        BEAST_EXPECT(!ingest.add({}));
+        BEAST_EXPECT(ingest.size() == 0);
+        BEAST_EXPECT(!ingest.add({}));
+        BEAST_EXPECT(ingest.size() == 0);
+        BEAST_EXPECT(ingest.checked() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testBound();
+        testStopped();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ValidationIngest, overlay, ripple);
+
+}  // namespace test
+}  // namespace ripple
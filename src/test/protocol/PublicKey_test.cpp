@@ -459,12 +459,58 @@ public:
         BEAST_EXPECT(pk1 == pk3);
     }
 
+    void
+    testDecodedKeyCache()
+    {
+        testcase("Decoded key cache");
+
+        auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
+        auto const [otherPk, otherSk] = randomKeyPair(KeyType::secp256k1);
+        std::string const message = "the message";
+        auto const sig = sign(pk, sk, makeSlice(message));
+
+        // The second check of a signature by the same key finds the
+        // decoded key in the cache.
+        auto const before = getPublicKeyCacheCounts();
+        BEAST_EXPECT(verify(pk, makeSlice(message), sig));
+        auto const first = getPublicKeyCacheCounts();
+        BEAST_EXPECT(
+            first.hits + first.misses == before.hits + before.misses + 1);
+        BEAST_EXPECT(verify(pk, makeSlice(message), sig));
+        auto const second = getPublicKeyCacheCounts();
+        BEAST_EXPECT(second.hits == first.hits + 1);
+        BEAST_EXPECT(second.misses == first.misses);
+
+        // A cached key still only verifies its own signatures
+        BEAST_EXPECT(verify(otherPk, makeSlice(message), sig) == false);
+        BEAST_EXPECT(verify(otherPk, makeSlice(message), sig) == false);
+        BEAST_EXPECT(verify(pk, makeSlice(message + "!"), sig) == false);
+        BEAST_EXPECT(
+            verify(
+                otherPk,
+                makeSlice(message),
+                sign(otherPk, otherSk, makeSlice(message))) == true);
+
+        // A key that is not a point on the curve is never cached
+        std::array<std::uint8_t, 33> bad;
+        bad.fill(0xFF);
+        bad[0] = 0x02;
+        PublicKey const badPk(makeSlice(bad));
+        auto const badBefore = getPublicKeyCacheCounts();
+        BEAST_EXPECT(verify(badPk, makeSlice(message), sig) == false);
+        BEAST_EXPECT(verify(badPk, makeSlice(message), sig) == false);
+        auto const badAfter = getPublicKeyCacheCounts();
+        BEAST_EXPECT(badAfter.hits == badBefore.hits);
+        BEAST_EXPECT(badAfter.misses == badBefore.misses + 2);
+    }
+
     void
     run() override
     {
         testBase58();
         testCanonical();
         testMiscOperations();
+        testDecodedKeyCache();
     }
 };
 
@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/beast/utility/rngfill.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STTx.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace ripple {
+
+class SField_test : public beast::unit_test::suite
+{
+    void
+    testLookupByCode()
+    {
+        testcase("lookup by code");
+
+        for (auto const& [code, f] : SField::getKnownCodeToField())
+        {
+            BEAST_EXPECT(&SField::getField(code) == f);
+            if (code > 0)
+                BEAST_EXPECT(
+                    &SField::getField(f->fieldType, f->fieldValue) == f);
+        }
+
+        BEAST_EXPECT(&SField::getField(0) == &sfGeneric);
+        BEAST_EXPECT(SField::getField(-1).isInvalid());
+        BEAST_EXPECT(SField::getField(STI_UINT32, 255).isInvalid());
+        BEAST_EXPECT(SField::getField(STI_UINT32, 256).isInvalid());
+        BEAST_EXPECT(SField::getField(31, 1).isInvalid());
+        BEAST_EXPECT(SField::getField(32, 1).isInvalid());
+        BEAST_EXPECT(SField::getField(STI_ACCOUNT, 1) == sfAccount);
+        BEAST_EXPECT(SField::getField(STI_UINT256, 257).getName() == "hash");
+        BEAST_EXPECT(SField::getField(STI_TRANSACTION, 257) == sfTransaction);
+    }
+
+    void
+    testLookupByName()
+    {
+        testcase("lookup by name");
+
+        for (auto const& [code, f] : SField::getKnownCodeToField())
+        {
+            if (code > 0)
+                BEAST_EXPECT(&SField::getField(f->fieldName) == f);
+        }
+
+        BEAST_EXPECT(SField::getField("Account") == sfAccount);
+        BEAST_EXPECT(
+            SField::getField("hash").getCode() == field_code(STI_UINT256, 257));
+        BEAST_EXPECT(SField::getField("").isInvalid());
+        BEAST_EXPECT(SField::getField("account").isInvalid());
+        BEAST_EXPECT(SField::getField("Accounts").isInvalid());
+        BEAST_EXPECT(SField::getField("Accoun").isInvalid());
+        BEAST_EXPECT(SField::getField("NoSuchField").isInvalid());
+        BEAST_EXPECT(
+            SField::getField(std::string("Account\0", 8)).isInvalid());
+    }
+
+public:
+    void
+    run() override
+    {
+        testLookupByCode();
+        testLookupByName();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SField, protocol, ripple);
+
+//------------------------------------------------------------------------------
+
+// A benchmark of field lookups, and of deserializing a ledger's worth of
+// transactions, which looks up the field of every value it reads. The map
+// lookup and linear name search are what SField used before its tables.
+class SFieldPerf_test : public beast::unit_test::suite
+{
+    using clock = std::chrono::steady_clock;
+
+    template <class F>
+    static std::chrono::nanoseconds
+    time(std::size_t count, F&& f)
+    {
+        auto const start = clock::now();
+        f();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   clock::now() - start) /
+            count;
+    }
+
+    static std::vector<Blob>
+    makeTxSet(std::size_t count)
+    {
+        std::mt19937_64 engine(7);
+        Issue const usd{Currency(0x5553440000000000), AccountID(0x4985601)};
+        auto const account = [&]() {
+            AccountID id;
+            beast::rngfill(id.data(), id.size(), engine);
+            return id;
+        };
+        auto const iou = [&]() {
+            return STAmount(usd, engine() % 1'000'000'000 + 1, -6);
+        };
+
+        std::vector<Blob> txs;
+        txs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            static TxType const types[] = {
+                ttPAYMENT, ttOFFER_CREATE, ttTRUST_SET};
+            auto const type = types[i % 3];
+            STTx const tx(type, [&](STObject& obj) {
+                obj.setAccountID(sfAccount, account());
+                obj.setFieldU32(sfSequence, engine() % 100000);
+                obj.setFieldU32(sfLastLedgerSequence, engine() % 100000);
+                obj.setFieldU32(sfFlags, 0);
+                obj.setFieldAmount(sfFee, STAmount(XRPAmount(12)));
+                Blob key(33, 2), sig(71, 0x30);
+                beast::rngfill(key.data() + 1, key.size() - 1, engine);
+                beast::rngfill(sig.data() + 1, sig.size() - 1, engine);
+                obj.setFieldVL(sfSigningPubKey, key);
+                obj.setFieldVL(sfTxnSignature, sig);
+                if (type == ttPAYMENT)
+                {
+                    obj.setAccountID(sfDestination, account());
+                    obj.setFieldAmount(sfAmount, iou());
+                    obj.setFieldAmount(sfSendMax, iou());
+                    obj.setFieldU32(sfDestinationTag, engine() % 1000);
+                }
+                else if (type == ttOFFER_CREATE)
+                {
+                    obj.setFieldAmount(sfTakerPays, iou());
+                    obj.setFieldAmount(
+                        sfTakerGets,
+                        STAmount(XRPAmount(engine() % 1'000'000'000 + 1)));
+                    obj.setFieldU32(sfExpiration, engine() % 100000);
+                }
+                else
+                {
+                    obj.setFieldAmount(sfLimitAmount, iou());
+                    obj.setFieldU32(sfQualityIn, 1'000'000'000);
+                }
+            });
+            txs.push_back(tx.getSerializer().getData());
+        }
+        return txs;
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("field lookup performance");
+
+        auto const& known = SField::getKnownCodeToField();
+        std::vector<int> codes;
+        std::vector<std::string> names;
+        for (auto const& [code, f] : known)
+        {
+            if (code > 0 && f->isBinary())
+                codes.push_back(code);
+            if (code > 0)
+                names.push_back(f->fieldName);
+        }
+        std::shuffle(codes.begin(), codes.end(), std::mt19937_64(1));
+        std::shuffle(names.begin(), names.end(), std::mt19937_64(2));
+
+        std::size_t const rounds = 2000;
+        std::size_t found = 0;
+        auto const byTable = time(rounds * codes.size(), [&]() {
+            for (std::size_t r = 0; r < rounds; ++r)
+                for (auto const c : codes)
+                    found += SField::getField(c).fieldNum;
+        });
+        auto const byMap = time(rounds * codes.size(), [&]() {
+            for (std::size_t r = 0; r < rounds; ++r)
+                for (auto const c : codes)
+                    found += known.find(c)->second->fieldNum;
+        });
+        auto const byHash = time(rounds * names.size(), [&]() {
+            for (std::size_t r = 0; r < rounds; ++r)
+                for (auto const& n : names)
+                    found += SField::getField(n).fieldNum;
+        });
+        auto const byScan = time(names.size(), [&]() {
+            for (auto const& n : names)
+            {
+                for (auto const& [_, f] : known)
+                {
+                    (void)_;
+                    if (f->fieldName == n)
+                    {
+                        found += f->fieldNum;
+                        break;
+                    }
+                }
+            }
+        });
+        BEAST_EXPECT(found != 0);
+
+        // About the number of transactions in a busy ledger
+        auto const txs = makeTxSet(1000);
+        std::size_t const passes = 50;
+        std::size_t fields = 0;
+        auto const perTx = time(passes * txs.size(), [&]() {
+            for (std::size_t p = 0; p < passes; ++p)
+            {
+                for (auto const& raw : txs)
+                {
+                    SerialIter sit(makeSlice(raw));
+                    STTx const tx(sit);
+                    fields += tx.getCount();
+                }
+            }
+        });
+        BEAST_EXPECT(fields != 0);
+
+        std::cout << "by code: " << byTable.count() << "ns (map "
+                  << byMap.count() << "ns)\n"
+                  << "by name: " << byHash.count() << "ns (linear search "
+                  << byScan.count() << "ns)\n"
+                  << "deserialize a tx set of " << txs.size() << ": "
+                  << perTx.count() << "ns per transaction\n";
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(SFieldPerf, protocol, ripple);
+
+}  // namespace ripple
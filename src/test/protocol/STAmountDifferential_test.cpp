@@ -0,0 +1,857 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/basics/IOUAmount.h>
+#include <xrpl/basics/MathUtilities.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/UintTypes.h>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace ripple {
+
+// The STAmount and IOUAmount arithmetic as it was written before it used
+// native 128 bit integers and power of ten tables: one step of ten at a
+// time, and boost::multiprecision for the wide products. The library must
+// agree with it bit for bit.
+namespace reference {
+
+static std::uint64_t const tenTo14 = 100000000000000ull;
+static std::uint64_t const tenTo14m1 = tenTo14 - 1;
+static std::uint64_t const tenTo17 = tenTo14 * 1000;
+
+struct Canonical
+{
+    std::uint64_t value;
+    int offset;
+    bool negative;
+};
+
+// STAmount::canonicalize, with the number switchover off. Returns nothing
+// where the library throws.
+std::optional<Canonical>
+canonicalize(bool native, std::uint64_t value, int offset, bool negative)
+{
+    if (native)
+    {
+        if (value == 0 || offset <= -20)
+            return Canonical{0, 0, false};
+
+        if (getSTAmountCanonicalizeSwitchover() && offset > 17)
+            return std::nullopt;
+
+        while (offset < 0)
+        {
+            value /= 10;
+            ++offset;
+        }
+
+        while (offset > 0)
+        {
+            if (getSTAmountCanonicalizeSwitchover() &&
+                value > STAmount::cMaxNativeN)
+                return std::nullopt;
+            value *= 10;
+            --offset;
+        }
+
+        if (value > STAmount::cMaxNativeN)
+            return std::nullopt;
+        return Canonical{value, 0, negative};
+    }
+
+    if (value == 0)
+        return Canonical{0, -100, false};
+
+    while ((value < STAmount::cMinValue) && (offset > STAmount::cMinOffset))
+    {
+        value *= 10;
+        --offset;
+    }
+
+    while (value > STAmount::cMaxValue)
+    {
+        if (offset >= STAmount::cMaxOffset)
+            return std::nullopt;
+
+        value /= 10;
+        ++offset;
+    }
+
+    if ((offset < STAmount::cMinOffset) || (value < STAmount::cMinValue))
+        return Canonical{0, -100, false};
+
+    if (offset > STAmount::cMaxOffset)
+        return std::nullopt;
+
+    return Canonical{value, offset, negative};
+}
+
+// IOUAmount::normalize, with the number switchover off
+std::optional<std::pair<std::int64_t, int>>
+normalize(std::int64_t mantissa, int exponent)
+{
+    std::int64_t const minMantissa = 1000000000000000ull;
+    std::int64_t const maxMantissa = 9999999999999999ull;
+    int const minExponent = -96;
+    int const maxExponent = 80;
+
+    if (mantissa == 0)
+        return std::make_pair(0, -100);
+
+    bool const negative = (mantissa < 0);
+    if (negative)
+        mantissa = -mantissa;
+
+    while ((mantissa < minMantissa) && (exponent > minExponent))
+    {
+        mantissa *= 10;
+        --exponent;
+    }
+
+    while (mantissa > maxMantissa)
+    {
+        if (exponent >= maxExponent)
+            return std::nullopt;
+
+        mantissa /= 10;
+        ++exponent;
+    }
+
+    if ((exponent < minExponent) || (mantissa < minMantissa))
+        return std::make_pair(0, -100);
+
+    if (exponent > maxExponent)
+        return std::nullopt;
+
+    return std::make_pair(negative ? -mantissa : mantissa, exponent);
+}
+
+static std::int64_t
+getSNValue(STAmount const& amount)
+{
+    auto ret = static_cast<std::int64_t>(amount.mantissa());
+    return amount.negative() ? -ret : ret;
+}
+
+static std::uint64_t
+muldiv(
+    std::uint64_t multiplier,
+    std::uint64_t multiplicand,
+    std::uint64_t divisor)
+{
+    boost::multiprecision::uint128_t ret;
+
+    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    ret /= divisor;
+
+    if (ret > std::numeric_limits<std::uint64_t>::max())
+        Throw<std::overflow_error>("overflow");
+
+    return static_cast<uint64_t>(ret);
+}
+
+static std::uint64_t
+muldiv_round(
+    std::uint64_t multiplier,
+    std::uint64_t multiplicand,
+    std::uint64_t divisor,
+    std::uint64_t rounding)
+{
+    boost::multiprecision::uint128_t ret;
+
+    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    ret += rounding;
+    ret /= divisor;
+
+    if (ret > std::numeric_limits<std::uint64_t>::max())
+        Throw<std::overflow_error>("overflow");
+
+    return static_cast<uint64_t>(ret);
+}
+
+static void
+scaleUp(STAmount const& v, std::uint64_t& value, int& offset)
+{
+    value = v.mantissa();
+    offset = v.exponent();
+    if (v.native())
+    {
+        while (value < STAmount::cMinValue)
+        {
+            value *= 10;
+            --offset;
+        }
+    }
+}
+
+STAmount
+divide(STAmount const& num, STAmount const& den, Issue const& issue)
+{
+    if (den == beast::zero)
+        Throw<std::runtime_error>("division by zero");
+
+    if (num == beast::zero)
+        return {issue};
+
+    std::uint64_t numVal, denVal;
+    int numOffset, denOffset;
+    scaleUp(num, numVal, numOffset);
+    scaleUp(den, denVal, denOffset);
+
+    return STAmount(
+        issue,
+        muldiv(numVal, tenTo17, denVal) + 5,
+        numOffset - denOffset - 17,
+        num.negative() != den.negative());
+}
+
+STAmount
+multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
+{
+    if (v1 == beast::zero || v2 == beast::zero)
+        return STAmount(issue);
+
+    if (v1.native() && v2.native() && isXRP(issue))
+    {
+        std::uint64_t const minV =
+            getSNValue(v1) < getSNValue(v2) ? getSNValue(v1) : getSNValue(v2);
+        std::uint64_t const maxV =
+            getSNValue(v1) < getSNValue(v2) ? getSNValue(v2) : getSNValue(v1);
+
+        if (minV > 3000000000ull)  // sqrt(cMaxNative)
+            Throw<std::runtime_error>("Native value overflow");
+
+        if (((maxV >> 32) * minV) > 2095475792ull)  // cMaxNative / 2^32
+            Throw<std::runtime_error>("Native value overflow");
+
+        return STAmount(v1.getFName(), minV * maxV);
+    }
+
+    if (getSTNumberSwitchover())
+        return {IOUAmount{Number{v1} * Number{v2}}, issue};
+
+    std::uint64_t value1, value2;
+    int offset1, offset2;
+    scaleUp(v1, value1, offset1);
+    scaleUp(v2, value2, offset2);
+
+    return STAmount(
+        issue,
+        muldiv(value1, value2, tenTo14) + 7,
+        offset1 + offset2 + 14,
+        v1.negative() != v2.negative());
+}
+
+static void
+canonicalizeRound(bool native, std::uint64_t& value, int& offset, bool)
+{
+    if (native)
+    {
+        if (offset < 0)
+        {
+            int loops = 0;
+
+            while (offset < -1)
+            {
+                value /= 10;
+                ++offset;
+                ++loops;
+            }
+
+            value += (loops >= 2) ? 9 : 10;  // add before last divide
+            value /= 10;
+            ++offset;
+        }
+    }
+    else if (value > STAmount::cMaxValue)
+    {
+        while (value > (10 * STAmount::cMaxValue))
+        {
+            value /= 10;
+            ++offset;
+        }
+
+        value += 9;  // add before last divide
+        value /= 10;
+        ++offset;
+    }
+}
+
+static void
+canonicalizeRoundStrict(
+    bool native,
+    std::uint64_t& value,
+    int& offset,
+    bool roundUp)
+{
+    if (native)
+    {
+        if (offset < 0)
+        {
+            bool hadRemainder = false;
+
+            while (offset < -1)
+            {
+                std::uint64_t const newValue = value / 10;
+                hadRemainder |= (value != (newValue * 10));
+                value = newValue;
+                ++offset;
+            }
+            value +=
+                (hadRemainder && roundUp) ? 10 : 9;  // Add before last divide
+            value /= 10;
+            ++offset;
+        }
+    }
+    else if (value > STAmount::cMaxValue)
+    {
+        while (value > (10 * STAmount::cMaxValue))
+        {
+            value /= 10;
+            ++offset;
+        }
+        value += 9;  // add before last divide
+        value /= 10;
+        ++offset;
+    }
+}
+
+class DontAffectNumberRoundMode
+{
+public:
+    explicit DontAffectNumberRoundMode(Number::rounding_mode) noexcept
+    {
+    }
+};
+
+template <
+    void (*CanonicalizeFunc)(bool, std::uint64_t&, int&, bool),
+    typename MightSaveRound>
+static STAmount
+mulRoundImpl(
+    STAmount const& v1,
+    STAmount const& v2,
+    Issue const& issue,
+    bool roundUp)
+{
+    if (v1 == beast::zero || v2 == beast::zero)
+        return {issue};
+
+    bool const xrp = isXRP(issue);
+
+    if (v1.native() && v2.native() && xrp)
+    {
+        std::uint64_t minV =
+            (getSNValue(v1) < getSNValue(v2)) ? getSNValue(v1) : getSNValue(v2);
+        std::uint64_t maxV =
+            (getSNValue(v1) < getSNValue(v2)) ? getSNValue(v2) : getSNValue(v1);
+
+        if (minV > 3000000000ull)  // sqrt(cMaxNative)
+            Throw<std::runtime_error>("Native value overflow");
+
+        if (((maxV >> 32) * minV) > 2095475792ull)  // cMaxNative / 2^32
+            Throw<std::runtime_error>("Native value overflow");
+
+        return STAmount(v1.getFName(), minV * maxV);
+    }
+
+    std::uint64_t value1, value2;
+    int offset1, offset2;
+    scaleUp(v1, value1, offset1);
+    scaleUp(v2, value2, offset2);
+
+    bool const resultNegative = v1.negative() != v2.negative();
+
+    std::uint64_t amount = muldiv_round(
+        value1, value2, tenTo14, (resultNegative != roundUp) ? tenTo14m1 : 0);
+
+    int offset = offset1 + offset2 + 14;
+    if (resultNegative != roundUp)
+        CanonicalizeFunc(xrp, amount, offset, roundUp);
+
+    STAmount result = [&]() {
+        MightSaveRound const savedRound(Number::towards_zero);
+        return STAmount(issue, amount, offset, resultNegative);
+    }();
+
+    if (roundUp && !resultNegative && !result)
+    {
+        if (xrp)
+        {
+            amount = 1;
+            offset = 0;
+        }
+        else
+        {
+            amount = STAmount::cMinValue;
+            offset = STAmount::cMinOffset;
+        }
+        return STAmount(issue, amount, offset, resultNegative);
+    }
+    return result;
+}
+
+template <typename MightSaveRound>
+static STAmount
+divRoundImpl(
+    STAmount const& num,
+    STAmount const& den,
+    Issue const& issue,
+    bool roundUp)
+{
+    if (den == beast::zero)
+        Throw<std::runtime_error>("division by zero");
+
+    if (num == beast::zero)
+        return {issue};
+
+    std::uint64_t numVal, denVal;
+    int numOffset, denOffset;
+    scaleUp(num, numVal, numOffset);
+    scaleUp(den, denVal, denOffset);
+
+    bool const resultNegative = (num.negative() != den.negative());
+
+    std::uint64_t amount = muldiv_round(
+        numVal, tenTo17, denVal, (resultNegative != roundUp) ? denVal - 1 : 0);
+
+    int offset = numOffset - denOffset - 17;
+
+    if (resultNegative != roundUp)
+        canonicalizeRound(isXRP(issue), amount, offset, roundUp);
+
+    STAmount result = [&]() {
+        using enum Number::rounding_mode;
+        MightSaveRound const savedRound(
+            roundUp ^ resultNegative ? upward : downward);
+        return STAmount(issue, amount, offset, resultNegative);
+    }();
+
+    if (roundUp && !resultNegative && !result)
+    {
+        if (isXRP(issue))
+        {
+            amount = 1;
+            offset = 0;
+        }
+        else
+        {
+            amount = STAmount::cMinValue;
+            offset = STAmount::cMinOffset;
+        }
+        return STAmount(issue, amount, offset, resultNegative);
+    }
+    return result;
+}
+
+STAmount
+mulRound(
+    STAmount const& v1,
+    STAmount const& v2,
+    Issue const& issue,
+    bool roundUp)
+{
+    return mulRoundImpl<canonicalizeRound, DontAffectNumberRoundMode>(
+        v1, v2, issue, roundUp);
+}
+
+STAmount
+mulRoundStrict(
+    STAmount const& v1,
+    STAmount const& v2,
+    Issue const& issue,
+    bool roundUp)
+{
+    return mulRoundImpl<canonicalizeRoundStrict, NumberRoundModeGuard>(
+        v1, v2, issue, roundUp);
+}
+
+STAmount
+divRound(
+    STAmount const& num,
+    STAmount const& den,
+    Issue const& issue,
+    bool roundUp)
+{
+    return divRoundImpl<DontAffectNumberRoundMode>(num, den, issue, roundUp);
+}
+
+STAmount
+divRoundStrict(
+    STAmount const& num,
+    STAmount const& den,
+    Issue const& issue,
+    bool roundUp)
+{
+    return divRoundImpl<NumberRoundModeGuard>(num, den, issue, roundUp);
+}
+
+}  // namespace reference
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+Issue const usd{Currency(0x5553440000000000), AccountID(0x4985601)};
+
+class Generator
+{
+    std::mt19937_64 engine_;
+
+    int
+    between(int lo, int hi)
+    {
+        return std::uniform_int_distribution<int>(lo, hi)(engine_);
+    }
+
+public:
+    explicit Generator(std::uint64_t seed) : engine_(seed)
+    {
+    }
+
+    // Any value, with the number of digits spread evenly so that small and
+    // large mantissas are equally likely.
+    std::uint64_t
+    mantissa()
+    {
+        int const digits = between(0, 20);
+        std::uint64_t const v = engine_();
+        if (digits == 20)
+            return v;
+        return v % powersOfTen[digits];
+    }
+
+    int
+    exponent(int lo, int hi)
+    {
+        return between(lo, hi);
+    }
+
+    bool
+    flip()
+    {
+        return engine_() & 1;
+    }
+
+    // A valid amount: an IOU of any magnitude, or up to the XRP supply
+    STAmount
+    amount()
+    {
+        if (between(0, 2) == 0)
+        {
+            auto const drops = std::uniform_int_distribution<std::int64_t>(
+                -100'000'000'000'000'000, 100'000'000'000'000'000)(engine_);
+            auto const scale =
+                static_cast<std::int64_t>(powersOfTen[between(0, 17)]);
+            return STAmount(XRPAmount(drops / scale));
+        }
+        return STAmount(
+            usd,
+            between(1, 9999) * powersOfTen[between(0, 12)] + engine_() % 1000,
+            between(-100, 80),
+            flip());
+    }
+};
+
+template <class F>
+std::optional<STAmount>
+attempt(F&& f)
+{
+    try
+    {
+        return f();
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+bool
+identical(std::optional<STAmount> const& a, std::optional<STAmount> const& b)
+{
+    if (!a || !b)
+        return !a && !b;
+    return a->mantissa() == b->mantissa() && a->exponent() == b->exponent() &&
+        a->negative() == b->negative() && a->native() == b->native() &&
+        a->issue() == b->issue();
+}
+
+}  // namespace
+
+class STAmountDifferential_test : public beast::unit_test::suite
+{
+    static constexpr std::size_t iterations = 20000;
+
+    void
+    testCanonicalize()
+    {
+        testcase("canonicalize");
+
+        NumberSO const legacy{false};
+        Generator gen(1);
+        for (bool const amountSO : {false, true})
+        {
+            STAmountSO const canonicalizeSO{amountSO};
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                bool const native = gen.flip();
+                auto const value = gen.mantissa();
+                auto const offset = native ? gen.exponent(-25, 20)
+                                           : gen.exponent(-130, 100);
+                bool const negative = gen.flip();
+
+                auto const expected =
+                    reference::canonicalize(native, value, offset, negative);
+                auto const actual = attempt([&]() {
+                    return STAmount(
+                        native ? xrpIssue() : usd, value, offset, negative);
+                });
+
+                bool const same = expected
+                    ? actual && actual->mantissa() == expected->value &&
+                        actual->exponent() == expected->offset &&
+                        actual->negative() == expected->negative
+                    : !actual;
+                if (!same)
+                {
+                    log << (native ? "native " : "IOU ") << value << "e"
+                        << offset << std::endl;
+                }
+                BEAST_EXPECT(same);
+            }
+        }
+    }
+
+    void
+    testNormalize()
+    {
+        testcase("IOUAmount normalize");
+
+        NumberSO const legacy{false};
+        Generator gen(2);
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            auto const m = static_cast<std::int64_t>(gen.mantissa() >> 1) *
+                (gen.flip() ? -1 : 1);
+            auto const e = gen.exponent(-130, 100);
+
+            auto const expected = reference::normalize(m, e);
+            std::optional<IOUAmount> actual;
+            try
+            {
+                actual.emplace(m, e);
+            }
+            catch (std::overflow_error const&)
+            {
+            }
+
+            bool const same = expected
+                ? actual && actual->mantissa() == expected->first &&
+                    actual->exponent() == expected->second
+                : !actual;
+            if (!same)
+                log << "IOUAmount " << m << "e" << e << std::endl;
+            BEAST_EXPECT(same);
+        }
+    }
+
+    void
+    testArithmetic()
+    {
+        for (bool const numberSO : {false, true})
+        {
+            testcase(
+                std::string("arithmetic, number switchover ") +
+                (numberSO ? "on" : "off"));
+
+            NumberSO const switchover{numberSO};
+            Generator gen(numberSO ? 4 : 3);
+            std::size_t mismatches = 0;
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                auto const a = gen.amount();
+                auto const b = gen.amount();
+                auto const& issue = gen.flip() ? xrpIssue() : usd;
+                bool const up = gen.flip();
+
+                auto const check = [&](char const* op, auto&& x, auto&& y) {
+                    if (!identical(attempt(x), attempt(y)))
+                    {
+                        if (++mismatches < 10)
+                            log << op << "(" << a << ", " << b << ")"
+                                << std::endl;
+                        fail();
+                    }
+                    else
+                    {
+                        pass();
+                    }
+                };
+
+                check(
+                    "multiply",
+                    [&]() { return multiply(a, b, issue); },
+                    [&]() { return reference::multiply(a, b, issue); });
+                check(
+                    "divide",
+                    [&]() { return divide(a, b, issue); },
+                    [&]() { return reference::divide(a, b, issue); });
+                check(
+                    "mulRound",
+                    [&]() { return mulRound(a, b, issue, up); },
+                    [&]() { return reference::mulRound(a, b, issue, up); });
+                check(
+                    "mulRoundStrict",
+                    [&]() { return mulRoundStrict(a, b, issue, up); },
+                    [&]() {
+                        return reference::mulRoundStrict(a, b, issue, up);
+                    });
+                check(
+                    "divRound",
+                    [&]() { return divRound(a, b, issue, up); },
+                    [&]() { return reference::divRound(a, b, issue, up); });
+                check(
+                    "divRoundStrict",
+                    [&]() { return divRoundStrict(a, b, issue, up); },
+                    [&]() {
+                        return reference::divRoundStrict(a, b, issue, up);
+                    });
+            }
+        }
+    }
+
+    void
+    testDigits()
+    {
+        testcase("decimal digits");
+
+        for (int d = 1; d < 20; ++d)
+        {
+            BEAST_EXPECT(decimalDigits(powersOfTen[d] - 1) == d);
+            BEAST_EXPECT(decimalDigits(powersOfTen[d]) == d + 1);
+            BEAST_EXPECT(decimalDigits(powersOfTen[d] + 1) == d + 1);
+        }
+        for (int b = 0; b < 64; ++b)
+        {
+            std::uint64_t const v = std::uint64_t(1) << b;
+            int expected = 0;
+            for (auto x = v; x != 0; x /= 10)
+                ++expected;
+            BEAST_EXPECT(decimalDigits(v) == expected);
+            BEAST_EXPECT(decimalDigits(v | (v - 1)) >= expected);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testDigits();
+        testCanonicalize();
+        testNormalize();
+        testArithmetic();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STAmountDifferential, protocol, ripple);
+
+//------------------------------------------------------------------------------
+
+// A microbenchmark of the rounding arithmetic that offer crossing runs for
+// every step through a book: products and quotients of IOU and XRP amounts.
+// The reference versions show the cost before the fixed point kernels.
+class STAmountArithPerf_test : public beast::unit_test::suite
+{
+    template <class F>
+    std::chrono::nanoseconds
+    time(std::vector<std::pair<STAmount, STAmount>> const& pairs, F&& f)
+    {
+        using clock = std::chrono::steady_clock;
+        std::size_t const rounds = 20;
+        std::uint64_t sum = 0;
+        auto const start = clock::now();
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (auto const& [a, b] : pairs)
+                sum += f(a, b).mantissa();
+        }
+        auto const elapsed = clock::now() - start;
+        BEAST_EXPECT(sum != 0);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   elapsed) /
+            (rounds * pairs.size());
+    }
+
+public:
+    void
+    run() override
+    {
+        testcase("rounding arithmetic performance");
+
+        // Amounts of the size a book holds, so that nothing overflows
+        std::mt19937_64 engine(5);
+        auto const iou = [&]() {
+            return STAmount(
+                usd, engine() % 9'000'000'000'000'000 + 1'000'000, -10);
+        };
+        auto const xrp = [&]() {
+            return STAmount(XRPAmount(engine() % 100'000'000'000 + 1));
+        };
+        std::vector<std::pair<STAmount, STAmount>> pairs;
+        for (std::size_t i = 0; i < 10000; ++i)
+        {
+            pairs.emplace_back(iou(), iou());
+            pairs.emplace_back(xrp(), iou());
+        }
+
+        for (bool const numberSO : {false, true})
+        {
+            NumberSO const switchover{numberSO};
+            auto const mulNew = time(pairs, [](auto const& a, auto const& b) {
+                return mulRound(a, b, usd, true);
+            });
+            auto const mulOld = time(pairs, [](auto const& a, auto const& b) {
+                return reference::mulRound(a, b, usd, true);
+            });
+            auto const divNew = time(pairs, [](auto const& a, auto const& b) {
+                return divRound(a, b, xrpIssue(), false);
+            });
+            auto const divOld = time(pairs, [](auto const& a, auto const& b) {
+                return reference::divRound(a, b, xrpIssue(), false);
+            });
+            std::cout << "number switchover " << (numberSO ? "on" : "off")
+                      << ": mulRound " << mulNew.count() << "ns (was "
+                      << mulOld.count() << "ns), divRound " << divNew.count()
+                      << "ns (was " << divOld.count() << "ns)\n";
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(STAmountArithPerf, protocol, ripple);
+
+}  // namespace ripple
@@ -233,6 +233,38 @@ public:
                     "Field 'test.Method' has bad type.");
             }
         }
+
+        {
+            // A path element must name something, and a path must have
+            // elements, or they cannot be serialized.
+            std::string const json(
+                R"({"Paths":[[{"account":)"
+                R"("rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh"}],[{"type":48}]]})");
+
+            Json::Value jv;
+            if (BEAST_EXPECT(parseJSONString(json, jv)))
+            {
+                STParsedJSONObject parsed("test", jv);
+                BEAST_EXPECT(!parsed.object);
+                BEAST_EXPECT(
+                    parsed.error[jss::error_message] ==
+                    "Field 'test.Paths[1][0]' has invalid data.");
+            }
+        }
+
+        {
+            std::string const json(R"({"Paths":[[{"currency":"USD"}],[]]})");
+
+            Json::Value jv;
+            if (BEAST_EXPECT(parseJSONString(json, jv)))
+            {
+                STParsedJSONObject parsed("test", jv);
+                BEAST_EXPECT(!parsed.object);
+                BEAST_EXPECT(
+                    parsed.error[jss::error_message] ==
+                    "Field 'test.Paths[1]' has invalid data.");
+            }
+        }
     }
 
     void
@@ -699,6 +731,36 @@ public:
         }
     }
 
+    void
+    testFootprint()
+    {
+        testcase("Footprint");
+
+        STObject st(sfGeneric);
+        auto const empty = st.getFieldsFootprint();
+
+        // Hash vectors count their storage
+        std::vector<uint256> hashes(100);
+        st.setFieldV256(sfIndexes, STVector256(hashes));
+        auto const withHashes = st.getFieldsFootprint();
+        BEAST_EXPECT(withHashes >= empty + 100 * sizeof(uint256));
+
+        // and so do paths
+        STPathSet paths;
+        for (int i = 0; i < 4; ++i)
+        {
+            STPath path;
+            for (int j = 0; j < 5; ++j)
+                path.emplace_back(
+                    AccountID(j + 2), std::nullopt, std::nullopt);
+            paths.push_back(path);
+        }
+        st.setFieldPathSet(sfPaths, paths);
+        BEAST_EXPECT(
+            st.getFieldsFootprint() >=
+            withHashes + 4 * (sizeof(STPath) + 5 * sizeof(STPathElement)));
+    }
+
     void
     run() override
     {
@@ -711,6 +773,7 @@ public:
         testParseJSONArrayWithInvalidChildrenObjects();
         testParseJSONEdgeCases();
         testMalformed();
+        testFootprint();
     }
 };
 
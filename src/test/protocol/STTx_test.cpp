@@ -61,6 +61,10 @@ public:
 
         testcase("STObject constructor errors");
         testObjectCtorErrors();
+
+        testWireEncoding(KeyType::secp256k1);
+        testWireEncoding(KeyType::ed25519);
+        testWireMultiSign();
     }
 
     void
@@ -1634,6 +1638,169 @@ public:
         }
     }
 
+    void
+    testWireEncoding(KeyType keyType)
+    {
+        testcase(
+            std::string("wire encoding, ") +
+            (keyType == KeyType::ed25519 ? "ed25519" : "secp256k1"));
+
+        std::unordered_set<uint256, beast::uhash<>> const presets;
+        Rules const defaultRules{presets};
+
+        auto const keypair = randomKeyPair(keyType);
+        auto const alice = calcAccountID(keypair.first);
+        auto const bob = calcAccountID(randomKeyPair(keyType).first);
+
+        STTx j(ttPAYMENT, [&](auto& obj) {
+            obj.setAccountID(sfAccount, alice);
+            obj.setAccountID(sfDestination, bob);
+            obj.setFieldAmount(
+                sfAmount, STAmount(Issue{to_currency("USD"), alice}, 125, -1));
+            obj.setFieldAmount(sfFee, STAmount(10ull));
+            obj.setFieldU32(sfSequence, 7);
+            obj.setFieldVL(sfSigningPubKey, keypair.first.slice());
+
+            STObject memo(sfMemo);
+            memo.setFieldVL(sfMemoData, Slice("wire", 4));
+            STArray memos(sfMemos, 1);
+            memos.push_back(std::move(memo));
+            obj.setFieldArray(sfMemos, memos);
+        });
+        j.sign(keypair.first, keypair.second);
+        BEAST_EXPECT(!j.getWireData());
+
+        Serializer raw;
+        j.add(raw);
+
+        {
+            // A canonical encoding is kept and yields the same hashes.
+            STTx const tx(raw.slice());
+            BEAST_EXPECT(tx.getWireData() == raw.slice());
+            BEAST_EXPECT(tx.getTransactionID() == j.getTransactionID());
+            BEAST_EXPECT(tx.getSigningHash() == j.getSigningHash());
+            BEAST_EXPECT(tx == j);
+            BEAST_EXPECT(tx.checkSign(
+                STTx::RequireFullyCanonicalSig::yes, defaultRules));
+
+            // Copies share the encoding; signing drops it.
+            STTx copy(tx);
+            BEAST_EXPECT(copy.getWireData() == raw.slice());
+            copy.sign(keypair.first, keypair.second);
+            BEAST_EXPECT(!copy.getWireData());
+            BEAST_EXPECT(copy.getTransactionID() == j.getTransactionID());
+        }
+
+        {
+            // A damaged signature is still caught.
+            Blob bad = raw.peekData();
+            auto const sig = j.getFieldVL(sfTxnSignature);
+            auto const at = std::search(
+                bad.begin(), bad.end(), sig.begin(), sig.end());
+            BEAST_EXPECT(at != bad.end());
+            at[sig.size() / 2] ^= 0x01;
+
+            STTx const tx(makeSlice(bad));
+            BEAST_EXPECT(tx.getWireData());
+            BEAST_EXPECT(tx.getTransactionID() != j.getTransactionID());
+            BEAST_EXPECT(tx.getSigningHash() == j.getSigningHash());
+            BEAST_EXPECT(!tx.checkSign(
+                STTx::RequireFullyCanonicalSig::yes, defaultRules));
+        }
+
+        {
+            // Fields out of canonical order are accepted, but the hashes
+            // come from the parsed object and the bytes are not kept.
+            Serializer reordered;
+            for (auto const& field : j)
+            {
+                if (field.getSType() == STI_NOTPRESENT)
+                    continue;
+                field.addFieldID(reordered);
+                field.add(reordered);
+                if (field.getSType() == STI_ARRAY)
+                    reordered.addFieldID(STI_ARRAY, 1);
+            }
+            BEAST_EXPECT(reordered.size() == raw.size());
+            BEAST_EXPECT(reordered.slice() != raw.slice());
+
+            STTx const tx(reordered.slice());
+            BEAST_EXPECT(!tx.getWireData());
+            BEAST_EXPECT(tx.getTransactionID() == j.getTransactionID());
+            BEAST_EXPECT(tx.getSigningHash() == j.getSigningHash());
+            BEAST_EXPECT(tx.checkSign(
+                STTx::RequireFullyCanonicalSig::yes, defaultRules));
+        }
+
+        {
+            // Any change to the fields discards the encoding, so the
+            // signing hash follows the fields.
+            auto const changed = [&](auto&& change) {
+                STTx tx(raw.slice());
+                if (!tx.getWireData())
+                    return false;
+                change(tx);
+                return !tx.getWireData() &&
+                    tx.getSigningHash() != j.getSigningHash() &&
+                    !tx.checkSign(
+                        STTx::RequireFullyCanonicalSig::yes, defaultRules);
+            };
+            BEAST_EXPECT(
+                changed([](STTx& tx) { tx.setFieldU32(sfSequence, 8); }));
+            BEAST_EXPECT(changed([](STTx& tx) { tx[sfSequence] = 8; }));
+            BEAST_EXPECT(changed([](STTx& tx) { tx[~sfSourceTag] = 1u; }));
+            BEAST_EXPECT(changed([](STTx& tx) {
+                tx.peekFieldArray(sfMemos)[0].setFieldVL(
+                    sfMemoData, Slice("else", 4));
+            }));
+            BEAST_EXPECT(changed([](STTx& tx) { tx.delField(sfMemos); }));
+            BEAST_EXPECT(
+                changed([](STTx& tx) { tx.makeFieldAbsent(sfMemos); }));
+        }
+    }
+
+    void
+    testWireMultiSign()
+    {
+        testcase("wire encoding, multi-signed");
+
+        std::unordered_set<uint256, beast::uhash<>> const presets;
+        Rules const defaultRules{presets};
+
+        auto const kp1 = randomKeyPair(KeyType::secp256k1);
+        auto const id1 = calcAccountID(kp1.first);
+        auto const kp2 = randomKeyPair(KeyType::ed25519);
+        auto const id2 = calcAccountID(kp2.first);
+
+        STTx j(ttACCOUNT_SET, [&](auto& obj) {
+            obj.setAccountID(sfAccount, id1);
+            obj.setFieldU32(sfSequence, 3);
+            obj.setFieldAmount(sfFee, STAmount(30ull));
+            obj.setFieldVL(sfSigningPubKey, Slice{});
+        });
+
+        Serializer const data = buildMultiSigningData(j, id2);
+        STObject signer(sfSigner);
+        signer.setAccountID(sfAccount, id2);
+        signer.setFieldVL(sfSigningPubKey, kp2.first.slice());
+        signer.setFieldVL(
+            sfTxnSignature, sign(kp2.first, kp2.second, data.slice()));
+        STArray signers(sfSigners, 1);
+        signers.push_back(std::move(signer));
+        j.setFieldArray(sfSigners, signers);
+
+        Serializer raw;
+        j.add(raw);
+
+        STTx const tx(raw.slice());
+        BEAST_EXPECT(tx.getWireData() == raw.slice());
+        BEAST_EXPECT(
+            tx.getTransactionID() == j.getHash(HashPrefix::transactionID));
+        BEAST_EXPECT(tx.getSigningHash() == j.getSigningHash());
+        BEAST_EXPECT(
+            tx.checkSign(STTx::RequireFullyCanonicalSig::yes, defaultRules));
+    }
+
     void
     testObjectCtorErrors()
     {
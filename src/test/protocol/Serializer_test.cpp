@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/Serializer.h>
+
+namespace ripple {
+
+class Serializer_test : public beast::unit_test::suite
+{
+    void
+    testBufferReuse()
+    {
+        testcase("buffer reuse");
+
+        void const* first = nullptr;
+        {
+            Serializer s;
+            s.add32(1);
+            first = s.data();
+        }
+
+        auto const before = getSerializerPoolCounts();
+        {
+            // The buffer of the last serializer is handed to the next one
+            Serializer s;
+            BEAST_EXPECT(s.size() == 0);
+            s.add32(2);
+            BEAST_EXPECT(s.data() == first);
+            BEAST_EXPECT(s == Serializer(s.data(), s.size()));
+        }
+        auto const after = getSerializerPoolCounts();
+        BEAST_EXPECT(after.reused > before.reused);
+
+        // Large buffers are not kept
+        {
+            Serializer s(4096);
+            s.addRaw(Blob(4096, 7));
+        }
+        {
+            auto const counts = getSerializerPoolCounts();
+            Serializer s(4096);
+            BEAST_EXPECT(
+                getSerializerPoolCounts().allocated == counts.allocated + 1);
+            BEAST_EXPECT(s.capacity() >= 4096);
+        }
+    }
+
+    void
+    testMovedData()
+    {
+        testcase("moved data");
+
+        Blob kept;
+        {
+            Serializer s;
+            s.add64(0x0102030405060708);
+            kept = std::move(s.modData());
+        }
+        {
+            // Data moved out of a serializer is never recycled
+            Serializer s;
+            s.add64(0);
+            BEAST_EXPECT(s.data() != kept.data());
+        }
+        BEAST_EXPECT(kept.size() == 8 && kept[0] == 1 && kept[7] == 8);
+
+        Serializer a;
+        a.add32(0xdeadbeef);
+        Serializer b(a);
+        Serializer c(std::move(a));
+        BEAST_EXPECT(b == c);
+        BEAST_EXPECT(b.data() != c.data());
+        c = b;
+        BEAST_EXPECT(c == b);
+    }
+
+public:
+    void
+    run() override
+    {
+        testBufferReuse();
+        testMovedData();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Serializer, protocol, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/protocol/PublicKey.h>
+#include <xrpl/protocol/SecretKey.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace ripple {
+
+// A microbenchmark of secp256k1 signature verification, comparing keys that
+// are found in the cache of decoded keys with keys that must be decoded.
+class VerifyPerf_test : public beast::unit_test::suite
+{
+    struct Signed
+    {
+        PublicKey pk;
+        Buffer sig;
+    };
+
+    static std::vector<Signed>
+    makeSigned(std::size_t count, Slice message)
+    {
+        std::vector<Signed> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
+            result.push_back({pk, sign(pk, sk, message)});
+        }
+        return result;
+    }
+
+    // Verify every signature `rounds` times, and return the mean time taken
+    // by one verification.
+    std::chrono::nanoseconds
+    time(std::vector<Signed> const& sigs, std::size_t rounds, Slice message)
+    {
+        using clock = std::chrono::steady_clock;
+        std::size_t good = 0;
+        auto const start = clock::now();
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (auto const& s : sigs)
+                good += verify(s.pk, message, s.sig);
+        }
+        auto const elapsed = clock::now() - start;
+        BEAST_EXPECT(good == rounds * sigs.size());
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   elapsed) /
+            (rounds * sigs.size());
+    }
+
+    void
+    reportVerifyPerformance()
+    {
+        testcase("secp256k1 verification performance");
+
+        std::string const message = "a message of no particular interest";
+        auto const m = makeSlice(message);
+
+        // A handful of keys signing over and over, like the validators
+        auto const few = makeSigned(32, m);
+        // More keys than the cache holds, so that every key is decoded
+        auto const many = makeSigned(20000, m);
+
+        auto const before = getPublicKeyCacheCounts();
+        auto const cached = time(few, 200, m);
+        auto const mid = getPublicKeyCacheCounts();
+        auto const decoded = time(many, 1, m);
+        auto const after = getPublicKeyCacheCounts();
+
+        std::cout << "cached keys: " << cached.count() << "ns per verify ("
+                  << (mid.hits - before.hits) << " hits, "
+                  << (mid.misses - before.misses) << " misses)\n"
+                  << "decoded keys: " << decoded.count()
+                  << "ns per verify (" << (after.hits - mid.hits)
+                  << " hits, " << (after.misses - mid.misses)
+                  << " misses)\n";
+    }
+
+public:
+    void
+    run() override
+    {
+        reportVerifyPerformance();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(VerifyPerf, protocol, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <test/unit_test/SuiteJournal.h>
+#include <xrpl/basics/chrono.h>
+#include <xrpl/beast/unit_test.h>
+#include <xrpl/beast/xor_shift_engine.h>
+#include <xrpl/resource/Consumer.h>
+#include <xrpl/resource/detail/Logic.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace Resource {
+
+/** Measures Resource::Logic throughput when many threads create, charge and
+    release consumers concurrently, as RPC and peer traffic does on a busy
+    server.
+
+    The optional argument is a comma separated list of thread counts, e.g.
+    --unittest=LogicStress --unittest-arg=1,2,4,8
+*/
+class LogicStress_test : public beast::unit_test::suite
+{
+    // Operations performed by each thread
+    static std::size_t constexpr operations = 200000;
+
+    // Distinct client addresses
+    static std::size_t constexpr addresses = 4096;
+
+    static beast::IP::Endpoint
+    address(std::size_t i)
+    {
+        beast::IP::AddressV4::bytes_type d = {
+            {10,
+             static_cast<std::uint8_t>(i >> 16),
+             static_cast<std::uint8_t>(i >> 8),
+             static_cast<std::uint8_t>(i)}};
+        return beast::IP::Endpoint{beast::IP::AddressV4{d}, 51235};
+    }
+
+    void
+    doStress(std::size_t threads, beast::Journal journal)
+    {
+        Logic logic(beast::insight::NullCollector::New(), stopwatch(), journal);
+
+        std::atomic<bool> done{false};
+        std::atomic<std::size_t> warnings{0};
+
+        // Groom the table concurrently, as the resource manager thread does
+        std::thread groomer([&]() {
+            while (!done)
+            {
+                logic.periodicActivity();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        });
+
+        auto const start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                beast::xor_shift_engine gen(t + 1);
+                std::uniform_int_distribution<std::size_t> pick(
+                    0, addresses - 1);
+                std::size_t warned = 0;
+
+                for (std::size_t i = 0; i < operations; ++i)
+                {
+                    // Like an RPC request: look up the client, charge it
+                    // and check whether it should be warned or dropped.
+                    Consumer c(logic.newInboundEndpoint(address(pick(gen))));
+                    if (c.charge(feeReferenceRPC) != Disposition::ok &&
+                        c.warn())
+                        ++warned;
+                    c.disconnect(journal);
+                }
+
+                warnings += warned;
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        auto const elapsed = std::chrono::duration_cast<
+            std::chrono::duration<double>>(
+            std::chrono::steady_clock::now() - start);
+
+        done = true;
+        groomer.join();
+
+        auto const total = threads * operations;
+        std::stringstream ss;
+        ss << std::setw(3) << threads << " thread" << (threads > 1 ? "s" : " ")
+           << std::setw(10) << total << " operations in " << std::fixed
+           << std::setprecision(3) << elapsed.count() << "s, "
+           << std::setprecision(0) << total / elapsed.count() << " ops/s, "
+           << warnings << " warnings";
+        log << ss.str() << std::endl;
+
+        BEAST_EXPECT(logic.getJson(0).size() == 0);
+    }
+
+    void
+    run() override
+    {
+        testcase("Stress");
+
+        test::SuiteJournal journal("LogicStress_test", *this);
+
+        std::vector<std::size_t> threadCounts;
+        if (arg().empty())
+        {
+            threadCounts = {1, 2, 4, 8, 16};
+        }
+        else
+        {
+            std::stringstream ss(arg());
+            std::string s;
+            while (std::getline(ss, s, ','))
+                threadCounts.push_back(std::stoul(s));
+        }
+
+        for (auto const threads : threadCounts)
+            doStress(threads, journal);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(LogicStress, resource, ripple);
+
+}  // namespace Resource
+}  // namespace ripple
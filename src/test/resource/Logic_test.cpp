@@ -27,6 +27,7 @@
 
 #include <boost/utility/base_from_member.hpp>
 #include <functional>
+#include <vector>
 
 namespace ripple {
 namespace Resource {
@@ -275,6 +276,71 @@ public:
         pass();
     }
 
+    void
+    testShards(beast::Journal j)
+    {
+        testcase("Shards");
+
+        TestLogic logic(j);
+
+        // Enough distinct consumers to populate every shard
+        std::size_t const count = 8 * consumerTableShards;
+        Charge const fee(warningThreshold * decayWindowSeconds);
+
+        {
+            std::vector<Consumer> consumers;
+            consumers.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                beast::IP::AddressV4::bytes_type d = {
+                    {198, 51, static_cast<std::uint8_t>(i / 256),
+                     static_cast<std::uint8_t>(i % 256)}};
+                consumers.push_back(logic.newInboundEndpoint(
+                    beast::IP::Endpoint{beast::IP::AddressV4{d}}));
+                BEAST_EXPECT(consumers.back().charge(fee) == warn);
+            }
+
+            BEAST_EXPECT(logic.getJson().size() == count);
+            BEAST_EXPECT(logic.exportConsumers().items.size() == count);
+
+            // A second reference to an existing consumer shares its entry
+            Consumer c(logic.newInboundEndpoint(
+                beast::IP::Endpoint::from_string("198.51.0.1")));
+            BEAST_EXPECT(c.balance() == consumers[1].balance());
+            BEAST_EXPECT(logic.getJson().size() == count);
+        }
+
+        // Released consumers are inactive and no longer reported
+        BEAST_EXPECT(logic.getJson().size() == 0);
+        BEAST_EXPECT(logic.exportConsumers().items.empty());
+
+        // Remote balances imported through gossip are visible to the
+        // consumer regardless of which shard holds it.
+        {
+            Gossip g;
+            Gossip::Item item;
+            item.balance = dropThreshold;
+            item.address = beast::IP::Endpoint::from_string("198.51.0.2");
+            g.items.push_back(item);
+            logic.importConsumers("g", g);
+
+            Consumer c(logic.newInboundEndpoint(item.address));
+            BEAST_EXPECT(c.disposition() == drop);
+        }
+
+        // Imported balances are withdrawn when the gossip expires
+        for (auto n = gossipExpirationSeconds; n.count() >= 0; --n)
+        {
+            logic.advance();
+            logic.periodicActivity();
+        }
+        {
+            Consumer c(logic.newInboundEndpoint(
+                beast::IP::Endpoint::from_string("198.51.0.2")));
+            BEAST_EXPECT(c.disposition() != drop);
+        }
+    }
+
     void
     run() override
     {
@@ -286,6 +352,7 @@ public:
         testCharges(journal);
         testImports(journal);
         testImport(journal);
+        testShards(journal);
     }
 };
 
@@ -77,6 +77,18 @@ class GetCounts_test : public beast::unit_test::suite
                 BEAST_EXPECTS(result[it.first].asInt() == it.second, it.first);
             }
             BEAST_EXPECT(!result.isMember(jss::local_txs));
+
+            // every counted type that holds memory reports its bytes
+            auto const& objectBytes =
+                CountedObjects::getInstance().getBytes(10);
+            BEAST_EXPECT(!objectBytes.empty());
+            for (auto const& it : objectBytes)
+            {
+                BEAST_EXPECTS(
+                    result[jss::object_bytes].isMember(it.first), it.first);
+            }
+            BEAST_EXPECT(result.isMember(jss::treenode_cache_bytes));
+            BEAST_EXPECT(result.isMember(jss::pubkey_hit_rate));
         }
 
         {
@@ -24,6 +24,12 @@
 #include <xrpl/basics/Buffer.h>
 #include <xrpl/beast/unit_test.h>
 #include <xrpl/beast/utility/Journal.h>
+#include <xrpl/protocol/digest.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 namespace ripple {
 namespace tests {
@@ -122,6 +128,237 @@ public:
 
         run(true, journal);
         run(false, journal);
+
+        testSortedItems(true, journal);
+        testSortedItems(false, journal);
+        testWriteSortedItems(journal);
+    }
+
+    void
+    testSortedItems(bool backed, beast::Journal const& journal)
+    {
+        if (backed)
+            testcase("add sorted items backed");
+        else
+            testcase("add sorted items unbacked");
+
+        for (int const count : {0, 1, 2, 17, 256, 1000})
+        {
+            std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+            for (int i = 0; i < count; ++i)
+                items.push_back(make_shamapitem(sha512Half(i), IntToVUC(i)));
+            std::sort(
+                items.begin(), items.end(), [](auto const& a, auto const& b) {
+                    return a->key() < b->key();
+                });
+
+            tests::TestNodeFamily f(journal);
+            SHAMap incremental(SHAMapType::FREE, f);
+            SHAMap sorted(SHAMapType::FREE, f);
+            if (!backed)
+            {
+                incremental.setUnbacked();
+                sorted.setUnbacked();
+            }
+
+            for (auto const& item : items)
+                incremental.addItem(SHAMapNodeType::tnTRANSACTION_MD, item);
+            BEAST_EXPECT(
+                sorted.addSortedItems(SHAMapNodeType::tnTRANSACTION_MD, items));
+
+            // Backed maps write every node once they are flushed
+            if (backed)
+                BEAST_EXPECT(
+                    sorted.flushDirty(hotTRANSACTION_NODE) ==
+                    incremental.flushDirty(hotTRANSACTION_NODE));
+            sorted.invariants();
+
+            BEAST_EXPECT(sorted.getHash() == incremental.getHash());
+            BEAST_EXPECT(std::equal(
+                sorted.begin(),
+                sorted.end(),
+                items.begin(),
+                items.end(),
+                [](auto const& a, auto const& b) { return a == *b; }));
+
+            // The map can still be modified afterwards
+            auto const extra = make_shamapitem(sha512Half(count), IntToVUC(0));
+            BEAST_EXPECT(
+                sorted.addItem(SHAMapNodeType::tnTRANSACTION_MD, extra));
+            BEAST_EXPECT(
+                incremental.addItem(SHAMapNodeType::tnTRANSACTION_MD, extra));
+            if (count != 0)
+            {
+                BEAST_EXPECT(sorted.delItem(items.front()->key()));
+                BEAST_EXPECT(incremental.delItem(items.front()->key()));
+            }
+            sorted.invariants();
+            BEAST_EXPECT(sorted.getHash() == incremental.getHash());
+
+            // Only an empty map can be populated this way
+            BEAST_EXPECT(!sorted.addSortedItems(
+                SHAMapNodeType::tnTRANSACTION_MD, items));
+        }
+
+        {
+            // Keys must be strictly increasing
+            tests::TestNodeFamily f(journal);
+            SHAMap map(SHAMapType::FREE, f);
+            if (!backed)
+                map.setUnbacked();
+
+            auto const a = make_shamapitem(uint256(1), IntToVUC(1));
+            auto const b = make_shamapitem(uint256(2), IntToVUC(2));
+            BEAST_EXPECT(
+                !map.addSortedItems(SHAMapNodeType::tnTRANSACTION_MD, {b, a}));
+            BEAST_EXPECT(
+                !map.addSortedItems(SHAMapNodeType::tnTRANSACTION_MD, {a, a}));
+            BEAST_EXPECT(map.getHash().isZero());
+            BEAST_EXPECT(
+                map.addSortedItems(SHAMapNodeType::tnTRANSACTION_MD, {a, b}));
+            BEAST_EXPECT(map.hasItem(a->key()) && map.hasItem(b->key()));
+        }
+
+        {
+            // Building the subtrees on several threads gives the same map
+            std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+            for (int i = 0; i < 10000; ++i)
+                items.push_back(make_shamapitem(sha512Half(i), IntToVUC(i)));
+            std::sort(
+                items.begin(), items.end(), [](auto const& a, auto const& b) {
+                    return a->key() < b->key();
+                });
+
+            tests::TestNodeFamily f(journal);
+            SHAMap serial(SHAMapType::FREE, f);
+            SHAMap parallel(SHAMapType::FREE, f);
+            if (!backed)
+            {
+                serial.setUnbacked();
+                parallel.setUnbacked();
+            }
+
+            BEAST_EXPECT(serial.addSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE, items, 1));
+            BEAST_EXPECT(parallel.addSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE, items, 4));
+            parallel.invariants();
+            BEAST_EXPECT(parallel.getHash() == serial.getHash());
+            if (backed)
+                BEAST_EXPECT(
+                    parallel.flushDirty(hotACCOUNT_NODE) ==
+                    serial.flushDirty(hotACCOUNT_NODE));
+        }
+    }
+
+    void
+    testWriteSortedItems(beast::Journal const& journal)
+    {
+        testcase("write sorted items");
+
+        using Items = std::vector<boost::intrusive_ptr<SHAMapItem const>>;
+        auto reader = [](Items const& items) {
+            return [&items, i = std::size_t{0}]() mutable {
+                return i == items.size()
+                    ? boost::intrusive_ptr<SHAMapItem const>{}
+                    : items[i++];
+            };
+        };
+
+        for (int const count : {0, 1, 2, 17, 1000, 10000})
+        {
+            Items items;
+            for (int i = 0; i < count; ++i)
+                items.push_back(make_shamapitem(sha512Half(i), IntToVUC(i)));
+            std::sort(
+                items.begin(), items.end(), [](auto const& a, auto const& b) {
+                    return a->key() < b->key();
+                });
+
+            tests::TestNodeFamily f(journal);
+            SHAMap expected(SHAMapType::FREE, f);
+            BEAST_EXPECT(expected.addSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE, items));
+
+            SHAMap written(SHAMapType::FREE, f);
+            BEAST_EXPECT(written.writeSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                reader(items),
+                hotACCOUNT_NODE,
+                4));
+            BEAST_EXPECT(written.getHash() == expected.getHash());
+
+            // Every node was written, and can be read back
+            SHAMap loaded(SHAMapType::FREE, f);
+            if (count != 0)
+                BEAST_EXPECT(loaded.fetchRoot(written.getHash(), nullptr));
+            BEAST_EXPECT(std::equal(
+                loaded.begin(),
+                loaded.end(),
+                items.begin(),
+                items.end(),
+                [](auto const& a, auto const& b) { return a == *b; }));
+            std::vector<SHAMapMissingNode> missing;
+            loaded.walkMap(missing, 1);
+            BEAST_EXPECT(missing.empty());
+
+            // Only an empty map can be populated this way
+            BEAST_EXPECT(
+                count == 0 ||
+                !written.writeSortedItems(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    reader(items),
+                    hotACCOUNT_NODE));
+        }
+
+        tests::TestNodeFamily f(journal);
+        auto const a = make_shamapitem(uint256(1), IntToVUC(1));
+        auto const b = make_shamapitem(uint256(2), IntToVUC(2));
+        {
+            // Keys must be strictly increasing
+            SHAMap map(SHAMapType::FREE, f);
+            Items const unsorted{b, a};
+            BEAST_EXPECT(!map.writeSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                reader(unsorted),
+                hotACCOUNT_NODE));
+            Items const repeated{a, a};
+            BEAST_EXPECT(!map.writeSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                reader(repeated),
+                hotACCOUNT_NODE));
+            BEAST_EXPECT(map.getHash().isZero());
+        }
+        {
+            // Unbacked maps are never written
+            SHAMap map(SHAMapType::FREE, f);
+            map.setUnbacked();
+            Items const items{a, b};
+            BEAST_EXPECT(!map.writeSortedItems(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                reader(items),
+                hotACCOUNT_NODE));
+        }
+        {
+            // An exception from the reader is passed on
+            SHAMap map(SHAMapType::FREE, f);
+            bool thrown = false;
+            try
+            {
+                map.writeSortedItems(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    []() -> boost::intrusive_ptr<SHAMapItem const> {
+                        Throw<std::runtime_error>("damaged");
+                        return {};
+                    },
+                    hotACCOUNT_NODE);
+            }
+            catch (std::runtime_error const& e)
+            {
+                thrown = std::string(e.what()) == "damaged";
+            }
+            BEAST_EXPECT(thrown);
+        }
     }
 
     void
@@ -400,7 +637,183 @@ class SHAMapPathProof_test : public beast::unit_test::suite
     }
 };
 
+// Compares building a map one item at a time with building it from sorted
+// items. The argument is a comma separated list of item counts.
+class SHAMapBuildPerf_test : public beast::unit_test::suite
+{
+    using Items = std::vector<boost::intrusive_ptr<SHAMapItem const>>;
+
+    template <class Build>
+    std::chrono::microseconds
+    measure(bool backed, beast::Journal const& journal, Build&& build)
+    {
+        tests::TestNodeFamily f(journal);
+        SHAMap map(SHAMapType::TRANSACTION, f);
+        if (!backed)
+            map.setUnbacked();
+
+        using clock = std::chrono::steady_clock;
+        auto const start = clock::now();
+        build(map);
+        if (backed)
+            map.flushDirty(hotTRANSACTION_NODE);
+        BEAST_EXPECT(map.getHash().isNonZero());
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            clock::now() - start);
+    }
+
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMapBuildPerf_test", *this);
+
+        std::vector<int> counts;
+        {
+            std::stringstream ss(arg().empty() ? "1000,10000,100000" : arg());
+            std::string token;
+            while (std::getline(ss, token, ','))
+                counts.push_back(std::stoi(token));
+        }
+
+        for (int const count : counts)
+        {
+            testcase(std::to_string(count) + " items");
+
+            // Roughly the size of a transaction with its metadata
+            Blob const data(200, 0xab);
+
+            Items items;
+            items.reserve(count);
+            for (int i = 0; i < count; ++i)
+                items.push_back(
+                    make_shamapitem(sha512Half(i), makeSlice(data)));
+            std::sort(
+                items.begin(), items.end(), [](auto const& a, auto const& b) {
+                    return a->key() < b->key();
+                });
+
+            for (bool const backed : {false, true})
+            {
+                auto const incremental =
+                    measure(backed, journal, [&](SHAMap& map) {
+                        for (auto const& item : items)
+                            map.addItem(
+                                SHAMapNodeType::tnTRANSACTION_MD, item);
+                    });
+                auto const sorted = measure(backed, journal, [&](SHAMap& map) {
+                    BEAST_EXPECT(map.addSortedItems(
+                        SHAMapNodeType::tnTRANSACTION_MD, items));
+                });
+
+                log << std::setw(8) << count
+                    << (backed ? " backed  " : " unbacked")
+                    << "  addItem: " << std::setw(9) << incremental.count()
+                    << "us  addSortedItems: " << std::setw(9)
+                    << sorted.count() << "us" << std::endl;
+            }
+        }
+    }
+};
+
+// Reports the memory and update cost of a large account state map.
+// Pass the number of items as the argument (default 1,000,000, which is
+// close to the size of the mainnet state map).
+class SHAMapMemoryPerf_test : public beast::unit_test::suite
+{
+    // Resident set size in kilobytes, or 0 where it can't be determined.
+    static std::size_t
+    residentKB()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind("VmRSS:", 0) == 0)
+                return std::stoul(line.substr(6));
+        }
+        return 0;
+    }
+
+    template <class F>
+    static std::chrono::milliseconds
+    timed(F&& f)
+    {
+        using clock = std::chrono::steady_clock;
+        auto const start = clock::now();
+        f();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            clock::now() - start);
+    }
+
+public:
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMapMemoryPerf_test", *this);
+        int const count = arg().empty() ? 1000000 : std::stoi(arg());
+        // Roughly the size of a serialized AccountRoot
+        Blob const data(120, 0xcd);
+
+        testcase(std::to_string(count) + " items");
+
+        auto const rssBefore = residentKB();
+        tests::TestNodeFamily f(journal);
+        auto map = std::make_shared<SHAMap>(SHAMapType::STATE, f);
+        map->setUnbacked();
+
+        auto const buildTime = timed([&] {
+            for (int i = 0; i < count; ++i)
+                map->addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(sha512Half(i), makeSlice(data)));
+            map->getHash();
+        });
+        auto const rssAfter = residentKB();
+
+        std::size_t inner = 0;
+        std::size_t leaves = 0;
+        map->visitNodes([&](SHAMapTreeNode& node) {
+            ++(node.isInner() ? inner : leaves);
+            return true;
+        });
+        BEAST_EXPECT(leaves == static_cast<std::size_t>(count));
+
+        // Simulate closing a ledger: snapshot, touch a few hundred entries
+        // and rehash.
+        constexpr int closes = 10;
+        constexpr int touched = 500;
+        Blob const updated(120, 0xef);
+        auto const closeTime = timed([&] {
+            for (int c = 0; c < closes; ++c)
+            {
+                map = map->snapShot(true);
+                for (int i = 0; i < touched; ++i)
+                    map->updateGiveItem(
+                        SHAMapNodeType::tnACCOUNT_STATE,
+                        make_shamapitem(
+                            sha512Half((c * touched + i) % count),
+                            makeSlice(updated)));
+                map->getHash();
+            }
+        });
+
+        auto const destroyTime = timed([&] { map.reset(); });
+
+        log << "  inner nodes: " << inner << "  leaf nodes: " << leaves
+            << "\n  build: " << buildTime.count() << "ms"
+            << "  close (avg of " << closes
+            << "): " << closeTime.count() / closes << "ms"
+            << "  destroy: " << destroyTime.count() << "ms"
+            << "\n  RSS growth: " << (rssAfter - rssBefore) / 1024 << "MB"
+            << "  node pointer size: "
+            << sizeof(intr_ptr::SharedPtr<SHAMapTreeNode>) << " bytes"
+            << std::endl;
+    }
+};
+
 BEAST_DEFINE_TESTSUITE(SHAMap, ripple_app, ripple);
 BEAST_DEFINE_TESTSUITE(SHAMapPathProof, ripple_app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMapBuildPerf, ripple_app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMapMemoryPerf, ripple_app, ripple);
 }  // namespace tests
 }  // namespace ripple
@@ -41,6 +41,7 @@
 #include <xrpl/beast/core/LexicalCast.h>
 #include <xrpl/protocol/BuildInfo.h>
 #include <xrpl/protocol/Feature.h>
+#include <xrpl/protocol/Serializer.h>
 #include <xrpl/protocol/digest.h>
 
 #include <algorithm>
@@ -328,16 +329,24 @@ RCLConsensus::Adaptor::onClose(
         std::make_shared<SHAMap>(SHAMapType::TRANSACTION, app_.getNodeFamily());
     initialSet->setUnbacked();
 
-    // Build SHAMap containing all transactions in our open ledger
-    for (auto const& tx : initialLedger->txs)
+    // Build SHAMap containing all transactions in our open ledger. The open
+    // ledger holds them in key order, so the map can be built in one pass.
     {
-        JLOG(j_.trace()) << "Adding open ledger TX "
-                         << tx.first->getTransactionID();
-        Serializer s(2048);
-        tx.first->add(s);
-        initialSet->addItem(
-            SHAMapNodeType::tnTRANSACTION_NM,
-            make_shamapitem(tx.first->getTransactionID(), s.slice()));
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+        items.reserve(initialLedger->txCount());
+        for (auto const& tx : initialLedger->txs)
+        {
+            JLOG(j_.trace()) << "Adding open ledger TX "
+                             << tx.first->getTransactionID();
+            Serializer s(2048);
+            tx.first->add(s);
+            items.push_back(
+                make_shamapitem(tx.first->getTransactionID(), s.slice()));
+        }
+
+        if (!initialSet->addSortedItems(
+                SHAMapNodeType::tnTRANSACTION_NM, items))
+            LogicError("RCLConsensus::onClose: unsorted open ledger");
     }
 
     // Add pseudo-transactions to the set
@@ -767,6 +776,7 @@ RCLConsensus::Adaptor::buildLCL(
     std::chrono::milliseconds roundTime,
     std::set<TxID>& failedTxs)
 {
+    auto const buffersBefore = getSerializerPoolCounts();
     std::shared_ptr<Ledger> built = [&]() {
         if (auto const replayData = ledgerMaster_.releaseReplay())
         {
@@ -784,6 +794,15 @@ RCLConsensus::Adaptor::buildLCL(
             j_);
     }();
 
+    // The counts are process wide, so they include any work done by other
+    // threads while the ledger was built.
+    auto const buffersAfter = getSerializerPoolCounts();
+    JLOG(j_.debug()) << "Serializer buffers building ledger #" << built->seq()
+                     << ": " << buffersAfter.reused - buffersBefore.reused
+                     << " reused, "
+                     << buffersAfter.allocated - buffersBefore.allocated
+                     << " allocated";
+
     // Update fee computations based on accepted txs
     using namespace std::chrono_literals;
     app_.getTxQ().processClosedLedger(app_, *built, roundTime > 5s);
@@ -57,9 +57,8 @@ ConsensusTransSetSF::gotNode(
         try
         {
             // skip prefix
-            Serializer s(nodeData.data() + 4, nodeData.size() - 4);
-            SerialIter sit(s.slice());
-            auto stx = std::make_shared<STTx const>(std::ref(sit));
+            auto stx = std::make_shared<STTx const>(
+                Slice(nodeData.data() + 4, nodeData.size() - 4));
             assert(stx->getTransactionID() == nodeHash.as_uint256());
             auto const pap = &app_;
             app_.getJobQueue().addJob(jtTRANSACTION, "TXS->TXN", [pap, stx]() {
@@ -21,13 +21,19 @@
 #define RIPPLE_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 
 #include <xrpld/app/ledger/Ledger.h>
+#include <xrpld/app/ledger/detail/AcquireScheduler.h>
 #include <xrpld/app/ledger/detail/TimeoutCounter.h>
 #include <xrpld/app/main/Application.h>
+#include <xrpld/nodestore/Types.h>
 #include <xrpld/overlay/PeerSet.h>
+#include <xrpld/shamap/SHAMapNodeID.h>
+#include <xrpld/shamap/SHAMapTreeNode.h>
 #include <xrpl/basics/CountedObject.h>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -124,6 +130,18 @@ private:
     void
     filterNodes(
         std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+        TriggerReason reason,
+        std::size_t limit);
+
+    /** Request missing nodes, split across the peers that will be asked.
+
+        Returns false if there was nothing worth requesting.
+    */
+    bool
+    requestNodes(
+        protocol::TMGetLedger& tmGL,
+        std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+        std::shared_ptr<Peer> const& peer,
         TriggerReason reason);
 
     void
@@ -150,14 +168,59 @@ private:
     std::weak_ptr<TimeoutCounter>
     pmDowncast() override;
 
+    /** A node received from a peer, decoded before the lock is taken.
+
+        The node is null for a root node, which is decoded when it is
+        added. A node that could not be decoded has no ID.
+    */
+    struct DecodedNode
+    {
+        std::optional<SHAMapNodeID> id;
+        intr_ptr::SharedPtr<SHAMapTreeNode> node;
+    };
+
+    using DecodedNodes = std::vector<DecodedNode>;
+
+    static DecodedNode
+    decodeNode(protocol::TMLedgerNode const& node);
+
+    using ReceivedData = std::vector<std::pair<
+        std::weak_ptr<Peer>,
+        std::shared_ptr<protocol::TMLedgerData>>>;
+
+    /** Decode and hash the nodes of the messages that carry nodes for a map
+        we still need, on several threads if there are enough of them.
+
+        Returns one list of nodes per message, empty for the messages that
+        were skipped.
+    */
+    std::vector<DecodedNodes>
+    decodeNodes(ReceivedData const& data);
+
     int
-    processData(std::shared_ptr<Peer> peer, protocol::TMLedgerData& data);
+    processData(
+        std::shared_ptr<Peer> peer,
+        protocol::TMLedgerData& data,
+        DecodedNodes const& decoded);
 
     bool
     takeHeader(std::string const& data);
 
+    /** Add the nodes of a message to the map they belong to.
+
+        The nodes the map accepts are collected in `writes` instead of being
+        written to the node store one at a time.
+    */
+    void
+    receiveNode(
+        protocol::TMLedgerData& packet,
+        DecodedNodes const& decoded,
+        NodeStore::Batch& writes,
+        SHAMapAddNode&);
+
+    /** Write the nodes collected by receiveNode to the node store. */
     void
-    receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode&);
+    storeNodes(NodeStore::Batch& writes, std::uint32_t seq);
 
     bool
     takeTxRootNode(Slice const& data, SHAMapAddNode&);
@@ -187,11 +250,12 @@ private:
 
     SHAMapAddNode mStats;
 
+    // Decides which peers are asked for which nodes
+    AcquireScheduler mScheduler;
+
     // Data we have received from peers
     std::mutex mReceivedDataLock;
-    std::vector<
-        std::pair<std::weak_ptr<Peer>, std::shared_ptr<protocol::TMLedgerData>>>
-        mReceivedData;
+    ReceivedData mReceivedData;
     bool mReceiveDispatched;
     std::unique_ptr<PeerSet> mPeerSet;
 };
@@ -454,6 +454,23 @@ Ledger::read(Keylet const& k) const
     return sle;
 }
 
+std::optional<LazySLE>
+Ledger::readLazy(Keylet const& k) const
+{
+    if (k.key == beast::zero)
+    {
+        assert(false);
+        return std::nullopt;
+    }
+    auto const& item = stateMap_.peekItem(k.key);
+    if (!item)
+        return std::nullopt;
+    LazySLE sle(item);
+    if (!k.check(sle.getType()))
+        return std::nullopt;
+    return sle;
+}
+
 //------------------------------------------------------------------------------
 
 auto
@@ -573,6 +590,35 @@ Ledger::rawTxInsert(
         LogicError("duplicate_tx: " + to_string(key));
 }
 
+void
+Ledger::rawTxInsertSorted(std::vector<tx_entry> const& txs)
+{
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+    items.reserve(txs.size());
+    for (auto const& [key, txn, metaData] : txs)
+    {
+        assert(metaData);
+
+        Serializer s(txn->getDataLength() + metaData->getDataLength() + 16);
+        s.addVL(txn->peekData());
+        s.addVL(metaData->peekData());
+        items.push_back(make_shamapitem(key, s.slice()));
+    }
+
+    // A freshly built ledger has an empty tx map which can be populated in
+    // one pass; otherwise fall back to inserting one at a time.
+    if (txMap_.addSortedItems(SHAMapNodeType::tnTRANSACTION_MD, items))
+        return;
+
+    for (auto& item : items)
+    {
+        auto const key = item->key();
+        if (!txMap_.addGiveItem(
+                SHAMapNodeType::tnTRANSACTION_MD, std::move(item)))
+            LogicError("duplicate_tx: " + to_string(key));
+    }
+}
+
 uint256
 Ledger::rawTxInsertWithHash(
     uint256 const& key,
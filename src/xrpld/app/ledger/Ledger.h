@@ -185,6 +185,9 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    std::optional<LazySLE>
+    readLazy(Keylet const& k) const override;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
@@ -245,6 +248,9 @@ public:
         std::shared_ptr<Serializer const> const& txn,
         std::shared_ptr<Serializer const> const& metaData) override;
 
+    void
+    rawTxInsertSorted(std::vector<tx_entry> const& txs) override;
+
     // Insert the transaction, and return the hash of the SHAMap leaf node
     // holding the transaction. The hash can be used to fetch the transaction
     // directly, instead of traversing the SHAMap
@@ -57,6 +57,14 @@ public:
     */
     virtual void
     clean(Json::Value const& parameters) = 0;
+
+    /** Report the range left to clean and the rate of progress.
+
+        Thread safety:
+            Safe to call from any thread at any time.
+    */
+    virtual Json::Value
+    getJson() const = 0;
 };
 
 std::unique_ptr<LedgerCleaner>
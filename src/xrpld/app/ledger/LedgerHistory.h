@@ -36,6 +36,8 @@ namespace ripple {
 class LedgerHistory
 {
 public:
+    using LedgersByHash = TaggedCache<LedgerHash, Ledger const>;
+
     LedgerHistory(
         beast::insight::Collector::ptr const& collector,
         Application& app);
@@ -70,6 +72,23 @@ public:
     LedgerHash
     getLedgerHash(LedgerIndex ledgerIndex);
 
+    /** Get the hashes of the most recently used cached ledgers
+        @param limit The maximum number of hashes to return
+        @return The hashes, from the most to the least recently used
+    */
+    std::vector<LedgerHash>
+    getRecentHashes(std::size_t limit) const
+    {
+        return m_ledgers_by_hash.getRecentKeys(limit);
+    }
+
+    /** The cache of ledgers by hash */
+    LedgersByHash&
+    getCache()
+    {
+        return m_ledgers_by_hash;
+    }
+
     /** Remove stale cache entries
      */
     void
@@ -126,8 +145,6 @@ private:
     beast::insight::Collector::ptr collector_;
     beast::insight::Counter mismatch_counter_;
 
-    using LedgersByHash = TaggedCache<LedgerHash, Ledger const>;
-
     LedgersByHash m_ledgers_by_hash;
 
     // Maps ledger indexes to the corresponding hashes
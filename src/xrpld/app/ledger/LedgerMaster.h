@@ -37,15 +37,34 @@
 #include <xrpl/protocol/RippleLedgerHash.h>
 #include <xrpl/protocol/STValidation.h>
 #include <xrpl/protocol/messages.h>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include <mutex>
 
 namespace ripple {
 
+class Message;
 class Peer;
 class Transaction;
 
+/** The messages making up a fetch pack, in the order they were sent. */
+struct FetchPackReply
+{
+    std::vector<std::shared_ptr<Message>> messages;
+
+    // The encoded size of all the messages
+    std::size_t bytes = 0;
+
+    std::size_t
+    memoryFootprint() const
+    {
+        return sizeof(*this) +
+            messages.capacity() * sizeof(std::shared_ptr<Message>) + bytes;
+    }
+};
+
 // Tracks the current ledger and any ledgers in the process of closing
 // Tracks ledger history
 // Tracks held transactions
@@ -204,6 +223,13 @@ public:
     float
     getCacheHitRate();
 
+    LedgerHistory::LedgersByHash&
+    getLedgerCache();
+
+    /** Get the hashes of the most recently used cached ledgers. */
+    std::vector<uint256>
+    getRecentLedgerHashes(std::size_t limit) const;
+
     void
     checkAccept(std::shared_ptr<Ledger const> const& ledger);
     void
@@ -258,6 +284,20 @@ public:
         uint256 haveLedgerHash,
         UptimeClock::time_point uptime);
 
+    /** Send a fetch pack that was recently built for another peer.
+
+        Peers that lag behind at the same ledger ask for the same fetch pack,
+        so the messages sent to the first of them are kept for a while and
+        sent again, as they are, to the others.
+
+        @return `true` if the fetch pack was sent.
+    */
+    bool
+    sendCachedFetchPack(
+        std::shared_ptr<Peer> const& peer,
+        protocol::TMGetObjectByHash const& request,
+        uint256 const& haveLedgerHash);
+
     std::size_t
     getFetchPackCacheSize() const;
 
@@ -380,6 +420,9 @@ private:
 
     TaggedCache<uint256, Blob> fetch_packs_;
 
+    // Fetch packs recently sent, by the hash of the requester's ledger.
+    TaggedCache<uint256, FetchPackReply> fetch_pack_replies_;
+
     std::uint32_t fetch_seq_{0};
 
     // Try to keep a validator from switching from test to live network
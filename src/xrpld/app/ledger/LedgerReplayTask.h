@@ -24,6 +24,7 @@
 #include <xrpld/app/ledger/detail/TimeoutCounter.h>
 #include <xrpld/app/main/Application.h>
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -165,10 +166,27 @@ private:
     /**
      * Try to build more ledgers
      * @param sl  lock. this function must be called with the lock
+     * @note the ledgers are built by a job, so that the threads delivering
+     *       deltas are not held up while a ledger is being built
      */
     void
     tryAdvance(ScopedLockType& sl);
 
+    /**
+     * Build ledgers from the deltas, in order, for as long as the next delta
+     * is ready. The task lock is released while a ledger is being built.
+     */
+    void
+    buildLedgers();
+
+    /**
+     * Start acquiring the deltas within the prefetch window of the next
+     * ledger to build
+     * @note this function must be called without the lock
+     */
+    void
+    startDeltas();
+
     InboundLedgers& inboundLedgers_;
     LedgerReplayer& replayer_;
     TaskParameter parameter_;
@@ -176,7 +194,14 @@ private:
     std::shared_ptr<SkipListAcquire> skipListAcquirer_;
     std::shared_ptr<Ledger const> parent_ = {};
     uint32_t deltaToBuild_ = 0;  // should not build until have parent
+    uint32_t deltasStarted_ = 0;
     std::vector<std::shared_ptr<LedgerDeltaAcquire>> deltas_;
+    // whether a job is building ledgers, and whether a delta became ready
+    // while it was
+    bool building_ = false;
+    bool advance_ = false;
+    // when the previous ledger was built, or the first build started
+    std::chrono::steady_clock::time_point lastBuilt_;
 
     friend class test::LedgerReplayClient;
 };
@@ -23,8 +23,10 @@
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/ledger/LedgerReplayTask.h>
 #include <xrpld/app/main/Application.h>
+#include <xrpl/beast/insight/Collector.h>
 #include <xrpl/beast/utility/Journal.h>
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -64,6 +66,10 @@ std::uint32_t constexpr MAX_TASK_SIZE = 256;
 
 // to limit the number of LedgerReplay related jobs in JobQueue
 std::uint32_t constexpr MAX_QUEUED_TASKS = 100;
+
+// for LedgerReplayTask to limit the number of deltas being acquired ahead
+// of the next ledger to build
+std::uint32_t constexpr DELTA_PREFETCH_WINDOW = 32;
 }  // namespace LedgerReplayParameters
 
 /**
@@ -118,6 +124,17 @@ public:
         LedgerInfo const& info,
         std::map<std::uint32_t, std::shared_ptr<STTx const>>&& txns);
 
+    /**
+     * Record that a task built a ledger from its delta
+     * @param buildTime  time taken to build the ledger
+     * @param waitTime  time the task waited for the delta after building
+     *        the previous ledger
+     */
+    void
+    onLedgerBuilt(
+        std::chrono::steady_clock::duration buildTime,
+        std::chrono::steady_clock::duration waitTime);
+
     /** Remove completed tasks */
     void
     sweep();
@@ -147,6 +164,26 @@ public:
     }
 
 private:
+    struct Stats
+    {
+        explicit Stats(beast::insight::Collector::ptr const& collector)
+            : skipListsAcquired(
+                  collector->make_counter("LedgerReplay", "Skip_Lists"))
+            , deltasAcquired(collector->make_counter("LedgerReplay", "Deltas"))
+            , ledgersBuilt(
+                  collector->make_counter("LedgerReplay", "Ledgers_Built"))
+            , buildTime(collector->make_event("LedgerReplay", "Build_Time"))
+            , waitTime(collector->make_event("LedgerReplay", "Wait_Time"))
+        {
+        }
+
+        beast::insight::Counter skipListsAcquired;
+        beast::insight::Counter deltasAcquired;
+        beast::insight::Counter ledgersBuilt;
+        beast::insight::Event buildTime;
+        beast::insight::Event waitTime;
+    };
+
     mutable std::mutex mtx_;
     std::vector<std::shared_ptr<LedgerReplayTask>> tasks_;
     hash_map<uint256, std::weak_ptr<LedgerDeltaAcquire>> deltas_;
@@ -156,6 +193,7 @@ private:
     InboundLedgers& inboundLedgers_;
     std::unique_ptr<PeerSetBuilder> peerSetBuilder_;
     beast::Journal j_;
+    Stats stats_;
 
     friend class test::LedgerReplayClient;
 };
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERSNAPSHOT_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERSNAPSHOT_H_INCLUDED
+
+#include <xrpld/app/ledger/Ledger.h>
+#include <xrpl/beast/utility/Journal.h>
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace ripple {
+
+/** A portable snapshot of a single closed ledger.
+
+    The snapshot holds everything needed to rebuild the ledger without
+    talking to the network: the ledger header followed by the leaves of the
+    state map and then of the transaction map, each in key order.
+
+    Layout, with all integers big-endian:
+
+        "XRPLSNAP"                  magic
+        uint32                      format version
+        uint32, bytes               serialized ledger header, with its hash
+        chunk...                    state map leaves
+        uint32 0                    end of the state map
+        chunk...                    transaction map leaves
+        uint32 0                    end of the transaction map
+
+    where each chunk is
+
+        uint32                      size of the payload in bytes
+        payload                     uint32 count, then per leaf:
+                                    uint256 key, uint32 size, data
+        uint256                     SHA-512Half of the payload
+
+    Chunks let a reader stream the file and detect corruption early,
+    without waiting for the root hashes to be computed.
+*/
+struct LedgerSnapshotStats
+{
+    std::size_t stateItems = 0;
+    std::size_t txItems = 0;
+    std::uint64_t bytes = 0;
+};
+
+/** Write a snapshot of a closed ledger.
+
+    @throws std::runtime_error if the stream fails.
+*/
+LedgerSnapshotStats
+writeLedgerSnapshot(Ledger const& ledger, std::ostream& out);
+
+/** Rebuild a ledger from a snapshot.
+
+    Each map is built bottom-up from its sorted leaves as they are read,
+    and written to the node store of `family`, one branch of the root at a
+    time, so only the leaves below one branch are held in memory. The
+    subtrees below each branch are hashed on `threads` threads. The rebuilt
+    root hashes must match the header, and the header must match its hash.
+
+    @return The immutable ledger, or nullptr if the snapshot is damaged or
+            fails verification. The reason is logged.
+*/
+std::shared_ptr<Ledger>
+loadLedgerSnapshot(
+    std::istream& in,
+    Config const& config,
+    Family& family,
+    beast::Journal j,
+    std::size_t threads);
+
+}  // namespace ripple
+
+#endif
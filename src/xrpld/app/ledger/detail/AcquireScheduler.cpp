@@ -0,0 +1,237 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/ledger/detail/AcquireScheduler.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ripple {
+
+AcquireScheduler::AcquireScheduler(std::size_t window) : window_(window)
+{
+}
+
+void
+AcquireScheduler::onRequest(
+    Peer::id_t peer,
+    protocol::TMLedgerInfoType type,
+    std::vector<SHAMapNodeID> nodes,
+    clock_type::time_point now)
+{
+    if (!start_)
+        start_ = now;
+
+    auto& stats = peers_[peer];
+    stats.inFlight.push_back({now, type, std::move(nodes)});
+    ++stats.requests;
+}
+
+bool
+AcquireScheduler::onReply(
+    Peer::id_t peer,
+    protocol::TMLedgerInfoType type,
+    SHAMapNodeID const& first,
+    std::size_t nodes,
+    std::size_t bytes,
+    clock_type::time_point now)
+{
+    nodes_ += nodes;
+    bytes_ += bytes;
+
+    auto const it = peers_.find(peer);
+    if (it == peers_.end())
+        return false;
+
+    auto& stats = it->second;
+    auto const request = std::find_if(
+        stats.inFlight.begin(), stats.inFlight.end(), [&](Request const& r) {
+            return r.type == type &&
+                std::find(r.nodes.begin(), r.nodes.end(), first) !=
+                r.nodes.end();
+        });
+    if (request == stats.inFlight.end())
+        return false;
+
+    bool const initial = stats.replies == 0 && stats.timeouts == 0;
+    auto const rtt = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now - request->sent);
+    stats.inFlight.erase(request);
+
+    stats.latency = initial ? rtt : (stats.latency * 3 + rtt) / 4;
+    stats.nodesPerReply =
+        initial ? nodes : (stats.nodesPerReply * 3 + nodes) / 4;
+    ++stats.replies;
+    stats.nodes += nodes;
+    stats.bytes += bytes;
+    return true;
+}
+
+void
+AcquireScheduler::expire(
+    clock_type::time_point now,
+    std::chrono::milliseconds timeout)
+{
+    for (auto& [id, stats] : peers_)
+    {
+        while (!stats.inFlight.empty() &&
+               now - stats.inFlight.front().sent >= timeout)
+        {
+            stats.inFlight.pop_front();
+            bool const first = stats.replies == 0 && stats.timeouts == 0;
+            stats.latency = first ? timeout : (stats.latency * 3 + timeout) / 4;
+            stats.nodesPerReply = first ? 0 : stats.nodesPerReply * 3 / 4;
+            ++stats.timeouts;
+        }
+    }
+}
+
+std::size_t
+AcquireScheduler::capacity(Peer::id_t peer) const
+{
+    auto const it = peers_.find(peer);
+    if (it == peers_.end())
+        return window_;
+    return window_ - std::min(window_, it->second.inFlight.size());
+}
+
+double
+AcquireScheduler::score(Peer::id_t peer) const
+{
+    auto const measured = [](PeerStats const& stats) {
+        auto const ms = std::max<std::int64_t>(stats.latency.count(), 1);
+        return stats.nodesPerReply * 1000 / ms;
+    };
+
+    auto const it = peers_.find(peer);
+    if (it != peers_.end() && (it->second.replies || it->second.timeouts))
+        return measured(it->second);
+
+    double sum = 0;
+    std::size_t known = 0;
+    for (auto const& [id, stats] : peers_)
+    {
+        if (stats.replies || stats.timeouts)
+        {
+            sum += measured(stats);
+            ++known;
+        }
+    }
+    return (known == 0 || sum == 0) ? 1.0 : sum / known;
+}
+
+std::vector<std::size_t>
+AcquireScheduler::shares(
+    std::size_t total,
+    std::vector<Peer::id_t> const& peers,
+    std::size_t maxPerPeer) const
+{
+    std::vector<std::size_t> counts(peers.size(), 0);
+    std::vector<double> weights(peers.size(), 0);
+    for (std::size_t i = 0; i < peers.size(); ++i)
+    {
+        if (capacity(peers[i]) != 0)
+            weights[i] = score(peers[i]);
+    }
+
+    // A peer that has only timed out still gets a little work so it can
+    // recover; otherwise it would never be asked again.
+    double const sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double const floor = (sum == 0 ? 1.0 : sum) / (16 * peers.size() + 1);
+    double weightSum = 0;
+    for (std::size_t i = 0; i < peers.size(); ++i)
+    {
+        if (capacity(peers[i]) != 0)
+        {
+            weights[i] = std::max(weights[i], floor);
+            weightSum += weights[i];
+        }
+    }
+    if (weightSum == 0)
+        return counts;
+
+    std::size_t assigned = 0;
+    for (std::size_t i = 0; i < peers.size(); ++i)
+    {
+        counts[i] = std::min<std::size_t>(
+            maxPerPeer, std::floor(total * weights[i] / weightSum));
+        assigned += counts[i];
+    }
+
+    // Hand out what rounding left over, best peers first.
+    std::vector<std::size_t> order(peers.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+        return weights[a] > weights[b];
+    });
+    while (assigned < total)
+    {
+        bool progress = false;
+        for (auto i : order)
+        {
+            if (assigned == total)
+                break;
+            if (weights[i] > 0 && counts[i] < maxPerPeer)
+            {
+                ++counts[i];
+                ++assigned;
+                progress = true;
+            }
+        }
+        if (!progress)
+            break;
+    }
+    return counts;
+}
+
+double
+AcquireScheduler::rate(clock_type::time_point now) const
+{
+    if (!start_)
+        return 0;
+    auto const elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - *start_);
+    return nodes_ * 1000.0 / std::max<std::int64_t>(elapsed.count(), 1);
+}
+
+Json::Value
+AcquireScheduler::getJson(clock_type::time_point now) const
+{
+    Json::Value ret(Json::objectValue);
+    ret[jss::nodes_received] = static_cast<Json::UInt>(nodes_);
+    ret[jss::bytes_received] = static_cast<Json::UInt>(bytes_);
+    ret[jss::nodes_per_second] =
+        static_cast<Json::UInt>(std::lround(rate(now)));
+
+    Json::Value& peers = (ret[jss::peer_stats] = Json::arrayValue);
+    for (auto const& [id, stats] : peers_)
+    {
+        Json::Value& p = peers.append(Json::objectValue);
+        p[jss::id] = id;
+        p[jss::outstanding] = static_cast<Json::UInt>(stats.inFlight.size());
+        p[jss::latency] = static_cast<Json::UInt>(stats.latency.count());
+        p[jss::nodes_received] = static_cast<Json::UInt>(stats.nodes);
+        p[jss::timeouts] = static_cast<Json::UInt>(stats.timeouts);
+    }
+    return ret;
+}
+
+}  // namespace ripple
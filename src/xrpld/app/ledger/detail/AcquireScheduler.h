@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_ACQUIRESCHEDULER_H_INCLUDED
+#define RIPPLE_APP_LEDGER_ACQUIRESCHEDULER_H_INCLUDED
+
+#include <xrpld/overlay/Peer.h>
+#include <xrpld/shamap/SHAMapNodeID.h>
+#include <xrpl/json/json_value.h>
+#include <xrpl/protocol/messages.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Spreads the nodes an acquisition needs across the peers serving it.
+
+    For every peer we track the requests in flight and estimate how quickly
+    the peer answers (round-trip latency) and how much useful data each reply
+    carries. Missing nodes are then divided into contiguous runs, so each
+    peer is asked for nearby parts of the tree, with faster peers getting
+    proportionally larger runs. Each peer may have up to `window` requests
+    in flight, so a fast peer is never idle waiting for the next round.
+
+    Replies are matched to requests by the nodes they carry, since a peer
+    may send data nobody asked it for, and requests sent to every peer are
+    not tracked.
+
+    This class is not thread safe; the owner must serialize access.
+*/
+class AcquireScheduler
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct Request
+    {
+        clock_type::time_point sent;
+        protocol::TMLedgerInfoType type;
+        std::vector<SHAMapNodeID> nodes;
+    };
+
+    struct PeerStats
+    {
+        // The requests still waiting for a reply, oldest first
+        std::deque<Request> inFlight;
+
+        // Smoothed round-trip time and useful nodes per reply
+        std::chrono::milliseconds latency{0};
+        double nodesPerReply = 0;
+
+        std::uint64_t requests = 0;
+        std::uint64_t replies = 0;
+        std::uint64_t timeouts = 0;
+        std::uint64_t nodes = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    explicit AcquireScheduler(std::size_t window = 4);
+
+    /** Record that a request was sent to a peer.
+
+        @param type The type of the nodes asked for.
+        @param nodes The IDs of the nodes asked for.
+    */
+    void
+    onRequest(
+        Peer::id_t peer,
+        protocol::TMLedgerInfoType type,
+        std::vector<SHAMapNodeID> nodes,
+        clock_type::time_point now);
+
+    /** Record a reply from a peer.
+
+        A peer answers with the nodes it has in the order they were asked
+        for, so the reply belongs to the oldest request in flight to the
+        peer that asked for its first node. A reply that belongs to no
+        request adds to the nodes received, but not to the peer's latency
+        or share of the work.
+
+        @param first The ID of the first node in the reply.
+        @param nodes The number of useful nodes the reply contained.
+        @param bytes The size of the reply on the wire.
+        @return `true` if the reply answered a request.
+    */
+    bool
+    onReply(
+        Peer::id_t peer,
+        protocol::TMLedgerInfoType type,
+        SHAMapNodeID const& first,
+        std::size_t nodes,
+        std::size_t bytes,
+        clock_type::time_point now);
+
+    /** Give up on requests that have been in flight for too long.
+
+        Each expired request counts against the peer as a reply that took
+        `timeout` and carried nothing, so slow peers get smaller shares.
+    */
+    void
+    expire(clock_type::time_point now, std::chrono::milliseconds timeout);
+
+    /** Number of additional requests the peer may have in flight. */
+    std::size_t
+    capacity(Peer::id_t peer) const;
+
+    /** Estimated useful nodes per second from the peer.
+
+        Peers we have not heard from yet get the average of the peers we
+        have, so they receive a fair share to start with.
+    */
+    double
+    score(Peer::id_t peer) const;
+
+    /** Divide items among peers.
+
+        Items should be sorted so that nodes of the same subtree are
+        adjacent. Each peer with spare capacity receives a contiguous run of
+        at most `maxPerPeer` items, sized by its score. Items that do not fit
+        are not assigned.
+    */
+    template <class T>
+    std::vector<std::pair<Peer::id_t, std::vector<T>>>
+    assign(
+        std::vector<T> const& items,
+        std::vector<Peer::id_t> const& peers,
+        std::size_t maxPerPeer) const;
+
+    /** Total useful nodes received. */
+    std::uint64_t
+    nodes() const
+    {
+        return nodes_;
+    }
+
+    /** Useful nodes received per second since the first request. */
+    double
+    rate(clock_type::time_point now) const;
+
+    Json::Value
+    getJson(clock_type::time_point now) const;
+
+private:
+    // Split `total` items in proportion to the peers' scores.
+    std::vector<std::size_t>
+    shares(
+        std::size_t total,
+        std::vector<Peer::id_t> const& peers,
+        std::size_t maxPerPeer) const;
+
+    std::size_t const window_;
+    std::map<Peer::id_t, PeerStats> peers_;
+    std::uint64_t nodes_ = 0;
+    std::uint64_t bytes_ = 0;
+    std::optional<clock_type::time_point> start_;
+};
+
+template <class T>
+std::vector<std::pair<Peer::id_t, std::vector<T>>>
+AcquireScheduler::assign(
+    std::vector<T> const& items,
+    std::vector<Peer::id_t> const& peers,
+    std::size_t maxPerPeer) const
+{
+    std::vector<std::pair<Peer::id_t, std::vector<T>>> result;
+    auto const counts = shares(items.size(), peers, maxPerPeer);
+
+    auto it = items.begin();
+    for (std::size_t i = 0; i < peers.size(); ++i)
+    {
+        if (counts[i] == 0)
+            continue;
+        result.emplace_back(peers[i], std::vector<T>(it, it + counts[i]));
+        it += counts[i];
+    }
+    return result;
+}
+
+}  // namespace ripple
+
+#endif
@@ -25,9 +25,66 @@
 #include <xrpld/app/misc/CanonicalTXSet.h>
 #include <xrpld/app/tx/apply.h>
 #include <xrpl/protocol/Feature.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 
+/* Check the signatures of the given transactions on several threads.
+
+   Signature and local checks depend only on the transaction and the rules,
+   and their outcome is recorded in the HashRouter, where preflight finds it
+   when the transactions are later applied one at a time in canonical order.
+   The ledger that gets built is therefore the same as without this step.
+*/
+static void
+checkValidityParallel(
+    Application& app,
+    Rules const& rules,
+    std::vector<STTx const*> const& txs,
+    beast::Journal j)
+{
+    // Below this many transactions per thread, spawning threads costs more
+    // than checking the signatures serially.
+    constexpr std::size_t minPerThread = 16;
+
+    auto const threads = std::min<std::size_t>(
+        std::thread::hardware_concurrency(), txs.size() / minPerThread);
+    if (threads < 2)
+        return;
+
+    std::atomic<std::size_t> next = 0;
+    auto work = [&] {
+        for (auto i = next++; i < txs.size(); i = next++)
+        {
+            try
+            {
+                checkValidity(
+                    app.getHashRouter(), *txs[i], rules, app.config());
+            }
+            catch (std::exception const& ex)
+            {
+                // Leave it to preflight to report
+                JLOG(j.debug())
+                    << "Transaction " << txs[i]->getTransactionID()
+                    << " check throws: " << ex.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers)
+        worker.join();
+
+    JLOG(j.debug()) << "Checked " << txs.size() << " transactions on "
+                    << threads << " threads";
+}
+
 /* Generic buildLedgerImpl that dispatches to ApplyTxs invocable with signature
     void(OpenView&, std::shared_ptr<Ledger> const&)
    It is responsible for adding transactions to the open view to generate the
@@ -105,6 +162,15 @@ applyTransactions(
     bool certainRetry = true;
     std::size_t count = 0;
 
+    if (app.config().PARALLEL_TX_CHECKS)
+    {
+        std::vector<STTx const*> txs;
+        txs.reserve(txns.size());
+        for (auto const& item : txns)
+            txs.push_back(item.second.get());
+        checkValidityParallel(app, view.rules(), txs, j);
+    }
+
     // Attempt to apply all of the retriable transactions
     for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
     {
@@ -232,6 +298,15 @@ buildLedger(
         app,
         j,
         [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
+            if (app.config().PARALLEL_TX_CHECKS)
+            {
+                std::vector<STTx const*> txs;
+                txs.reserve(replayData.orderedTxns().size());
+                for (auto const& tx : replayData.orderedTxns())
+                    txs.push_back(tx.second.get());
+                checkValidityParallel(app, accum.rules(), txs, j);
+            }
+
             for (auto& tx : replayData.orderedTxns())
                 applyTransaction(app, accum, *tx.second, false, applyFlags, j);
         });
@@ -35,7 +35,9 @@
 #include <boost/iterator/function_output_iterator.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <random>
+#include <thread>
 
 namespace ripple {
 
@@ -68,11 +70,61 @@ enum {
     // Number of nodes to request blindly
     ,
     reqNodes = 12
+
+    // Number of received nodes worth starting another decoding thread for
+    ,
+    decodeNodesPerThread = 256
+
+    // Most threads used to decode the nodes received at once
+    ,
+    decodeThreadsMax = 4
 };
 
 // millisecond for each ledger timeout
 auto constexpr ledgerAcquireTimeout = 3000ms;
 
+namespace {
+
+// Collects the nodes that a map hands to its sync filter, so that they
+// can be written to the node store in one batch after the ledger's lock
+// is released.
+class BatchingSF : public SHAMapSyncFilter
+{
+public:
+    BatchingSF(
+        NodeObjectType type,
+        AbstractFetchPackContainer& fp,
+        NodeStore::Batch& batch)
+        : type_(type), fp_(fp), batch_(batch)
+    {
+    }
+
+    void
+    gotNode(
+        bool,
+        SHAMapHash const& nodeHash,
+        std::uint32_t,
+        Blob&& nodeData,
+        SHAMapNodeType) const override
+    {
+        batch_.push_back(NodeObject::createObject(
+            type_, std::move(nodeData), nodeHash.as_uint256()));
+    }
+
+    std::optional<Blob>
+    getNode(SHAMapHash const& nodeHash) const override
+    {
+        return fp_.getFetchPack(nodeHash.as_uint256());
+    }
+
+private:
+    NodeObjectType const type_;
+    AbstractFetchPackContainer& fp_;
+    NodeStore::Batch& batch_;
+};
+
+}  // namespace
+
 InboundLedger::InboundLedger(
     Application& app,
     uint256 const& hash,
@@ -364,6 +416,7 @@ void
 InboundLedger::onTimer(bool wasProgress, ScopedLockType&)
 {
     mRecentNodes.clear();
+    mScheduler.expire(m_clock.now(), ledgerAcquireTimeout);
 
     if (isDone())
     {
@@ -627,6 +680,9 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             JLOG(journal_.trace()) << "Sending AS root request to "
                                    << (peer ? "selected peer" : "all peers");
             mPeerSet->sendRequest(tmGL, peer);
+            if (peer)
+                mScheduler.onRequest(
+                    peer->id(), tmGL.itype(), {SHAMapNodeID()}, m_clock.now());
             return;
         }
         else
@@ -657,27 +713,11 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
                 }
                 else
                 {
-                    filterNodes(nodes, reason);
-
-                    if (!nodes.empty())
-                    {
-                        tmGL.set_itype(protocol::liAS_NODE);
-                        for (auto const& id : nodes)
-                        {
-                            *(tmGL.add_nodeids()) = id.first.getRawString();
-                        }
-
-                        JLOG(journal_.trace())
-                            << "Sending AS node request (" << nodes.size()
-                            << ") to "
-                            << (peer ? "selected peer" : "all peers");
-                        mPeerSet->sendRequest(tmGL, peer);
+                    tmGL.set_itype(protocol::liAS_NODE);
+                    if (requestNodes(tmGL, nodes, peer, reason))
                         return;
-                    }
-                    else
-                    {
-                        JLOG(journal_.trace()) << "All AS nodes filtered";
-                    }
+
+                    JLOG(journal_.trace()) << "All AS nodes filtered";
                 }
             }
         }
@@ -699,6 +739,9 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             JLOG(journal_.trace()) << "Sending TX root request to "
                                    << (peer ? "selected peer" : "all peers");
             mPeerSet->sendRequest(tmGL, peer);
+            if (peer)
+                mScheduler.onRequest(
+                    peer->id(), tmGL.itype(), {SHAMapNodeID()}, m_clock.now());
             return;
         }
         else
@@ -723,25 +766,11 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             }
             else
             {
-                filterNodes(nodes, reason);
-
-                if (!nodes.empty())
-                {
-                    tmGL.set_itype(protocol::liTX_NODE);
-                    for (auto const& n : nodes)
-                    {
-                        *(tmGL.add_nodeids()) = n.first.getRawString();
-                    }
-                    JLOG(journal_.trace())
-                        << "Sending TX node request (" << nodes.size()
-                        << ") to " << (peer ? "selected peer" : "all peers");
-                    mPeerSet->sendRequest(tmGL, peer);
+                tmGL.set_itype(protocol::liTX_NODE);
+                if (requestNodes(tmGL, nodes, peer, reason))
                     return;
-                }
-                else
-                {
-                    JLOG(journal_.trace()) << "All TX nodes filtered";
-                }
+
+                JLOG(journal_.trace()) << "All TX nodes filtered";
             }
         }
     }
@@ -759,7 +788,8 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
 void
 InboundLedger::filterNodes(
     std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
-    TriggerReason reason)
+    TriggerReason reason,
+    std::size_t limit)
 {
     // Sort nodes so that the ones we haven't recently
     // requested come before the ones we have.
@@ -788,9 +818,6 @@ InboundLedger::filterNodes(
         nodes.erase(dup, nodes.end());
     }
 
-    std::size_t const limit =
-        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
-
     if (nodes.size() > limit)
         nodes.resize(limit);
 
@@ -798,6 +825,107 @@ InboundLedger::filterNodes(
         mRecentNodes.insert(n.second);
 }
 
+bool
+InboundLedger::requestNodes(
+    protocol::TMGetLedger& tmGL,
+    std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+    std::shared_ptr<Peer> const& peer,
+    TriggerReason reason)
+{
+    std::size_t const perRequest =
+        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
+
+    std::vector<Peer::id_t> targets;
+    std::size_t capacity = 0;
+    if (peer)
+    {
+        // A peer that keeps answering may have several requests in flight.
+        // If its window is full, wait for a reply before asking again.
+        capacity = mScheduler.capacity(peer->id());
+        if (capacity == 0 && reason == TriggerReason::reply)
+        {
+            JLOG(journal_.trace()) << "Request window full for " << peer->id();
+            return true;
+        }
+        targets.push_back(peer->id());
+    }
+    else
+    {
+        for (auto id : mPeerSet->getPeerIds())
+        {
+            if (app_.overlay().findPeerByShortID(id))
+            {
+                targets.push_back(id);
+                capacity += std::min<std::size_t>(mScheduler.capacity(id), 1);
+            }
+        }
+    }
+
+    filterNodes(nodes, reason, perRequest * std::max<std::size_t>(capacity, 1));
+    if (nodes.empty())
+        return false;
+
+    // Keep each subtree together so that a peer is asked for nearby nodes
+    std::sort(nodes.begin(), nodes.end(), [](auto const& a, auto const& b) {
+        return std::make_pair(a.first.getNodeID(), a.first.getDepth()) <
+            std::make_pair(b.first.getNodeID(), b.first.getDepth());
+    });
+
+    auto send = [&](std::shared_ptr<Peer> const& to, auto first, auto last) {
+        std::vector<SHAMapNodeID> ids;
+        ids.reserve(std::distance(first, last));
+        tmGL.clear_nodeids();
+        for (auto it = first; it != last; ++it)
+        {
+            *(tmGL.add_nodeids()) = it->first.getRawString();
+            ids.push_back(it->first);
+        }
+        mPeerSet->sendRequest(tmGL, to);
+        mScheduler.onRequest(
+            to->id(), tmGL.itype(), std::move(ids), m_clock.now());
+    };
+
+    if (peer)
+    {
+        for (auto it = nodes.begin(); it != nodes.end();)
+        {
+            auto const last =
+                it + std::min<std::ptrdiff_t>(perRequest, nodes.end() - it);
+            send(peer, it, last);
+            it = last;
+        }
+        JLOG(journal_.trace())
+            << "Sending node request (" << nodes.size() << ") to "
+            << peer->id();
+        return true;
+    }
+
+    auto const assigned = mScheduler.assign(nodes, targets, perRequest);
+    if (assigned.empty())
+    {
+        // Every peer is busy. Fall back to asking all of them for the same
+        // nodes, which is what we did before tracking peers.
+        if (nodes.size() > perRequest)
+            nodes.resize(perRequest);
+        tmGL.clear_nodeids();
+        for (auto const& n : nodes)
+            *(tmGL.add_nodeids()) = n.first.getRawString();
+        JLOG(journal_.trace())
+            << "Sending node request (" << nodes.size() << ") to all peers";
+        mPeerSet->sendRequest(tmGL, nullptr);
+        return true;
+    }
+
+    for (auto const& [id, share] : assigned)
+    {
+        if (auto p = app_.overlay().findPeerByShortID(id))
+            send(p, share.begin(), share.end());
+    }
+    JLOG(journal_.trace()) << "Sending node requests (" << nodes.size()
+                           << ") split across " << assigned.size() << " peers";
+    return true;
+}
+
 /** Take ledger header data
     Call with a lock
 */
@@ -850,7 +978,11 @@ InboundLedger::takeHeader(std::string const& data)
     Call with a lock
 */
 void
-InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
+InboundLedger::receiveNode(
+    protocol::TMLedgerData& packet,
+    DecodedNodes const& decoded,
+    NodeStore::Batch& writes,
+    SHAMapAddNode& san)
 {
     if (!mHaveHeader)
     {
@@ -878,33 +1010,41 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
             return {
                 mLedger->txMap(),
                 SHAMapHash{mLedger->info().txHash},
-                std::make_unique<TransactionStateSF>(
-                    mLedger->txMap().family().db(), app_.getLedgerMaster())};
+                std::make_unique<BatchingSF>(
+                    hotTRANSACTION_NODE, app_.getLedgerMaster(), writes)};
         return {
             mLedger->stateMap(),
             SHAMapHash{mLedger->info().accountHash},
-            std::make_unique<AccountStateSF>(
-                mLedger->stateMap().family().db(), app_.getLedgerMaster())};
+            std::make_unique<BatchingSF>(
+                hotACCOUNT_NODE, app_.getLedgerMaster(), writes)};
     }();
 
+    // The nodes were not decoded if the map was complete at the time
+    if (decoded.size() != static_cast<std::size_t>(packet.nodes_size()))
+    {
+        san.incDuplicate();
+        return;
+    }
+
     try
     {
         auto const f = filter.get();
 
-        for (auto const& node : packet.nodes())
+        for (int i = 0; i < packet.nodes_size(); ++i)
         {
-            auto const nodeID = deserializeSHAMapNodeID(node.nodeid());
+            auto const& [nodeID, node] = decoded[i];
 
-            if (!nodeID)
+            if (!nodeID || (!nodeID->isRoot() && !node))
                 throw std::runtime_error("data does not properly deserialize");
 
             if (nodeID->isRoot())
             {
-                san += map.addRootNode(rootHash, makeSlice(node.nodedata()), f);
+                san += map.addRootNode(
+                    rootHash, makeSlice(packet.nodes(i).nodedata()), f);
             }
             else
             {
-                san += map.addKnownNode(*nodeID, makeSlice(node.nodedata()), f);
+                san += map.addKnownNode(*nodeID, node, f);
             }
 
             if (!san.isGood())
@@ -930,6 +1070,8 @@ InboundLedger::receiveNode(protocol::TMLedgerData& packet, SHAMapAddNode& san)
 
         if (mHaveTransactions && mHaveState)
         {
+            // The ledger must be in the node store before it is announced
+            storeNodes(writes, mLedger->info().seq);
             complete_ = true;
             done();
         }
@@ -1045,6 +1187,94 @@ InboundLedger::gotData(
     return true;
 }
 
+InboundLedger::DecodedNode
+InboundLedger::decodeNode(protocol::TMLedgerNode const& node)
+{
+    try
+    {
+        auto nodeID = deserializeSHAMapNodeID(node.nodeid());
+        if (!nodeID)
+            return {};
+
+        // A root node is checked against the ledger header when it is added
+        if (nodeID->isRoot())
+            return {nodeID, {}};
+
+        auto n = SHAMapTreeNode::makeFromWire(makeSlice(node.nodedata()));
+        if (!n)
+            return {};
+        return {nodeID, std::move(n)};
+    }
+    catch (std::exception const&)
+    {
+        return {};
+    }
+}
+
+std::vector<InboundLedger::DecodedNodes>
+InboundLedger::decodeNodes(ReceivedData const& data)
+{
+    std::vector<DecodedNodes> decoded(data.size());
+
+    bool haveState, haveTransactions;
+    {
+        ScopedLockType sl(mtx_);
+        haveState = mHaveState || failed_;
+        haveTransactions = mHaveTransactions || failed_;
+    }
+
+    // Every node to decode, as the message and its index in the message
+    std::vector<std::pair<std::size_t, int>> work;
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        auto const& packet = *data[i].second;
+        if ((packet.type() == protocol::liTX_NODE && !haveTransactions) ||
+            (packet.type() == protocol::liAS_NODE && !haveState))
+        {
+            decoded[i].resize(packet.nodes_size());
+            for (int j = 0; j < packet.nodes_size(); ++j)
+                work.emplace_back(i, j);
+        }
+    }
+
+    std::atomic<std::size_t> next = 0;
+    auto const worker = [&]() {
+        for (std::size_t w = next++; w < work.size(); w = next++)
+        {
+            auto const [i, j] = work[w];
+            decoded[i][j] = decodeNode(data[i].second->nodes(j));
+        }
+    };
+
+    auto const threads = std::min<std::size_t>(
+        {decodeThreadsMax,
+         std::max(std::thread::hardware_concurrency(), 1u),
+         work.size() / decodeNodesPerThread});
+
+    std::vector<std::thread> helpers;
+    if (threads > 1)
+    {
+        helpers.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t)
+            helpers.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : helpers)
+        t.join();
+
+    return decoded;
+}
+
+void
+InboundLedger::storeNodes(NodeStore::Batch& writes, std::uint32_t seq)
+{
+    if (writes.empty())
+        return;
+
+    app_.getNodeStore().storeBatch(writes, seq);
+    writes.clear();
+}
+
 /** Process one TMLedgerData
     Returns the number of useful nodes
 */
@@ -1056,7 +1286,8 @@ InboundLedger::gotData(
 int
 InboundLedger::processData(
     std::shared_ptr<Peer> peer,
-    protocol::TMLedgerData& packet)
+    protocol::TMLedgerData& packet,
+    DecodedNodes const& decoded)
 {
     if (packet.type() == protocol::liBASE)
     {
@@ -1125,8 +1356,6 @@ InboundLedger::processData(
             return -1;
         }
 
-        ScopedLockType sl(mtx_);
-
         // Verify node IDs and data are complete
         for (auto const& node : packet.nodes())
         {
@@ -1139,17 +1368,38 @@ InboundLedger::processData(
         }
 
         SHAMapAddNode san;
-        receiveNode(packet, san);
-
-        JLOG(journal_.debug())
-            << "Ledger "
-            << ((packet.type() == protocol::liTX_NODE) ? "TX" : "AS")
-            << " node stats: " << san.get();
-
-        if (san.isUseful())
-            progress_ = true;
+        NodeStore::Batch writes;
+        std::uint32_t seq = 0;
+        {
+            ScopedLockType sl(mtx_);
+
+            receiveNode(packet, decoded, writes, san);
+            if (auto const first =
+                    deserializeSHAMapNodeID(packet.nodes(0).nodeid()))
+                mScheduler.onReply(
+                    peer->id(),
+                    packet.type(),
+                    *first,
+                    san.getGood(),
+                    packet.ByteSizeLong(),
+                    m_clock.now());
+
+            JLOG(journal_.debug())
+                << "Ledger "
+                << ((packet.type() == protocol::liTX_NODE) ? "TX" : "AS")
+                << " node stats: " << san.get();
+
+            if (san.isUseful())
+                progress_ = true;
+
+            mStats += san;
+            if (mHaveHeader)
+                seq = mLedger->info().seq;
+        }
 
-        mStats += san;
+        // The nodes are in the map already, so other threads can use them
+        // while they are written.
+        storeNodes(writes, seq);
         return san.getGood();
     }
 
@@ -1239,7 +1489,7 @@ InboundLedger::runData()
     // Maximum number of peers to request data from
     constexpr std::size_t maxUsefulPeers = 6;
 
-    decltype(mReceivedData) data;
+    ReceivedData data;
 
     // Reserve some memory so the first couple iterations don't reallocate
     data.reserve(8);
@@ -1262,11 +1512,15 @@ InboundLedger::runData()
             data.swap(mReceivedData);
         }
 
-        for (auto& entry : data)
+        // Decode and hash the nodes before taking the ledger's lock, so
+        // that the lock is only held to hook them into the maps.
+        auto const decoded = decodeNodes(data);
+
+        for (std::size_t i = 0; i < data.size(); ++i)
         {
-            if (auto peer = entry.first.lock())
+            if (auto peer = data[i].first.lock())
             {
-                int count = processData(peer, *(entry.second));
+                int count = processData(peer, *data[i].second, decoded[i]);
                 dataCounts.update(std::move(peer), count);
             }
         }
@@ -1308,6 +1562,10 @@ InboundLedger::getJson(int)
 
     ret[jss::timeouts] = timeouts_;
 
+    auto const acquired = mScheduler.getJson(m_clock.now());
+    for (auto const& name : acquired.getMemberNames())
+        ret[name] = acquired[name];
+
     if (mHaveHeader && !mHaveState)
     {
         Json::Value hv(Json::arrayValue);
@@ -18,443 +18,717 @@
 //==============================================================================
 
 #include <xrpld/app/ledger/InboundLedgers.h>
-#include <xrpld/app/ledger/LedgerCleaner.h>
 #include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/ledger/detail/LedgerCleanerImp.h>
 #include <xrpld/app/misc/LoadFeeTrack.h>
+#include <xrpld/core/ConfigSections.h>
 #include <xrpl/beast/core/CurrentThreadName.h>
+#include <xrpl/json/json_reader.h>
+#include <xrpl/json/to_string.h>
 #include <xrpl/protocol/jss.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
 
 namespace ripple {
 
-/*
+LedgerCleanerImp::LedgerCleanerImp(
+    Application& app,
+    Section const& config,
+    beast::Journal journal)
+    : app_(app)
+    , j_(journal)
+    , threads_(std::max<std::size_t>(config.value_or("threads", 1), 1))
+    , maxLedgersPerSecond_(config.value_or("max_ledgers_per_second", 10))
+{
+    boost::filesystem::path const dir(app_.config().legacy("database_path"));
+    if (auto const path = config.get<std::string>("checkpoint"); path)
+    {
+        boost::filesystem::path p(*path);
+        if (p.is_relative())
+            p = dir / p;
+        checkpointPath_ = p.string();
+    }
+    else if (!dir.empty() && !app_.config().standalone())
+    {
+        checkpointPath_ = (dir / "ledger_cleaner.json").string();
+    }
+}
+
+LedgerCleanerImp::~LedgerCleanerImp()
+{
+    if (thread_.joinable())
+        LogicError("LedgerCleanerImp::stop not called.");
+}
 
-LedgerCleaner
+void
+LedgerCleanerImp::start()
+{
+    resume();
+    thread_ = std::thread{&LedgerCleanerImp::run, this};
+}
 
-Cleans up the ledger. Specifically, resolves these issues:
+void
+LedgerCleanerImp::stop()
+{
+    JLOG(j_.info()) << "Stopping";
+    {
+        std::lock_guard lock(mutex_);
+        shouldExit_ = true;
+        wakeup_.notify_all();
+    }
+    thread_.join();
+}
 
-1. Older versions could leave the SQLite account and transaction databases in
-   an inconsistent state. The cleaner identifies these inconsistencies and
-   resolves them.
+//------------------------------------------------------------------------------
+//
+// PropertyStream
+//
+//------------------------------------------------------------------------------
 
-2. Upon request, checks for missing nodes in a ledger and triggers a fetch.
+void
+LedgerCleanerImp::onWrite(beast::PropertyStream::Map& map)
+{
+    std::lock_guard lock(mutex_);
 
-*/
+    if (maxRange_ == 0)
+        map["status"] = "idle";
+    else
+    {
+        map["status"] = "running";
+        map["min_ledger"] = minRange_;
+        map["max_ledger"] = maxRange_;
+        map["check_nodes"] = checkNodes_ ? "true" : "false";
+        map["fix_txns"] = fixTxns_ ? "true" : "false";
+        map["threads"] = threads_;
+        map["ledgers_cleaned"] = cleaned_;
+        map["ledgers_per_second"] = rate(clock_type::now());
+        if (failures_ > 0)
+            map["fail_counts"] = failures_;
+    }
+}
 
-class LedgerCleanerImp : public LedgerCleaner
+//------------------------------------------------------------------------------
+//
+// LedgerCleaner
+//
+//------------------------------------------------------------------------------
+
+void
+LedgerCleanerImp::clean(Json::Value const& params)
 {
-    Application& app_;
-    beast::Journal const j_;
-    mutable std::mutex mutex_;
+    LedgerIndex minRange = 0;
+    LedgerIndex maxRange = 0;
+    app_.getLedgerMaster().getFullValidatedRange(minRange, maxRange);
 
-    mutable std::condition_variable wakeup_;
+    {
+        std::lock_guard lock(mutex_);
 
-    std::thread thread_;
+        maxRange_ = maxRange;
+        minRange_ = minRange;
+        checkNodes_ = false;
+        fixTxns_ = false;
+        failures_ = 0;
 
-    enum class State : char { notCleaning = 0, cleaning };
-    State state_ = State::notCleaning;
-    bool shouldExit_ = false;
+        /*
+        JSON Parameters:
 
-    // The lowest ledger in the range we're checking.
-    LedgerIndex minRange_ = 0;
+            All parameters are optional. By default the cleaner cleans
+            things it thinks are necessary. This behavior can be modified
+            using the following options supplied via JSON RPC:
 
-    // The highest ledger in the range we're checking
-    LedgerIndex maxRange_ = 0;
+            "ledger"
+                A single unsigned integer representing an individual
+                ledger to clean.
 
-    // Check all state/transaction nodes
-    bool checkNodes_ = false;
+            "min_ledger", "max_ledger"
+                Unsigned integers representing the starting and ending
+                ledger numbers to clean. If unspecified, clean all ledgers.
 
-    // Rewrite SQL databases
-    bool fixTxns_ = false;
+            "full"
+                A boolean. When true, means clean everything possible.
 
-    // Number of errors encountered since last success
-    int failures_ = 0;
+            "fix_txns"
+                A boolean value indicating whether or not to fix the
+                transactions in the database as well.
 
-    //--------------------------------------------------------------------------
-public:
-    LedgerCleanerImp(Application& app, beast::Journal journal)
-        : app_(app), j_(journal)
-    {
+            "check_nodes"
+                A boolean, when set to true means check the nodes.
+
+            "stop"
+                A boolean, when true informs the cleaner to gracefully
+                stop its current activities if any cleaning is taking place.
+        */
+
+        // Quick way to fix a single ledger
+        if (params.isMember(jss::ledger))
+        {
+            maxRange_ = params[jss::ledger].asUInt();
+            minRange_ = params[jss::ledger].asUInt();
+            fixTxns_ = true;
+            checkNodes_ = true;
+        }
+
+        if (params.isMember(jss::max_ledger))
+            maxRange_ = params[jss::max_ledger].asUInt();
+
+        if (params.isMember(jss::min_ledger))
+            minRange_ = params[jss::min_ledger].asUInt();
+
+        if (params.isMember(jss::full))
+            fixTxns_ = checkNodes_ = params[jss::full].asBool();
+
+        if (params.isMember(jss::fix_txns))
+            fixTxns_ = params[jss::fix_txns].asBool();
+
+        if (params.isMember(jss::check_nodes))
+            checkNodes_ = params[jss::check_nodes].asBool();
+
+        if (params.isMember(jss::stop) && params[jss::stop].asBool())
+            minRange_ = maxRange_ = 0;
+
+        restart();
     }
 
-    ~LedgerCleanerImp() override
+    saveCheckpoint();
+}
+
+Json::Value
+LedgerCleanerImp::getJson() const
+{
+    Json::Value ret(Json::objectValue);
+    std::lock_guard lock(mutex_);
+
+    ret[jss::threads] = static_cast<Json::UInt>(threads_);
+    if (maxRange_ == 0)
     {
-        if (thread_.joinable())
-            LogicError("LedgerCleanerImp::stop not called.");
+        ret[jss::state] = "idle";
+        return ret;
     }
 
-    void
-    start() override
+    ret[jss::state] = "running";
+    ret[jss::min_ledger] = minRange_;
+    ret[jss::max_ledger] = maxRange_;
+    ret[jss::check_nodes] = checkNodes_;
+    ret[jss::fix_txns] = fixTxns_;
+    ret[jss::ledgers_cleaned] = static_cast<Json::UInt>(cleaned_);
+    ret[jss::ledgers_per_second] = rate(clock_type::now());
+    if (failures_ > 0)
+        ret[jss::fail_counts] = failures_;
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+//
+// LedgerCleanerImp
+//
+//------------------------------------------------------------------------------
+/** Start the workers over on the current range.
+    The caller must hold the mutex.
+*/
+void
+LedgerCleanerImp::restart()
+{
+    ++generation_;
+    next_ = maxRange_;
+    batches_.clear();
+    cleaned_ = 0;
+    started_ = clock_type::now();
+    nextStart_ = started_;
+    state_ = State::cleaning;
+    wakeup_.notify_all();
+}
+
+/** The ledgers cleaned per second since the range was set.
+    The caller must hold the mutex.
+*/
+double
+LedgerCleanerImp::rate(clock_type::time_point now) const
+{
+    using namespace std::chrono;
+    auto const elapsed = duration_cast<duration<double>>(now - started_);
+    if (elapsed.count() <= 0)
+        return 0;
+    return cleaned_ / elapsed.count();
+}
+
+// Pick up the range saved by a previous run, if any.
+void
+LedgerCleanerImp::resume()
+{
+    if (checkpointPath_.empty())
+        return;
+
+    std::ifstream in(checkpointPath_);
+    if (!in)
+        return;
+
+    std::stringstream ss;
+    ss << in.rdbuf();
+
+    Json::Value checkpoint;
+    if (!Json::Reader().parse(ss.str(), checkpoint) ||
+        !checkpoint.isObject() ||
+        !checkpoint[jss::min_ledger].isIntegral() ||
+        !checkpoint[jss::max_ledger].isIntegral())
     {
-        thread_ = std::thread{&LedgerCleanerImp::run, this};
+        JLOG(j_.warn()) << "Ignoring damaged checkpoint "
+                        << checkpointPath_;
+        return;
     }
 
-    void
-    stop() override
+    std::lock_guard lock(mutex_);
+    minRange_ = checkpoint[jss::min_ledger].asUInt();
+    maxRange_ = checkpoint[jss::max_ledger].asUInt();
+    checkNodes_ = checkpoint[jss::check_nodes].asBool();
+    fixTxns_ = checkpoint[jss::fix_txns].asBool();
+    if ((minRange_ > maxRange_) || (maxRange_ == 0) || (minRange_ == 0))
     {
-        JLOG(j_.info()) << "Stopping";
-        {
-            std::lock_guard lock(mutex_);
-            shouldExit_ = true;
-            wakeup_.notify_one();
-        }
-        thread_.join();
+        minRange_ = maxRange_ = 0;
+        return;
     }
 
-    //--------------------------------------------------------------------------
-    //
-    // PropertyStream
-    //
-    //--------------------------------------------------------------------------
+    JLOG(j_.info()) << "Resuming at ledger " << maxRange_ << " down to "
+                    << minRange_;
+    restart();
+}
+
+/** Save the remaining range, or remove the checkpoint if none is left.
+    The caller must not hold the mutex.
+*/
+void
+LedgerCleanerImp::saveCheckpoint()
+{
+    if (checkpointPath_.empty())
+        return;
 
-    void
-    onWrite(beast::PropertyStream::Map& map) override
+    Json::Value checkpoint(Json::objectValue);
     {
         std::lock_guard lock(mutex_);
-
-        if (maxRange_ == 0)
-            map["status"] = "idle";
-        else
+        lastCheckpoint_ = clock_type::now();
+        if (maxRange_ != 0 && minRange_ != 0 && minRange_ <= maxRange_)
         {
-            map["status"] = "running";
-            map["min_ledger"] = minRange_;
-            map["max_ledger"] = maxRange_;
-            map["check_nodes"] = checkNodes_ ? "true" : "false";
-            map["fix_txns"] = fixTxns_ ? "true" : "false";
-            if (failures_ > 0)
-                map["fail_counts"] = failures_;
+            checkpoint[jss::min_ledger] = minRange_;
+            checkpoint[jss::max_ledger] = maxRange_;
+            checkpoint[jss::check_nodes] = checkNodes_;
+            checkpoint[jss::fix_txns] = fixTxns_;
         }
     }
 
-    //--------------------------------------------------------------------------
-    //
-    // LedgerCleaner
-    //
-    //--------------------------------------------------------------------------
-
-    void
-    clean(Json::Value const& params) override
+    std::lock_guard lock(checkpointMutex_);
+    boost::system::error_code ec;
+    if (checkpoint.size() == 0)
     {
-        LedgerIndex minRange = 0;
-        LedgerIndex maxRange = 0;
-        app_.getLedgerMaster().getFullValidatedRange(minRange, maxRange);
+        boost::filesystem::remove(checkpointPath_, ec);
+        return;
+    }
 
+    // Write a new file and rename it, so that a crash never leaves a
+    // truncated checkpoint behind.
+    auto const partial = checkpointPath_ + ".partial";
+    {
+        std::ofstream out(partial, std::ios::out | std::ios::trunc);
+        out << to_string(checkpoint);
+        if (!out)
         {
-            std::lock_guard lock(mutex_);
-
-            maxRange_ = maxRange;
-            minRange_ = minRange;
-            checkNodes_ = false;
-            fixTxns_ = false;
-            failures_ = 0;
-
-            /*
-            JSON Parameters:
-
-                All parameters are optional. By default the cleaner cleans
-                things it thinks are necessary. This behavior can be modified
-                using the following options supplied via JSON RPC:
-
-                "ledger"
-                    A single unsigned integer representing an individual
-                    ledger to clean.
+            JLOG(j_.warn()) << "Unable to write checkpoint " << partial;
+            return;
+        }
+    }
 
-                "min_ledger", "max_ledger"
-                    Unsigned integers representing the starting and ending
-                    ledger numbers to clean. If unspecified, clean all ledgers.
+    boost::filesystem::rename(partial, checkpointPath_, ec);
+    if (ec)
+    {
+        JLOG(j_.warn()) << "Unable to rename " << partial << " to "
+                        << checkpointPath_ << ": " << ec.message();
+    }
+}
 
-                "full"
-                    A boolean. When true, means clean everything possible.
+void
+LedgerCleanerImp::run()
+{
+    beast::setCurrentThreadName("LedgerCleaner");
+    JLOG(j_.debug()) << "Started";
 
-                "fix_txns"
-                    A boolean value indicating whether or not to fix the
-                    transactions in the database as well.
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeup_.wait(lock, [this]() {
+                return (shouldExit_ || state_ == State::cleaning);
+            });
+            if (shouldExit_)
+                break;
+            assert(state_ == State::cleaning);
+        }
+        doLedgerCleaner();
+    }
 
-                "check_nodes"
-                    A boolean, when set to true means check the nodes.
+    // Keep the progress for the next run
+    saveCheckpoint();
+}
 
-                "stop"
-                    A boolean, when true informs the cleaner to gracefully
-                    stop its current activities if any cleaning is taking place.
-            */
+// VFALCO TODO This should return std::optional<uint256>
+LedgerHash
+LedgerCleanerImp::getLedgerHash(
+    std::shared_ptr<ReadView const>& ledger,
+    LedgerIndex index)
+{
+    std::optional<LedgerHash> hash;
+    try
+    {
+        hash = hashOfSeq(*ledger, index, j_);
+    }
+    catch (SHAMapMissingNode const& mn)
+    {
+        JLOG(j_.warn())
+            << "Ledger #" << ledger->info().seq << ": " << mn.what();
+        app_.getInboundLedgers().acquire(
+            ledger->info().hash,
+            ledger->info().seq,
+            InboundLedger::Reason::GENERIC);
+    }
+    return hash ? *hash : beast::zero;  // kludge
+}
 
-            // Quick way to fix a single ledger
-            if (params.isMember(jss::ledger))
-            {
-                maxRange_ = params[jss::ledger].asUInt();
-                minRange_ = params[jss::ledger].asUInt();
-                fixTxns_ = true;
-                checkNodes_ = true;
-            }
+/** Process a single ledger
+    @param ledgerIndex The index of the ledger to process.
+    @param ledgerHash  The known correct hash of the ledger.
+    @param doNodes Ensure all ledger nodes are in the node db.
+    @param doTxns Reprocess (account) transactions to SQL databases.
+    @return `true` if the ledger was cleaned.
+*/
+bool
+LedgerCleanerImp::doLedger(
+    LedgerIndex const& ledgerIndex,
+    LedgerHash const& ledgerHash,
+    bool doNodes,
+    bool doTxns)
+{
+    auto nodeLedger = app_.getInboundLedgers().acquire(
+        ledgerHash, ledgerIndex, InboundLedger::Reason::GENERIC);
+    if (!nodeLedger)
+    {
+        JLOG(j_.debug()) << "Ledger " << ledgerIndex << " not available";
+        app_.getLedgerMaster().clearLedger(ledgerIndex);
+        app_.getInboundLedgers().acquire(
+            ledgerHash, ledgerIndex, InboundLedger::Reason::GENERIC);
+        return false;
+    }
 
-            if (params.isMember(jss::max_ledger))
-                maxRange_ = params[jss::max_ledger].asUInt();
+    auto dbLedger = loadByIndex(ledgerIndex, app_);
+    if (!dbLedger || (dbLedger->info().hash != ledgerHash) ||
+        (dbLedger->info().parentHash != nodeLedger->info().parentHash))
+    {
+        // Ideally we'd also check for more than one ledger with that index
+        JLOG(j_.debug())
+            << "Ledger " << ledgerIndex << " mismatches SQL DB";
+        doTxns = true;
+    }
 
-            if (params.isMember(jss::min_ledger))
-                minRange_ = params[jss::min_ledger].asUInt();
+    if (!app_.getLedgerMaster().fixIndex(ledgerIndex, ledgerHash))
+    {
+        JLOG(j_.debug())
+            << "ledger " << ledgerIndex << " had wrong entry in history";
+        doTxns = true;
+    }
 
-            if (params.isMember(jss::full))
-                fixTxns_ = checkNodes_ = params[jss::full].asBool();
+    if (doNodes && !nodeLedger->walkLedger(app_.journal("Ledger")))
+    {
+        JLOG(j_.debug()) << "Ledger " << ledgerIndex << " is missing nodes";
+        app_.getLedgerMaster().clearLedger(ledgerIndex);
+        app_.getInboundLedgers().acquire(
+            ledgerHash, ledgerIndex, InboundLedger::Reason::GENERIC);
+        return false;
+    }
 
-            if (params.isMember(jss::fix_txns))
-                fixTxns_ = params[jss::fix_txns].asBool();
+    if (doTxns && !pendSaveValidated(app_, nodeLedger, true, false))
+    {
+        JLOG(j_.debug()) << "Failed to save ledger " << ledgerIndex;
+        return false;
+    }
 
-            if (params.isMember(jss::check_nodes))
-                checkNodes_ = params[jss::check_nodes].asBool();
+    return true;
+}
 
-            if (params.isMember(jss::stop) && params[jss::stop].asBool())
-                minRange_ = maxRange_ = 0;
+/** Returns the hash of the specified ledger.
+    @param ledgerIndex The index of the desired ledger.
+    @param referenceLedger [out] An optional known good subsequent ledger.
+    @return The hash of the ledger. This will be all-bits-zero if not found.
+*/
+LedgerHash
+LedgerCleanerImp::getHash(
+    LedgerIndex const& ledgerIndex,
+    std::shared_ptr<ReadView const>& referenceLedger)
+{
+    LedgerHash ledgerHash;
 
-            state_ = State::cleaning;
-            wakeup_.notify_one();
+    if (!referenceLedger || (referenceLedger->info().seq < ledgerIndex))
+    {
+        referenceLedger = app_.getLedgerMaster().getValidatedLedger();
+        if (!referenceLedger)
+        {
+            JLOG(j_.warn()) << "No validated ledger";
+            return ledgerHash;  // Nothing we can do. No validated ledger.
         }
     }
 
-    //--------------------------------------------------------------------------
-    //
-    // LedgerCleanerImp
-    //
-    //--------------------------------------------------------------------------
-private:
-    void
-    run()
+    if (referenceLedger->info().seq >= ledgerIndex)
     {
-        beast::setCurrentThreadName("LedgerCleaner");
-        JLOG(j_.debug()) << "Started";
-
-        while (true)
+        // See if the hash for the ledger we need is in the reference ledger
+        ledgerHash = getLedgerHash(referenceLedger, ledgerIndex);
+        if (ledgerHash.isZero())
         {
+            // No. Try to get another ledger that might have the hash we
+            // need: compute the index and hash of a ledger that will have
+            // the hash we need.
+            LedgerIndex refIndex = getCandidateLedger(ledgerIndex);
+            LedgerHash refHash = getLedgerHash(referenceLedger, refIndex);
+
+            bool const nonzero(refHash.isNonZero());
+            assert(nonzero);
+            if (nonzero)
             {
-                std::unique_lock<std::mutex> lock(mutex_);
-                state_ = State::notCleaning;
-                wakeup_.wait(lock, [this]() {
-                    return (shouldExit_ || state_ == State::cleaning);
-                });
-                if (shouldExit_)
-                    break;
-                assert(state_ == State::cleaning);
+                // We found the hash and sequence of a better reference
+                // ledger.
+                referenceLedger = app_.getInboundLedgers().acquire(
+                    refHash, refIndex, InboundLedger::Reason::GENERIC);
+                if (referenceLedger)
+                    ledgerHash =
+                        getLedgerHash(referenceLedger, ledgerIndex);
             }
-            doLedgerCleaner();
         }
     }
+    else
+        JLOG(j_.warn()) << "Validated ledger is prior to target ledger";
+
+    return ledgerHash;
+}
+
+/** Wait until the given time.
+    @return `false` if the cleaner is stopping or the range was replaced.
+*/
+bool
+LedgerCleanerImp::waitUntil(
+    std::unique_lock<std::mutex>& lock,
+    clock_type::time_point when,
+    std::uint64_t generation)
+{
+    return !wakeup_.wait_until(lock, when, [this, generation] {
+        return shouldExit_ || generation_ != generation;
+    });
+}
+
+bool
+LedgerCleanerImp::waitFor(
+    clock_type::duration delay,
+    std::uint64_t generation)
+{
+    std::unique_lock lock(mutex_);
+    return waitUntil(lock, clock_type::now() + delay, generation);
+}
+
+bool
+LedgerCleanerImp::cleanOne(
+    LedgerIndex ledgerIndex,
+    std::shared_ptr<ReadView const>& goodLedger,
+    bool doNodes,
+    bool doTxns)
+{
+    auto const ledgerHash = getHash(ledgerIndex, goodLedger);
+
+    if (ledgerHash.isZero())
+    {
+        JLOG(j_.info()) << "Unable to get hash for ledger " << ledgerIndex;
+        return false;
+    }
 
-    // VFALCO TODO This should return std::optional<uint256>
-    LedgerHash
-    getLedgerHash(std::shared_ptr<ReadView const>& ledger, LedgerIndex index)
+    if (!doLedger(ledgerIndex, ledgerHash, doNodes, doTxns))
     {
-        std::optional<LedgerHash> hash;
-        try
-        {
-            hash = hashOfSeq(*ledger, index, j_);
-        }
-        catch (SHAMapMissingNode const& mn)
-        {
-            JLOG(j_.warn())
-                << "Ledger #" << ledger->info().seq << ": " << mn.what();
-            app_.getInboundLedgers().acquire(
-                ledger->info().hash,
-                ledger->info().seq,
-                InboundLedger::Reason::GENERIC);
-        }
-        return hash ? *hash : beast::zero;  // kludge
+        JLOG(j_.info()) << "Failed to process ledger " << ledgerIndex;
+        return false;
     }
 
-    /** Process a single ledger
-        @param ledgerIndex The index of the ledger to process.
-        @param ledgerHash  The known correct hash of the ledger.
-        @param doNodes Ensure all ledger nodes are in the node db.
-        @param doTxns Reprocess (account) transactions to SQL databases.
-        @return `true` if the ledger was cleaned.
-    */
-    bool
-    doLedger(
-        LedgerIndex const& ledgerIndex,
-        LedgerHash const& ledgerHash,
-        bool doNodes,
-        bool doTxns)
+    return true;
+}
+
+/** Clean one ledger, retrying until it succeeds.
+    @return `false` if the cleaner is stopping or the range was replaced.
+*/
+bool
+LedgerCleanerImp::cleanLedger(
+    LedgerIndex ledgerIndex,
+    std::shared_ptr<ReadView const>& goodLedger,
+    bool doNodes,
+    bool doTxns,
+    std::uint64_t generation)
+{
+    while (true)
     {
-        auto nodeLedger = app_.getInboundLedgers().acquire(
-            ledgerHash, ledgerIndex, InboundLedger::Reason::GENERIC);
-        if (!nodeLedger)
         {
-            JLOG(j_.debug()) << "Ledger " << ledgerIndex << " not available";
-            app_.getLedgerMaster().clearLedger(ledgerIndex);
-            app_.getInboundLedgers().acquire(
-                ledgerHash, ledgerIndex, InboundLedger::Reason::GENERIC);
-            return false;
+            std::lock_guard lock(mutex_);
+            if (shouldExit_ || generation_ != generation)
+                return false;
         }
 
-        auto dbLedger = loadByIndex(ledgerIndex, app_);
-        if (!dbLedger || (dbLedger->info().hash != ledgerHash) ||
-            (dbLedger->info().parentHash != nodeLedger->info().parentHash))
+        if (app_.getFeeTrack().isLoadedLocal())
         {
-            // Ideally we'd also check for more than one ledger with that index
-            JLOG(j_.debug())
-                << "Ledger " << ledgerIndex << " mismatches SQL DB";
-            doTxns = true;
+            JLOG(j_.debug()) << "Waiting for load to subside";
+            if (!waitFor(std::chrono::seconds(5), generation))
+                return false;
+            continue;
         }
 
-        if (!app_.getLedgerMaster().fixIndex(ledgerIndex, ledgerHash))
+        // Stay within the I/O budget shared by all the workers
+        if (maxLedgersPerSecond_ != 0)
         {
-            JLOG(j_.debug())
-                << "ledger " << ledgerIndex << " had wrong entry in history";
-            doTxns = true;
+            std::unique_lock lock(mutex_);
+            auto const when = std::max(clock_type::now(), nextStart_);
+            nextStart_ = when +
+                clock_type::duration(std::chrono::seconds(1)) /
+                    maxLedgersPerSecond_;
+            if (!waitUntil(lock, when, generation))
+                return false;
         }
 
-        if (doNodes && !nodeLedger->walkLedger(app_.journal("Ledger")))
-        {
-            JLOG(j_.debug()) << "Ledger " << ledgerIndex << " is missing nodes";
-            app_.getLedgerMaster().clearLedger(ledgerIndex);
-            app_.getInboundLedgers().acquire(
-                ledgerHash, ledgerIndex, InboundLedger::Reason::GENERIC);
-            return false;
-        }
+        if (cleanOne(ledgerIndex, goodLedger, doNodes, doTxns))
+            return true;
 
-        if (doTxns && !pendSaveValidated(app_, nodeLedger, true, false))
         {
-            JLOG(j_.debug()) << "Failed to save ledger " << ledgerIndex;
-            return false;
+            std::lock_guard lock(mutex_);
+            ++failures_;
         }
-
-        return true;
+        // Wait for acquiring to catch up to us
+        if (!waitFor(std::chrono::seconds(2), generation))
+            return false;
     }
+}
 
-    /** Returns the hash of the specified ledger.
-        @param ledgerIndex The index of the desired ledger.
-        @param referenceLedger [out] An optional known good subsequent ledger.
-        @return The hash of the ledger. This will be all-bits-zero if not found.
-    */
-    LedgerHash
-    getHash(
-        LedgerIndex const& ledgerIndex,
-        std::shared_ptr<ReadView const>& referenceLedger)
+/** Record that a ledger of a batch was cleaned.
+    @param top The highest ledger of the batch.
+    @param remaining The highest ledger of the batch still to be
+                     cleaned, or 0 if the whole batch was.
+*/
+void
+LedgerCleanerImp::onCleaned(
+    LedgerIndex top,
+    LedgerIndex remaining,
+    std::uint64_t generation)
+{
+    bool save = false;
     {
-        LedgerHash ledgerHash;
+        std::lock_guard lock(mutex_);
+        if (generation != generation_)
+            return;
 
-        if (!referenceLedger || (referenceLedger->info().seq < ledgerIndex))
-        {
-            referenceLedger = app_.getLedgerMaster().getValidatedLedger();
-            if (!referenceLedger)
-            {
-                JLOG(j_.warn()) << "No validated ledger";
-                return ledgerHash;  // Nothing we can do. No validated ledger.
-            }
-        }
+        ++cleaned_;
+        failures_ = 0;
+        batches_[top] = remaining;
 
-        if (referenceLedger->info().seq >= ledgerIndex)
-        {
-            // See if the hash for the ledger we need is in the reference ledger
-            ledgerHash = getLedgerHash(referenceLedger, ledgerIndex);
-            if (ledgerHash.isZero())
-            {
-                // No. Try to get another ledger that might have the hash we
-                // need: compute the index and hash of a ledger that will have
-                // the hash we need.
-                LedgerIndex refIndex = getCandidateLedger(ledgerIndex);
-                LedgerHash refHash = getLedgerHash(referenceLedger, refIndex);
-
-                bool const nonzero(refHash.isNonZero());
-                assert(nonzero);
-                if (nonzero)
-                {
-                    // We found the hash and sequence of a better reference
-                    // ledger.
-                    referenceLedger = app_.getInboundLedgers().acquire(
-                        refHash, refIndex, InboundLedger::Reason::GENERIC);
-                    if (referenceLedger)
-                        ledgerHash =
-                            getLedgerHash(referenceLedger, ledgerIndex);
-                }
-            }
-        }
-        else
-            JLOG(j_.warn()) << "Validated ledger is prior to target ledger";
+        // Every ledger above the highest unfinished batch is clean
+        while (!batches_.empty() && batches_.rbegin()->second == 0)
+            batches_.erase(std::prev(batches_.end()));
+        maxRange_ = batches_.empty() ? next_ : batches_.rbegin()->second;
 
-        return ledgerHash;
+        save = clock_type::now() - lastCheckpoint_ >= checkpointInterval;
     }
 
-    /** Run the ledger cleaner. */
-    void
-    doLedgerCleaner()
-    {
-        auto shouldExit = [this] {
-            std::lock_guard lock(mutex_);
-            return shouldExit_;
-        };
+    if (save)
+        saveCheckpoint();
+}
+
+void
+LedgerCleanerImp::worker()
+{
+    beast::setCurrentThreadName("LedgerCleaner");
 
-        std::shared_ptr<ReadView const> goodLedger;
+    std::shared_ptr<ReadView const> goodLedger;
+
+    while (true)
+    {
+        LedgerIndex top;
+        LedgerIndex bottom;
+        bool doNodes;
+        bool doTxns;
+        std::uint64_t generation;
 
-        while (!shouldExit())
         {
-            LedgerIndex ledgerIndex;
-            LedgerHash ledgerHash;
-            bool doNodes;
-            bool doTxns;
+            std::lock_guard lock(mutex_);
+            if (shouldExit_ || (minRange_ > maxRange_) ||
+                (maxRange_ == 0) || (minRange_ == 0) ||
+                (next_ < minRange_))
+                return;
+
+            top = next_;
+            bottom = (top - minRange_ >= batchSize) ? top - batchSize + 1
+                                                     : minRange_;
+            next_ = bottom - 1;
+            batches_.emplace(top, top);
+            doNodes = checkNodes_;
+            doTxns = fixTxns_;
+            generation = generation_;
+        }
 
-            if (app_.getFeeTrack().isLoadedLocal())
-            {
-                JLOG(j_.debug()) << "Waiting for load to subside";
-                std::this_thread::sleep_for(std::chrono::seconds(5));
-                continue;
-            }
+        for (auto ledgerIndex = top; ledgerIndex >= bottom; --ledgerIndex)
+        {
+            if (!cleanLedger(
+                    ledgerIndex, goodLedger, doNodes, doTxns, generation))
+                break;
 
-            {
-                std::lock_guard lock(mutex_);
-                if ((minRange_ > maxRange_) || (maxRange_ == 0) ||
-                    (minRange_ == 0))
-                {
-                    minRange_ = maxRange_ = 0;
-                    return;
-                }
-                ledgerIndex = maxRange_;
-                doNodes = checkNodes_;
-                doTxns = fixTxns_;
-            }
+            onCleaned(
+                top,
+                ledgerIndex == bottom ? 0 : ledgerIndex - 1,
+                generation);
 
-            ledgerHash = getHash(ledgerIndex, goodLedger);
+            if (ledgerIndex == bottom)
+                break;
+        }
+    }
+}
 
-            bool fail = false;
-            if (ledgerHash.isZero())
-            {
-                JLOG(j_.info())
-                    << "Unable to get hash for ledger " << ledgerIndex;
-                fail = true;
-            }
-            else if (!doLedger(ledgerIndex, ledgerHash, doNodes, doTxns))
-            {
-                JLOG(j_.info()) << "Failed to process ledger " << ledgerIndex;
-                fail = true;
-            }
+/** Run the ledger cleaner. */
+void
+LedgerCleanerImp::doLedgerCleaner()
+{
+    std::vector<std::thread> workers;
+    workers.reserve(threads_ - 1);
+    for (std::size_t i = 1; i < threads_; ++i)
+        workers.emplace_back(&LedgerCleanerImp::worker, this);
+    worker();
+    for (auto& w : workers)
+        w.join();
+
+    bool done = false;
+    {
+        std::lock_guard lock(mutex_);
+        if (shouldExit_)
+            return;
 
-            if (fail)
-            {
-                {
-                    std::lock_guard lock(mutex_);
-                    ++failures_;
-                }
-                // Wait for acquiring to catch up to us
-                std::this_thread::sleep_for(std::chrono::seconds(2));
-            }
-            else
-            {
-                {
-                    std::lock_guard lock(mutex_);
-                    if (ledgerIndex == minRange_)
-                        ++minRange_;
-                    if (ledgerIndex == maxRange_)
-                        --maxRange_;
-                    failures_ = 0;
-                }
-                // Reduce I/O pressure and wait for acquiring to catch up to us
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
+        // The range may have been replaced after the workers ran out
+        // of ledgers.
+        if ((minRange_ > maxRange_) || (maxRange_ == 0) ||
+            (minRange_ == 0))
+        {
+            JLOG(j_.info()) << "Cleaned " << cleaned_ << " ledgers at "
+                            << rate(clock_type::now()) << " per second";
+            minRange_ = maxRange_ = 0;
+            state_ = State::notCleaning;
+            done = true;
         }
     }
-};
+
+    if (done)
+        saveCheckpoint();
+}
 
 std::unique_ptr<LedgerCleaner>
 make_LedgerCleaner(Application& app, beast::Journal journal)
 {
-    return std::make_unique<LedgerCleanerImp>(app, journal);
+    return std::make_unique<LedgerCleanerImp>(
+        app, app.config().section(SECTION_LEDGER_CLEANER), journal);
 }
 
 }  // namespace ripple
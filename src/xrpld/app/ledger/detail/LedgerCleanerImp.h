@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERCLEANERIMP_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERCLEANERIMP_H_INCLUDED
+
+#include <xrpld/app/ledger/LedgerCleaner.h>
+#include <xrpld/ledger/ReadView.h>
+#include <xrpl/basics/BasicConfig.h>
+#include <xrpl/protocol/RippleLedgerHash.h>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ripple {
+
+/*
+
+LedgerCleaner
+
+Cleans up the ledger. Specifically, resolves these issues:
+
+1. Older versions could leave the SQLite account and transaction databases in
+   an inconsistent state. The cleaner identifies these inconsistencies and
+   resolves them.
+
+2. Upon request, checks for missing nodes in a ledger and triggers a fetch.
+
+The range is split into batches of consecutive ledgers which are handed out,
+from the highest to the lowest, to a configurable number of worker threads.
+All the workers together start no more ledgers per second than the configured
+I/O budget allows.
+
+Every ledger above maxRange_ has been cleaned, even though the workers may be
+further down the range. When a checkpoint file is configured, the remaining
+range is saved to it periodically, so that a restarted server resumes where
+the previous one stopped rather than starting over.
+
+*/
+
+class LedgerCleanerImp : public LedgerCleaner
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    // The number of consecutive ledgers handed to a worker at a time
+    static constexpr LedgerIndex batchSize = 64;
+
+    // How often the progress is saved to the checkpoint file
+    static constexpr std::chrono::seconds checkpointInterval{10};
+
+    /** Create a cleaner.
+        @param config The [ledger_cleaner] section of the configuration.
+    */
+    LedgerCleanerImp(
+        Application& app,
+        Section const& config,
+        beast::Journal journal);
+
+    ~LedgerCleanerImp() override;
+
+    void
+    start() override;
+
+    void
+    stop() override;
+
+    void
+    onWrite(beast::PropertyStream::Map& map) override;
+
+    void
+    clean(Json::Value const& params) override;
+
+    Json::Value
+    getJson() const override;
+
+protected:
+    /** Clean a single ledger.
+        @param ledgerIndex The index of the ledger to clean.
+        @param goodLedger [in,out] A known good subsequent ledger, if any.
+        @param doNodes Ensure all ledger nodes are in the node db.
+        @param doTxns Reprocess (account) transactions to SQL databases.
+        @return `true` if the ledger was cleaned.
+    */
+    virtual bool
+    cleanOne(
+        LedgerIndex ledgerIndex,
+        std::shared_ptr<ReadView const>& goodLedger,
+        bool doNodes,
+        bool doTxns);
+
+private:
+    void
+    restart();
+
+    double
+    rate(clock_type::time_point now) const;
+
+    void
+    resume();
+
+    void
+    saveCheckpoint();
+
+    void
+    run();
+
+    LedgerHash
+    getLedgerHash(std::shared_ptr<ReadView const>& ledger, LedgerIndex index);
+
+    bool
+    doLedger(
+        LedgerIndex const& ledgerIndex,
+        LedgerHash const& ledgerHash,
+        bool doNodes,
+        bool doTxns);
+
+    LedgerHash
+    getHash(
+        LedgerIndex const& ledgerIndex,
+        std::shared_ptr<ReadView const>& referenceLedger);
+
+    bool
+    waitUntil(
+        std::unique_lock<std::mutex>& lock,
+        clock_type::time_point when,
+        std::uint64_t generation);
+
+    bool
+    waitFor(clock_type::duration delay, std::uint64_t generation);
+
+    bool
+    cleanLedger(
+        LedgerIndex ledgerIndex,
+        std::shared_ptr<ReadView const>& goodLedger,
+        bool doNodes,
+        bool doTxns,
+        std::uint64_t generation);
+
+    void
+    onCleaned(LedgerIndex top, LedgerIndex remaining, std::uint64_t generation);
+
+    void
+    worker();
+
+    void
+    doLedgerCleaner();
+
+    Application& app_;
+    beast::Journal const j_;
+    mutable std::mutex mutex_;
+
+    mutable std::condition_variable wakeup_;
+
+    std::thread thread_;
+
+    enum class State : char { notCleaning = 0, cleaning };
+    State state_ = State::notCleaning;
+    bool shouldExit_ = false;
+
+    // The lowest ledger in the range we're checking.
+    LedgerIndex minRange_ = 0;
+
+    // The highest ledger in the range we're checking
+    LedgerIndex maxRange_ = 0;
+
+    // Check all state/transaction nodes
+    bool checkNodes_ = false;
+
+    // Rewrite SQL databases
+    bool fixTxns_ = false;
+
+    // Number of errors encountered since last success
+    int failures_ = 0;
+
+    // Changes whenever the range is replaced, so that the workers abandon
+    // the batches they took from the previous range.
+    std::uint64_t generation_ = 0;
+
+    // The highest ledger not yet handed to a worker
+    LedgerIndex next_ = 0;
+
+    // The batches handed to the workers, by their highest ledger. The value
+    // is the highest ledger of the batch not yet cleaned, or 0 once the
+    // whole batch is.
+    std::map<LedgerIndex, LedgerIndex> batches_;
+
+    // The number of worker threads
+    std::size_t const threads_;
+
+    // The most ledgers started per second by all the workers together, or
+    // 0 for no limit.
+    std::uint32_t const maxLedgersPerSecond_;
+
+    // The earliest time at which the next ledger may be started
+    clock_type::time_point nextStart_;
+
+    // The ledgers cleaned since the range was last set, and when it was.
+    std::uint64_t cleaned_ = 0;
+    clock_type::time_point started_;
+
+    // Where the remaining range is saved, if anywhere.
+    std::string checkpointPath_;
+    std::mutex checkpointMutex_;
+    clock_type::time_point lastCheckpoint_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -58,6 +58,9 @@ void
 LedgerDeltaAcquire::init(int numPeers)
 {
     ScopedLockType sl(mtx_);
+    if (std::exchange(started_, true))
+        return;
+
     if (!isDone())
     {
         trigger(numPeers, sl);
@@ -75,6 +75,8 @@ public:
     /**
      * Start the LedgerDeltaAcquire task
      * @param numPeers  number of peers to try initially
+     * @note only the first call has any effect, so that the tasks sharing
+     *       this subtask can each start it when they need it
      */
     void
     init(int numPeers);
@@ -156,6 +158,7 @@ private:
     std::set<InboundLedger::Reason> reasons_;
     std::uint32_t noFeaturePeerCount = 0;
     bool fallBack_ = false;
+    bool started_ = false;
 
     friend class LedgerReplayTask;  // for asserts only
     friend class test::LedgerReplayClient;
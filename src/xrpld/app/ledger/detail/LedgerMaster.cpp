@@ -197,6 +197,12 @@ LedgerMaster::LedgerMaster(
           std::chrono::seconds{45},
           stopwatch,
           app_.journal("TaggedCache"))
+    , fetch_pack_replies_(
+          "FetchPackReply",
+          16,
+          std::chrono::seconds{30},
+          stopwatch,
+          app_.journal("TaggedCache"))
     , m_stats(std::bind(&LedgerMaster::collect_metrics, this), collector)
 {
 }
@@ -1841,6 +1847,7 @@ LedgerMaster::sweep()
 {
     mLedgerHistory.sweep();
     fetch_packs_.sweep();
+    fetch_pack_replies_.sweep();
 }
 
 float
@@ -1849,6 +1856,18 @@ LedgerMaster::getCacheHitRate()
     return mLedgerHistory.getCacheHitRate();
 }
 
+LedgerHistory::LedgersByHash&
+LedgerMaster::getLedgerCache()
+{
+    return mLedgerHistory.getCache();
+}
+
+std::vector<uint256>
+LedgerMaster::getRecentLedgerHashes(std::size_t limit) const
+{
+    return mLedgerHistory.getRecentHashes(limit);
+}
+
 void
 LedgerMaster::clearPriorLedgers(LedgerIndex seq)
 {
@@ -2105,6 +2124,83 @@ LedgerMaster::gotFetchPack(bool progress, std::uint32_t seq)
     }
 }
 
+namespace {
+
+/** Encodes the objects of a fetch pack into messages as they are added.
+
+    Each message holds at most `chunkSize` objects and is handed to the
+    peer as soon as it is full, so that the peer can start using the fetch
+    pack while the rest of it is being built. The messages are kept so
+    that they can be sent to other peers asking for the same fetch pack.
+*/
+class FetchPackWriter
+{
+public:
+    static constexpr int chunkSize = 256;
+
+    FetchPackWriter(
+        std::shared_ptr<Peer> peer,
+        protocol::TMGetObjectByHash const& request)
+        : peer_(std::move(peer))
+    {
+        reply_.set_query(false);
+        if (request.has_seq())
+            reply_.set_seq(request.seq());
+        reply_.set_ledgerhash(request.ledgerhash());
+        reply_.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+    }
+
+    void
+    add(uint256 const& hash,
+        void const* data,
+        std::size_t size,
+        LedgerIndex seq)
+    {
+        protocol::TMIndexedObject* obj = reply_.add_objects();
+        obj->set_hash(hash.data(), hash.size());
+        obj->set_data(data, size);
+        obj->set_ledgerseq(seq);
+        ++objects_;
+
+        if (reply_.objects_size() >= chunkSize)
+            flush();
+    }
+
+    void
+    flush()
+    {
+        if (reply_.objects_size() == 0)
+            return;
+
+        auto msg = std::make_shared<Message>(reply_, protocol::mtGET_OBJECTS);
+        reply_.clear_objects();
+        result_.bytes += msg->getBufferSize();
+        result_.messages.push_back(msg);
+        peer_->send(msg);
+    }
+
+    /** The number of objects added so far. */
+    std::size_t
+    objects() const
+    {
+        return objects_;
+    }
+
+    FetchPackReply&
+    result()
+    {
+        return result_;
+    }
+
+private:
+    std::shared_ptr<Peer> const peer_;
+    protocol::TMGetObjectByHash reply_;
+    FetchPackReply result_;
+    std::size_t objects_ = 0;
+};
+
+}  // namespace
+
 /** Populate a fetch pack with data from the map the recipient wants.
 
     A recipient may or may not have the map that they are asking for. If
@@ -2113,7 +2209,7 @@ LedgerMaster::gotFetchPack(bool progress, std::uint32_t seq)
 
     @param have The map that the recipient already has (if any).
     @param cnt The maximum number of nodes to return.
-    @param into The protocol object into which we add information.
+    @param into The writer to which we add information.
     @param seq The sequence number of the ledger the map is a part of.
     @param withLeaves True if leaf nodes should be included.
 
@@ -2135,7 +2231,7 @@ populateFetchPack(
     SHAMap const& want,
     SHAMap const* have,
     std::uint32_t cnt,
-    protocol::TMGetObjectByHash* into,
+    FetchPackWriter& into,
     std::uint32_t seq,
     bool withLeaves = true)
 {
@@ -2145,19 +2241,14 @@ populateFetchPack(
 
     want.visitDifferences(
         have,
-        [&s, withLeaves, &cnt, into, seq](SHAMapTreeNode const& n) -> bool {
+        [&s, withLeaves, &cnt, &into, seq](SHAMapTreeNode const& n) -> bool {
             if (!withLeaves && n.isLeaf())
                 return true;
 
             s.erase();
             n.serializeWithPrefix(s);
-
-            auto const& hash = n.getHash().as_uint256();
-
-            protocol::TMIndexedObject* obj = into->add_objects();
-            obj->set_ledgerseq(seq);
-            obj->set_hash(hash.data(), hash.size());
-            obj->set_data(s.getDataPtr(), s.getLength());
+            into.add(
+                n.getHash().as_uint256(), s.getDataPtr(), s.getLength(), seq);
 
             return --cnt != 0;
         });
@@ -2177,17 +2268,22 @@ LedgerMaster::makeFetchPack(
         return;
     }
 
+    auto peer = wPeer.lock();
+
+    if (!peer)
+        return;
+
+    // Another peer may have asked for the same fetch pack while this
+    // request was queued.
+    if (sendCachedFetchPack(peer, *request, haveLedgerHash))
+        return;
+
     if (app_.getFeeTrack().isLoadedLocal() || (getValidatedLedgerAge() > 40s))
     {
         JLOG(m_journal.info()) << "Too busy to make fetch pack";
         return;
     }
 
-    auto peer = wPeer.lock();
-
-    if (!peer)
-        return;
-
     auto have = getLedgerByHash(haveLedgerHash);
 
     if (!have)
@@ -2228,14 +2324,7 @@ LedgerMaster::makeFetchPack(
     {
         Serializer hdr(128);
 
-        protocol::TMGetObjectByHash reply;
-        reply.set_query(false);
-
-        if (request->has_seq())
-            reply.set_seq(request->seq());
-
-        reply.set_ledgerhash(request->ledgerhash());
-        reply.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+        FetchPackWriter writer(peer, *request);
 
         // Building a fetch pack:
         //  1. Add the header for the requested ledger.
@@ -2245,6 +2334,8 @@ LedgerMaster::makeFetchPack(
         //  4. If the FetchPack now contains at least 512 entries then stop.
         //  5. If not very much time has elapsed, then loop back and repeat
         //     the same process adding the previous ledger to the FetchPack.
+        //
+        // The writer sends the objects to the peer in chunks as it goes.
         do
         {
             std::uint32_t lSeq = want->info().seq;
@@ -2257,35 +2348,45 @@ LedgerMaster::makeFetchPack(
                 addRaw(want->info(), hdr);
 
                 // Add the data
-                protocol::TMIndexedObject* obj = reply.add_objects();
-                obj->set_hash(
-                    want->info().hash.data(), want->info().hash.size());
-                obj->set_data(hdr.getDataPtr(), hdr.getLength());
-                obj->set_ledgerseq(lSeq);
+                writer.add(
+                    want->info().hash,
+                    hdr.getDataPtr(),
+                    hdr.getLength(),
+                    lSeq);
             }
 
             populateFetchPack(
-                want->stateMap(), &have->stateMap(), 16384, &reply, lSeq);
+                want->stateMap(), &have->stateMap(), 16384, writer, lSeq);
 
             // We use nullptr here because transaction maps are per ledger
             // and so the requestor is unlikely to already have it.
             if (want->info().txHash.isNonZero())
-                populateFetchPack(want->txMap(), nullptr, 512, &reply, lSeq);
+                populateFetchPack(want->txMap(), nullptr, 512, writer, lSeq);
 
-            if (reply.objects().size() >= 512)
+            if (writer.objects() >= 512)
                 break;
 
             have = std::move(want);
             want = getLedgerByHash(have->info().parentHash);
         } while (want && UptimeClock::now() <= uptime + 1s);
 
-        auto msg = std::make_shared<Message>(reply, protocol::mtGET_OBJECTS);
+        writer.flush();
+
+        auto& result = writer.result();
 
         JLOG(m_journal.info())
-            << "Built fetch pack with " << reply.objects().size() << " nodes ("
-            << msg->getBufferSize() << " bytes)";
+            << "Built fetch pack with " << writer.objects() << " nodes in "
+            << result.messages.size() << " messages (" << result.bytes
+            << " bytes)";
 
-        peer->send(msg);
+        // The reply echoes the obsolete sequence of the request, so only
+        // replies to requests without it can be shared.
+        if (!request->has_seq())
+        {
+            auto shared = std::make_shared<FetchPackReply>(std::move(result));
+            fetch_pack_replies_.canonicalize_replace_cache(
+                haveLedgerHash, shared);
+        }
     }
     catch (std::exception const& ex)
     {
@@ -2294,6 +2395,27 @@ LedgerMaster::makeFetchPack(
     }
 }
 
+bool
+LedgerMaster::sendCachedFetchPack(
+    std::shared_ptr<Peer> const& peer,
+    protocol::TMGetObjectByHash const& request,
+    uint256 const& haveLedgerHash)
+{
+    if (request.has_seq())
+        return false;
+
+    auto const reply = fetch_pack_replies_.fetch(haveLedgerHash);
+    if (!reply)
+        return false;
+
+    for (auto const& msg : reply->messages)
+        peer->send(msg);
+
+    JLOG(m_journal.debug()) << "Sent cached fetch pack for " << haveLedgerHash
+                            << " (" << reply->bytes << " bytes)";
+    return true;
+}
+
 std::size_t
 LedgerMaster::getFetchPackCacheSize() const
 {
@@ -195,31 +195,107 @@ LedgerReplayTask::tryAdvance(ScopedLockType& sl)
     if (!shouldTry)
         return;
 
-    try
+    if (building_)
     {
-        for (; deltaToBuild_ < deltas_.size(); ++deltaToBuild_)
+        advance_ = true;
+        return;
+    }
+
+    std::weak_ptr<LedgerReplayTask> wptr = shared_from_this();
+    building_ = app_.getJobQueue().addJob(
+        jtREPLAY_TASK, "LedgerReplayBuild", [wptr]() {
+            if (auto sptr = wptr.lock(); sptr)
+                sptr->buildLedgers();
+        });
+}
+
+void
+LedgerReplayTask::buildLedgers()
+{
+    using clock_type = std::chrono::steady_clock;
+
+    ScopedLockType sl(mtx_);
+    if (lastBuilt_ == clock_type::time_point{})
+        lastBuilt_ = clock_type::now();
+
+    while (!isDone())
+    {
+        advance_ = false;
+        if (deltaToBuild_ == deltas_.size())
         {
-            auto& delta = deltas_[deltaToBuild_];
-            assert(parent_->seq() + 1 == delta->ledgerSeq_);
-            if (auto l = delta->tryBuild(parent_); l)
-            {
-                JLOG(journal_.debug())
-                    << "Task " << hash_ << " got ledger " << l->info().hash
-                    << " deltaIndex=" << deltaToBuild_
-                    << " totalDeltas=" << deltas_.size();
-                parent_ = l;
-            }
-            else
-                return;
+            complete_ = true;
+            JLOG(journal_.info()) << "Completed " << hash_;
+            break;
+        }
+
+        auto const delta = deltas_[deltaToBuild_];
+        auto const parent = parent_;
+        assert(parent->seq() + 1 == delta->ledgerSeq_);
+
+        // The deltas that follow keep arriving while this one is built
+        sl.unlock();
+        std::shared_ptr<Ledger const> ledger;
+        bool failed = false;
+        auto const start = clock_type::now();
+        try
+        {
+            ledger = delta->tryBuild(parent);
+        }
+        catch (std::runtime_error const&)
+        {
+            failed = true;
         }
+        auto const finish = clock_type::now();
+        sl.lock();
 
-        complete_ = true;
-        JLOG(journal_.info()) << "Completed " << hash_;
+        if (failed)
+        {
+            failed_ = true;
+            break;
+        }
+
+        if (!ledger)
+        {
+            if (advance_)
+                continue;
+            break;
+        }
+
+        JLOG(journal_.debug())
+            << "Task " << hash_ << " got ledger " << ledger->info().hash
+            << " deltaIndex=" << deltaToBuild_
+            << " totalDeltas=" << deltas_.size();
+        replayer_.onLedgerBuilt(finish - start, start - lastBuilt_);
+        lastBuilt_ = finish;
+        parent_ = ledger;
+        ++deltaToBuild_;
+
+        sl.unlock();
+        startDeltas();
+        sl.lock();
     }
-    catch (std::runtime_error const&)
+
+    building_ = false;
+}
+
+void
+LedgerReplayTask::startDeltas()
+{
+    std::vector<std::shared_ptr<LedgerDeltaAcquire>> toStart;
     {
-        failed_ = true;
+        ScopedLockType sl(mtx_);
+        if (isDone())
+            return;
+
+        auto const end = std::min<std::size_t>(
+            deltas_.size(),
+            deltaToBuild_ + LedgerReplayParameters::DELTA_PREFETCH_WINDOW);
+        for (; deltasStarted_ < end; ++deltasStarted_)
+            toStart.push_back(deltas_[deltasStarted_]);
     }
+
+    for (auto const& delta : toStart)
+        delta->init(1);
 }
 
 void
@@ -294,6 +370,9 @@ LedgerReplayTask::addDelta(std::shared_ptr<LedgerDeltaAcquire> const& delta)
             deltas_.back()->ledgerSeq_ + 1 == delta->ledgerSeq_);
         deltas_.push_back(delta);
     }
+    sl.unlock();
+
+    startDeltas();
 }
 
 bool
@@ -20,6 +20,7 @@
 #include <xrpld/app/ledger/LedgerReplayer.h>
 #include <xrpld/app/ledger/detail/LedgerDeltaAcquire.h>
 #include <xrpld/app/ledger/detail/SkipListAcquire.h>
+#include <xrpld/app/main/CollectorManager.h>
 #include <xrpld/core/JobQueue.h>
 
 namespace ripple {
@@ -32,6 +33,7 @@ LedgerReplayer::LedgerReplayer(
     , inboundLedgers_(inboundLedgers)
     , peerSetBuilder_(std::move(peerSetBuilder))
     , j_(app.journal("LedgerReplayer"))
+    , stats_(app.getCollectorManager().collector())
 {
 }
 
@@ -134,13 +136,14 @@ LedgerReplayer::createDeltas(std::shared_ptr<LedgerReplayTask> task)
             return;
         }
 
+        // The task starts acquiring the deltas, a window at a time, as it
+        // builds the ledgers.
         for (std::uint32_t seq = parameter.startSeq_ + 1;
              seq <= parameter.finishSeq_ &&
              skipListItem != parameter.skipList_.end();
              ++seq, ++skipListItem)
         {
             std::shared_ptr<LedgerDeltaAcquire> delta;
-            bool newDelta = false;
             {
                 std::lock_guard<std::mutex> lock(mtx_);
                 if (app_.isStopping())
@@ -158,13 +161,10 @@ LedgerReplayer::createDeltas(std::shared_ptr<LedgerReplayTask> task)
                         seq,
                         peerSetBuilder_->build());
                     deltas_[*skipListItem] = delta;
-                    newDelta = true;
                 }
             }
 
             task->addDelta(delta);
-            if (newDelta)
-                delta->init(1);
         }
     }
 }
@@ -189,7 +189,10 @@ LedgerReplayer::gotSkipList(
     }
 
     if (skipList)
+    {
+        ++stats_.skipListsAcquired;
         skipList->processData(info.seq, item);
+    }
 }
 
 void
@@ -212,7 +215,21 @@ LedgerReplayer::gotReplayDelta(
     }
 
     if (delta)
+    {
+        ++stats_.deltasAcquired;
         delta->processData(info, std::move(txns));
+    }
+}
+
+void
+LedgerReplayer::onLedgerBuilt(
+    std::chrono::steady_clock::duration buildTime,
+    std::chrono::steady_clock::duration waitTime)
+{
+    using namespace std::chrono;
+    ++stats_.ledgersBuilt;
+    stats_.buildTime.notify(duration_cast<milliseconds>(buildTime));
+    stats_.waitTime.notify(duration_cast<milliseconds>(waitTime));
 }
 
 void
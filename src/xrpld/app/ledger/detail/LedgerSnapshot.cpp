@@ -0,0 +1,373 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/ledger/LedgerSnapshot.h>
+#include <xrpl/basics/ByteUtilities.h>
+#include <xrpl/basics/Log.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/digest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace ripple {
+
+namespace {
+
+constexpr char snapshotMagic[8] = {'X', 'R', 'P', 'L', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t snapshotVersion = 1;
+
+// A chunk is closed once it holds this many leaves or this many bytes
+constexpr std::uint32_t chunkItems = 4096;
+constexpr std::size_t chunkBytes = megabytes<std::size_t>(16);
+
+// Larger chunk sizes can only come from a damaged file. A chunk may exceed
+// chunkBytes by at most one leaf, and leaves are limited to 16 MB.
+constexpr std::uint32_t maxChunkBytes = megabytes<std::uint32_t>(48);
+
+void
+writeRaw(std::ostream& out, Slice data, LedgerSnapshotStats& stats)
+{
+    out.write(reinterpret_cast<char const*>(data.data()), data.size());
+    if (!out)
+        Throw<std::runtime_error>("ledger snapshot: write failed");
+    stats.bytes += data.size();
+}
+
+void
+write32(std::ostream& out, std::uint32_t v, LedgerSnapshotStats& stats)
+{
+    Serializer s(4);
+    s.add32(v);
+    writeRaw(out, s.slice(), stats);
+}
+
+std::size_t
+writeMap(SHAMap const& map, std::ostream& out, LedgerSnapshotStats& stats)
+{
+    std::size_t total = 0;
+    std::uint32_t count = 0;
+    Serializer leaves;
+
+    auto flush = [&]() {
+        if (count == 0)
+            return;
+        Serializer payload(leaves.size() + 4);
+        payload.add32(count);
+        payload.addRaw(leaves.slice());
+        write32(out, payload.size(), stats);
+        writeRaw(out, payload.slice(), stats);
+        auto const hash = sha512Half(payload.slice());
+        writeRaw(out, Slice(hash.data(), hash.size()), stats);
+        leaves.erase();
+        count = 0;
+    };
+
+    for (auto const& item : map)
+    {
+        leaves.addBitString(item.key());
+        leaves.add32(item.size());
+        leaves.addRaw(item.slice());
+        ++total;
+        if (++count == chunkItems || leaves.size() >= chunkBytes)
+            flush();
+    }
+    flush();
+    write32(out, 0, stats);
+    return total;
+}
+
+bool
+readRaw(std::istream& in, void* data, std::size_t size)
+{
+    in.read(static_cast<char*>(data), size);
+    return static_cast<std::size_t>(in.gcount()) == size;
+}
+
+std::optional<std::uint32_t>
+read32(std::istream& in)
+{
+    std::uint8_t b[4];
+    if (!readRaw(in, b, sizeof(b)))
+        return std::nullopt;
+    return (std::uint32_t{b[0]} << 24) | (std::uint32_t{b[1]} << 16) |
+        (std::uint32_t{b[2]} << 8) | std::uint32_t{b[3]};
+}
+
+/** Reads the leaves of one map from a snapshot, a chunk at a time.
+
+    Each chunk is checked against its hash before any of its leaves are
+    handed out, and is released once they all have been.
+*/
+class MapReader
+{
+public:
+    MapReader(std::istream& in, std::string name)
+        : in_(in), name_(std::move(name))
+    {
+    }
+
+    /** Return the next leaf, or nullptr after the last one.
+
+        @throws std::runtime_error if the snapshot is damaged.
+    */
+    boost::intrusive_ptr<SHAMapItem const>
+    next()
+    {
+        while (remaining_ == 0)
+        {
+            if (done_)
+                return nullptr;
+            if (sit_ && !sit_->empty())
+                fail("has trailing data");
+            readChunk();
+        }
+
+        --remaining_;
+        ++items_;
+        try
+        {
+            auto const key = sit_->get256();
+            return make_shamapitem(key, sit_->getSlice(sit_->get32()));
+        }
+        catch (std::exception const& e)
+        {
+            fail(std::string("is malformed: ") + e.what());
+        }
+    }
+
+    /** The number of leaves read so far. */
+    std::size_t
+    items() const
+    {
+        return items_;
+    }
+
+private:
+    [[noreturn]] void
+    fail(std::string const& what) const
+    {
+        Throw<std::runtime_error>(
+            "Snapshot " + name_ + " chunk " + std::to_string(chunk_) + " " +
+            what);
+    }
+
+    void
+    readChunk()
+    {
+        sit_.reset();
+        auto const size = read32(in_);
+        if (!size)
+            Throw<std::runtime_error>("Snapshot is truncated");
+        if (*size == 0)
+        {
+            done_ = true;
+            return;
+        }
+
+        ++chunk_;
+        if (*size < 4 || *size > maxChunkBytes)
+            fail("has invalid size " + std::to_string(*size));
+
+        payload_.resize(*size);
+        uint256 hash;
+        if (!readRaw(in_, payload_.data(), payload_.size()) ||
+            !readRaw(in_, hash.data(), hash.size()))
+            Throw<std::runtime_error>("Snapshot is truncated");
+        if (sha512Half(makeSlice(payload_)) != hash)
+            fail("is corrupt");
+
+        sit_.emplace(makeSlice(payload_));
+        remaining_ = sit_->get32();
+    }
+
+    std::istream& in_;
+    std::string const name_;
+    Blob payload_;
+    std::optional<SerialIter> sit_;
+    std::uint32_t remaining_ = 0;
+    std::size_t chunk_ = 0;
+    std::size_t items_ = 0;
+    bool done_ = false;
+};
+
+// Rebuild a map from its leaves as they are read, writing it to the node
+// store as it goes.
+bool
+buildMap(
+    SHAMapType mapType,
+    SHAMapNodeType leafType,
+    NodeObjectType nodeType,
+    MapReader& reader,
+    uint256 const& expected,
+    Family& family,
+    std::size_t threads,
+    beast::Journal j)
+{
+    SHAMap map(mapType, family);
+    if (!map.writeSortedItems(
+            leafType, [&reader]() { return reader.next(); }, nodeType, threads))
+    {
+        JLOG(j.fatal()) << "Snapshot leaves are not in key order";
+        return false;
+    }
+
+    if (map.getHash().as_uint256() != expected)
+    {
+        JLOG(j.fatal()) << "Snapshot " << to_string(mapType)
+                        << " root hash mismatch: expected " << expected
+                        << ", got " << map.getHash();
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace
+
+LedgerSnapshotStats
+writeLedgerSnapshot(Ledger const& ledger, std::ostream& out)
+{
+    assert(!ledger.open());
+    LedgerSnapshotStats stats;
+
+    writeRaw(out, Slice(snapshotMagic, sizeof(snapshotMagic)), stats);
+    write32(out, snapshotVersion, stats);
+
+    Serializer header;
+    addRaw(ledger.info(), header, true);
+    write32(out, header.size(), stats);
+    writeRaw(out, header.slice(), stats);
+
+    stats.stateItems = writeMap(ledger.stateMap(), out, stats);
+    stats.txItems = writeMap(ledger.txMap(), out, stats);
+    out.flush();
+    if (!out)
+        Throw<std::runtime_error>("ledger snapshot: write failed");
+    return stats;
+}
+
+std::shared_ptr<Ledger>
+loadLedgerSnapshot(
+    std::istream& in,
+    Config const& config,
+    Family& family,
+    beast::Journal j,
+    std::size_t threads)
+{
+    char magic[sizeof(snapshotMagic)];
+    if (!readRaw(in, magic, sizeof(magic)) ||
+        std::memcmp(magic, snapshotMagic, sizeof(magic)) != 0)
+    {
+        JLOG(j.fatal()) << "Not a ledger snapshot";
+        return nullptr;
+    }
+
+    if (auto const version = read32(in); version != snapshotVersion)
+    {
+        JLOG(j.fatal()) << "Unsupported ledger snapshot version";
+        return nullptr;
+    }
+
+    LedgerInfo info;
+    {
+        auto const size = read32(in);
+        if (!size || *size > 1024)
+        {
+            JLOG(j.fatal()) << "Snapshot header is invalid";
+            return nullptr;
+        }
+        Blob header(*size);
+        if (!readRaw(in, header.data(), header.size()))
+        {
+            JLOG(j.fatal()) << "Snapshot is truncated";
+            return nullptr;
+        }
+        try
+        {
+            info = deserializeHeader(makeSlice(header), true);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j.fatal()) << "Snapshot header is invalid: " << e.what();
+            return nullptr;
+        }
+    }
+
+    if (calculateLedgerHash(info) != info.hash)
+    {
+        JLOG(j.fatal()) << "Snapshot header does not match ledger hash "
+                        << info.hash;
+        return nullptr;
+    }
+
+    JLOG(j.info()) << "Loading snapshot of ledger " << info.seq << " "
+                   << info.hash;
+
+    try
+    {
+        MapReader state(in, "state");
+        if (!buildMap(
+                SHAMapType::STATE,
+                SHAMapNodeType::tnACCOUNT_STATE,
+                hotACCOUNT_NODE,
+                state,
+                info.accountHash,
+                family,
+                threads,
+                j))
+            return nullptr;
+        JLOG(j.info()) << "Loaded " << state.items() << " state entries";
+
+        MapReader tx(in, "transaction");
+        if (!buildMap(
+                SHAMapType::TRANSACTION,
+                SHAMapNodeType::tnTRANSACTION_MD,
+                hotTRANSACTION_NODE,
+                tx,
+                info.txHash,
+                family,
+                threads,
+                j))
+            return nullptr;
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j.fatal()) << e.what();
+        return nullptr;
+    }
+
+    bool loaded;
+    auto ledger =
+        std::make_shared<Ledger>(info, loaded, false, config, family, j);
+    if (!loaded)
+    {
+        JLOG(j.fatal()) << "Snapshot ledger could not be loaded";
+        return nullptr;
+    }
+
+    ledger->setImmutable();
+    ledger->setFull();
+    return ledger;
+}
+
+}  // namespace ripple
@@ -23,6 +23,7 @@
 #include <xrpld/app/ledger/LedgerCleaner.h>
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/ledger/LedgerReplayer.h>
+#include <xrpld/app/ledger/LedgerSnapshot.h>
 #include <xrpld/app/ledger/LedgerToJson.h>
 #include <xrpld/app/ledger/OpenLedger.h>
 #include <xrpld/app/ledger/OrderBookDB.h>
@@ -37,8 +38,10 @@
 #include <xrpld/app/main/NodeStoreScheduler.h>
 #include <xrpld/app/main/Tuning.h>
 #include <xrpld/app/misc/AmendmentTable.h>
+#include <xrpld/app/misc/CacheWarmer.h>
 #include <xrpld/app/misc/HashRouter.h>
 #include <xrpld/app/misc/LoadFeeTrack.h>
+#include <xrpld/app/misc/MemoryGovernor.h>
 #include <xrpld/app/misc/NetworkOPs.h>
 #include <xrpld/app/misc/SHAMapStore.h>
 #include <xrpld/app/misc/TxQ.h>
@@ -58,6 +61,7 @@
 #include <xrpld/rpc/detail/RPCHelpers.h>
 #include <xrpld/shamap/NodeFamily.h>
 #include <xrpl/basics/ByteUtilities.h>
+#include <xrpl/basics/CountedObject.h>
 #include <xrpl/basics/ResolverAsio.h>
 #include <xrpl/basics/random.h>
 #include <xrpl/basics/safe_cast.h>
@@ -77,14 +81,18 @@
 
 #include <date/date.h>
 
+#include <cctype>
 #include <chrono>
 #include <condition_variable>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <variant>
 
@@ -158,6 +166,60 @@ private:
         }
     };
 
+    // Publishes the bytes held by each type of counted object. A gauge is
+    // made the first time a type is seen, since types register their
+    // counters when the first instance is built.
+    class object_bytes_stats
+    {
+    private:
+        beast::insight::Collector::ptr m_collector;
+        std::map<std::string, beast::insight::Gauge> m_gauges;
+        // Declared last, so that it is removed before the gauges are
+        beast::insight::Hook m_hook;
+
+        void
+        collect()
+        {
+            auto const bytes = CountedObjects::getInstance().getBytes(0);
+            for (auto const& [name, value] : bytes)
+            {
+                auto it = m_gauges.find(name);
+                if (it == m_gauges.end())
+                {
+                    it = m_gauges
+                             .emplace(
+                                 name,
+                                 m_collector->make_gauge(
+                                     "Object_Bytes", gaugeName(name)))
+                             .first;
+                }
+                it->second.set(value);
+            }
+        }
+
+        // "ripple::SHAMapItem" becomes "SHAMapItem"
+        static std::string
+        gaugeName(std::string name)
+        {
+            if (name.starts_with("ripple::"))
+                name.erase(0, 8);
+            for (auto& c : name)
+            {
+                if (!std::isalnum(static_cast<unsigned char>(c)))
+                    c = '_';
+            }
+            return name;
+        }
+
+    public:
+        explicit object_bytes_stats(
+            beast::insight::Collector::ptr const& collector)
+            : m_collector(collector)
+            , m_hook(collector->make_hook([this]() { collect(); }))
+        {
+        }
+    };
+
 public:
     std::unique_ptr<Config> config_;
     std::unique_ptr<Logs> logs_;
@@ -193,6 +255,8 @@ public:
     std::unique_ptr<PathRequests> m_pathRequests;
     std::unique_ptr<LedgerMaster> m_ledgerMaster;
     std::unique_ptr<LedgerCleaner> ledgerCleaner_;
+    std::unique_ptr<CacheWarmer> cacheWarmer_;
+    std::unique_ptr<MemoryGovernor> memoryGovernor_;
     std::unique_ptr<InboundLedgers> m_inboundLedgers;
     std::unique_ptr<InboundTransactions> m_inboundTransactions;
     std::unique_ptr<LedgerReplayer> m_ledgerReplayer;
@@ -233,6 +297,7 @@ public:
     std::unique_ptr<ResolverAsio> m_resolver;
 
     io_latency_sampler m_io_latency_sampler;
+    object_bytes_stats m_object_bytes_stats;
 
     std::unique_ptr<GRPCServer> grpcServer_;
 
@@ -368,6 +433,14 @@ public:
         , ledgerCleaner_(
               make_LedgerCleaner(*this, logs_->journal("LedgerCleaner")))
 
+        , cacheWarmer_(std::make_unique<CacheWarmer>(
+              *this,
+              logs_->journal("CacheWarmer")))
+
+        , memoryGovernor_(std::make_unique<MemoryGovernor>(
+              config_->MEMORY_BUDGET,
+              logs_->journal("MemoryGovernor")))
+
         // VFALCO NOTE must come before NetworkOPs to prevent a crash due
         //             to dependencies in the destructor.
         //
@@ -471,6 +544,7 @@ public:
               logs_->journal("Application"),
               std::chrono::milliseconds(100),
               get_io_service())
+        , m_object_bytes_stats(m_collectorManager->collector())
         , grpcServer_(std::make_unique<GRPCServer>(*this))
     {
         initAccountIdCache(config_->getValueFor(SizedItem::accountIdCacheSize));
@@ -493,6 +567,18 @@ public:
         //
 
         add(ledgerCleaner_.get());
+
+        // Rough sizes of an entry in each cache, until the caches hold
+        // entries whose footprint can be measured.
+        memoryGovernor_->add(
+            "treenode", *nodeFamily_.getTreeNodeCache(), 384, 16384);
+        memoryGovernor_->add(
+            "ledger", m_ledgerMaster->getLedgerCache(), 1024, 8);
+        memoryGovernor_->add("SLE", cachedSLEs_, 512, 1024);
+        memoryGovernor_->add(
+            "transaction", m_txMaster.getCache(), 1024, 1024);
+        memoryGovernor_->addFixed(
+            "node_db", [this]() { return m_nodeStore->getCacheBytes(); });
     }
 
     //--------------------------------------------------------------------------
@@ -614,6 +700,18 @@ public:
         return *ledgerCleaner_;
     }
 
+    CacheWarmer&
+    getCacheWarmer() override
+    {
+        return *cacheWarmer_;
+    }
+
+    MemoryGovernor&
+    getMemoryGovernor() override
+    {
+        return *memoryGovernor_;
+    }
+
     LedgerReplayer&
     getLedgerReplayer() override
     {
@@ -965,6 +1063,8 @@ public:
             signalStop();
         }
 
+        memoryGovernor_->rebalance();
+
         // VFALCO NOTE Does the order of calls matter?
         // VFALCO TODO fix the dependency inversion using an observer,
         //         have listeners register for "onSweep ()" notification.
@@ -1142,6 +1242,9 @@ private:
     std::shared_ptr<Ledger>
     loadLedgerFromFile(std::string const& ledgerID);
 
+    std::shared_ptr<Ledger>
+    loadLedgerFromSnapshot(std::string const& name);
+
     bool
     loadOldLedger(
         std::string const& ledgerID,
@@ -1261,14 +1364,15 @@ ApplicationImp::setup(boost::program_options::variables_map const& cmdline)
     }
     else if (
         startUp == Config::LOAD || startUp == Config::LOAD_FILE ||
-        startUp == Config::REPLAY)
+        startUp == Config::LOAD_SNAPSHOT || startUp == Config::REPLAY)
     {
         JLOG(m_journal.info()) << "Loading specified Ledger";
 
         if (!loadOldLedger(
                 config_->START_LEDGER,
                 startUp == Config::REPLAY,
-                startUp == Config::LOAD_FILE,
+                startUp == Config::LOAD_FILE ||
+                    startUp == Config::LOAD_SNAPSHOT,
                 config_->TRAP_TX_HASH))
         {
             JLOG(m_journal.error())
@@ -1524,6 +1628,7 @@ ApplicationImp::start(bool withTimers)
         overlay_->start();
     grpcServer_->start();
     ledgerCleaner_->start();
+    cacheWarmer_->start();
     perfLog_->start();
 }
 
@@ -1616,6 +1721,8 @@ ApplicationImp::run()
     m_inboundTransactions->stop();
     m_inboundLedgers->stop();
     ledgerCleaner_->stop();
+    cacheWarmer_->stop();
+    cacheWarmer_->save();
     m_nodeStore->stop();
     perfLog_->stop();
 
@@ -1883,6 +1990,34 @@ ApplicationImp::loadLedgerFromFile(std::string const& name)
     }
 }
 
+std::shared_ptr<Ledger>
+ApplicationImp::loadLedgerFromSnapshot(std::string const& name)
+{
+    std::ifstream snapshot(name, std::ios::in | std::ios::binary);
+    if (!snapshot)
+    {
+        JLOG(m_journal.fatal()) << "Unable to open snapshot '" << name << "'";
+        return nullptr;
+    }
+
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+    auto ledger = loadLedgerSnapshot(
+        snapshot,
+        *config_,
+        nodeFamily_,
+        journal("Ledger"),
+        std::max(std::thread::hardware_concurrency(), 1u));
+    if (ledger)
+    {
+        JLOG(m_journal.info())
+            << "Loaded snapshot of ledger " << ledger->info().seq << " in "
+            << duration_cast<milliseconds>(steady_clock::now() - start).count()
+            << "ms";
+    }
+    return ledger;
+}
+
 bool
 ApplicationImp::loadOldLedger(
     std::string const& ledgerID,
@@ -1897,7 +2032,9 @@ ApplicationImp::loadOldLedger(
         if (isFileName)
         {
             if (!ledgerID.empty())
-                loadLedger = loadLedgerFromFile(ledgerID);
+                loadLedger = config_->START_UP == Config::LOAD_SNAPSHOT
+                    ? loadLedgerFromSnapshot(ledgerID)
+                    : loadLedgerFromFile(ledgerID);
         }
         else if (ledgerID.length() == 64)
         {
@@ -56,7 +56,9 @@ template <
     bool IsKeyCache,
     class Hash,
     class KeyEqual,
-    class Mutex>
+    class Mutex,
+    class SharedPointerType,
+    class WeakPointerType>
 class TaggedCache;
 class STLedgerEntry;
 using SLE = STLedgerEntry;
@@ -99,6 +101,8 @@ class Cluster;
 class RelationalDatabase;
 class DatabaseCon;
 class SHAMapStore;
+class CacheWarmer;
+class MemoryGovernor;
 
 using NodeCache = TaggedCache<SHAMapHash, Blob>;
 
@@ -214,6 +218,10 @@ public:
     getLedgerMaster() = 0;
     virtual LedgerCleaner&
     getLedgerCleaner() = 0;
+    virtual CacheWarmer&
+    getCacheWarmer() = 0;
+    virtual MemoryGovernor&
+    getMemoryGovernor() = 0;
     virtual LedgerReplayer&
     getLedgerReplayer() = 0;
     virtual NetworkOPs&
@@ -393,6 +393,9 @@ run(int argc, char** argv)
         "ledgerfile",
         po::value<std::string>(),
         "Load the specified ledger file.")(
+        "load-snapshot",
+        po::value<std::string>(),
+        "Load the ledger from the specified snapshot file.")(
         "load", "Load the current ledger from the local DB.")(
         "net", "Get the initial ledger from the network.")(
         "replay", "Replay a ledger close.")(
@@ -689,6 +692,11 @@ run(int argc, char** argv)
         config->START_LEDGER = vm["ledgerfile"].as<std::string>();
         config->START_UP = Config::LOAD_FILE;
     }
+    else if (vm.count("load-snapshot"))
+    {
+        config->START_LEDGER = vm["load-snapshot"].as<std::string>();
+        config->START_UP = Config::LOAD_SNAPSHOT;
+    }
     else if (vm.count("load") || config->FAST_LOAD)
     {
         config->START_UP = Config::LOAD;
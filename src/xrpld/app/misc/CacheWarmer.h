@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_CACHEWARMER_H_INCLUDED
+#define RIPPLE_APP_MISC_CACHEWARMER_H_INCLUDED
+
+#include <xrpl/basics/Blob.h>
+#include <xrpl/basics/Slice.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/beast/utility/Journal.h>
+#include <xrpl/json/json_value.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+
+/** The keys of the most recently used cache entries.
+
+    Each list is ordered from the most to the least recently used entry.
+
+    Serialized layout, with all integers big-endian:
+
+        "XRPLWARM"                  magic
+        uint32                      format version
+        uint32, uint256...          ledger hashes
+        uint32, uint256...          SHAMap tree node hashes
+        uint32, uint256...          hashes of the leaves backing cached SLEs
+        uint256                     SHA-512Half of everything above
+*/
+struct CacheImage
+{
+    std::vector<uint256> ledgers;
+    std::vector<uint256> treeNodes;
+    std::vector<uint256> sles;
+};
+
+Blob
+serializeCacheImage(CacheImage const& image);
+
+/** Parse a serialized cache image.
+
+    @return The image, or std::nullopt if the data is damaged.
+*/
+std::optional<CacheImage>
+deserializeCacheImage(Slice data);
+
+/** Saves the hottest cache keys on shutdown and re-warms them on startup.
+
+    When the [cache_image] section is configured, the keys of the most
+    recently used entries of the ledger history, the tree node cache and the
+    SLE cache are written to a file when the server stops. When it starts
+    again, a background thread reads the file and loads the same entries
+    from the node store, issuing the reads in batches so that the node
+    store's read threads can work on them in parallel. While it does, the
+    server does not report itself FULL, so that it takes requests only once
+    they can be served from memory, but never for longer than the
+    configured max_delay.
+
+    The progress and the time taken to warm the caches are reported by
+    getJson(), which server_info includes.
+*/
+class CacheWarmer
+{
+public:
+    CacheWarmer(Application& app, beast::Journal journal);
+
+    ~CacheWarmer();
+
+    /** Whether a cache image is configured. */
+    bool
+    enabled() const
+    {
+        return !path_.empty();
+    }
+
+    /** Read the cache image, if any, and start warming the caches. */
+    void
+    start();
+
+    /** Whether the server should not yet report itself FULL.
+
+        @return `true` while the caches are being warmed, until max_delay
+                has passed since warming started.
+    */
+    bool
+    holdsFull() const;
+
+    /** Stop warming the caches and wait for the thread to finish. */
+    void
+    stop();
+
+    /** Write the keys of the hottest cache entries to the cache image.
+
+        Nothing is written if warming was interrupted, so that a quick
+        restart does not replace a full image with a partial one.
+    */
+    void
+    save();
+
+    /** Report the warming progress, or null if no image is configured. */
+    Json::Value
+    getJson() const;
+
+private:
+    enum class State { idle, warming, complete, stopped, failed };
+
+    void
+    run(CacheImage image);
+
+    // Fetch the nodes in batches. If sles is true, the nodes are state map
+    // leaves and the SLEs they hold are added to the SLE cache too.
+    void
+    warmNodes(std::vector<uint256> const& keys, bool sles);
+
+    bool
+    stopping() const;
+
+    Application& app_;
+    beast::Journal const j_;
+
+    std::string path_;
+    std::size_t maxLedgers_;
+    std::size_t maxTreeNodes_;
+    std::size_t maxSles_;
+    std::chrono::seconds maxDelay_;
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    bool stop_ = false;
+    std::size_t pending_ = 0;
+
+    std::atomic<State> state_{State::idle};
+    std::atomic<std::size_t> requested_{0};
+    std::atomic<std::size_t> loaded_{0};
+    std::atomic<std::size_t> missing_{0};
+    std::chrono::steady_clock::time_point start_;
+    std::atomic<std::chrono::microseconds::rep> duration_{0};
+};
+
+}  // namespace ripple
+
+#endif
@@ -63,6 +63,20 @@ HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
     return {result.second, result.first.relayed()};
 }
 
+std::pair<bool, std::optional<Stopwatch::time_point>>
+HashRouter::addSuppressionPeerIfKnown(uint256 const& key, PeerShortID peer)
+{
+    std::lock_guard lock(mutex_);
+
+    auto iter = suppressionMap_.find(key);
+    if (iter == suppressionMap_.end())
+        return {false, std::nullopt};
+
+    suppressionMap_.touch(iter);
+    iter->second.addPeer(peer);
+    return {true, iter->second.relayed()};
+}
+
 bool
 HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags)
 {
@@ -172,6 +172,19 @@ public:
     bool
     addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags);
 
+    /** Add a suppression peer to a message that is already known.
+
+        Unlike addSuppressionPeerWithStatus, an unknown message is not
+        added, so the caller may still decide that it should not be
+        suppressed.
+
+        Return pair:
+        element 1: true if the message is known.
+        element 2: optional is seated to the relay time point or
+        is unseated if has not relayed yet. */
+    std::pair<bool, std::optional<Stopwatch::time_point>>
+    addSuppressionPeerIfKnown(uint256 const& key, PeerShortID peer);
+
     // Add a peer suppression and return whether the entry should be processed
     bool
     shouldProcess(
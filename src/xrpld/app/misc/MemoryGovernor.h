@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_MEMORYGOVERNOR_H_INCLUDED
+#define RIPPLE_APP_MISC_MEMORYGOVERNOR_H_INCLUDED
+
+#include <xrpl/beast/utility/Journal.h>
+#include <xrpl/json/json_value.h>
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Divides a single memory budget between the caches.
+
+    Each registered cache reports how many entries it holds, roughly how
+    many bytes it holds, and how often it hits and misses. On
+    every call to rebalance() the governor compares the total with the
+    budget and adjusts the target sizes of the caches:
+
+    - Over budget, the caches whose misses per byte are lowest shrink
+      first, since they lose the least by giving up memory.
+    - Well under budget, the caches whose misses per byte are highest grow,
+      provided they are filling the target they already have.
+    - Otherwise memory moves from the cache with the lowest misses per
+      byte to the one with the highest, when they differ by more than 2x.
+
+    Misses per byte over the last interval stand in for the marginal
+    utility of memory: a cache that misses often for its size is the one
+    where another megabyte saves the most reads.
+
+    No target changes by more than a quarter per round, so a single noisy
+    interval cannot empty a cache. A cache never shrinks below its
+    minimum size.
+
+    With a zero budget the governor only measures, and never changes a
+    target.
+*/
+class MemoryGovernor
+{
+public:
+    /** @param budget The number of bytes the caches may use, or zero. */
+    MemoryGovernor(std::uint64_t budget, beast::Journal journal);
+
+    /** Govern a TaggedCache.
+
+        @param name The name reported by getJson().
+        @param entryBytes Approximate bytes held by each cached entry,
+                          used until the cache holds entries to measure.
+        @param minSize The smallest target size the governor may set.
+    */
+    template <class Cache>
+    void
+    add(std::string name,
+        Cache& cache,
+        std::size_t entryBytes,
+        std::size_t minSize)
+    {
+        Governed c;
+        c.name = std::move(name);
+        c.entries = [&cache]() {
+            return static_cast<std::size_t>(cache.getCacheSize());
+        };
+        c.bytes = [&cache]() { return cache.getBytes(); };
+        c.hitsAndMisses = [&cache]() { return cache.getHitsAndMisses(); };
+        c.setTarget = [&cache](std::size_t size) {
+            cache.setTargetSize(static_cast<int>(size));
+        };
+        c.entryBytes = entryBytes;
+        c.minSize = minSize;
+        c.target = static_cast<std::size_t>(cache.getTargetSize());
+
+        std::lock_guard lock(mutex_);
+        caches_.push_back(std::move(c));
+    }
+
+    /** Count a cache against the budget without resizing it.
+
+        @param name The name reported by getJson().
+        @param bytes Returns the bytes the cache holds.
+    */
+    void
+    addFixed(std::string name, std::function<std::uint64_t()> bytes);
+
+    /** Measure the caches and adjust their target sizes. */
+    void
+    rebalance();
+
+    Json::Value
+    getJson() const;
+
+private:
+    enum class Action { hold, grow, shrink };
+
+    struct Governed
+    {
+        std::string name;
+        std::function<std::size_t()> entries;
+        std::function<std::uint64_t()> bytes;
+        std::function<std::pair<std::uint64_t, std::uint64_t>()>
+            hitsAndMisses;
+        // Empty for caches that are measured but not resized
+        std::function<void(std::size_t)> setTarget;
+        std::size_t minSize = 0;
+
+        // The state seen by the last rebalance
+        std::size_t entryBytes = 0;
+        std::size_t target = 0;
+        std::size_t lastEntries = 0;
+        std::uint64_t lastBytes = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        double hitRate = 0;
+        double utility = 0;
+        Action action = Action::hold;
+    };
+
+    // Change the target of a cache by about `bytes`, within the limits.
+    // Returns the bytes added to the target when growing, or the bytes the
+    // cache will free, as a negative number, when shrinking.
+    std::int64_t
+    resize(Governed& c, std::int64_t bytes);
+
+    std::uint64_t const budget_;
+    beast::Journal const j_;
+
+    mutable std::mutex mutex_;
+    std::vector<Governed> caches_;
+    std::uint64_t total_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -29,6 +29,7 @@
 #include <xrpld/app/ledger/TransactionMaster.h>
 #include <xrpld/app/main/LoadManager.h>
 #include <xrpld/app/misc/AmendmentTable.h>
+#include <xrpld/app/misc/CacheWarmer.h>
 #include <xrpld/app/misc/DeliverMax.h>
 #include <xrpld/app/misc/HashRouter.h>
 #include <xrpld/app/misc/LoadFeeTrack.h>
@@ -1467,10 +1468,19 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                 if (toSkip)
                 {
                     protocol::TMTransaction tx;
-                    Serializer s;
+                    auto const& stx = e.transaction->getSTransaction();
 
-                    e.transaction->getSTransaction()->add(s);
-                    tx.set_rawtransaction(s.data(), s.size());
+                    // Relay the encoding we received, when we have it
+                    if (auto const wire = stx->getWireData())
+                    {
+                        tx.set_rawtransaction(wire->data(), wire->size());
+                    }
+                    else
+                    {
+                        Serializer s;
+                        stx->add(s);
+                        tx.set_rawtransaction(s.data(), s.size());
+                    }
                     tx.set_status(protocol::tsCURRENT);
                     tx.set_receivetimestamp(
                         app_.timeKeeper().now().time_since_epoch().count());
@@ -2282,6 +2292,11 @@ NetworkOPsImp::setMode(OperatingMode om)
     if ((om > OperatingMode::CONNECTED) && isBlocked())
         om = OperatingMode::CONNECTED;
 
+    // Wait for the caches to be warm before taking requests as a full
+    // server. The next consensus round tries again.
+    if (om == OperatingMode::FULL && app_.getCacheWarmer().holdsFull())
+        om = OperatingMode::TRACKING;
+
     if (mMode == om)
         return;
 
@@ -2681,6 +2696,11 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
     }
 
     accounting_.json(info);
+    if (admin)
+    {
+        if (auto const warm = app_.getCacheWarmer().getJson(); !warm.isNull())
+            info[jss::cache_warm] = warm;
+    }
     info[jss::uptime] = UptimeClock::now().time_since_epoch().count();
     info[jss::jq_trans_overflow] =
         std::to_string(app_.overlay().getJqTransOverflow());
@@ -309,6 +309,10 @@ public:
     Json::Value
     getJson(JsonOptions options, bool binary = false) const;
 
+    /** The approximate bytes taken by this and the transaction it holds. */
+    std::size_t
+    memoryFootprint() const;
+
     // Information used to locate a transaction.
     // Contains a nodestore hash and ledger sequence pair if the transaction was
     // found. Otherwise, contains the range of ledgers present in the database
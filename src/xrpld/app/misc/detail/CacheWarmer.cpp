@@ -0,0 +1,414 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/misc/CacheWarmer.h>
+#include <xrpld/app/ledger/LedgerMaster.h>
+#include <xrpld/app/main/Application.h>
+#include <xrpld/core/ConfigSections.h>
+#include <xrpld/nodestore/Database.h>
+#include <xrpld/shamap/SHAMapLeafNode.h>
+#include <xrpld/shamap/SHAMapTreeNode.h>
+#include <xrpl/basics/Log.h>
+#include <xrpl/beast/core/CurrentThreadName.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/Serializer.h>
+#include <xrpl/protocol/digest.h>
+#include <xrpl/protocol/jss.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace ripple {
+
+namespace {
+
+constexpr char imageMagic[8] = {'X', 'R', 'P', 'L', 'W', 'A', 'R', 'M'};
+constexpr std::uint32_t imageVersion = 1;
+
+// The number of node store reads in flight at once while warming
+constexpr std::size_t batchSize = 256;
+
+void
+addKeys(Serializer& s, std::vector<uint256> const& keys)
+{
+    s.add32(keys.size());
+    for (auto const& key : keys)
+        s.addBitString(key);
+}
+
+bool
+getKeys(SerialIter& sit, std::vector<uint256>& keys)
+{
+    auto const count = sit.get32();
+    if (count > sit.getBytesLeft() / uint256::size())
+        return false;
+    keys.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+        keys.push_back(sit.get256());
+    return true;
+}
+
+}  // namespace
+
+Blob
+serializeCacheImage(CacheImage const& image)
+{
+    auto const keys =
+        image.ledgers.size() + image.treeNodes.size() + image.sles.size();
+    Serializer s(sizeof(imageMagic) + 16 + uint256::size() * (keys + 1));
+    s.addRaw(Slice(imageMagic, sizeof(imageMagic)));
+    s.add32(imageVersion);
+    addKeys(s, image.ledgers);
+    addKeys(s, image.treeNodes);
+    addKeys(s, image.sles);
+    s.addBitString(sha512Half(s.slice()));
+    return s.getData();
+}
+
+std::optional<CacheImage>
+deserializeCacheImage(Slice data)
+{
+    // Magic, version, three empty lists and the hash
+    if (data.size() < sizeof(imageMagic) + 16 + uint256::size())
+        return std::nullopt;
+
+    Slice const body(data.data(), data.size() - uint256::size());
+    if (sha512Half(body) != uint256::fromVoid(data.data() + body.size()))
+        return std::nullopt;
+    if (std::memcmp(body.data(), imageMagic, sizeof(imageMagic)) != 0)
+        return std::nullopt;
+
+    SerialIter sit(
+        body.data() + sizeof(imageMagic), body.size() - sizeof(imageMagic));
+    if (sit.get32() != imageVersion)
+        return std::nullopt;
+
+    CacheImage image;
+    if (!getKeys(sit, image.ledgers) || !getKeys(sit, image.treeNodes) ||
+        !getKeys(sit, image.sles) || !sit.empty())
+        return std::nullopt;
+    return image;
+}
+
+//------------------------------------------------------------------------------
+
+CacheWarmer::CacheWarmer(Application& app, beast::Journal journal)
+    : app_(app), j_(journal)
+{
+    auto const& section = app_.config().section(SECTION_CACHE_IMAGE);
+    maxLedgers_ = section.value_or<std::size_t>("ledgers", 32);
+    maxTreeNodes_ = section.value_or<std::size_t>("tree_nodes", 250000);
+    maxSles_ = section.value_or<std::size_t>("sles", 50000);
+    maxDelay_ =
+        std::chrono::seconds{section.value_or<std::uint32_t>("max_delay", 120)};
+
+    if (auto const path = section.get<std::string>("path"); path)
+    {
+        boost::filesystem::path p(*path);
+        if (p.is_relative())
+        {
+            boost::filesystem::path const dir(
+                app_.config().legacy("database_path"));
+            p = dir / p;
+        }
+        path_ = p.string();
+    }
+}
+
+CacheWarmer::~CacheWarmer()
+{
+    stop();
+}
+
+void
+CacheWarmer::start()
+{
+    if (!enabled())
+        return;
+
+    std::ifstream in(path_, std::ios::in | std::ios::binary);
+    if (!in)
+    {
+        JLOG(j_.info()) << "No cache image at " << path_;
+        return;
+    }
+
+    Blob const data{
+        std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    auto image = deserializeCacheImage(makeSlice(data));
+    if (!image)
+    {
+        JLOG(j_.warn()) << "Ignoring damaged cache image " << path_;
+        state_ = State::failed;
+        return;
+    }
+
+    requested_ =
+        image->ledgers.size() + image->treeNodes.size() + image->sles.size();
+    JLOG(j_.info()) << "Warming caches with " << requested_ << " entries from "
+                    << path_;
+
+    start_ = std::chrono::steady_clock::now();
+    state_ = State::warming;
+    thread_ = std::thread(&CacheWarmer::run, this, std::move(*image));
+}
+
+void
+CacheWarmer::stop()
+{
+    if (thread_.joinable())
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        thread_.join();
+    }
+}
+
+bool
+CacheWarmer::holdsFull() const
+{
+    return state_ == State::warming &&
+        std::chrono::steady_clock::now() - start_ < maxDelay_;
+}
+
+bool
+CacheWarmer::stopping() const
+{
+    std::lock_guard lock(mutex_);
+    return stop_ || app_.isStopping();
+}
+
+void
+CacheWarmer::run(CacheImage image)
+{
+    beast::setCurrentThreadName("CacheWarmer");
+
+    // Loading a ledger also loads the roots of its maps, which every lookup
+    // in that ledger starts from.
+    for (auto const& hash : image.ledgers)
+    {
+        if (stopping())
+            break;
+
+        try
+        {
+            if (app_.getLedgerMaster().getLedgerByHash(hash))
+                ++loaded_;
+            else
+                ++missing_;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.debug()) << "Unable to load ledger " << hash << ": "
+                             << e.what();
+            ++missing_;
+        }
+    }
+
+    warmNodes(image.treeNodes, false);
+    warmNodes(image.sles, true);
+
+    using namespace std::chrono;
+    auto const elapsed =
+        duration_cast<microseconds>(steady_clock::now() - start_);
+    duration_ = elapsed.count();
+    state_ = stopping() ? State::stopped : State::complete;
+
+    JLOG(j_.info()) << "Loaded " << loaded_ << " of " << requested_
+                    << " cache entries in "
+                    << duration_cast<milliseconds>(elapsed).count() << "ms, "
+                    << missing_ << " missing";
+}
+
+void
+CacheWarmer::warmNodes(std::vector<uint256> const& keys, bool sles)
+{
+    auto& db = app_.getNodeStore();
+    auto const treeCache = app_.getNodeFamily().getTreeNodeCache();
+    auto& sleCache = app_.cachedSLEs();
+
+    auto const onFetch = [&](uint256 const& key,
+                             std::shared_ptr<NodeObject> const& object) {
+        if (!object)
+        {
+            ++missing_;
+            return;
+        }
+
+        try
+        {
+            auto node = SHAMapTreeNode::makeFromPrefix(
+                makeSlice(object->getData()), SHAMapHash{key});
+
+            if (sles)
+            {
+                // The key of a cached SLE is the hash of its leaf
+                if (node->getType() != SHAMapNodeType::tnACCOUNT_STATE)
+                {
+                    ++missing_;
+                    return;
+                }
+                auto const& item =
+                    intr_ptr::static_pointer_cast<SHAMapLeafNode>(node)
+                        ->peekItem();
+                std::shared_ptr<SLE const> sle = std::make_shared<SLE>(
+                    SerialIter{item->slice()}, item->key());
+                sleCache.canonicalize_replace_client(key, sle);
+            }
+
+            treeCache->canonicalize_replace_client(key, node);
+            ++loaded_;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.debug()) << "Unable to decode node " << key << ": "
+                             << e.what();
+            ++missing_;
+        }
+    };
+
+    for (std::size_t first = 0; first < keys.size(); first += batchSize)
+    {
+        if (stopping())
+            return;
+
+        auto const last = std::min(keys.size(), first + batchSize);
+        {
+            std::lock_guard lock(mutex_);
+            pending_ = last - first;
+        }
+
+        // The node store's read threads service the batch in parallel. The
+        // application stops this thread before it stops the node store, so
+        // every callback runs before the batch is abandoned.
+        for (auto i = first; i != last; ++i)
+        {
+            db.asyncFetch(
+                keys[i],
+                0,
+                [this, &onFetch, key = keys[i]](
+                    std::shared_ptr<NodeObject> const& object) {
+                    onFetch(key, object);
+                    std::lock_guard lock(mutex_);
+                    if (--pending_ == 0)
+                        cond_.notify_all();
+                });
+        }
+
+        std::unique_lock lock(mutex_);
+        cond_.wait(lock, [this] { return pending_ == 0; });
+    }
+}
+
+void
+CacheWarmer::save()
+{
+    if (!enabled())
+        return;
+
+    if (state_ == State::warming || state_ == State::stopped)
+    {
+        JLOG(j_.info()) << "Cache warming was interrupted, keeping "
+                        << path_;
+        return;
+    }
+
+    CacheImage image;
+    image.ledgers = app_.getLedgerMaster().getRecentLedgerHashes(maxLedgers_);
+    image.treeNodes =
+        app_.getNodeFamily().getTreeNodeCache()->getRecentKeys(maxTreeNodes_);
+    image.sles = app_.cachedSLEs().getRecentKeys(maxSles_);
+    auto const data = serializeCacheImage(image);
+
+    // Write a new file and rename it, so that a crash never leaves a
+    // truncated image behind.
+    auto const partial = path_ + ".partial";
+    {
+        std::ofstream out(
+            partial, std::ios::out | std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<char const*>(data.data()), data.size());
+        if (!out)
+        {
+            JLOG(j_.warn()) << "Unable to write cache image " << partial;
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(partial, path_, ec);
+    if (ec)
+    {
+        JLOG(j_.warn()) << "Unable to rename " << partial << " to " << path_
+                        << ": " << ec.message();
+        return;
+    }
+
+    JLOG(j_.info()) << "Saved " << image.ledgers.size() << " ledgers, "
+                    << image.treeNodes.size() << " tree nodes and "
+                    << image.sles.size() << " SLEs to " << path_;
+}
+
+Json::Value
+CacheWarmer::getJson() const
+{
+    if (!enabled())
+        return {};
+
+    Json::Value ret(Json::objectValue);
+    auto const state = state_.load();
+    switch (state)
+    {
+        case State::idle:
+            ret[jss::status] = "none";
+            break;
+        case State::warming:
+            ret[jss::status] = "warming";
+            break;
+        case State::complete:
+            ret[jss::status] = "complete";
+            break;
+        case State::stopped:
+            ret[jss::status] = "stopped";
+            break;
+        case State::failed:
+            ret[jss::status] = "failed";
+            break;
+    }
+
+    if (state == State::idle || state == State::failed)
+        return ret;
+
+    ret[jss::requested] = static_cast<Json::UInt>(requested_.load());
+    ret[jss::loaded] = static_cast<Json::UInt>(loaded_.load());
+    ret[jss::missing] = static_cast<Json::UInt>(missing_.load());
+
+    using namespace std::chrono;
+    auto const duration = state == State::warming
+        ? duration_cast<microseconds>(steady_clock::now() - start_).count()
+        : duration_.load();
+    ret[jss::duration_us] = std::to_string(duration);
+    return ret;
+}
+
+}  // namespace ripple
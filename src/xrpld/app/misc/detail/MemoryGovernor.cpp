@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/misc/MemoryGovernor.h>
+#include <xrpl/basics/ByteUtilities.h>
+#include <xrpl/basics/Log.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+MemoryGovernor::MemoryGovernor(std::uint64_t budget, beast::Journal journal)
+    : budget_(budget), j_(journal)
+{
+}
+
+void
+MemoryGovernor::addFixed(
+    std::string name,
+    std::function<std::uint64_t()> bytes)
+{
+    Governed c;
+    c.name = std::move(name);
+    c.entries = []() { return std::size_t{0}; };
+    c.bytes = std::move(bytes);
+    c.hitsAndMisses = []() {
+        return std::pair<std::uint64_t, std::uint64_t>{};
+    };
+
+    std::lock_guard lock(mutex_);
+    caches_.push_back(std::move(c));
+}
+
+std::int64_t
+MemoryGovernor::resize(Governed& c, std::int64_t bytes)
+{
+    auto const entryBytes =
+        static_cast<std::int64_t>(std::max<std::size_t>(c.entryBytes, 1));
+    auto const current = static_cast<std::int64_t>(c.target);
+    auto const held = static_cast<std::int64_t>(c.lastEntries);
+    std::int64_t target;
+
+    if (bytes < 0)
+    {
+        // The cache holding more entries than its target means the last
+        // shrink has not been swept yet; shrinking again would overshoot.
+        // Otherwise shrink from what it holds, which may be below the
+        // target.
+        if (current < held)
+            return 0;
+        auto const base = std::min(current, held);
+        auto const step = std::max<std::int64_t>(base / 4, 1);
+        target = base - std::min(-bytes / entryBytes, step);
+    }
+    else
+    {
+        // Growing only helps a cache that fills the target it has
+        if (c.lastEntries * 4 < c.target * 3)
+            return 0;
+        auto const step = std::max<std::int64_t>(current / 4, 1);
+        target = current + std::min(bytes / entryBytes, step);
+    }
+
+    target = std::max<std::int64_t>(target, c.minSize);
+    if (target == current)
+        return 0;
+
+    JLOG(j_.debug()) << c.name << " target size " << current << " -> "
+                     << target;
+    c.action = target > current ? Action::grow : Action::shrink;
+    c.target = static_cast<std::size_t>(target);
+    c.setTarget(c.target);
+
+    // A shrink frees only the entries held beyond the new target, which
+    // is less than the drop in target when the cache was not full.
+    if (target < current)
+        return std::min<std::int64_t>(target - held, 0) * entryBytes;
+    return (target - current) * entryBytes;
+}
+
+void
+MemoryGovernor::rebalance()
+{
+    std::lock_guard lock(mutex_);
+
+    std::uint64_t total = 0;
+    for (auto& c : caches_)
+    {
+        c.lastBytes = c.bytes();
+        total += c.lastBytes;
+        if (!c.setTarget)
+            continue;
+
+        c.lastEntries = c.entries();
+        if (c.lastEntries != 0)
+            c.entryBytes = std::max<std::size_t>(
+                c.lastBytes / c.lastEntries, 1);
+
+        // The counters only grow, unless the cache was reset
+        auto const [hits, misses] = c.hitsAndMisses();
+        auto const dh = hits >= c.hits ? hits - c.hits : hits;
+        auto const dm = misses >= c.misses ? misses - c.misses : misses;
+        c.hits = hits;
+        c.misses = misses;
+        c.hitRate = (dh + dm) != 0 ? double(dh) / (dh + dm) : 0;
+        c.utility = double(dm) /
+            std::max<double>(c.lastBytes, megabytes(1)) * megabytes(1);
+
+        // A cache without a size limit starts from what it holds now
+        if (c.target == 0)
+            c.target = std::max(c.lastEntries, c.minSize);
+
+        c.action = Action::hold;
+    }
+    total_ = total;
+
+    if (budget_ == 0)
+        return;
+
+    std::vector<Governed*> byUtility;
+    byUtility.reserve(caches_.size());
+    for (auto& c : caches_)
+    {
+        if (c.setTarget)
+            byUtility.push_back(&c);
+    }
+    std::stable_sort(
+        byUtility.begin(), byUtility.end(), [](auto const* a, auto const* b) {
+            return a->utility < b->utility;
+        });
+
+    // Leave some headroom, so that growth between rounds stays in budget
+    auto const high = budget_;
+    auto const low = budget_ - budget_ / 10;
+
+    if (total > high)
+    {
+        auto excess = static_cast<std::int64_t>(total - high);
+        for (auto* c : byUtility)
+        {
+            if (excess <= 0)
+                break;
+            excess += resize(*c, -excess);
+        }
+    }
+    else if (total < low)
+    {
+        auto room = static_cast<std::int64_t>(low - total);
+        for (auto it = byUtility.rbegin(); it != byUtility.rend(); ++it)
+        {
+            if (room <= 0 || (*it)->utility == 0)
+                break;
+            room -= resize(**it, room);
+        }
+    }
+    else if (byUtility.size() > 1)
+    {
+        auto& donor = *byUtility.front();
+        auto& taker = *byUtility.back();
+        if (taker.utility > 2 * donor.utility)
+        {
+            auto const freed = -resize(
+                donor, -static_cast<std::int64_t>(donor.lastBytes / 8));
+            if (freed > 0)
+                resize(taker, freed);
+        }
+    }
+}
+
+Json::Value
+MemoryGovernor::getJson() const
+{
+    std::lock_guard lock(mutex_);
+
+    Json::Value ret(Json::objectValue);
+    ret[jss::budget] = std::to_string(budget_);
+    ret[jss::bytes] = std::to_string(total_);
+
+    Json::Value& caches = ret[jss::caches] = Json::objectValue;
+    for (auto const& c : caches_)
+    {
+        Json::Value& entry = caches[c.name] = Json::objectValue;
+        entry[jss::bytes] = std::to_string(c.lastBytes);
+        if (!c.setTarget)
+            continue;
+        entry[jss::entries] = static_cast<Json::UInt>(c.lastEntries);
+        entry[jss::target_size] = static_cast<Json::UInt>(c.target);
+        entry[jss::hit_rate] = c.hitRate;
+        switch (c.action)
+        {
+            case Action::hold:
+                entry[jss::action] = "hold";
+                break;
+            case Action::grow:
+                entry[jss::action] = "grow";
+                break;
+            case Action::shrink:
+                entry[jss::action] = "shrink";
+                break;
+        }
+    }
+    return ret;
+}
+
+}  // namespace ripple
@@ -147,6 +147,15 @@ Transaction::load(
     return db->getTransaction(id, range, ec);
 }
 
+std::size_t
+Transaction::memoryFootprint() const
+{
+    std::size_t bytes = sizeof(*this);
+    if (mTransaction)
+        bytes += sizeof(STTx) + mTransaction->getFieldsFootprint();
+    return bytes;
+}
+
 // options 1 to include the date of the transaction
 Json::Value
 Transaction::getJson(JsonOptions options, bool binary) const
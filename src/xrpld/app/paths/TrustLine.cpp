@@ -25,14 +25,12 @@
 
 namespace ripple {
 
-TrustLineBase::TrustLineBase(
-    std::shared_ptr<SLE const> const& sle,
-    AccountID const& viewAccount)
-    : key_(sle->key())
-    , mLowLimit(sle->getFieldAmount(sfLowLimit))
-    , mHighLimit(sle->getFieldAmount(sfHighLimit))
-    , mBalance(sle->getFieldAmount(sfBalance))
-    , mFlags(sle->getFieldU32(sfFlags))
+TrustLineBase::TrustLineBase(LazySLE const& sle, AccountID const& viewAccount)
+    : key_(sle.key())
+    , mLowLimit(sle.getFieldAmount(sfLowLimit))
+    , mHighLimit(sle.getFieldAmount(sfHighLimit))
+    , mBalance(sle.getFieldAmount(sfBalance))
+    , mFlags(sle.getFieldU32(sfFlags))
     , mViewLowest(mLowLimit.getIssuer() == viewAccount)
 {
     if (!mViewLowest)
@@ -55,7 +53,7 @@ PathFindTrustLine::makeItem(
 {
     if (!sle || sle->getType() != ltRIPPLE_STATE)
         return {};
-    return std::optional{PathFindTrustLine{sle, accountID}};
+    return std::optional{PathFindTrustLine{LazySLE{sle}, accountID}};
 }
 
 namespace detail {
@@ -95,14 +93,12 @@ PathFindTrustLine::getItems(
         accountID, view, direction);
 }
 
-RPCTrustLine::RPCTrustLine(
-    std::shared_ptr<SLE const> const& sle,
-    AccountID const& viewAccount)
+RPCTrustLine::RPCTrustLine(LazySLE const& sle, AccountID const& viewAccount)
     : TrustLineBase(sle, viewAccount)
-    , lowQualityIn_(sle->getFieldU32(sfLowQualityIn))
-    , lowQualityOut_(sle->getFieldU32(sfLowQualityOut))
-    , highQualityIn_(sle->getFieldU32(sfHighQualityIn))
-    , highQualityOut_(sle->getFieldU32(sfHighQualityOut))
+    , lowQualityIn_(sle.getFieldU32(sfLowQualityIn))
+    , lowQualityOut_(sle.getFieldU32(sfLowQualityOut))
+    , highQualityIn_(sle.getFieldU32(sfHighQualityIn))
+    , highQualityOut_(sle.getFieldU32(sfHighQualityOut))
 {
 }
 
@@ -113,7 +109,17 @@ RPCTrustLine::makeItem(
 {
     if (!sle || sle->getType() != ltRIPPLE_STATE)
         return {};
-    return std::optional{RPCTrustLine{sle, accountID}};
+    return std::optional{RPCTrustLine{LazySLE{sle}, accountID}};
+}
+
+std::optional<RPCTrustLine>
+RPCTrustLine::makeItem(
+    AccountID const& accountID,
+    std::optional<LazySLE> const& sle)
+{
+    if (!sle || sle->getType() != ltRIPPLE_STATE)
+        return {};
+    return std::optional{RPCTrustLine{*sle, accountID}};
 }
 
 std::vector<RPCTrustLine>
@@ -55,9 +55,7 @@ class TrustLineBase
 protected:
     // This class should not be instantiated directly. Use one of the derived
     // classes.
-    TrustLineBase(
-        std::shared_ptr<SLE const> const& sle,
-        AccountID const& viewAccount);
+    TrustLineBase(LazySLE const& sle, AccountID const& viewAccount);
 
     ~TrustLineBase() = default;
     TrustLineBase(TrustLineBase const&) = default;
@@ -209,9 +207,7 @@ class RPCTrustLine final : public TrustLineBase,
 public:
     RPCTrustLine() = delete;
 
-    RPCTrustLine(
-        std::shared_ptr<SLE const> const& sle,
-        AccountID const& viewAccount);
+    RPCTrustLine(LazySLE const& sle, AccountID const& viewAccount);
 
     Rate const&
     getQualityIn() const
@@ -228,6 +224,9 @@ public:
     static std::optional<RPCTrustLine>
     makeItem(AccountID const& accountID, std::shared_ptr<SLE const> const& sle);
 
+    static std::optional<RPCTrustLine>
+    makeItem(AccountID const& accountID, std::optional<LazySLE> const& sle);
+
     static std::vector<RPCTrustLine>
     getItems(AccountID const& accountID, ReadView const& view);
 
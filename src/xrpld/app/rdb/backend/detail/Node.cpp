@@ -88,6 +88,7 @@ makeLedgerDBs(
 
         if (!setup.standAlone || setup.startUp == Config::LOAD ||
             setup.startUp == Config::LOAD_FILE ||
+            setup.startUp == Config::LOAD_SNAPSHOT ||
             setup.startUp == Config::REPLAY)
         {
             // Check if AccountTransactions has primary key
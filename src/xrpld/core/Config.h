@@ -150,7 +150,15 @@ public:
     // Entries from [ips_fixed] config stanza
     std::vector<std::string> IPS_FIXED;
 
-    enum StartUpType { FRESH, NORMAL, LOAD, LOAD_FILE, REPLAY, NETWORK };
+    enum StartUpType {
+        FRESH,
+        NORMAL,
+        LOAD,
+        LOAD_FILE,
+        LOAD_SNAPSHOT,
+        REPLAY,
+        NETWORK
+    };
     StartUpType START_UP = NORMAL;
 
     bool START_VALID = false;
@@ -229,6 +237,13 @@ public:
     // Enable the experimental Ledger Replay functionality
     bool LEDGER_REPLAY = false;
 
+    // Check transaction signatures concurrently when building a ledger
+    bool PARALLEL_TX_CHECKS = false;
+
+    // Bytes the caches may use between them, or 0 to keep the sizes
+    // derived from node_size
+    std::uint64_t MEMORY_BUDGET = 0;
+
     // Work queue limits
     int MAX_TRANSACTIONS = 250;
     static constexpr int MAX_JOB_QUEUE_TX = 1000;
@@ -124,6 +124,7 @@ public:
         : DatabaseCon(
               setup.standAlone && setup.startUp != Config::LOAD &&
                       setup.startUp != Config::LOAD_FILE &&
+                      setup.startUp != Config::LOAD_SNAPSHOT &&
                       setup.startUp != Config::REPLAY
                   ? ""
                   : (setup.dataDir / dbName),
@@ -0,0 +1,218 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_LAZYSLE_H_INCLUDED
+#define RIPPLE_LEDGER_LAZYSLE_H_INCLUDED
+
+#include <xrpld/shamap/SHAMapItem.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/STVector256.h>
+#include <boost/container/small_vector.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace ripple {
+
+/** A read-only view of a ledger entry that decodes fields on demand.
+
+    Reading an entry normally deserializes every field into an SLE, even
+    when the caller only wants a balance or a flag. A LazySLE instead
+    keeps a reference to the serialized bytes, scans the field headers
+    once to find where each field of the entry's template starts, and
+    decodes only the fields that are asked for.
+
+    A LazySLE can also wrap an entry that is already deserialized, which
+    is what views that hold modified entries return.
+
+    The accessors follow the semantics of the STObject functions of the
+    same name.
+*/
+class LazySLE
+{
+public:
+    /** Wrap an entry that has already been deserialized. */
+    explicit LazySLE(std::shared_ptr<SLE const> sle);
+
+    /** View the serialized entry held by a state map item. */
+    explicit LazySLE(boost::intrusive_ptr<SHAMapItem const> item);
+
+    uint256 const&
+    key() const
+    {
+        return key_;
+    }
+
+    LedgerEntryType
+    getType() const
+    {
+        return type_;
+    }
+
+    bool
+    isFieldPresent(SField const& field) const;
+
+    std::uint32_t
+    getFlags() const;
+
+    bool
+    isFlag(std::uint32_t flag) const
+    {
+        return (getFlags() & flag) == flag;
+    }
+
+    std::uint8_t
+    getFieldU8(SField const& field) const;
+
+    std::uint16_t
+    getFieldU16(SField const& field) const;
+
+    std::uint32_t
+    getFieldU32(SField const& field) const;
+
+    std::uint64_t
+    getFieldU64(SField const& field) const;
+
+    uint256
+    getFieldH256(SField const& field) const;
+
+    AccountID
+    getAccountID(SField const& field) const;
+
+    STAmount
+    getFieldAmount(SField const& field) const;
+
+    STVector256
+    getFieldV256(SField const& field) const;
+
+    template <class T>
+    std::decay_t<typename T::value_type>
+    operator[](TypedField<T> const& f) const;
+
+    template <class T>
+    std::optional<std::decay_t<typename T::value_type>>
+    operator[](OptionaledField<T> const& of) const;
+
+    /** Deserialize the whole entry. */
+    std::shared_ptr<SLE const>
+    decode() const;
+
+    Json::Value
+    getJson(JsonOptions options) const;
+
+private:
+    static constexpr std::uint32_t absent = ~std::uint32_t(0);
+
+    bool
+    index();
+
+    // Return the field's position in the template, throwing if the
+    // template does not include it.
+    int
+    position(SField const& field) const;
+
+    // Decode the field, if it is present.
+    template <class T>
+    std::optional<T>
+    find(SField const& field) const;
+
+    template <class T>
+    std::decay_t<typename T::value_type>
+    value(SField const& field) const;
+
+    std::shared_ptr<SLE const> sle_;
+    boost::intrusive_ptr<SHAMapItem const> item_;
+    uint256 key_;
+    LedgerEntryType type_ = ltANY;
+    SOTemplate const* format_ = nullptr;
+
+    // The offset of each field of the template within the item
+    boost::container::small_vector<std::uint32_t, 32> offsets_;
+};
+
+template <class T>
+std::optional<T>
+LazySLE::find(SField const& field) const
+{
+    auto const offset = offsets_[position(field)];
+    if (offset == absent)
+        return std::nullopt;
+
+    auto const data = item_->slice();
+    SerialIter sit(data.data() + offset, data.size() - offset);
+
+    int type;
+    int name;
+    sit.getFieldID(type, name);  // Skip the header
+
+    std::optional<T> v{std::in_place, sit, field};
+    if (v->getSType() != field.fieldType)
+        Throw<std::runtime_error>("Wrong field type");
+    return v;
+}
+
+template <class T>
+std::decay_t<typename T::value_type>
+LazySLE::value(SField const& field) const
+{
+    if (auto const v = find<T>(field))
+        return v->value();
+    return {};
+}
+
+template <class T>
+std::decay_t<typename T::value_type>
+LazySLE::operator[](TypedField<T> const& f) const
+{
+    if (sle_)
+        return (*sle_)[f];
+
+    if (auto const v = find<T>(f))
+        return v->value();
+
+    if (format_->style(f) == soeOPTIONAL)
+        Throw<STObject::FieldErr>("Missing optional field: " + f.getName());
+
+    return {};
+}
+
+template <class T>
+std::optional<std::decay_t<typename T::value_type>>
+LazySLE::operator[](OptionaledField<T> const& of) const
+{
+    if (sle_)
+        return (*sle_)[of];
+
+    if (format_->getIndex(*of.f) < 0)
+        return std::nullopt;
+
+    if (auto const v = find<T>(*of.f))
+        return v->value();
+
+    if (format_->style(*of.f) == soeOPTIONAL)
+        return std::nullopt;
+
+    return std::decay_t<typename T::value_type>{};
+}
+
+}  // namespace ripple
+
+#endif
@@ -25,7 +25,9 @@
 #include <xrpl/protocol/Serializer.h>
 #include <cstdint>
 #include <memory>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -107,6 +109,23 @@ public:
         ReadView::key_type const& key,
         std::shared_ptr<Serializer const> const& txn,
         std::shared_ptr<Serializer const> const& metaData) = 0;
+
+    using tx_entry = std::tuple<
+        ReadView::key_type,
+        std::shared_ptr<Serializer const>,
+        std::shared_ptr<Serializer const>>;
+
+    /** Add transactions, in strictly increasing key order, to the tx map.
+
+        The default implementation calls rawTxInsert for each one;
+        views backed by a SHAMap can build the map in a single pass.
+    */
+    virtual void
+    rawTxInsertSorted(std::vector<tx_entry> const& txs)
+    {
+        for (auto const& [key, txn, metaData] : txs)
+            rawTxInsert(key, txn, metaData);
+    }
 };
 
 }  // namespace ripple
@@ -20,6 +20,7 @@
 #ifndef RIPPLE_LEDGER_READVIEW_H_INCLUDED
 #define RIPPLE_LEDGER_READVIEW_H_INCLUDED
 
+#include <xrpld/ledger/LazySLE.h>
 #include <xrpld/ledger/detail/ReadViewFwdRange.h>
 #include <xrpl/basics/FeeUnits.h>
 #include <xrpl/basics/IOUAmount.h>
@@ -173,6 +174,19 @@ public:
     virtual std::shared_ptr<SLE const>
     read(Keylet const& k) const = 0;
 
+    /** Return a read-only view of the state item associated with a key.
+
+        Unlike read(), the entry's fields are only decoded when they are
+        accessed, if the view holds the entry in serialized form. This
+        makes it the better choice for callers that need a few fields.
+        By default, the entry returned by read() is wrapped.
+
+        @return `std::nullopt` if the key is not present or if the type
+                does not match.
+    */
+    virtual std::optional<LazySLE>
+    readLazy(Keylet const& k) const;
+
     // Accounts in a payment are not allowed to use assets acquired during that
     // payment. The PaymentSandbox tracks the debits, credits, and owner count
     // changes that accounts make during a payment. `balanceHook` adjusts
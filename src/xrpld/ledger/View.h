@@ -178,6 +178,18 @@ forEachItemAfter(
     unsigned int limit,
     std::function<bool(std::shared_ptr<SLE const> const&)> const& f);
 
+/** Iterate all items after an item in the given directory, decoding the
+    fields of each item only as they are accessed.
+*/
+bool
+forEachItemAfter(
+    ReadView const& view,
+    Keylet const& root,
+    uint256 const& after,
+    std::uint64_t const hint,
+    unsigned int limit,
+    std::function<bool(std::optional<LazySLE> const&)> const& f);
+
 /** Iterate all items in an account's owner directory. */
 inline void
 forEachItem(
@@ -206,6 +218,18 @@ forEachItemAfter(
     return forEachItemAfter(view, keylet::ownerDir(id), after, hint, limit, f);
 }
 
+inline bool
+forEachItemAfter(
+    ReadView const& view,
+    AccountID const& id,
+    uint256 const& after,
+    std::uint64_t const hint,
+    unsigned int limit,
+    std::function<bool(std::optional<LazySLE> const&)> const& f)
+{
+    return forEachItemAfter(view, keylet::ownerDir(id), after, hint, limit, f);
+}
+
 [[nodiscard]] Rate
 transferRate(ReadView const& view, AccountID const& issuer);
 
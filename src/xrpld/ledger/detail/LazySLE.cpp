@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/ledger/LazySLE.h>
+#include <xrpl/basics/safe_cast.h>
+#include <xrpl/protocol/LedgerFormats.h>
+#include <xrpl/protocol/STAccount.h>
+#include <xrpl/protocol/STBitString.h>
+#include <xrpl/protocol/STInteger.h>
+#include <xrpl/protocol/detail/STVar.h>
+
+namespace ripple {
+
+LazySLE::LazySLE(std::shared_ptr<SLE const> sle)
+    : sle_(std::move(sle)), key_(sle_->key()), type_(sle_->getType())
+{
+}
+
+LazySLE::LazySLE(boost::intrusive_ptr<SHAMapItem const> item)
+    : item_(std::move(item)), key_(item_->key())
+{
+    // Entries that cannot be indexed are simply deserialized
+    if (!index())
+    {
+        sle_ = std::make_shared<SLE>(SerialIter{item_->slice()}, key_);
+        type_ = sle_->getType();
+        item_.reset();
+    }
+}
+
+bool
+LazySLE::index()
+{
+    auto const data = item_->slice();
+    SerialIter sit(data);
+
+    while (!sit.empty())
+    {
+        std::uint32_t const offset = data.size() - sit.getBytesLeft();
+
+        int type;
+        int name;
+        sit.getFieldID(type, name);
+        auto const& field = SField::getField(type, name);
+        if (field.isInvalid())
+            return false;
+
+        if (!format_)
+        {
+            // In canonical order the entry type is always the first field
+            if (field != sfLedgerEntryType)
+                return false;
+
+            type_ = safe_cast<LedgerEntryType>(sit.get16());
+            auto const item = LedgerFormats::getInstance().findByType(type_);
+            if (!item)
+                return false;
+
+            format_ = &item->getSOTemplate();
+            offsets_.assign(format_->size(), absent);
+        }
+
+        auto const n = format_->getIndex(field);
+        if (n < 0 || offsets_[n] != absent)
+            return false;
+        offsets_[n] = offset;
+
+        switch (type)
+        {
+            case STI_UINT8:
+                sit.skip(1);
+                break;
+            case STI_UINT16:
+                // The entry type has already been read
+                if (field != sfLedgerEntryType)
+                    sit.skip(2);
+                break;
+            case STI_UINT32:
+                sit.skip(4);
+                break;
+            case STI_UINT64:
+                sit.skip(8);
+                break;
+            case STI_UINT128:
+                sit.skip(16);
+                break;
+            case STI_UINT160:
+                sit.skip(20);
+                break;
+            case STI_UINT192:
+                sit.skip(24);
+                break;
+            case STI_UINT256:
+                sit.skip(32);
+                break;
+            case STI_AMOUNT:
+                if (sit.empty())
+                    return false;
+                // Native amounts are 8 bytes, issued amounts add the issue
+                sit.skip(
+                    (data[data.size() - sit.getBytesLeft()] & 0x80) ? 48 : 8);
+                break;
+            case STI_VL:
+            case STI_ACCOUNT:
+            case STI_VECTOR256:
+                sit.skip(sit.getVLDataLength());
+                break;
+            default:
+                // Anything else is rare in ledger entries; deserializing
+                // the field is the simplest way to find where it ends.
+                detail::STVar(sit, field);
+                break;
+        }
+    }
+
+    return format_ != nullptr;
+}
+
+int
+LazySLE::position(SField const& field) const
+{
+    auto const n = format_->getIndex(field);
+    if (n < 0)
+        throwFieldNotFound(field);
+    return n;
+}
+
+bool
+LazySLE::isFieldPresent(SField const& field) const
+{
+    if (sle_)
+        return sle_->isFieldPresent(field);
+
+    auto const n = format_->getIndex(field);
+    return n >= 0 && offsets_[n] != absent;
+}
+
+std::uint32_t
+LazySLE::getFlags() const
+{
+    if (sle_)
+        return sle_->getFlags();
+
+    // Unlike the other fields, a missing flags field is not an error
+    if (format_->getIndex(sfFlags) < 0)
+        return 0;
+    return value<STUInt32>(sfFlags);
+}
+
+std::uint8_t
+LazySLE::getFieldU8(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU8(field);
+    return value<STUInt8>(field);
+}
+
+std::uint16_t
+LazySLE::getFieldU16(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU16(field);
+    return value<STUInt16>(field);
+}
+
+std::uint32_t
+LazySLE::getFieldU32(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU32(field);
+    return value<STUInt32>(field);
+}
+
+std::uint64_t
+LazySLE::getFieldU64(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldU64(field);
+    return value<STUInt64>(field);
+}
+
+uint256
+LazySLE::getFieldH256(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldH256(field);
+    return value<STUInt256>(field);
+}
+
+AccountID
+LazySLE::getAccountID(SField const& field) const
+{
+    if (sle_)
+        return sle_->getAccountID(field);
+    return value<STAccount>(field);
+}
+
+STAmount
+LazySLE::getFieldAmount(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldAmount(field);
+    if (auto v = find<STAmount>(field))
+        return std::move(*v);
+    return STAmount{};
+}
+
+STVector256
+LazySLE::getFieldV256(SField const& field) const
+{
+    if (sle_)
+        return sle_->getFieldV256(field);
+    if (auto v = find<STVector256>(field))
+        return std::move(*v);
+    return STVector256{};
+}
+
+std::shared_ptr<SLE const>
+LazySLE::decode() const
+{
+    if (sle_)
+        return sle_;
+    return std::make_shared<SLE>(SerialIter{item_->slice()}, key_);
+}
+
+Json::Value
+LazySLE::getJson(JsonOptions options) const
+{
+    return decode()->getJson(options);
+}
+
+}  // namespace ripple
@@ -130,8 +130,12 @@ void
 OpenView::apply(TxsRawView& to) const
 {
     items_.apply(to);
+
+    std::vector<TxsRawView::tx_entry> txs;
+    txs.reserve(txs_.size());
     for (auto const& item : txs_)
-        to.rawTxInsert(item.first, item.second.txn, item.second.meta);
+        txs.emplace_back(item.first, item.second.txn, item.second.meta);
+    to.rawTxInsertSorted(txs);
 }
 
 //---
@@ -173,6 +177,12 @@ OpenView::read(Keylet const& k) const
     return items_.read(*base_, k);
 }
 
+std::optional<LazySLE>
+OpenView::readLazy(Keylet const& k) const
+{
+    return items_.readLazy(*base_, k);
+}
+
 auto
 OpenView::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
 {
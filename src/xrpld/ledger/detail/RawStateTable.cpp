@@ -319,6 +319,17 @@ RawStateTable::read(ReadView const& base, Keylet const& k) const
     return sle;
 }
 
+std::optional<LazySLE>
+RawStateTable::readLazy(ReadView const& base, Keylet const& k) const
+{
+    // Entries that were not touched can be read lazily from the base
+    if (items_.find(k.key) == items_.end())
+        return base.readLazy(k);
+    if (auto sle = read(base, k))
+        return LazySLE(std::move(sle));
+    return std::nullopt;
+}
+
 void
 RawStateTable::destroyXRP(XRPAmount const& fee)
 {
@@ -25,6 +25,14 @@ ReadView::sles_type::sles_type(ReadView const& view) : ReadViewFwdRange(view)
 {
 }
 
+std::optional<LazySLE>
+ReadView::readLazy(Keylet const& k) const
+{
+    if (auto sle = read(k))
+        return LazySLE(std::move(sle));
+    return std::nullopt;
+}
+
 auto
 ReadView::sles_type::begin() const -> iterator
 {
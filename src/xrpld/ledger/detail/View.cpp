@@ -172,7 +172,7 @@ isGlobalFrozen(ReadView const& view, AccountID const& issuer)
 {
     if (isXRP(issuer))
         return false;
-    if (auto const sle = view.read(keylet::account(issuer)))
+    if (auto const sle = view.readLazy(keylet::account(issuer)))
         return sle->isFlag(lsfGlobalFreeze);
     return false;
 }
@@ -189,7 +189,8 @@ isIndividualFrozen(
     if (issuer != account)
     {
         // Check if the issuer froze the line
-        auto const sle = view.read(keylet::line(account, issuer, currency));
+        auto const sle =
+            view.readLazy(keylet::line(account, issuer, currency));
         if (sle &&
             sle->isFlag((issuer > account) ? lsfHighFreeze : lsfLowFreeze))
             return true;
@@ -208,13 +209,13 @@ isFrozen(
 {
     if (isXRP(currency))
         return false;
-    auto sle = view.read(keylet::account(issuer));
+    auto sle = view.readLazy(keylet::account(issuer));
     if (sle && sle->isFlag(lsfGlobalFreeze))
         return true;
     if (issuer != account)
     {
         // Check if the issuer froze the line
-        sle = view.read(keylet::line(account, issuer, currency));
+        sle = view.readLazy(keylet::line(account, issuer, currency));
         if (sle &&
             sle->isFlag((issuer > account) ? lsfHighFreeze : lsfLowFreeze))
             return true;
@@ -238,7 +239,7 @@ accountHolds(
     }
 
     // IOU: Return balance on trust line modulo freeze
-    auto const sle = view.read(keylet::line(account, issuer, currency));
+    auto const sle = view.readLazy(keylet::line(account, issuer, currency));
     if (!sle)
     {
         amount.clear({currency, issuer});
@@ -348,8 +349,8 @@ xrpLiquid(
     std::int32_t ownerCountAdj,
     beast::Journal j)
 {
-    auto const sle = view.read(keylet::account(id));
-    if (sle == nullptr)
+    auto const sle = view.readLazy(keylet::account(id));
+    if (!sle)
         return beast::zero;
 
     // Return balance minus reserve
@@ -393,7 +394,7 @@ forEachItem(
 
     while (true)
     {
-        auto sle = view.read(pos);
+        auto const sle = view.readLazy(pos);
         if (!sle)
             return;
         for (auto const& key : sle->getFieldV256(sfIndexes))
@@ -405,14 +406,17 @@ forEachItem(
     }
 }
 
-bool
-forEachItemAfter(
+// Walk the items after an item in a directory, reading each with `read`
+template <class Read, class F>
+static bool
+forEachItemAfterImpl(
     ReadView const& view,
     Keylet const& root,
     uint256 const& after,
     std::uint64_t const hint,
     unsigned int limit,
-    std::function<bool(std::shared_ptr<SLE const> const&)> const& f)
+    Read const& read,
+    F const& f)
 {
     assert(root.type == ltDIR_NODE);
 
@@ -426,7 +430,7 @@ forEachItemAfter(
     {
         auto const hintIndex = keylet::page(root, hint);
 
-        if (auto hintDir = view.read(hintIndex))
+        if (auto const hintDir = view.readLazy(hintIndex))
         {
             for (auto const& key : hintDir->getFieldV256(sfIndexes))
             {
@@ -442,7 +446,7 @@ forEachItemAfter(
         bool found = false;
         for (;;)
         {
-            auto const ownerDir = view.read(currentIndex);
+            auto const ownerDir = view.readLazy(currentIndex);
             if (!ownerDir)
                 return found;
             for (auto const& key : ownerDir->getFieldV256(sfIndexes))
@@ -452,7 +456,7 @@ forEachItemAfter(
                     if (key == after)
                         found = true;
                 }
-                else if (f(view.read(keylet::child(key))) && limit-- <= 1)
+                else if (f(read(keylet::child(key))) && limit-- <= 1)
                 {
                     return found;
                 }
@@ -468,11 +472,11 @@ forEachItemAfter(
     {
         for (;;)
         {
-            auto const ownerDir = view.read(currentIndex);
+            auto const ownerDir = view.readLazy(currentIndex);
             if (!ownerDir)
                 return true;
             for (auto const& key : ownerDir->getFieldV256(sfIndexes))
-                if (f(view.read(keylet::child(key))) && limit-- <= 1)
+                if (f(read(keylet::child(key))) && limit-- <= 1)
                     return true;
             auto const uNodeNext = ownerDir->getFieldU64(sfIndexNext);
             if (uNodeNext == 0)
@@ -482,10 +486,48 @@ forEachItemAfter(
     }
 }
 
+bool
+forEachItemAfter(
+    ReadView const& view,
+    Keylet const& root,
+    uint256 const& after,
+    std::uint64_t const hint,
+    unsigned int limit,
+    std::function<bool(std::shared_ptr<SLE const> const&)> const& f)
+{
+    return forEachItemAfterImpl(
+        view,
+        root,
+        after,
+        hint,
+        limit,
+        [&view](Keylet const& k) { return view.read(k); },
+        f);
+}
+
+bool
+forEachItemAfter(
+    ReadView const& view,
+    Keylet const& root,
+    uint256 const& after,
+    std::uint64_t const hint,
+    unsigned int limit,
+    std::function<bool(std::optional<LazySLE> const&)> const& f)
+{
+    return forEachItemAfterImpl(
+        view,
+        root,
+        after,
+        hint,
+        limit,
+        [&view](Keylet const& k) { return view.readLazy(k); },
+        f);
+}
+
 Rate
 transferRate(ReadView const& view, AccountID const& issuer)
 {
-    auto const sle = view.read(keylet::account(issuer));
+    auto const sle = view.readLazy(keylet::account(issuer));
 
     if (sle && sle->isFieldPresent(sfTransferRate))
         return Rate{sle->getFieldU32(sfTransferRate)};
@@ -604,7 +646,7 @@ areCompatible(
 bool
 dirIsEmpty(ReadView const& view, Keylet const& k)
 {
-    auto const sleNode = view.read(k);
+    auto const sleNode = view.readLazy(k);
     if (!sleNode)
         return true;
     if (!sleNode->getFieldV256(sfIndexes).empty())
@@ -673,7 +715,7 @@ hashOfSeq(ReadView const& ledger, LedgerIndex seq, beast::Journal journal)
     if (int diff = ledger.seq() - seq; diff <= 256)
     {
         // Within 256...
-        auto const hashIndex = ledger.read(keylet::skip());
+        auto const hashIndex = ledger.readLazy(keylet::skip());
         if (hashIndex)
         {
             assert(
@@ -702,7 +744,7 @@ hashOfSeq(ReadView const& ledger, LedgerIndex seq, beast::Journal journal)
     }
 
     // in skiplist
-    auto const hashIndex = ledger.read(keylet::skip(seq));
+    auto const hashIndex = ledger.readLazy(keylet::skip(seq));
     if (hashIndex)
     {
         auto const lastSeq = hashIndex->getFieldU32(sfLastLedgerSequence);
@@ -1520,11 +1562,12 @@ requireAuth(ReadView const& view, Issue const& issue, AccountID const& account)
 {
     if (isXRP(issue) || issue.account == account)
         return tesSUCCESS;
-    if (auto const issuerAccount = view.read(keylet::account(issue.account));
+    if (auto const issuerAccount =
+            view.readLazy(keylet::account(issue.account));
         issuerAccount && (*issuerAccount)[sfFlags] & lsfRequireAuth)
     {
-        if (auto const trustLine =
-                view.read(keylet::line(account, issue.account, issue.currency)))
+        if (auto const trustLine = view.readLazy(
+                keylet::line(account, issue.account, issue.currency)))
             return ((*trustLine)[sfFlags] &
                     ((account > issue.account) ? lsfLowAuth : lsfHighAuth))
                 ? tesSUCCESS
@@ -1109,6 +1109,20 @@ private:
         return jvRequest;
     }
 
+    // snapshot_create <path> [<ledger>]
+    Json::Value
+    parseSnapshotCreate(Json::Value const& jvParams)
+    {
+        Json::Value jvRequest(Json::objectValue);
+        jvRequest[jss::path] = jvParams[0u].asString();
+
+        if (jvParams.size() == 2 &&
+            !jvParseLedger(jvRequest, jvParams[1u].asString()))
+            return rpcError(rpcLGR_IDX_MALFORMED);
+
+        return jvRequest;
+    }
+
 public:
     //--------------------------------------------------------------------------
 
@@ -1201,6 +1215,7 @@ public:
             {"server_state", &RPCParser::parseServerInfo, 0, 1},
             {"sign", &RPCParser::parseSignSubmit, 2, 3},
             {"sign_for", &RPCParser::parseSignFor, 3, 4},
+            {"snapshot_create", &RPCParser::parseSnapshotCreate, 1, 2},
             {"stop", &RPCParser::parseAsIs, 0, 0},
             {"submit", &RPCParser::parseSignSubmit, 1, 3},
             {"submit_multisigned", &RPCParser::parseSubmitMultiSigned, 1, 1},
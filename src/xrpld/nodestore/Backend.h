@@ -133,6 +133,13 @@ public:
     virtual int
     getWriteLoad() = 0;
 
+    /** Returns the number of bytes held by the backend's own cache. */
+    virtual std::uint64_t
+    getCacheBytes() const
+    {
+        return 0;
+    }
+
     /** Remove contents on disk upon destruction. */
     virtual void
     setDeletePath() = 0;
@@ -87,6 +87,10 @@ public:
     virtual std::int32_t
     getWriteLoad() const = 0;
 
+    /** Retrieve the number of bytes held by the backends' own caches. */
+    virtual std::uint64_t
+    getCacheBytes() const = 0;
+
     /** Store the object.
 
         The caller's Blob parameter is overwritten.
@@ -106,6 +110,17 @@ public:
         uint256 const& hash,
         std::uint32_t ledgerSeq) = 0;
 
+    /** Store a group of objects.
+
+        Backends that can write several objects at once do so with a single
+        write, rather than queueing each object separately.
+
+        @param batch The objects to store.
+        @param ledgerSeq The sequence of the ledger the objects belong to.
+    */
+    virtual void
+    storeBatch(Batch const& batch, std::uint32_t ledgerSeq) = 0;
+
     /* Check if two ledgers are in the same database
 
         If these two sequence numbers map to the same database,
@@ -95,6 +95,7 @@ public:
     std::unique_ptr<rocksdb::DB> m_db;
     int fdRequired_ = 2048;
     rocksdb::Options m_options;
+    std::shared_ptr<rocksdb::Cache> m_cache;
 
     RocksDBBackend(
         int keyBytes,
@@ -123,7 +124,8 @@ public:
             if (!hard_set && size == 256)
                 size = 1024;
 
-            table_options.block_cache = rocksdb::NewLRUCache(megabytes(size));
+            m_cache = rocksdb::NewLRUCache(megabytes(size));
+            table_options.block_cache = m_cache;
         }
 
         if (auto const v = get<int>(keyValues, "filter_bits"))
@@ -420,6 +422,12 @@ public:
         return m_batch.getWriteLoad();
     }
 
+    std::uint64_t
+    getCacheBytes() const override
+    {
+        return m_cache ? m_cache->GetUsage() : 0;
+    }
+
     void
     setDeletePath() override
     {
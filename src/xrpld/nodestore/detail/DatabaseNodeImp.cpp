@@ -44,6 +44,31 @@ DatabaseNodeImp::store(
     }
 }
 
+void
+DatabaseNodeImp::storeBatch(Batch const& batch, std::uint32_t)
+{
+    if (batch.empty())
+        return;
+
+    std::uint64_t sz = 0;
+    for (auto const& obj : batch)
+        sz += obj->getData().size();
+    storeStats(batch.size(), sz);
+
+    backend_->storeBatch(batch);
+    if (cache_)
+    {
+        for (auto obj : batch)
+        {
+            // Replace a negative cache entry if there is one
+            cache_->canonicalize(
+                obj->getHash(), obj, [](std::shared_ptr<NodeObject> const& n) {
+                    return n->getType() == hotDUMMY;
+                });
+        }
+    }
+}
+
 void
 DatabaseNodeImp::asyncFetch(
     uint256 const& hash,
@@ -96,6 +96,12 @@ public:
         return backend_->getWriteLoad();
     }
 
+    std::uint64_t
+    getCacheBytes() const override
+    {
+        return backend_->getCacheBytes();
+    }
+
     void
     importDatabase(Database& source) override
     {
@@ -106,6 +112,9 @@ public:
     store(NodeObjectType type, Blob&& data, uint256 const& hash, std::uint32_t)
         override;
 
+    void
+    storeBatch(Batch const& batch, std::uint32_t) override;
+
     bool
     isSameDB(std::uint32_t, std::uint32_t) override
     {
@@ -67,6 +67,14 @@ DatabaseRotatingImp::getWriteLoad() const
     return writableBackend_->getWriteLoad();
 }
 
+std::uint64_t
+DatabaseRotatingImp::getCacheBytes() const
+{
+    std::lock_guard lock(mutex_);
+    return writableBackend_->getCacheBytes() +
+        archiveBackend_->getCacheBytes();
+}
+
 void
 DatabaseRotatingImp::importDatabase(Database& source)
 {
@@ -103,6 +111,25 @@ DatabaseRotatingImp::store(
     storeStats(1, nObj->getData().size());
 }
 
+void
+DatabaseRotatingImp::storeBatch(Batch const& batch, std::uint32_t)
+{
+    if (batch.empty())
+        return;
+
+    auto const backend = [&] {
+        std::lock_guard lock(mutex_);
+        return writableBackend_;
+    }();
+
+    backend->storeBatch(batch);
+
+    std::uint64_t sz = 0;
+    for (auto const& obj : batch)
+        sz += obj->getData().size();
+    storeStats(batch.size(), sz);
+}
+
 void
 DatabaseRotatingImp::sweep()
 {
@@ -59,6 +59,9 @@ public:
     std::int32_t
     getWriteLoad() const override;
 
+    std::uint64_t
+    getCacheBytes() const override;
+
     void
     importDatabase(Database& source) override;
 
@@ -73,6 +76,9 @@ public:
     store(NodeObjectType type, Blob&& data, uint256 const& hash, std::uint32_t)
         override;
 
+    void
+    storeBatch(Batch const& batch, std::uint32_t) override;
+
     void
     sync() override;
 
@@ -139,6 +139,16 @@ OverlayImpl::OverlayImpl(
     , next_id_(1)
     , timer_count_(0)
     , slots_(app.logs(), *this)
+    , trustedValidations_(
+          app_.getJobQueue(),
+          jtVALIDATION_t,
+          "Trusted validation",
+          journal_)
+    , untrustedValidations_(
+          app_.getJobQueue(),
+          jtVALIDATION_ut,
+          "Untrusted validation",
+          journal_)
     , m_stats(
           std::bind(&OverlayImpl::collect_metrics, this),
           collector,
@@ -28,6 +28,7 @@
 #include <xrpld/overlay/detail/Handshake.h>
 #include <xrpld/overlay/detail/TrafficCount.h>
 #include <xrpld/overlay/detail/TxMetrics.h>
+#include <xrpld/overlay/detail/ValidationIngest.h>
 #include <xrpld/peerfinder/PeerfinderManager.h>
 #include <xrpld/rpc/ServerHandler.h>
 #include <xrpl/basics/Resolver.h>
@@ -124,6 +125,10 @@ private:
     // Transaction reduce-relay metrics
     metrics::TxMetrics txMetrics_;
 
+    // Batched checking of validations received from peers
+    ValidationIngest trustedValidations_;
+    ValidationIngest untrustedValidations_;
+
     // A message with the list of manifests we send to peers
     std::shared_ptr<Message> manifestMessage_;
     // Used to track whether we need to update the cached list of manifests
@@ -244,6 +249,15 @@ public:
     std::shared_ptr<Message>
     getManifestsMessage();
 
+    /** Returns the stage which checks validations from trusted or untrusted
+        validators.
+    */
+    ValidationIngest&
+    validationIngest(bool trusted)
+    {
+        return trusted ? trustedValidations_ : untrustedValidations_;
+    }
+
     //--------------------------------------------------------------------------
     //
     // OverlayImpl
@@ -1231,11 +1231,10 @@ PeerImp::handleTransaction(
         return;
     }
 
-    SerialIter sit(makeSlice(m->rawtransaction()));
-
     try
     {
-        auto stx = std::make_shared<STTx const>(sit);
+        auto stx =
+            std::make_shared<STTx const>(makeSlice(m->rawtransaction()));
         uint256 txID = stx->getTransactionID();
 
         int flags;
@@ -2215,11 +2214,11 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
     try
     {
         auto const closeTime = app_.timeKeeper().closeTime();
+        auto const key = sha512Half(makeSlice(m->validation()));
 
-        std::shared_ptr<STValidation> val;
-        {
+        auto const deserialize = [&]() {
             SerialIter sit(makeSlice(m->validation()));
-            val = std::make_shared<STValidation>(
+            auto val = std::make_shared<STValidation>(
                 std::ref(sit),
                 [this](PublicKey const& pk) {
                     return calcNodeID(
@@ -2227,8 +2226,43 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
                 },
                 false);
             val->setSeen(closeTime);
+            return val;
+        };
+
+        auto const onDuplicate =
+            [&](std::optional<Stopwatch::time_point> const& relayed,
+                std::shared_ptr<STValidation> val) {
+                // Count unique messages (Slots has it's own 'HashRouter'),
+                // which a peer receives within IDLED seconds since the
+                // message has been relayed. Wait WAIT_ON_BOOTUP time to let
+                // the server establish connections to peers.
+                if (reduceRelayReady() && relayed &&
+                    (stopwatch().now() - *relayed) < reduce_relay::IDLED)
+                {
+                    if (!val)
+                        val = deserialize();
+                    overlay_.updateSlotAndSquelch(
+                        key,
+                        val->getSignerPublic(),
+                        id_,
+                        protocol::mtVALIDATION);
+                }
+                JLOG(p_journal_.trace()) << "Validation: duplicate";
+            };
+
+        // Most copies of a validation are ones already seen, so look for it
+        // before deserializing it. Only a validation that passes the checks
+        // below is added, so a stale copy never suppresses a later one.
+        if (auto const [known, relayed] =
+                app_.getHashRouter().addSuppressionPeerIfKnown(key, id_);
+            known)
+        {
+            onDuplicate(relayed, nullptr);
+            return;
         }
 
+        auto const val = deserialize();
+
         if (!isCurrent(
                 app_.getValidations().parms(),
                 app_.timeKeeper().closeTime(),
@@ -2252,21 +2286,12 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
         if (!isTrusted && app_.config().RELAY_UNTRUSTED_VALIDATIONS == -1)
             return;
 
-        auto key = sha512Half(makeSlice(m->validation()));
-
-        if (auto [added, relayed] =
+        // Another copy may have been added since the lookup above
+        if (auto const [added, relayed] =
                 app_.getHashRouter().addSuppressionPeerWithStatus(key, id_);
             !added)
         {
-            // Count unique messages (Slots has it's own 'HashRouter'), which a
-            // peer receives within IDLED seconds since the message has been
-            // relayed. Wait WAIT_ON_BOOTUP time to let the server establish
-            // connections to peers.
-            if (reduceRelayReady() && relayed &&
-                (stopwatch().now() - *relayed) < reduce_relay::IDLED)
-                overlay_.updateSlotAndSquelch(
-                    key, val->getSignerPublic(), id_, protocol::mtVALIDATION);
-            JLOG(p_journal_.trace()) << "Validation: duplicate";
+            onDuplicate(relayed, val);
             return;
         }
 
@@ -2277,27 +2302,14 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
         }
         else if (isTrusted || !app_.getFeeTrack().isLoadedLocal())
         {
-            std::string const name = [isTrusted, val]() {
-                std::string ret =
-                    isTrusted ? "Trusted validation" : "Untrusted validation";
-
-#ifdef DEBUG
-                ret += " " +
-                    std::to_string(val->getFieldU32(sfLedgerSequence)) + ": " +
-                    to_string(val->getNodeID());
-#endif
-
-                return ret;
-            }();
-
-            std::weak_ptr<PeerImp> weak = shared_from_this();
-            app_.getJobQueue().addJob(
-                isTrusted ? jtVALIDATION_t : jtVALIDATION_ut,
-                name,
-                [weak, val, m, key]() {
-                    if (auto peer = weak.lock())
-                        peer->checkValidation(val, key, m);
-                });
+            // The signature is verified, and the validation handled, by
+            // a batch job.
+            if (!overlay_.validationIngest(isTrusted).add(
+                    {shared_from_this(), val, m, key}))
+            {
+                JLOG(p_journal_.debug())
+                    << "Dropping validation: too many waiting to be checked";
+            }
         }
         else
         {
@@ -2656,6 +2668,12 @@ PeerImp::doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet)
 
     uint256 const hash{packet->ledgerhash()};
 
+    // A fetch pack recently built for another peer is sent as it is,
+    // without queueing a job to build it again.
+    if (app_.getLedgerMaster().sendCachedFetchPack(
+            shared_from_this(), *packet, hash))
+        return;
+
     std::weak_ptr<PeerImp> weak = shared_from_this();
     auto elapsed = UptimeClock::now();
     auto const pap = &app_;
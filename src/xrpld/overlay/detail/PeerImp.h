@@ -177,6 +177,7 @@ private:
     LedgerReplayMsgHandler ledgerReplayMsgHandler_;
 
     friend class OverlayImpl;
+    friend class ValidationIngest;
 
     class Metrics
     {
@@ -59,6 +59,15 @@ enum {
 
     /** The maximum number of levels to search */
     maxQueryDepth = 3,
+
+    /** How many queued validations a single job checks */
+    validationBatchSize = 64,
+
+    /** How many jobs may check queued validations concurrently */
+    maxValidationJobs = 4,
+
+    /** How many validations may wait to be checked, per trust level */
+    maxPendingValidations = 1024,
 };
 
 /** Size of buffer used to read from the socket. */
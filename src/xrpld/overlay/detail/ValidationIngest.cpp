@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/core/JobQueue.h>
+#include <xrpld/overlay/detail/PeerImp.h>
+#include <xrpld/overlay/detail/Tuning.h>
+#include <xrpld/overlay/detail/ValidationIngest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace ripple {
+
+ValidationIngest::ValidationIngest(
+    JobQueue& jobQueue,
+    JobType type,
+    std::string name,
+    beast::Journal journal)
+    : jobQueue_(jobQueue)
+    , type_(type)
+    , name_(std::move(name))
+    , journal_(journal)
+{
+}
+
+bool
+ValidationIngest::add(Item&& item)
+{
+    std::lock_guard lock(mutex_);
+    if (pending_.size() >= Tuning::maxPendingValidations)
+    {
+        JLOG(journal_.debug()) << name_ << ": queue full, dropping";
+        return false;
+    }
+
+    pending_.push_back(std::move(item));
+    schedule();
+
+    // Only empty if no job could be scheduled and the queue was dropped.
+    return !pending_.empty();
+}
+
+std::size_t
+ValidationIngest::size() const
+{
+    std::lock_guard lock(mutex_);
+    return pending_.size();
+}
+
+void
+ValidationIngest::schedule()
+{
+    // Add a job if none is pending, or if the backlog is larger than what
+    // the jobs already scheduled will take in their next batch.
+    if (pending_.empty() || jobs_ >= Tuning::maxValidationJobs ||
+        (jobs_ != 0 && pending_.size() <= jobs_ * Tuning::validationBatchSize))
+        return;
+
+    if (jobQueue_.addJob(type_, name_, [this]() { process(); }))
+    {
+        ++jobs_;
+    }
+    else if (jobs_ == 0)
+    {
+        // The job queue is stopping. No job is left to take what is
+        // waiting, so drop it rather than hold it forever.
+        JLOG(journal_.debug()) << name_ << ": unable to schedule job, dropping "
+                               << pending_.size();
+        pending_.clear();
+    }
+    else
+    {
+        // The jobs still running try again when they finish.
+        JLOG(journal_.debug()) << name_ << ": unable to schedule job";
+    }
+}
+
+void
+ValidationIngest::check(Item const& item)
+{
+    if (auto peer = item.peer.lock())
+        peer->checkValidation(item.val, item.key, item.packet);
+}
+
+void
+ValidationIngest::process()
+{
+    std::vector<Item> batch;
+    {
+        std::lock_guard lock(mutex_);
+        auto const n = std::min<std::size_t>(
+            pending_.size(), Tuning::validationBatchSize);
+        batch.reserve(n);
+        std::move(
+            pending_.begin(),
+            pending_.begin() + n,
+            std::back_inserter(batch));
+        pending_.erase(pending_.begin(), pending_.begin() + n);
+    }
+
+    JLOG(journal_.trace()) << name_ << ": checking " << batch.size();
+
+    for (auto const& item : batch)
+        check(item);
+
+    std::lock_guard lock(mutex_);
+    --jobs_;
+
+    // Keep each job to a single batch so that other work at the same
+    // priority is not starved, and requeue if anything is left.
+    schedule();
+}
+
+}  // namespace ripple
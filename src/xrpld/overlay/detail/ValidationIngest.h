@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_VALIDATIONINGEST_H_INCLUDED
+#define RIPPLE_OVERLAY_VALIDATIONINGEST_H_INCLUDED
+
+#include <xrpld/core/Job.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/beast/utility/Journal.h>
+#include <xrpl/protocol/STValidation.h>
+#include <xrpl/protocol/messages.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+class JobQueue;
+class PeerImp;
+
+/** Collects validations received from peers and checks them in batches.
+
+    Rather than scheduling one job per validation, incoming validations are
+    queued and drained by a small number of jobs of the configured type. The
+    time a validation spends waiting for a job is the collection window: during
+    bursts many validations accumulate and are handled by each job, amortizing
+    the job queue overhead. When the backlog grows beyond what the running jobs
+    pick up in one batch, additional jobs are scheduled (up to a limit) so that
+    signature verification proceeds in parallel on several worker threads.
+
+    At most Tuning::maxPendingValidations validations wait at a time; more
+    are refused. If no job can be scheduled, because the job queue is
+    stopping, whatever is waiting is dropped.
+
+    Callers are expected to have already checked that a validation is current
+    and suppressed duplicates through the HashRouter, so each unique
+    validation is only queued once.
+*/
+class ValidationIngest
+{
+public:
+    struct Item
+    {
+        std::weak_ptr<PeerImp> peer;
+        std::shared_ptr<STValidation> val;
+        std::shared_ptr<protocol::TMValidation> packet;
+        uint256 key;
+    };
+
+    ValidationIngest(
+        JobQueue& jobQueue,
+        JobType type,
+        std::string name,
+        beast::Journal journal);
+
+    virtual ~ValidationIngest() = default;
+
+    ValidationIngest(ValidationIngest const&) = delete;
+    ValidationIngest&
+    operator=(ValidationIngest const&) = delete;
+
+    /** Queue a validation for signature verification and processing.
+        @return `false` if the validation was dropped.
+    */
+    bool
+    add(Item&& item);
+
+    /** The number of validations waiting to be processed. */
+    std::size_t
+    size() const;
+
+protected:
+    /** Verify and handle a single queued validation. */
+    virtual void
+    check(Item const& item);
+
+private:
+    // Adds a job if more are needed. Must be called with mutex_ held.
+    void
+    schedule();
+
+    void
+    process();
+
+    JobQueue& jobQueue_;
+    JobType const type_;
+    std::string const name_;
+    beast::Journal const journal_;
+
+    std::mutex mutable mutex_;
+    std::deque<Item> pending_;
+    // Jobs scheduled or running
+    std::size_t jobs_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
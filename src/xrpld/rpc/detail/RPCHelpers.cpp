@@ -96,18 +96,24 @@ accountFromString(AccountID& result, std::string const& strIdent, bool bStrict)
 std::uint64_t
 getStartHint(std::shared_ptr<SLE const> const& sle, AccountID const& accountID)
 {
-    if (sle->getType() == ltRIPPLE_STATE)
+    return getStartHint(LazySLE{sle}, accountID);
+}
+
+std::uint64_t
+getStartHint(LazySLE const& sle, AccountID const& accountID)
+{
+    if (sle.getType() == ltRIPPLE_STATE)
     {
-        if (sle->getFieldAmount(sfLowLimit).getIssuer() == accountID)
-            return sle->getFieldU64(sfLowNode);
-        else if (sle->getFieldAmount(sfHighLimit).getIssuer() == accountID)
-            return sle->getFieldU64(sfHighNode);
+        if (sle.getFieldAmount(sfLowLimit).getIssuer() == accountID)
+            return sle.getFieldU64(sfLowNode);
+        else if (sle.getFieldAmount(sfHighLimit).getIssuer() == accountID)
+            return sle.getFieldU64(sfHighNode);
     }
 
-    if (!sle->isFieldPresent(sfOwnerNode))
+    if (!sle.isFieldPresent(sfOwnerNode))
         return 0;
 
-    return sle->getFieldU64(sfOwnerNode);
+    return sle.getFieldU64(sfOwnerNode);
 }
 
 bool
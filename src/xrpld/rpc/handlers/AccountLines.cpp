@@ -186,7 +186,7 @@ doAccountLines(RPC::JsonContext& context)
                 startHint,
                 limit + 1,
                 [&visitData, &count, &marker, &limit, &nextHint](
-                    std::shared_ptr<SLE const> const& sleCur) {
+                    std::optional<LazySLE> const& sleCur) {
                     if (!sleCur)
                     {
                         assert(false);
@@ -197,7 +197,7 @@ doAccountLines(RPC::JsonContext& context)
                     {
                         marker = sleCur->key();
                         nextHint =
-                            RPC::getStartHint(sleCur, visitData.accountID);
+                            RPC::getStartHint(*sleCur, visitData.accountID);
                     }
 
                     if (sleCur->getType() != ltRIPPLE_STATE)
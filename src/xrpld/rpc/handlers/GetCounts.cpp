@@ -21,6 +21,7 @@
 #include <xrpld/app/ledger/InboundLedgers.h>
 #include <xrpld/app/ledger/LedgerMaster.h>
 #include <xrpld/app/main/Application.h>
+#include <xrpld/app/misc/MemoryGovernor.h>
 #include <xrpld/app/misc/NetworkOPs.h>
 #include <xrpld/app/rdb/backend/SQLiteDatabase.h>
 #include <xrpld/ledger/CachedSLEs.h>
@@ -29,6 +30,7 @@
 #include <xrpl/basics/UptimeClock.h>
 #include <xrpl/json/json_value.h>
 #include <xrpl/protocol/ErrorCodes.h>
+#include <xrpl/protocol/PublicKey.h>
 #include <xrpl/protocol/RPCErr.h>
 #include <xrpl/protocol/jss.h>
 
@@ -71,6 +73,13 @@ getCountsJson(Application& app, int minObjectCount)
         ret[k] = v;
     }
 
+    {
+        Json::Value& bytes = (ret[jss::object_bytes] = Json::objectValue);
+        for (auto const& [k, v] :
+             CountedObjects::getInstance().getBytes(minObjectCount))
+            bytes[k] = std::to_string(v);
+    }
+
     if (app.config().useTxTables())
     {
         auto const db =
@@ -110,12 +119,25 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::AL_size] = Json::UInt(app.getAcceptedLedgerCache().size());
     ret[jss::AL_hit_rate] = app.getAcceptedLedgerCache().getHitRate();
 
+    {
+        auto const keys = getPublicKeyCacheCounts();
+        auto const total = static_cast<float>(keys.hits + keys.misses);
+        ret[jss::pubkey_hit_rate] =
+            keys.hits * (100.0f / std::max(1.0f, total));
+    }
+
     ret[jss::fullbelow_size] =
         static_cast<int>(app.getNodeFamily().getFullBelowCache()->size());
     ret[jss::treenode_cache_size] =
         app.getNodeFamily().getTreeNodeCache()->getCacheSize();
     ret[jss::treenode_track_size] =
         app.getNodeFamily().getTreeNodeCache()->getTrackSize();
+    ret[jss::treenode_cache_bytes] = std::to_string(
+        app.getNodeFamily().getTreeNodeCache()->getBytes());
+    ret[jss::SLE_cache_bytes] = std::to_string(app.cachedSLEs().getBytes());
+    ret[jss::AL_cache_bytes] =
+        std::to_string(app.getAcceptedLedgerCache().getBytes());
+    ret[jss::memory_governor] = app.getMemoryGovernor().getJson();
 
     std::string uptime;
     auto s = UptimeClock::now();
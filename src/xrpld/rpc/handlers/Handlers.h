@@ -137,6 +137,8 @@ doSignFor(RPC::JsonContext&);
 Json::Value
 doStop(RPC::JsonContext&);
 Json::Value
+doSnapshotCreate(RPC::JsonContext&);
+Json::Value
 doSubmit(RPC::JsonContext&);
 Json::Value
 doSubmitMultiSigned(RPC::JsonContext&);
@@ -22,14 +22,28 @@
 #include <xrpld/rpc/Context.h>
 #include <xrpld/rpc/detail/Handler.h>
 #include <xrpl/json/json_value.h>
+#include <xrpl/protocol/jss.h>
 
 namespace ripple {
 
 Json::Value
 doLedgerCleaner(RPC::JsonContext& context)
 {
-    context.app.getLedgerCleaner().clean(context.params);
-    return RPC::makeObjectValue("Cleaner configured");
+    auto& cleaner = context.app.getLedgerCleaner();
+
+    // Only report the progress when asked for the status
+    if (context.params.isMember(jss::status) &&
+        context.params[jss::status].asBool())
+    {
+        Json::Value ret(Json::objectValue);
+        ret[jss::ledger_cleaner] = cleaner.getJson();
+        return ret;
+    }
+
+    cleaner.clean(context.params);
+    auto ret = RPC::makeObjectValue("Cleaner configured");
+    ret[jss::ledger_cleaner] = cleaner.getJson();
+    return ret;
 }
 
 }  // namespace ripple
@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2024 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <xrpld/app/ledger/Ledger.h>
+#include <xrpld/app/ledger/LedgerSnapshot.h>
+#include <xrpld/rpc/Context.h>
+#include <xrpld/rpc/detail/RPCHelpers.h>
+#include <xrpl/protocol/ErrorCodes.h>
+#include <xrpl/protocol/jss.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace ripple {
+
+// {
+//   path : <file to write>
+//   ledger_hash : <ledger>
+//   ledger_index : <ledger_index>
+// }
+//
+// Write a snapshot of a closed ledger, by default the last validated one,
+// that a server can start from with --load-snapshot.
+Json::Value
+doSnapshotCreate(RPC::JsonContext& context)
+{
+    if (!context.params.isMember(jss::path))
+        return RPC::missing_field_error(jss::path);
+    if (!context.params[jss::path].isString() ||
+        context.params[jss::path].asString().empty())
+        return RPC::invalid_field_error(jss::path);
+
+    if (!context.params.isMember(jss::ledger_hash) &&
+        !context.params.isMember(jss::ledger_index))
+        context.params[jss::ledger_index] = "validated";
+
+    std::shared_ptr<ReadView const> view;
+    auto result = RPC::lookupLedger(view, context);
+    if (!view)
+        return result;
+
+    auto const ledger = std::dynamic_pointer_cast<Ledger const>(view);
+    if (!ledger || ledger->open())
+        return RPC::make_param_error("Ledger must be closed.");
+
+    // Write to a temporary file so a partial snapshot is never mistaken for
+    // a complete one.
+    boost::filesystem::path const path{context.params[jss::path].asString()};
+    auto const partial = boost::filesystem::path{path}.concat(".partial");
+    LedgerSnapshotStats stats;
+    try
+    {
+        {
+            std::ofstream out(
+                partial.string(),
+                std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!out)
+                return RPC::make_error(
+                    rpcINTERNAL, "Unable to open " + partial.string());
+            stats = writeLedgerSnapshot(*ledger, out);
+        }
+        boost::filesystem::rename(partial, path);
+    }
+    catch (std::exception const& e)
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(partial, ec);
+        return RPC::make_error(rpcINTERNAL, e.what());
+    }
+
+    result[jss::path] = path.string();
+    result[jss::size] = static_cast<Json::UInt>(stats.bytes);
+    return result;
+}
+
+}  // namespace ripple
@@ -81,13 +81,11 @@ doSubmit(RPC::JsonContext& context)
     if (!ret || !ret->size())
         return rpcError(rpcINVALID_PARAMS);
 
-    SerialIter sitTrans(makeSlice(*ret));
-
     std::shared_ptr<STTx const> stpTrans;
 
     try
     {
-        stpTrans = std::make_shared<STTx const>(std::ref(sitTrans));
+        stpTrans = std::make_shared<STTx const>(makeSlice(*ret));
     }
     catch (std::exception& e)
     {
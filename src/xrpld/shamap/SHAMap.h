@@ -104,7 +104,7 @@ private:
     /** The sequence of the ledger that this map references, if any. */
     std::uint32_t ledgerSeq_ = 0;
 
-    std::shared_ptr<SHAMapTreeNode> root_;
+    intr_ptr::SharedPtr<SHAMapTreeNode> root_;
     mutable SHAMapState state_;
     SHAMapType const type_;
     bool backed_ = true;         // Map is backed by the database
@@ -196,6 +196,55 @@ public:
     bool
     addItem(SHAMapNodeType type, boost::intrusive_ptr<SHAMapItem const> item);
 
+    /** Populate an empty map from items sorted by key.
+
+        Every node is created once, in its final shape, from the leaves up,
+        so each node is hashed exactly once instead of repeatedly rebuilding
+        and rehashing the path to the root as addItem does. Backed maps keep
+        the new nodes dirty, so flushDirty writes them as usual.
+
+        @param type the type of leaf node to create for each item
+        @param items the items, with strictly increasing keys
+        @param threads the number of threads that build and hash the
+                       subtrees below the root
+        @return false if the map is not empty or the keys are not strictly
+                increasing, in which case the map is not modified.
+     */
+    bool
+    addSortedItems(
+        SHAMapNodeType type,
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> const& items,
+        std::size_t threads = 1);
+
+    /** Populate an empty backed map from items read in key order, writing
+        it to the node store as it goes.
+
+        Unlike addSortedItems, this does not need every item at once.
+        `next` is called for each item in turn and returns nullptr after
+        the last one. The subtree below each branch of the root is built
+        as soon as the first item of the next branch arrives, then written
+        with `t` and released, so only the items below one branch are held
+        at a time. The map is left with a root whose children are fetched
+        from the node store when they are needed.
+
+        Anything thrown by `next` is passed on to the caller, and the nodes
+        written until then are left in the node store.
+
+        @param type the type of leaf node to create for each item
+        @param next returns the next item, with a key greater than the last
+        @param t the type of the node objects written
+        @param threads the number of threads that build and hash the
+                       subtrees below each branch of the root
+        @return false if the map is not empty or not backed, or if the keys
+                are not strictly increasing.
+     */
+    bool
+    writeSortedItems(
+        SHAMapNodeType type,
+        std::function<boost::intrusive_ptr<SHAMapItem const>()> const& next,
+        NodeObjectType t,
+        std::size_t threads = 1);
+
     SHAMapHash
     getHash() const;
 
@@ -323,6 +372,17 @@ public:
         Slice const& rawNode,
         SHAMapSyncFilter* filter);
 
+    /** Add a node that was decoded, and its hash computed, beforehand.
+
+        This lets callers decode the nodes they receive without holding
+        the locks that guard the map.
+    */
+    SHAMapAddNode
+    addKnownNode(
+        SHAMapNodeID const& nodeID,
+        intr_ptr::SharedPtr<SHAMapTreeNode> node,
+        SHAMapSyncFilter* filter);
+
     // status functions
     void
     setImmutable();
@@ -367,36 +427,47 @@ public:
 
 private:
     using SharedPtrNodeStack =
-        std::stack<std::pair<std::shared_ptr<SHAMapTreeNode>, SHAMapNodeID>>;
+        std::stack<std::pair<
+            intr_ptr::SharedPtr<SHAMapTreeNode>,
+            SHAMapNodeID>>;
     using DeltaRef = std::pair<
         boost::intrusive_ptr<SHAMapItem const>,
         boost::intrusive_ptr<SHAMapItem const>>;
 
     // tree node cache operations
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     cacheLookup(SHAMapHash const& hash) const;
     void
-    canonicalize(SHAMapHash const& hash, std::shared_ptr<SHAMapTreeNode>&)
+    canonicalize(SHAMapHash const& hash, intr_ptr::SharedPtr<SHAMapTreeNode>&)
         const;
 
     // database operations
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     fetchNodeFromDB(SHAMapHash const& hash) const;
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     fetchNodeNT(SHAMapHash const& hash) const;
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     fetchNodeNT(SHAMapHash const& hash, SHAMapSyncFilter* filter) const;
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     fetchNode(SHAMapHash const& hash) const;
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     checkFilter(SHAMapHash const& hash, SHAMapSyncFilter* filter) const;
 
+    // Hook a node into the map, calling makeNode only when the place it
+    // belongs to is found to be missing
+    template <class MakeNode>
+    SHAMapAddNode
+    addKnownNodeImpl(
+        SHAMapNodeID const& nodeID,
+        MakeNode&& makeNode,
+        SHAMapSyncFilter* filter);
+
     /** Update hashes up to the root */
     void
     dirtyUp(
         SharedPtrNodeStack& stack,
         uint256 const& target,
-        std::shared_ptr<SHAMapTreeNode> terminal);
+        intr_ptr::SharedPtr<SHAMapTreeNode> terminal);
 
     /** Walk towards the specified id, returning the node.  Caller must check
         if the return is nullptr, and if not, if the node->peekItem()->key() ==
@@ -410,36 +481,40 @@ private:
 
     /** Unshare the node, allowing it to be modified */
     template <class Node>
-    std::shared_ptr<Node>
-    unshareNode(std::shared_ptr<Node>, SHAMapNodeID const& nodeID);
+    intr_ptr::SharedPtr<Node>
+    unshareNode(intr_ptr::SharedPtr<Node>, SHAMapNodeID const& nodeID);
 
     /** prepare a node to be modified before flushing */
     template <class Node>
-    std::shared_ptr<Node>
-    preFlushNode(std::shared_ptr<Node> node) const;
+    intr_ptr::SharedPtr<Node>
+    preFlushNode(intr_ptr::SharedPtr<Node> node) const;
 
     /** write and canonicalize modified node */
-    std::shared_ptr<SHAMapTreeNode>
-    writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const;
+    intr_ptr::SharedPtr<SHAMapTreeNode>
+    writeNode(NodeObjectType t, intr_ptr::SharedPtr<SHAMapTreeNode> node) const;
+
+    /** write a subtree built by buildSubTree, without caching its nodes */
+    void
+    writeSubTree(NodeObjectType t, SHAMapTreeNode& node) const;
 
     // returns the first item at or below this node
     SHAMapLeafNode*
     firstBelow(
-        std::shared_ptr<SHAMapTreeNode>,
+        intr_ptr::SharedPtr<SHAMapTreeNode>,
         SharedPtrNodeStack& stack,
         int branch = 0) const;
 
     // returns the last item at or below this node
     SHAMapLeafNode*
     lastBelow(
-        std::shared_ptr<SHAMapTreeNode> node,
+        intr_ptr::SharedPtr<SHAMapTreeNode> node,
         SharedPtrNodeStack& stack,
         int branch = branchFactor) const;
 
     // helper function for firstBelow and lastBelow
     SHAMapLeafNode*
     belowHelper(
-        std::shared_ptr<SHAMapTreeNode> node,
+        intr_ptr::SharedPtr<SHAMapTreeNode> node,
         SharedPtrNodeStack& stack,
         int branch,
         std::tuple<
@@ -453,15 +528,15 @@ private:
     descend(SHAMapInnerNode*, int branch) const;
     SHAMapTreeNode*
     descendThrow(SHAMapInnerNode*, int branch) const;
-    std::shared_ptr<SHAMapTreeNode>
-    descend(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
-    std::shared_ptr<SHAMapTreeNode>
-    descendThrow(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
+    intr_ptr::SharedPtr<SHAMapTreeNode>
+    descend(intr_ptr::SharedPtr<SHAMapInnerNode> const&, int branch) const;
+    intr_ptr::SharedPtr<SHAMapTreeNode>
+    descendThrow(intr_ptr::SharedPtr<SHAMapInnerNode> const&, int branch) const;
 
     // Descend with filter
     // If pending, callback is called as if it called fetchNodeNT
-    using descendCallback =
-        std::function<void(std::shared_ptr<SHAMapTreeNode>, SHAMapHash const&)>;
+    using descendCallback = std::function<
+        void(intr_ptr::SharedPtr<SHAMapTreeNode>, SHAMapHash const&)>;
     SHAMapTreeNode*
     descendAsync(
         SHAMapInnerNode* parent,
@@ -479,8 +554,9 @@ private:
 
     // Non-storing
     // Does not hook the returned node to its parent
-    std::shared_ptr<SHAMapTreeNode>
-    descendNoStore(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
+    intr_ptr::SharedPtr<SHAMapTreeNode>
+    descendNoStore(intr_ptr::SharedPtr<SHAMapInnerNode> const&, int branch)
+        const;
 
     /** If there is only one leaf below this node, get its contents */
     boost::intrusive_ptr<SHAMapItem const> const&
@@ -505,6 +581,21 @@ private:
     int
     walkSubTree(bool doWrite, NodeObjectType t);
 
+    /** Build the subtree holding the sorted items in [first, last)
+
+        If threads is more than one, the children of this node are built
+        concurrently. An exception thrown while building any of them is
+        rethrown once all of them are done.
+     */
+    using SortedItems = std::vector<boost::intrusive_ptr<SHAMapItem const>>;
+    intr_ptr::SharedPtr<SHAMapTreeNode>
+    buildSubTree(
+        SHAMapNodeType type,
+        SortedItems::const_iterator first,
+        SortedItems::const_iterator last,
+        SHAMapNodeID const& nodeID,
+        std::size_t threads = 1);
+
     // Structure to track information about call to
     // getMissingNodes while it's in progress
     struct MissingNodes
@@ -544,7 +635,7 @@ private:
             SHAMapInnerNode*,                  // parent node
             SHAMapNodeID,                      // parent node ID
             int,                               // branch
-            std::shared_ptr<SHAMapTreeNode>>;  // node
+            intr_ptr::SharedPtr<SHAMapTreeNode>>;  // node
 
         int deferred_;
         std::mutex deferLock_;
@@ -578,7 +669,7 @@ private:
     gmn_ProcessDeferredReads(MissingNodes&);
 
     // fetch from DB helper function
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     finishFetch(
         SHAMapHash const& hash,
         std::shared_ptr<NodeObject> const& object) const;
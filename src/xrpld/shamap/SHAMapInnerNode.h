@@ -49,7 +49,7 @@ public:
 private:
     /** Opaque type that contains the `hashes` array (array of type
        `SHAMapHash`) and the `children` array (array of type
-       `std::shared_ptr<SHAMapInnerNode>`).
+       `intr_ptr::SharedPtr<SHAMapInnerNode>`).
      */
     TaggedPointer hashesAndChildren_;
 
@@ -72,6 +72,10 @@ private:
     void
     resizeChildArrays(std::uint8_t toAllocate);
 
+    /** The bytes allocated for the `hashes` and `children` arrays. */
+    std::size_t
+    arrayBytes() const;
+
     /** Get the child's index inside the `hashes` or `children` array (stored in
         `hashesAndChildren_`.
 
@@ -114,7 +118,10 @@ public:
     operator=(SHAMapInnerNode const&) = delete;
     ~SHAMapInnerNode();
 
-    std::shared_ptr<SHAMapTreeNode>
+    void
+    partialDestructor() override;
+
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     clone(std::uint32_t cowid) const override;
 
     SHAMapNodeType
@@ -135,6 +142,9 @@ public:
         return true;
     }
 
+    std::size_t
+    memoryFootprint() const override;
+
     bool
     isEmpty() const;
 
@@ -148,19 +158,19 @@ public:
     getChildHash(int m) const;
 
     void
-    setChild(int m, std::shared_ptr<SHAMapTreeNode> child);
+    setChild(int m, intr_ptr::SharedPtr<SHAMapTreeNode> child);
 
     void
-    shareChild(int m, std::shared_ptr<SHAMapTreeNode> const& child);
+    shareChild(int m, intr_ptr::SharedPtr<SHAMapTreeNode> const& child);
 
     SHAMapTreeNode*
     getChildPointer(int branch);
 
-    std::shared_ptr<SHAMapTreeNode>
+    intr_ptr::SharedPtr<SHAMapTreeNode>
     getChild(int branch);
 
-    std::shared_ptr<SHAMapTreeNode>
-    canonicalizeChild(int branch, std::shared_ptr<SHAMapTreeNode> node);
+    intr_ptr::SharedPtr<SHAMapTreeNode>
+    canonicalizeChild(int branch, intr_ptr::SharedPtr<SHAMapTreeNode> node);
 
     // sync functions
     bool
@@ -188,10 +198,10 @@ public:
     void
     invariants(bool is_root = false) const override;
 
-    static std::shared_ptr<SHAMapTreeNode>
+    static intr_ptr::SharedPtr<SHAMapTreeNode>
     makeFullInner(Slice data, SHAMapHash const& hash, bool hashValid);
 
-    static std::shared_ptr<SHAMapTreeNode>
+    static intr_ptr::SharedPtr<SHAMapTreeNode>
     makeCompressedInner(Slice data);
 };
 
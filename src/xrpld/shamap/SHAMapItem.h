@@ -68,9 +68,15 @@ private:
             reinterpret_cast<std::uint8_t*>(this) + sizeof(*this),
             data.data(),
             data.size());
+        countBytes(size_);
     }
 
 public:
+    ~SHAMapItem()
+    {
+        countBytes(-static_cast<std::ptrdiff_t>(size_));
+    }
+
     SHAMapItem() = delete;
 
     SHAMapItem(SHAMapItem const& other) = delete;
@@ -106,6 +112,13 @@ public:
     {
         return {data(), size()};
     }
+
+    /** The bytes taken by the item, including the data that follows it. */
+    std::size_t
+    memoryFootprint() const
+    {
+        return sizeof(*this) + size_;
+    }
 };
 
 namespace detail {
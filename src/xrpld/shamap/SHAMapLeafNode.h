@@ -63,6 +63,9 @@ public:
     void
     invariants(bool is_root = false) const final override;
 
+    void
+    partialDestructor() final override;
+
 public:
     boost::intrusive_ptr<SHAMapItem const> const&
     peekItem() const;
@@ -78,6 +81,10 @@ public:
 
     std::string
     getString(SHAMapNodeID const&) const final override;
+
+    /** Counts the item too, though other leaves may share it. */
+    std::size_t
+    memoryFootprint() const final override;
 };
 
 }  // namespace ripple
@@ -23,6 +23,8 @@
 #include <xrpld/shamap/SHAMapItem.h>
 #include <xrpld/shamap/SHAMapNodeID.h>
 #include <xrpl/basics/CountedObject.h>
+#include <xrpl/basics/IntrusivePointer.h>
+#include <xrpl/basics/IntrusiveRefCounts.h>
 #include <xrpl/basics/SHAMapHash.h>
 #include <xrpl/basics/TaggedCache.h>
 #include <xrpl/beast/utility/Journal.h>
@@ -50,7 +52,7 @@ enum class SHAMapNodeType {
     tnACCOUNT_STATE = 4
 };
 
-class SHAMapTreeNode
+class SHAMapTreeNode : public IntrusiveRefCounts
 {
 protected:
     SHAMapHash hash_;
@@ -89,6 +91,18 @@ protected:
 public:
     virtual ~SHAMapTreeNode() noexcept = default;
 
+    /** Release the resources held by this node.
+
+        Called when the last strong reference goes away while weak references
+        (for example from the TreeNodeCache) keep the memory alive. Children
+        and items are released here so they do not linger until the last
+        weak reference is dropped.
+     */
+    virtual void
+    partialDestructor()
+    {
+    }
+
     /** \defgroup SHAMap Copy-on-Write Support
 
         By nature, a node may appear in multiple SHAMap instances. Rather than
@@ -130,7 +144,7 @@ public:
     }
 
     /** Make a copy of this node, setting the owner. */
-    virtual std::shared_ptr<SHAMapTreeNode>
+    virtual intr_ptr::SharedPtr<SHAMapTreeNode>
     clone(std::uint32_t cowid) const = 0;
     /** @} */
 
@@ -168,23 +182,27 @@ public:
     virtual std::string
     getString(SHAMapNodeID const&) const;
 
+    /** The approximate bytes taken by this node and the memory it owns. */
+    virtual std::size_t
+    memoryFootprint() const = 0;
+
     virtual void
     invariants(bool is_root = false) const = 0;
 
-    static std::shared_ptr<SHAMapTreeNode>
+    static intr_ptr::SharedPtr<SHAMapTreeNode>
     makeFromPrefix(Slice rawNode, SHAMapHash const& hash);
 
-    static std::shared_ptr<SHAMapTreeNode>
+    static intr_ptr::SharedPtr<SHAMapTreeNode>
     makeFromWire(Slice rawNode);
 
 private:
-    static std::shared_ptr<SHAMapTreeNode>
+    static intr_ptr::SharedPtr<SHAMapTreeNode>
     makeTransaction(Slice data, SHAMapHash const& hash, bool hashValid);
 
-    static std::shared_ptr<SHAMapTreeNode>
+    static intr_ptr::SharedPtr<SHAMapTreeNode>
     makeAccountState(Slice data, SHAMapHash const& hash, bool hashValid);
 
-    static std::shared_ptr<SHAMapTreeNode>
+    static intr_ptr::SharedPtr<SHAMapTreeNode>
     makeTransactionWithMeta(Slice data, SHAMapHash const& hash, bool hashValid);
 };
 
@@ -24,7 +24,15 @@
 
 namespace ripple {
 
-using TreeNodeCache = TaggedCache<uint256, SHAMapTreeNode>;
+using TreeNodeCache = TaggedCache<
+    uint256,
+    SHAMapTreeNode,
+    /*IsKeyCache*/ false,
+    hardened_hash<>,
+    std::equal_to<uint256>,
+    std::recursive_mutex,
+    intr_ptr::SharedPtr<SHAMapTreeNode>,
+    intr_ptr::WeakPtr<SHAMapTreeNode>>;
 
 }  // namespace ripple
 
@@ -24,24 +24,30 @@
 #include <xrpld/shamap/SHAMapTxLeafNode.h>
 #include <xrpld/shamap/SHAMapTxPlusMetaLeafNode.h>
 #include <xrpl/basics/contract.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace ripple {
 
-[[nodiscard]] std::shared_ptr<SHAMapLeafNode>
+[[nodiscard]] intr_ptr::SharedPtr<SHAMapLeafNode>
 makeTypedLeaf(
     SHAMapNodeType type,
     boost::intrusive_ptr<SHAMapItem const> item,
     std::uint32_t owner)
 {
     if (type == SHAMapNodeType::tnTRANSACTION_NM)
-        return std::make_shared<SHAMapTxLeafNode>(std::move(item), owner);
+        return intr_ptr::make_shared<SHAMapTxLeafNode>(std::move(item), owner);
 
     if (type == SHAMapNodeType::tnTRANSACTION_MD)
-        return std::make_shared<SHAMapTxPlusMetaLeafNode>(
+        return intr_ptr::make_shared<SHAMapTxPlusMetaLeafNode>(
             std::move(item), owner);
 
     if (type == SHAMapNodeType::tnACCOUNT_STATE)
-        return std::make_shared<SHAMapAccountStateLeafNode>(
+        return intr_ptr::make_shared<SHAMapAccountStateLeafNode>(
             std::move(item), owner);
 
     LogicError(
@@ -53,7 +59,7 @@ makeTypedLeaf(
 SHAMap::SHAMap(SHAMapType t, Family& f)
     : f_(f), journal_(f.journal()), state_(SHAMapState::Modifying), type_(t)
 {
-    root_ = std::make_shared<SHAMapInnerNode>(cowid_);
+    root_ = intr_ptr::make_shared<SHAMapInnerNode>(cowid_);
 }
 
 // The `hash` parameter is unused. It is part of the interface so it's clear
@@ -63,7 +69,7 @@ SHAMap::SHAMap(SHAMapType t, Family& f)
 SHAMap::SHAMap(SHAMapType t, uint256 const& hash, Family& f)
     : f_(f), journal_(f.journal()), state_(SHAMapState::Synching), type_(t)
 {
-    root_ = std::make_shared<SHAMapInnerNode>(cowid_);
+    root_ = intr_ptr::make_shared<SHAMapInnerNode>(cowid_);
 }
 
 SHAMap::SHAMap(SHAMap const& other, bool isMutable)
@@ -94,7 +100,7 @@ void
 SHAMap::dirtyUp(
     SharedPtrNodeStack& stack,
     uint256 const& target,
-    std::shared_ptr<SHAMapTreeNode> child)
+    intr_ptr::SharedPtr<SHAMapTreeNode> child)
 {
     // walk the tree up from through the inner nodes to the root_
     // update hashes and links
@@ -109,7 +115,7 @@ SHAMap::dirtyUp(
     while (!stack.empty())
     {
         auto node =
-            std::dynamic_pointer_cast<SHAMapInnerNode>(stack.top().first);
+            intr_ptr::dynamic_pointer_cast<SHAMapInnerNode>(stack.top().first);
         SHAMapNodeID nodeID = stack.top().second;
         stack.pop();
         assert(node != nullptr);
@@ -136,7 +142,8 @@ SHAMap::walkTowardsKey(uint256 const& id, SharedPtrNodeStack* stack) const
         if (stack != nullptr)
             stack->push({inNode, nodeID});
 
-        auto const inner = std::static_pointer_cast<SHAMapInnerNode>(inNode);
+        auto const inner =
+            intr_ptr::static_pointer_cast<SHAMapInnerNode>(inNode);
         auto const branch = selectBranch(nodeID, id);
         if (inner->isEmptyBranch(branch))
             return nullptr;
@@ -159,7 +166,7 @@ SHAMap::findKey(uint256 const& id) const
     return leaf;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::fetchNodeFromDB(SHAMapHash const& hash) const
 {
     assert(backed_);
@@ -167,7 +174,7 @@ SHAMap::fetchNodeFromDB(SHAMapHash const& hash) const
     return finishFetch(hash, obj);
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::finishFetch(
     SHAMapHash const& hash,
     std::shared_ptr<NodeObject> const& object) const
@@ -206,7 +213,7 @@ SHAMap::finishFetch(
 }
 
 // See if a sync filter has a node
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::checkFilter(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
 {
     if (auto nodeData = filter->getNode(hash))
@@ -239,7 +246,7 @@ SHAMap::checkFilter(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
 
 // Get a node without throwing
 // Used on maps where missing nodes are expected
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::fetchNodeNT(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
 {
     auto node = cacheLookup(hash);
@@ -262,7 +269,7 @@ SHAMap::fetchNodeNT(SHAMapHash const& hash, SHAMapSyncFilter* filter) const
     return node;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::fetchNodeNT(SHAMapHash const& hash) const
 {
     auto node = cacheLookup(hash);
@@ -274,7 +281,7 @@ SHAMap::fetchNodeNT(SHAMapHash const& hash) const
 }
 
 // Throw if the node is missing
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::fetchNode(SHAMapHash const& hash) const
 {
     auto node = fetchNodeNT(hash);
@@ -296,11 +303,12 @@ SHAMap::descendThrow(SHAMapInnerNode* parent, int branch) const
     return ret;
 }
 
-std::shared_ptr<SHAMapTreeNode>
-SHAMap::descendThrow(std::shared_ptr<SHAMapInnerNode> const& parent, int branch)
-    const
+intr_ptr::SharedPtr<SHAMapTreeNode>
+SHAMap::descendThrow(
+    intr_ptr::SharedPtr<SHAMapInnerNode> const& parent,
+    int branch) const
 {
-    std::shared_ptr<SHAMapTreeNode> ret = descend(parent, branch);
+    intr_ptr::SharedPtr<SHAMapTreeNode> ret = descend(parent, branch);
 
     if (!ret && !parent->isEmptyBranch(branch))
         Throw<SHAMapMissingNode>(type_, parent->getChildHash(branch));
@@ -315,7 +323,7 @@ SHAMap::descend(SHAMapInnerNode* parent, int branch) const
     if (ret || !backed_)
         return ret;
 
-    std::shared_ptr<SHAMapTreeNode> node =
+    intr_ptr::SharedPtr<SHAMapTreeNode> node =
         fetchNodeNT(parent->getChildHash(branch));
     if (!node)
         return nullptr;
@@ -324,11 +332,11 @@ SHAMap::descend(SHAMapInnerNode* parent, int branch) const
     return node.get();
 }
 
-std::shared_ptr<SHAMapTreeNode>
-SHAMap::descend(std::shared_ptr<SHAMapInnerNode> const& parent, int branch)
+intr_ptr::SharedPtr<SHAMapTreeNode>
+SHAMap::descend(intr_ptr::SharedPtr<SHAMapInnerNode> const& parent, int branch)
     const
 {
-    std::shared_ptr<SHAMapTreeNode> node = parent->getChild(branch);
+    intr_ptr::SharedPtr<SHAMapTreeNode> node = parent->getChild(branch);
     if (node || !backed_)
         return node;
 
@@ -342,12 +350,12 @@ SHAMap::descend(std::shared_ptr<SHAMapInnerNode> const& parent, int branch)
 
 // Gets the node that would be hooked to this branch,
 // but doesn't hook it up.
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::descendNoStore(
-    std::shared_ptr<SHAMapInnerNode> const& parent,
+    intr_ptr::SharedPtr<SHAMapInnerNode> const& parent,
     int branch) const
 {
-    std::shared_ptr<SHAMapTreeNode> ret = parent->getChild(branch);
+    intr_ptr::SharedPtr<SHAMapTreeNode> ret = parent->getChild(branch);
     if (!ret && backed_)
         ret = fetchNode(parent->getChildHash(branch));
     return ret;
@@ -369,7 +377,7 @@ SHAMap::descend(
     if (!child)
     {
         auto const& childHash = parent->getChildHash(branch);
-        std::shared_ptr<SHAMapTreeNode> childNode =
+        intr_ptr::SharedPtr<SHAMapTreeNode> childNode =
             fetchNodeNT(childHash, filter);
 
         if (childNode)
@@ -426,8 +434,8 @@ SHAMap::descendAsync(
 }
 
 template <class Node>
-std::shared_ptr<Node>
-SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
+intr_ptr::SharedPtr<Node>
+SHAMap::unshareNode(intr_ptr::SharedPtr<Node> node, SHAMapNodeID const& nodeID)
 {
     // make sure the node is suitable for the intended operation (copy on write)
     assert(node->cowid() <= cowid_);
@@ -435,7 +443,7 @@ SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
     {
         // have a CoW
         assert(state_ != SHAMapState::Immutable);
-        node = std::static_pointer_cast<Node>(node->clone(cowid_));
+        node = intr_ptr::static_pointer_cast<Node>(node->clone(cowid_));
         if (nodeID.isRoot())
             root_ = node;
     }
@@ -444,7 +452,7 @@ SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
 
 SHAMapLeafNode*
 SHAMap::belowHelper(
-    std::shared_ptr<SHAMapTreeNode> node,
+    intr_ptr::SharedPtr<SHAMapTreeNode> node,
     SharedPtrNodeStack& stack,
     int branch,
     std::tuple<int, std::function<bool(int)>, std::function<void(int&)>> const&
@@ -453,11 +461,11 @@ SHAMap::belowHelper(
     auto& [init, cmp, incr] = loopParams;
     if (node->isLeaf())
     {
-        auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
+        auto n = intr_ptr::static_pointer_cast<SHAMapLeafNode>(node);
         stack.push({node, {leafDepth, n->peekItem()->key()}});
         return n.get();
     }
-    auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+    auto inner = intr_ptr::static_pointer_cast<SHAMapInnerNode>(node);
     if (stack.empty())
         stack.push({inner, SHAMapNodeID{}});
     else
@@ -470,11 +478,11 @@ SHAMap::belowHelper(
             assert(!stack.empty());
             if (node->isLeaf())
             {
-                auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
+                auto n = intr_ptr::static_pointer_cast<SHAMapLeafNode>(node);
                 stack.push({n, {leafDepth, n->peekItem()->key()}});
                 return n.get();
             }
-            inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+            inner = intr_ptr::static_pointer_cast<SHAMapInnerNode>(node);
             stack.push({inner, stack.top().second.getChildNodeID(branch)});
             i = init;  // descend and reset loop
         }
@@ -485,7 +493,7 @@ SHAMap::belowHelper(
 }
 SHAMapLeafNode*
 SHAMap::lastBelow(
-    std::shared_ptr<SHAMapTreeNode> node,
+    intr_ptr::SharedPtr<SHAMapTreeNode> node,
     SharedPtrNodeStack& stack,
     int branch) const
 {
@@ -497,7 +505,7 @@ SHAMap::lastBelow(
 }
 SHAMapLeafNode*
 SHAMap::firstBelow(
-    std::shared_ptr<SHAMapTreeNode> node,
+    intr_ptr::SharedPtr<SHAMapTreeNode> node,
     SharedPtrNodeStack& stack,
     int branch) const
 {
@@ -569,7 +577,7 @@ SHAMap::peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const
     {
         auto [node, nodeID] = stack.top();
         assert(!node->isLeaf());
-        auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+        auto inner = intr_ptr::static_pointer_cast<SHAMapInnerNode>(node);
         for (auto i = selectBranch(nodeID, id) + 1; i < branchFactor; ++i)
         {
             if (!inner->isEmptyBranch(i))
@@ -628,7 +636,7 @@ SHAMap::upper_bound(uint256 const& id) const
         }
         else
         {
-            auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+            auto inner = intr_ptr::static_pointer_cast<SHAMapInnerNode>(node);
             for (auto branch = selectBranch(nodeID, id) + 1;
                  branch < branchFactor;
                  ++branch)
@@ -665,7 +673,7 @@ SHAMap::lower_bound(uint256 const& id) const
         }
         else
         {
-            auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+            auto inner = intr_ptr::static_pointer_cast<SHAMapInnerNode>(node);
             for (int branch = selectBranch(nodeID, id) - 1; branch >= 0;
                  --branch)
             {
@@ -704,7 +712,8 @@ SHAMap::delItem(uint256 const& id)
     if (stack.empty())
         Throw<SHAMapMissingNode>(type_, id);
 
-    auto leaf = std::dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
+    auto leaf =
+        intr_ptr::dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
     stack.pop();
 
     if (!leaf || (leaf->peekItem()->key() != id))
@@ -714,12 +723,12 @@ SHAMap::delItem(uint256 const& id)
 
     // What gets attached to the end of the chain
     // (For now, nothing, since we deleted the leaf)
-    std::shared_ptr<SHAMapTreeNode> prevNode;
+    intr_ptr::SharedPtr<SHAMapTreeNode> prevNode;
 
     while (!stack.empty())
     {
         auto node =
-            std::static_pointer_cast<SHAMapInnerNode>(stack.top().first);
+            intr_ptr::static_pointer_cast<SHAMapInnerNode>(stack.top().first);
         SHAMapNodeID nodeID = stack.top().second;
         stack.pop();
 
@@ -792,7 +801,7 @@ SHAMap::addGiveItem(
 
     if (node->isLeaf())
     {
-        auto leaf = std::static_pointer_cast<SHAMapLeafNode>(node);
+        auto leaf = intr_ptr::static_pointer_cast<SHAMapLeafNode>(node);
         if (leaf->peekItem()->key() == tag)
             return false;
     }
@@ -800,7 +809,7 @@ SHAMap::addGiveItem(
     if (node->isInner())
     {
         // easy case, we end on an inner node
-        auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
+        auto inner = intr_ptr::static_pointer_cast<SHAMapInnerNode>(node);
         int branch = selectBranch(nodeID, tag);
         assert(inner->isEmptyBranch(branch));
         inner->setChild(branch, makeTypedLeaf(type, std::move(item), cowid_));
@@ -809,11 +818,11 @@ SHAMap::addGiveItem(
     {
         // this is a leaf node that has to be made an inner node holding two
         // items
-        auto leaf = std::static_pointer_cast<SHAMapLeafNode>(node);
+        auto leaf = intr_ptr::static_pointer_cast<SHAMapLeafNode>(node);
         auto otherItem = leaf->peekItem();
         assert(otherItem && (tag != otherItem->key()));
 
-        node = std::make_shared<SHAMapInnerNode>(node->cowid());
+        node = intr_ptr::make_shared<SHAMapInnerNode>(node->cowid());
 
         unsigned int b1, b2;
 
@@ -825,7 +834,7 @@ SHAMap::addGiveItem(
             // we need a new inner node, since both go on same branch at this
             // level
             nodeID = nodeID.getChildNodeID(b1);
-            node = std::make_shared<SHAMapInnerNode>(cowid_);
+            node = intr_ptr::make_shared<SHAMapInnerNode>(cowid_);
         }
 
         // we can add the two leaf nodes here
@@ -848,6 +857,231 @@ SHAMap::addItem(
     return addGiveItem(type, std::move(item));
 }
 
+bool
+SHAMap::addSortedItems(
+    SHAMapNodeType type,
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> const& items,
+    std::size_t threads)
+{
+    assert(state_ != SHAMapState::Immutable);
+    assert(type != SHAMapNodeType::tnINNER);
+
+    if (!root_->isInner() ||
+        !intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_)->isEmpty())
+        return false;
+
+    auto const unsorted = std::adjacent_find(
+        items.begin(), items.end(), [](auto const& a, auto const& b) {
+            return a->key() >= b->key();
+        });
+    if (unsorted != items.end())
+        return false;
+
+    if (items.empty())
+        return true;
+
+    // Spawning threads for small maps costs more than it saves
+    if (items.size() < 4096)
+        threads = 1;
+
+    auto node = buildSubTree(
+        type, items.begin(), items.end(), SHAMapNodeID{}, threads);
+
+    // The root is always an inner node, even if it only holds one item
+    if (node->isLeaf())
+    {
+        auto root = intr_ptr::make_shared<SHAMapInnerNode>(cowid_);
+        root->setChild(
+            selectBranch(SHAMapNodeID{}, items.front()->key()),
+            std::move(node));
+        root->updateHashDeep();
+        if (!backed_)
+            root->unshare();
+        node = std::move(root);
+    }
+
+    root_ = std::move(node);
+    return true;
+}
+
+bool
+SHAMap::writeSortedItems(
+    SHAMapNodeType type,
+    std::function<boost::intrusive_ptr<SHAMapItem const>()> const& next,
+    NodeObjectType t,
+    std::size_t threads)
+{
+    assert(state_ != SHAMapState::Immutable);
+    assert(type != SHAMapNodeType::tnINNER);
+
+    if (!backed_ || !root_->isInner() ||
+        !intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_)->isEmpty())
+        return false;
+
+    // The hashes of the children of the root, as a full inner node holds
+    // them, once each subtree has been written.
+    std::array<uint256, branchFactor> hashes{};
+    SortedItems items;
+    std::optional<uint256> last;
+    int branch = -1;
+
+    auto flush = [&]() {
+        if (items.empty())
+            return;
+
+        auto const node = buildSubTree(
+            type,
+            items.begin(),
+            items.end(),
+            SHAMapNodeID{}.getChildNodeID(branch),
+            items.size() < 4096 ? 1 : threads);
+        writeSubTree(t, *node);
+        hashes[branch] = node->getHash().as_uint256();
+        items.clear();
+    };
+
+    while (auto item = next())
+    {
+        if (last && !(*last < item->key()))
+            return false;
+        last = item->key();
+
+        // Since the keys increase, so do the branches
+        int const b = selectBranch(SHAMapNodeID{}, item->key());
+        if (b != branch)
+        {
+            flush();
+            branch = b;
+        }
+        items.push_back(std::move(item));
+    }
+    flush();
+
+    if (!last)
+        return true;
+
+    Serializer s(branchFactor * uint256::bytes);
+    for (auto const& hash : hashes)
+        s.addBitString(hash);
+    root_ = writeNode(
+        t, SHAMapInnerNode::makeFullInner(s.slice(), SHAMapHash{}, false));
+    return true;
+}
+
+void
+SHAMap::writeSubTree(NodeObjectType t, SHAMapTreeNode& node) const
+{
+    if (node.isInner())
+    {
+        auto& inner = static_cast<SHAMapInnerNode&>(node);
+        for (int i = 0; i < branchFactor; ++i)
+        {
+            if (!inner.isEmptyBranch(i))
+                writeSubTree(t, *inner.getChildPointer(i));
+        }
+    }
+
+    node.unshare();
+
+    // These nodes are released as soon as they are written, so they are
+    // not put in the tree node cache.
+    Serializer s;
+    node.serializeWithPrefix(s);
+    f_.db().store(
+        t, std::move(s.modData()), node.getHash().as_uint256(), ledgerSeq_);
+}
+
+intr_ptr::SharedPtr<SHAMapTreeNode>
+SHAMap::buildSubTree(
+    SHAMapNodeType type,
+    SortedItems::const_iterator first,
+    SortedItems::const_iterator last,
+    SHAMapNodeID const& nodeID,
+    std::size_t threads)
+{
+    assert(first != last);
+
+    // Nodes of unbacked maps are never written, so they can be shared
+    // right away; otherwise they stay dirty until flushDirty.
+    auto finish = [this](auto node) {
+        if (!backed_)
+            node->unshare();
+        return node;
+    };
+
+    if (std::next(first) == last)
+        return finish(makeTypedLeaf(type, *first, cowid_));
+
+    // Since the items are sorted, the items below each branch are adjacent.
+    std::array<int, branchFactor> branches;
+    std::array<SortedItems::const_iterator, branchFactor + 1> bounds;
+    int count = 0;
+
+    bounds[0] = first;
+    while (bounds[count] != last)
+    {
+        int const branch = selectBranch(nodeID, (*bounds[count])->key());
+        branches[count] = branch;
+        bounds[count + 1] =
+            std::find_if(bounds[count], last, [&](auto const& item) {
+                return selectBranch(nodeID, item->key()) != branch;
+            });
+        ++count;
+    }
+
+    std::array<intr_ptr::SharedPtr<SHAMapTreeNode>, branchFactor> children;
+    auto build = [&](int i) {
+        children[i] = buildSubTree(
+            type, bounds[i], bounds[i + 1], nodeID.getChildNodeID(branches[i]));
+    };
+
+    if (threads > 1 && count > 1)
+    {
+        // The subtrees are disjoint, so each can be built and hashed on its
+        // own thread. The calling thread takes a share of the work too.
+        std::atomic<int> next{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        auto worker = [&]() {
+            try
+            {
+                for (int i = next++; i < count; i = next++)
+                    build(i);
+            }
+            catch (...)
+            {
+                // Leave the remaining subtrees unbuilt
+                next = count;
+                std::lock_guard lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(std::min<std::size_t>(threads, count) - 1);
+        for (std::size_t t = 1; t < std::min<std::size_t>(threads, count); ++t)
+            workers.emplace_back(worker);
+        worker();
+        for (auto& w : workers)
+            w.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+    else
+    {
+        for (int i = 0; i < count; ++i)
+            build(i);
+    }
+
+    auto node = intr_ptr::make_shared<SHAMapInnerNode>(cowid_, count);
+    for (int i = 0; i < count; ++i)
+        node->setChild(branches[i], std::move(children[i]));
+
+    // Children are already hashed; this only copies their hashes
+    node->updateHashDeep();
+    return finish(std::move(node));
+}
+
 SHAMapHash
 SHAMap::getHash() const
 {
@@ -876,7 +1110,8 @@ SHAMap::updateGiveItem(
     if (stack.empty())
         Throw<SHAMapMissingNode>(type_, tag);
 
-    auto node = std::dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
+    auto node =
+        intr_ptr::dynamic_pointer_cast<SHAMapLeafNode>(stack.top().first);
     auto nodeID = stack.top().second;
     stack.pop();
 
@@ -946,8 +1181,10 @@ SHAMap::fetchRoot(SHAMapHash const& hash, SHAMapSyncFilter* filter)
     @note The node must have already been unshared by having the caller
           first call SHAMapTreeNode::unshare().
  */
-std::shared_ptr<SHAMapTreeNode>
-SHAMap::writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const
+intr_ptr::SharedPtr<SHAMapTreeNode>
+SHAMap::writeNode(
+    NodeObjectType t,
+    intr_ptr::SharedPtr<SHAMapTreeNode> node) const
 {
     assert(node->cowid() == 0);
     assert(backed_);
@@ -965,8 +1202,8 @@ SHAMap::writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const
 // pointer to because flushing modifies inner nodes -- it
 // makes them point to canonical/shared nodes.
 template <class Node>
-std::shared_ptr<Node>
-SHAMap::preFlushNode(std::shared_ptr<Node> node) const
+intr_ptr::SharedPtr<Node>
+SHAMap::preFlushNode(intr_ptr::SharedPtr<Node> node) const
 {
     // A shared node should never need to be flushed
     // because that would imply someone modified it
@@ -976,7 +1213,7 @@ SHAMap::preFlushNode(std::shared_ptr<Node> node) const
     {
         // Node is not uniquely ours, so unshare it before
         // possibly modifying it
-        node = std::static_pointer_cast<Node>(node->clone(cowid_));
+        node = intr_ptr::static_pointer_cast<Node>(node->clone(cowid_));
     }
     return node;
 }
@@ -1017,17 +1254,17 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         return 1;
     }
 
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
+    auto node = intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_);
 
     if (node->isEmpty())
     {  // replace empty root with a new empty root
-        root_ = std::make_shared<SHAMapInnerNode>(0);
+        root_ = intr_ptr::make_shared<SHAMapInnerNode>(0);
         return 1;
     }
 
     // Stack of {parent,index,child} pointers representing
     // inner nodes we are in the process of flushing
-    using StackEntry = std::pair<std::shared_ptr<SHAMapInnerNode>, int>;
+    using StackEntry = std::pair<intr_ptr::SharedPtr<SHAMapInnerNode>, int>;
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
     node = preFlushNode(std::move(node));
@@ -1064,7 +1301,7 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
                         // The semantics of this changes when we move to c++-20
                         // Right now no move will occur; With c++-20 child will
                         // be moved from.
-                        node = std::static_pointer_cast<SHAMapInnerNode>(
+                        node = intr_ptr::static_pointer_cast<SHAMapInnerNode>(
                             std::move(child));
                         pos = 0;
                     }
@@ -1086,14 +1323,16 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
             }
         }
 
-        // update the hash of this inner node
-        node->updateHashDeep();
+        // update the hash of this inner node, unless it is already current:
+        // modifying a child always clears the hash of each of its parents.
+        if (node->getHash().isZero())
+            node->updateHashDeep();
 
         // This inner node can now be shared
         node->unshare();
 
         if (doWrite)
-            node = std::static_pointer_cast<SHAMapInnerNode>(
+            node = intr_ptr::static_pointer_cast<SHAMapInnerNode>(
                 writeNode(t, std::move(node)));
 
         ++flushed;
@@ -1163,7 +1402,7 @@ SHAMap::dump(bool hash) const
     JLOG(journal_.info()) << leafCount << " resident leaves";
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMap::cacheLookup(SHAMapHash const& hash) const
 {
     auto ret = f_.getTreeNodeCache()->fetch(hash.as_uint256());
@@ -1174,7 +1413,7 @@ SHAMap::cacheLookup(SHAMapHash const& hash) const
 void
 SHAMap::canonicalize(
     SHAMapHash const& hash,
-    std::shared_ptr<SHAMapTreeNode>& node) const
+    intr_ptr::SharedPtr<SHAMapTreeNode>& node) const
 {
     assert(backed_);
     assert(node->cowid() == 0);
@@ -40,9 +40,33 @@ SHAMapInnerNode::SHAMapInnerNode(
     std::uint8_t numAllocatedChildren)
     : SHAMapTreeNode(cowid), hashesAndChildren_(numAllocatedChildren)
 {
+    countBytes(arrayBytes());
 }
 
-SHAMapInnerNode::~SHAMapInnerNode() = default;
+SHAMapInnerNode::~SHAMapInnerNode()
+{
+    countBytes(-static_cast<std::ptrdiff_t>(arrayBytes()));
+}
+
+std::size_t
+SHAMapInnerNode::arrayBytes() const
+{
+    return hashesAndChildren_.capacity() * elementSizeBytes;
+}
+
+std::size_t
+SHAMapInnerNode::memoryFootprint() const
+{
+    return sizeof(*this) + arrayBytes();
+}
+
+void
+SHAMapInnerNode::partialDestructor()
+{
+    auto const children = hashesAndChildren_.getChildren();
+    iterNonEmptyChildIndexes(
+        [&](auto branchNum, auto indexNum) { children[indexNum].reset(); });
+}
 
 template <class F>
 void
@@ -61,8 +85,10 @@ SHAMapInnerNode::iterNonEmptyChildIndexes(F&& f) const
 void
 SHAMapInnerNode::resizeChildArrays(std::uint8_t toAllocate)
 {
+    auto const before = static_cast<std::ptrdiff_t>(arrayBytes());
     hashesAndChildren_ =
         TaggedPointer(std::move(hashesAndChildren_), isBranch_, toAllocate);
+    countBytes(static_cast<std::ptrdiff_t>(arrayBytes()) - before);
 }
 
 std::optional<int>
@@ -71,17 +97,17 @@ SHAMapInnerNode::getChildIndex(int i) const
     return hashesAndChildren_.getChildIndex(isBranch_, i);
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMapInnerNode::clone(std::uint32_t cowid) const
 {
     auto const branchCount = getBranchCount();
     auto const thisIsSparse = !hashesAndChildren_.isDense();
-    auto p = std::make_shared<SHAMapInnerNode>(cowid, branchCount);
+    auto p = intr_ptr::make_shared<SHAMapInnerNode>(cowid, branchCount);
     p->hash_ = hash_;
     p->isBranch_ = isBranch_;
     p->fullBelowGen_ = fullBelowGen_;
     SHAMapHash *cloneHashes, *thisHashes;
-    std::shared_ptr<SHAMapTreeNode>*cloneChildren, *thisChildren;
+    intr_ptr::SharedPtr<SHAMapTreeNode>*cloneChildren, *thisChildren;
     // structured bindings can't be captured in c++ 17; use tie instead
     std::tie(std::ignore, cloneHashes, cloneChildren) =
         p->hashesAndChildren_.getHashesAndChildren();
@@ -122,7 +148,7 @@ SHAMapInnerNode::clone(std::uint32_t cowid) const
     return p;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMapInnerNode::makeFullInner(
     Slice data,
     SHAMapHash const& hash,
@@ -132,7 +158,7 @@ SHAMapInnerNode::makeFullInner(
     if (data.size() != branchFactor * uint256::bytes)
         Throw<std::runtime_error>("Invalid FI node");
 
-    auto ret = std::make_shared<SHAMapInnerNode>(0, branchFactor);
+    auto ret = intr_ptr::make_shared<SHAMapInnerNode>(0, branchFactor);
 
     SerialIter si(data);
 
@@ -156,7 +182,7 @@ SHAMapInnerNode::makeFullInner(
     return ret;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMapInnerNode::makeCompressedInner(Slice data)
 {
     // A compressed inner node is serialized as a series of 33 byte chunks,
@@ -169,7 +195,7 @@ SHAMapInnerNode::makeCompressedInner(Slice data)
 
     SerialIter si(data);
 
-    auto ret = std::make_shared<SHAMapInnerNode>(0, branchFactor);
+    auto ret = intr_ptr::make_shared<SHAMapInnerNode>(0, branchFactor);
 
     auto hashes = ret->hashesAndChildren_.getHashes();
 
@@ -211,7 +237,7 @@ void
 SHAMapInnerNode::updateHashDeep()
 {
     SHAMapHash* hashes;
-    std::shared_ptr<SHAMapTreeNode>* children;
+    intr_ptr::SharedPtr<SHAMapTreeNode>* children;
     // structured bindings can't be captured in c++ 17; use tie instead
     std::tie(std::ignore, hashes, children) =
         hashesAndChildren_.getHashesAndChildren();
@@ -272,7 +298,7 @@ SHAMapInnerNode::getString(const SHAMapNodeID& id) const
 
 // We are modifying an inner node
 void
-SHAMapInnerNode::setChild(int m, std::shared_ptr<SHAMapTreeNode> child)
+SHAMapInnerNode::setChild(int m, intr_ptr::SharedPtr<SHAMapTreeNode> child)
 {
     assert((m >= 0) && (m < branchFactor));
     assert(cowid_ != 0);
@@ -288,8 +314,10 @@ SHAMapInnerNode::setChild(int m, std::shared_ptr<SHAMapTreeNode> child)
     auto const dstToAllocate = popcnt16(dstIsBranch);
     // change hashesAndChildren to remove the element, or make room for the
     // added element, if necessary
+    auto const before = static_cast<std::ptrdiff_t>(arrayBytes());
     hashesAndChildren_ = TaggedPointer(
         std::move(hashesAndChildren_), isBranch_, dstIsBranch, dstToAllocate);
+    countBytes(static_cast<std::ptrdiff_t>(arrayBytes()) - before);
 
     isBranch_ = dstIsBranch;
 
@@ -308,7 +336,9 @@ SHAMapInnerNode::setChild(int m, std::shared_ptr<SHAMapTreeNode> child)
 
 // finished modifying, now make shareable
 void
-SHAMapInnerNode::shareChild(int m, std::shared_ptr<SHAMapTreeNode> const& child)
+SHAMapInnerNode::shareChild(
+    int m,
+    intr_ptr::SharedPtr<SHAMapTreeNode> const& child)
 {
     assert((m >= 0) && (m < branchFactor));
     assert(cowid_ != 0);
@@ -332,7 +362,7 @@ SHAMapInnerNode::getChildPointer(int branch)
     return hashesAndChildren_.getChildren()[index].get();
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMapInnerNode::getChild(int branch)
 {
     assert(branch >= 0 && branch < branchFactor);
@@ -355,10 +385,10 @@ SHAMapInnerNode::getChildHash(int m) const
     return zeroSHAMapHash;
 }
 
-std::shared_ptr<SHAMapTreeNode>
+intr_ptr::SharedPtr<SHAMapTreeNode>
 SHAMapInnerNode::canonicalizeChild(
     int branch,
-    std::shared_ptr<SHAMapTreeNode> node)
+    intr_ptr::SharedPtr<SHAMapTreeNode> node)
 {
     assert(branch >= 0 && branch < branchFactor);
     assert(node);
@@ -40,6 +40,12 @@ SHAMapLeafNode::SHAMapLeafNode(
     assert(item_->size() >= 12);
 }
 
+void
+SHAMapLeafNode::partialDestructor()
+{
+    item_.reset();
+}
+
 boost::intrusive_ptr<SHAMapItem const> const&
 SHAMapLeafNode::peekItem() const
 {
@@ -84,6 +90,12 @@ SHAMapLeafNode::getString(const SHAMapNodeID& id) const
     return ret;
 }
 
+std::size_t
+SHAMapLeafNode::memoryFootprint() const
+{
+    return sizeof(*this) + (item_ ? item_->memoryFootprint() : 0);
+}
+
 void
 SHAMapLeafNode::invariants(bool) const
 {
@@ -46,10 +46,10 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
     if (!root_->isInner())
         return;
 
-    using StackEntry = std::pair<int, std::shared_ptr<SHAMapInnerNode>>;
+    using StackEntry = std::pair<int, intr_ptr::SharedPtr<SHAMapInnerNode>>;
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
+    auto node = intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_);
     int pos = 0;
 
     while (true)
@@ -58,7 +58,7 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
         {
             if (!node->isEmptyBranch(pos))
             {
-                std::shared_ptr<SHAMapTreeNode> child =
+                intr_ptr::SharedPtr<SHAMapTreeNode> child =
                     descendNoStore(node, pos);
                 if (!function(*child))
                     return;
@@ -78,7 +78,8 @@ SHAMap::visitNodes(std::function<bool(SHAMapTreeNode&)> const& function) const
                     }
 
                     // descend to the child's first position
-                    node = std::static_pointer_cast<SHAMapInnerNode>(child);
+                    node =
+                        intr_ptr::static_pointer_cast<SHAMapInnerNode>(child);
                     pos = 0;
                 }
             }
@@ -114,7 +115,7 @@ SHAMap::visitDifferences(
 
     if (root_->isLeaf())
     {
-        auto leaf = std::static_pointer_cast<SHAMapLeafNode>(root_);
+        auto leaf = intr_ptr::static_pointer_cast<SHAMapLeafNode>(root_);
         if (!have ||
             !have->hasLeafNode(leaf->peekItem()->key(), leaf->getHash()))
             function(*root_);
@@ -201,7 +202,8 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
                 mn.filter_,
                 pending,
                 [node, nodeID, branch, &mn](
-                    std::shared_ptr<SHAMapTreeNode> found, SHAMapHash const&) {
+                    intr_ptr::SharedPtr<SHAMapTreeNode> found,
+                    SHAMapHash const&) {
                     // a read completed asynchronously
                     std::unique_lock<std::mutex> lock{mn.deferLock_};
                     mn.finishedReads_.emplace_back(
@@ -270,7 +272,7 @@ SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
             SHAMapInnerNode*,
             SHAMapNodeID,
             int,
-            std::shared_ptr<SHAMapTreeNode>>
+            intr_ptr::SharedPtr<SHAMapTreeNode>>
             deferredNode;
         {
             std::unique_lock<std::mutex> lock{mn.deferLock_};
@@ -324,7 +326,7 @@ SHAMap::getMissingNodes(int max, SHAMapSyncFilter* filter)
         f_.getFullBelowCache()->getGeneration());
 
     if (!root_->isInner() ||
-        std::static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
+        intr_ptr::static_pointer_cast<SHAMapInnerNode>(root_)->isFullBelow(
             mn.generation_))
     {
         clearSynching();
@@ -569,6 +571,27 @@ SHAMap::addKnownNode(
     const SHAMapNodeID& node,
     Slice const& rawNode,
     SHAMapSyncFilter* filter)
+{
+    return addKnownNodeImpl(
+        node, [&]() { return SHAMapTreeNode::makeFromWire(rawNode); }, filter);
+}
+
+SHAMapAddNode
+SHAMap::addKnownNode(
+    const SHAMapNodeID& node,
+    intr_ptr::SharedPtr<SHAMapTreeNode> newNode,
+    SHAMapSyncFilter* filter)
+{
+    return addKnownNodeImpl(
+        node, [&]() { return std::move(newNode); }, filter);
+}
+
+template <class MakeNode>
+SHAMapAddNode
+SHAMap::addKnownNodeImpl(
+    const SHAMapNodeID& node,
+    MakeNode&& makeNode,
+    SHAMapSyncFilter* filter)
 {
     assert(!node.isRoot());
 
@@ -606,7 +629,7 @@ SHAMap::addKnownNode(
 
         if (iNode == nullptr)
         {
-            auto newNode = SHAMapTreeNode::makeFromWire(rawNode);
+            auto newNode = makeNode();
 
             if (!newNode || childHash != newNode->getHash())
             {
@@ -797,8 +820,9 @@ SHAMap::getProofPath(uint256 const& key) const
     }
 
     if (auto const& node = stack.top().first; !node || node->isInner() ||
-        std::static_pointer_cast<SHAMapLeafNode>(node)->peekItem()->key() !=
-            key)
+        intr_ptr::static_pointer_cast<SHAMapLeafNode>(node)
+                ->peekItem()
+                ->key() != key)
     {
         JLOG(journal_.debug()) << "no path to " << key;
         return {};